@@ -0,0 +1,180 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "BatchedUno.hpp"
+#include "Uno.hpp"
+#include "model/ModelFactory.hpp"
+#include "model/synthetic/SyntheticModelFactory.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/HugePageAllocator.hpp"
+#include "tools/Logger.hpp"
+#include "tools/UserCallbacks.hpp"
+
+namespace uno {
+   void run_uno_synthetic(const std::string& problem_name, size_t size, const Options& options) {
+      try {
+         // synthetic model
+         std::unique_ptr<Model> synthetic_model = SyntheticModelFactory::create(problem_name, size);
+         DISCRETE << "Original model " << synthetic_model->name << '\n' << synthetic_model->number_variables << " variables, " <<
+            synthetic_model->number_constraints << " constraints, " << synthetic_model->number_jacobian_nonzeros() << " Jacobian nonzeros, " <<
+            synthetic_model->number_hessian_nonzeros() << " Hessian nonzeros\n";
+
+         // reformulate (scale, add slacks, relax the bounds, ...) if necessary
+         std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(synthetic_model), options);
+
+         // initialize initial primal and dual points
+         Iterate initial_iterate(model->number_variables, model->number_constraints);
+         model->initial_primal_point(initial_iterate.primals);
+         model->project_onto_variable_bounds(initial_iterate.primals);
+         model->initial_dual_point(initial_iterate.multipliers.constraints);
+         initial_iterate.feasibility_multipliers.reset();
+
+         // create the constraint relaxation strategy, the globalization mechanism and the Uno solver
+         auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
+         auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+         Uno uno = Uno(*globalization_mechanism, options);
+
+         // solve the instance
+         NoUserCallbacks user_callbacks{};
+         uno.solve(*model, initial_iterate, options, user_callbacks);
+      }
+      catch (std::exception& exception) {
+         DISCRETE << exception.what() << '\n';
+      }
+   }
+
+   // throughput of the batched solver against independent solves of the same instances
+   void run_batched_uno_synthetic(const std::string& problem_name, size_t size, size_t number_instances, const Options& options) {
+      try {
+         // instances with the same structure that differ by their initial points
+         std::vector<std::unique_ptr<Model>> models{};
+         std::vector<const Model*> model_pointers{};
+         std::vector<Iterate> initial_iterates{};
+         for (size_t instance_index: Range(number_instances)) {
+            models.emplace_back(ModelFactory::reformulate(SyntheticModelFactory::create(problem_name, size), options));
+            const Model& model = *models.back();
+            model_pointers.emplace_back(&model);
+            Iterate& initial_iterate = initial_iterates.emplace_back(model.number_variables, model.number_constraints);
+            model.initial_primal_point(initial_iterate.primals);
+            for (size_t variable_index: Range(model.number_variables)) {
+               initial_iterate.primals[variable_index] += 0.1 * std::sin(static_cast<double>(instance_index * model.number_variables + variable_index));
+            }
+            model.project_onto_variable_bounds(initial_iterate.primals);
+            model.initial_dual_point(initial_iterate.multipliers.constraints);
+            initial_iterate.feasibility_multipliers.reset();
+         }
+         const auto count_successes = [](const std::vector<Result>& results) {
+            return std::count_if(results.begin(), results.end(), [](const Result& result) {
+               return result.optimization_status == OptimizationStatus::SUCCESS;
+            });
+         };
+
+         // independent solves
+         std::vector<Iterate> independent_iterates = initial_iterates;
+         std::vector<Result> independent_results{};
+         auto start_time = std::chrono::steady_clock::now();
+         for (size_t instance_index: Range(number_instances)) {
+            auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*models[instance_index], options);
+            auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+            Uno uno = Uno(*globalization_mechanism, options);
+            independent_results.emplace_back(uno.solve(*models[instance_index], independent_iterates[instance_index], options));
+         }
+         const std::chrono::duration<double> independent_time = std::chrono::steady_clock::now() - start_time;
+
+         // batched solves
+         BatchedUno batched_uno(options);
+         start_time = std::chrono::steady_clock::now();
+         const std::vector<Result> batched_results = batched_uno.solve(model_pointers, initial_iterates, options);
+         const std::chrono::duration<double> batched_time = std::chrono::steady_clock::now() - start_time;
+
+         std::cout << number_instances << " instances of " << models[0]->name << " (batch size " << options.get_unsigned_int("batch_size") << ")\n";
+         std::cout << "Independent solves: " << independent_time.count() << " s, " << static_cast<double>(number_instances) / independent_time.count() <<
+            " instances/s, " << count_successes(independent_results) << " successes\n";
+         std::cout << "Batched solves:     " << batched_time.count() << " s, " << static_cast<double>(number_instances) / batched_time.count() <<
+            " instances/s, " << count_successes(batched_results) << " successes, " << batched_uno.number_batched_factorizations() <<
+            " batched factorizations\n";
+      }
+      catch (std::exception& exception) {
+         DISCRETE << exception.what() << '\n';
+      }
+   }
+
+   void print_uno_synthetic_instructions() {
+      std::cout << "Welcome in Uno " << Uno::current_version() << '\n';
+      std::cout << "To solve a synthetic problem, type ./uno_synthetic problem size [option_name=option_value ...]\n";
+      std::cout << "The available problems are:";
+      for (const std::string& problem_name: SyntheticModelFactory::available_problems()) {
+         std::cout << ' ' << problem_name;
+      }
+      std::cout << '\n';
+      std::cout << "The size is the number of variables (chained_rosenbrock), time steps (optimal_control, budget_control), grid points per dimension "
+                   "(poisson_control) or nodes (network_flow)\n";
+      std::cout << "To compare the batched solver with independent solves of N instances, add the argument batched_instances=N\n";
+   }
+} // namespace
+
+int main(int argc, char* argv[]) {
+   using namespace uno;
+
+   try {
+      if (argc < 3) {
+         print_uno_synthetic_instructions();
+      }
+      else {
+         // ./uno_synthetic problem size [option_name=option_value, ...]
+         const std::string problem_name = std::string(argv[1]);
+         const size_t size = std::stoul(std::string(argv[2]));
+
+         Options options = DefaultOptions::load();
+
+         // determine the default solvers based on the available libraries
+         Options solvers_options = DefaultOptions::determine_solvers();
+         options.overwrite_with(solvers_options);
+
+         // get the command line arguments (options start at index 3)
+         Options command_line_options = Options::get_command_line_options(argc, argv, 3);
+
+         // possibly set options from an option file
+         const auto optional_option_file = command_line_options.get_string_optional("option_file");
+         if (optional_option_file.has_value()) {
+            Options file_options = Options::load_option_file(*optional_option_file);
+            options.overwrite_with(file_options);
+         }
+
+         // possibly set a preset
+         const auto optional_preset = command_line_options.get_string_optional("preset");
+         Options preset_options = Presets::get_preset_options(optional_preset);
+         options.overwrite_with(preset_options);
+
+         // overwrite the options with the command line arguments
+         options.overwrite_with(command_line_options);
+
+         // solve the model
+         Logger::set_logger(options.get_string("logger"));
+         HugePages::set_policy(options.get_string("huge_pages"));
+         const auto optional_batched_instances = command_line_options.get_string_optional("batched_instances");
+         if (optional_batched_instances.has_value()) {
+            run_batched_uno_synthetic(problem_name, size, std::stoul(*optional_batched_instances), options);
+         }
+         else {
+            run_uno_synthetic(problem_name, size, options);
+         }
+      }
+   }
+   catch (std::exception& exception) {
+      DISCRETE << exception.what() << '\n';
+   }
+   return EXIT_SUCCESS;
+}
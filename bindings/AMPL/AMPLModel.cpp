@@ -3,10 +3,13 @@
 
 #include <array>
 #include <cassert>
+#include <filesystem>
 #include <stdexcept>
 #include "AMPLModel.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/nl/CompiledNLEvaluator.hpp"
+#include "model/nl/NLReader.hpp"
 #include "optimization/EvaluationErrors.hpp"
 #include "optimization/Iterate.hpp"
 #include "tools/Logger.hpp"
@@ -51,36 +54,27 @@ namespace uno {
          variable_upper_bounds(this->number_variables),
          constraint_lower_bounds(this->number_constraints),
          constraint_upper_bounds(this->number_constraints),
-         variable_status(this->number_variables),
          constraint_type(this->number_constraints),
-         constraint_status(this->number_constraints),
          multipliers_with_flipped_sign(this->number_constraints),
-         linear_constraints_collection(this->linear_constraints),
-         equality_constraints_collection(this->equality_constraints),
-         inequality_constraints_collection(this->inequality_constraints),
-         lower_bounded_variables_collection(this->lower_bounded_variables),
-         upper_bounded_variables_collection(this->upper_bounded_variables),
-         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
-         single_upper_bounded_variables_collection(this->single_upper_bounded_variables) {
+         partition(this->number_variables, this->number_constraints) {
       // evaluate the constraint Jacobian in sparse mode
       this->asl->i.congrd_mode = 1;
 
-      // variables
-      this->lower_bounded_variables.reserve(this->number_variables);
-      this->upper_bounded_variables.reserve(this->number_variables);
-      this->single_lower_bounded_variables.reserve(this->number_variables);
-      this->single_upper_bounded_variables.reserve(this->number_variables);
-      this->fixed_variables.reserve(this->number_variables);
       this->generate_variables();
-
-      // constraints
-      this->equality_constraints.reserve(this->number_constraints);
-      this->inequality_constraints.reserve(this->number_constraints);
-      this->linear_constraints.reserve(this->number_constraints);
       this->generate_constraints();
+      this->partition.compute(this->variable_lower_bounds, this->variable_upper_bounds, this->constraint_lower_bounds,
+         this->constraint_upper_bounds, this->constraint_type);
+      for (size_t variable_index: this->partition.get_fixed_variables()) {
+         WARNING << "Variable x" << variable_index << " has identical bounds\n";
+      }
+      this->compute_constraint_jacobian_sparsity();
 
       // compute sparsity pattern and number of nonzeros of Lagrangian Hessian
       this->compute_lagrangian_hessian_sparsity();
+
+      if (options.get_bool("AMPL_compile_expressions")) {
+         this->compile_expressions(file_name, options);
+      }
    }
 
    AMPLModel::~AMPLModel() {
@@ -88,6 +82,9 @@ namespace uno {
    }
 
    double AMPLModel::evaluate_objective(const Vector<double>& x) const {
+      if (this->compiled_evaluator) {
+         return this->compiled_evaluator->evaluate_objective(x);
+      }
       fint error_flag = 0;
       double result = this->objective_sign * (*(this->asl)->p.Objval)(this->asl, 0, const_cast<double*>(x.data()), &error_flag);
       if (0 < error_flag) {
@@ -98,6 +95,10 @@ namespace uno {
 
    // sparse gradient
    void AMPLModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      if (this->compiled_evaluator) {
+         this->compiled_evaluator->evaluate_objective_gradient(x, gradient);
+         return;
+      }
       fint error_flag = 0;
       // prevent ASL to crash by catching all evaluation errors
       Jmp_buf err_jmp_uno;
@@ -135,6 +136,10 @@ namespace uno {
    */
 
    void AMPLModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      if (this->compiled_evaluator) {
+         this->compiled_evaluator->evaluate_constraints(x, constraints);
+         return;
+      }
       fint error_flag = 0;
       (*(this->asl)->p.Conval)(this->asl, const_cast<double*>(x.data()), constraints.data(), &error_flag);
       if (0 < error_flag) {
@@ -144,6 +149,11 @@ namespace uno {
 
    // sparse gradient
    void AMPLModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      if (this->compiled_evaluator) {
+         gradient.clear();
+         this->compiled_evaluator->evaluate_constraint_gradient(x, constraint_index, gradient);
+         return;
+      }
       // compute the AMPL sparse gradient
       fint error_flag = 0;
       (*(this->asl)->p.Congrd)(this->asl, static_cast<int>(constraint_index), const_cast<double*>(x.data()), const_cast<double*>(this->asl_gradient.data()),
@@ -165,14 +175,33 @@ namespace uno {
    }
 
    void AMPLModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      if (this->compiled_evaluator) {
+         this->compiled_evaluator->evaluate_constraint_jacobian(x, constraint_jacobian);
+         return;
+      }
+      // evaluate all the rows in a single ASL call instead of one Congrd call per constraint
+      fint error_flag = 0;
+      (*(this->asl)->p.Jacval)(this->asl, const_cast<double*>(x.data()), this->asl_jacobian.data(), &error_flag);
+      if (0 < error_flag) {
+         throw GradientEvaluationError();
+      }
+
+      // scatter the nonzeros into the rows
       for (size_t constraint_index: Range(this->number_constraints)) {
-         constraint_jacobian[constraint_index].clear();
-         this->evaluate_constraint_gradient(x, constraint_index, constraint_jacobian[constraint_index]);
+         SparseVector<double>& constraint_gradient = constraint_jacobian[constraint_index];
+         constraint_gradient.clear();
+         for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+            constraint_gradient.insert(this->jacobian_column_indices[nonzero_index], this->asl_jacobian[this->jacobian_asl_positions[nonzero_index]]);
+         }
       }
    }
 
-   void AMPLModel::evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& multipliers,
+   void AMPLModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
          SymmetricMatrix<size_t, double>& hessian) const {
+      if (this->compiled_evaluator) {
+         this->compiled_evaluator->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+         return;
+      }
       assert(hessian.capacity() >= this->number_asl_hessian_nonzeros);
 
       // register the vector of variables
@@ -216,31 +245,31 @@ namespace uno {
    }
 
    BoundType AMPLModel::get_variable_bound_type(size_t variable_index) const {
-      return this->variable_status[variable_index];
+      return this->partition.get_variable_bound_type(variable_index);
    }
 
    const Collection<size_t>& AMPLModel::get_lower_bounded_variables() const {
-      return this->lower_bounded_variables_collection;
+      return this->partition.get_lower_bounded_variables();
    }
 
    const Collection<size_t>& AMPLModel::get_upper_bounded_variables() const {
-      return this->upper_bounded_variables_collection;
+      return this->partition.get_upper_bounded_variables();
    }
 
    const SparseVector<size_t>& AMPLModel::get_slacks() const {
-      return this->slacks;
+      return this->partition.get_slacks();
    }
 
    const Collection<size_t>& AMPLModel::get_single_lower_bounded_variables() const {
-      return this->single_lower_bounded_variables_collection;
+      return this->partition.get_single_lower_bounded_variables();
    }
 
    const Collection<size_t>& AMPLModel::get_single_upper_bounded_variables() const {
-      return this->single_upper_bounded_variables_collection;
+      return this->partition.get_single_upper_bounded_variables();
    }
 
    const Vector<size_t>& AMPLModel::get_fixed_variables() const {
-      return this->fixed_variables;
+      return this->partition.get_fixed_variables();
    }
 
    double AMPLModel::constraint_lower_bound(size_t constraint_index) const {
@@ -256,19 +285,19 @@ namespace uno {
    }
 
    BoundType AMPLModel::get_constraint_bound_type(size_t constraint_index) const {
-      return this->constraint_status[constraint_index];
+      return this->partition.get_constraint_bound_type(constraint_index);
    }
 
    const Collection<size_t>& AMPLModel::get_equality_constraints() const {
-      return this->equality_constraints_collection;
+      return this->partition.get_equality_constraints();
    }
 
    const Collection<size_t>& AMPLModel::get_inequality_constraints() const {
-      return this->inequality_constraints_collection;
+      return this->partition.get_inequality_constraints();
    }
 
    const Collection<size_t>& AMPLModel::get_linear_constraints() const {
-      return this->linear_constraints_collection;
+      return this->partition.get_linear_constraints();
    }
 
    // initial primal point
@@ -326,14 +355,23 @@ namespace uno {
    }
 
    size_t AMPLModel::number_objective_gradient_nonzeros() const {
+      if (this->compiled_evaluator) {
+         return this->compiled_evaluator->number_objective_gradient_nonzeros();
+      }
       return static_cast<size_t>(this->asl->i.nzo_);
    }
 
    size_t AMPLModel::number_jacobian_nonzeros() const {
+      if (this->compiled_evaluator) {
+         return this->compiled_evaluator->number_jacobian_nonzeros();
+      }
       return static_cast<size_t>(this->asl->i.nzc_);
    }
 
    size_t AMPLModel::number_hessian_nonzeros() const {
+      if (this->compiled_evaluator) {
+         return this->compiled_evaluator->number_hessian_nonzeros();
+      }
       return this->number_asl_hessian_nonzeros;
    }
 
@@ -341,27 +379,6 @@ namespace uno {
       for (size_t variable_index: Range(this->number_variables)) {
          this->variable_lower_bounds[variable_index] = (this->asl->i.LUv_ != nullptr) ? this->asl->i.LUv_[2*variable_index] : -INF<double>;
          this->variable_upper_bounds[variable_index] = (this->asl->i.LUv_ != nullptr) ? this->asl->i.LUv_[2*variable_index + 1] : INF<double>;
-         if (this->variable_lower_bounds[variable_index] == this->variable_upper_bounds[variable_index]) {
-            WARNING << "Variable x" << variable_index << " has identical bounds\n";
-            this->fixed_variables.emplace_back(variable_index);
-         }
-      }
-      AMPLModel::determine_bounds_types(this->variable_lower_bounds, this->variable_upper_bounds, this->variable_status);
-      // figure out the bounded variables
-      for (size_t variable_index: Range(this->number_variables)) {
-         const BoundType status = this->get_variable_bound_type(variable_index);
-         if (status == BOUNDED_LOWER || status == BOUNDED_BOTH_SIDES) {
-            this->lower_bounded_variables.emplace_back(variable_index);
-            if (status == BOUNDED_LOWER) {
-               this->single_lower_bounded_variables.emplace_back(variable_index);
-            }
-         }
-         if (status == BOUNDED_UPPER || status == BOUNDED_BOTH_SIDES) {
-            this->upper_bounded_variables.emplace_back(variable_index);
-            if (status == BOUNDED_UPPER) {
-               this->single_upper_bounded_variables.emplace_back(variable_index);
-            }
-         }
       }
    }
 
@@ -370,17 +387,6 @@ namespace uno {
          this->constraint_lower_bounds[constraint_index] = (this->asl->i.LUrhs_ != nullptr) ? this->asl->i.LUrhs_[2*constraint_index] : -INF<double>;
          this->constraint_upper_bounds[constraint_index] = (this->asl->i.LUrhs_ != nullptr) ? this->asl->i.LUrhs_[2*constraint_index + 1] : INF<double>;
       }
-      AMPLModel::determine_bounds_types(this->constraint_lower_bounds, this->constraint_upper_bounds, this->constraint_status);
-
-      // partition equality and inequality constraints
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         if (this->get_constraint_bound_type(constraint_index) == EQUAL_BOUNDS) {
-            this->equality_constraints.emplace_back(constraint_index);
-         }
-         else {
-            this->inequality_constraints.emplace_back(constraint_index);
-         }
-      }
 
       // AMPL orders the constraints based on the function type: nonlinear first, then linear
       const size_t number_nonlinear_constraints = static_cast<size_t>(this->asl->i.nlc_);
@@ -389,7 +395,44 @@ namespace uno {
       }
       for (size_t constraint_index: Range(number_nonlinear_constraints, this->number_constraints)) {
          this->constraint_type[constraint_index] = LINEAR;
-         this->linear_constraints.emplace_back(constraint_index);
+      }
+   }
+
+   // evaluate the model with native code compiled from the .nl file. ASL remains in use if the compilation fails
+   void AMPLModel::compile_expressions(const std::string& file_name, const Options& options) {
+      std::string directory = options.get_string("AMPL_compilation_directory");
+      if (directory == "default") {
+         directory = CompiledNLEvaluator::default_directory();
+      }
+      try {
+         auto evaluator = std::make_unique<CompiledNLEvaluator>(NLReader::read(file_name), options.get_string("AMPL_compiler"), directory);
+         const NLProblem& problem = evaluator->get_problem();
+         if (problem.number_variables != this->number_variables || problem.number_constraints != this->number_constraints) {
+            throw std::runtime_error("the dimensions differ from those of ASL");
+         }
+         DISCRETE << "The expressions were compiled into " << evaluator->get_library_path() << " (" << evaluator->number_kernels() << " kernels)\n";
+         this->compiled_evaluator = std::move(evaluator);
+      }
+      catch (const std::exception& exception) {
+         WARNING << "The expressions could not be compiled, ASL is used instead: " << exception.what() << '\n';
+      }
+   }
+
+   void AMPLModel::compute_constraint_jacobian_sparsity() {
+      const size_t number_jacobian_nonzeros = static_cast<size_t>(this->asl->i.nzc_);
+      this->asl_jacobian.resize(number_jacobian_nonzeros);
+      this->jacobian_row_starts.reserve(this->number_constraints + 1);
+      this->jacobian_column_indices.reserve(number_jacobian_nonzeros);
+      this->jacobian_asl_positions.reserve(number_jacobian_nonzeros);
+
+      // flatten the ASL linked lists into row-major arrays
+      this->jacobian_row_starts.emplace_back(0);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         for (cgrad* asl_variables_tmp = this->asl->i.Cgrad_[constraint_index]; asl_variables_tmp != nullptr; asl_variables_tmp = asl_variables_tmp->next) {
+            this->jacobian_column_indices.emplace_back(static_cast<size_t>(asl_variables_tmp->varno));
+            this->jacobian_asl_positions.emplace_back(static_cast<size_t>(asl_variables_tmp->goff));
+         }
+         this->jacobian_row_starts.emplace_back(this->jacobian_column_indices.size());
       }
    }
 
@@ -406,27 +449,4 @@ namespace uno {
       // check that the column pointers are sorted in increasing order
       assert(in_increasing_order(asl_column_start, this->number_variables + 1) && "AMPLModel::evaluate_lagrangian_hessian: column starts are not ordered");
    }
-
-   void AMPLModel::determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds, std::vector<BoundType>& status) {
-      assert(lower_bounds.size() == status.size());
-      assert(upper_bounds.size() == status.size());
-      // build the "status" vector as a mapping (map/transform operation) of the "bounds" vector
-      for (size_t index: Range(lower_bounds.size())) {
-         if (lower_bounds[index] == upper_bounds[index]) {
-            status[index] = EQUAL_BOUNDS;
-         }
-         else if (is_finite(lower_bounds[index]) && is_finite(upper_bounds[index])) {
-            status[index] = BOUNDED_BOTH_SIDES;
-         }
-         else if (is_finite(lower_bounds[index])) {
-            status[index] = BOUNDED_LOWER;
-         }
-         else if (is_finite(upper_bounds[index])) {
-            status[index] = BOUNDED_UPPER;
-         }
-         else {
-            status[index] = UNBOUNDED;
-         }
-      }
-   }
 } // namespace
@@ -4,12 +4,13 @@
 #ifndef UNO_AMPLMODEL_H
 #define UNO_AMPLMODEL_H
 
+#include <memory>
 #include <vector>
 #include "model/Model.hpp"
+#include "model/ModelPartition.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "optimization/Multipliers.hpp"
-#include "symbolic/CollectionAdapter.hpp"
 
 // include AMPL Solver Library (ASL)
 extern "C" {
@@ -19,6 +20,7 @@ extern "C" {
 
 namespace uno {
    // forward reference
+   class NLEvaluator;
    class Options;
 
    /*! \class AMPLModel
@@ -74,41 +76,30 @@ namespace uno {
       const bool write_solution_to_file;
       mutable std::vector<double> asl_gradient{};
       mutable std::vector<double> asl_hessian{};
+      // Jacobian evaluated in one pass by ASL (Jacval) and scattered into the rows with a precomputed map
+      mutable std::vector<double> asl_jacobian{};
+      std::vector<size_t> jacobian_row_starts{};
+      std::vector<size_t> jacobian_column_indices{};
+      std::vector<size_t> jacobian_asl_positions{}; /*!< Position of each nonzero in the ASL Jacobian array (goff) */
       size_t number_asl_hessian_nonzeros{0}; /*!< Number of nonzero elements in the Hessian */
+      // optional native evaluation of the functions and derivatives (ASL is used otherwise)
+      std::unique_ptr<NLEvaluator> compiled_evaluator{};
 
       std::vector<double> variable_lower_bounds;
       std::vector<double> variable_upper_bounds;
       std::vector<double> constraint_lower_bounds;
       std::vector<double> constraint_upper_bounds;
-      std::vector<BoundType> variable_status; /*!< Status of the variables (EQUALITY, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES) */
       std::vector<FunctionType> constraint_type; /*!< Types of the constraints (LINEAR, QUADRATIC, NONLINEAR) */
-      std::vector<BoundType> constraint_status; /*!< Status of the constraints (EQUAL_BOUNDS, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES,
-    * UNBOUNDED) */
       mutable Vector<double> multipliers_with_flipped_sign;
 
-      // lists of variables and constraints + corresponding collection objects
-      std::vector<size_t> linear_constraints{};
-      CollectionAdapter<std::vector<size_t>&> linear_constraints_collection;
-      std::vector<size_t> equality_constraints{};
-      CollectionAdapter<std::vector<size_t>&> equality_constraints_collection;
-      std::vector<size_t> inequality_constraints{};
-      CollectionAdapter<std::vector<size_t>&> inequality_constraints_collection;
-      SparseVector<size_t> slacks{};
-      std::vector<size_t> lower_bounded_variables;
-      CollectionAdapter<std::vector<size_t>&> lower_bounded_variables_collection;
-      std::vector<size_t> upper_bounded_variables;
-      CollectionAdapter<std::vector<size_t>&> upper_bounded_variables_collection;
-      std::vector<size_t> single_lower_bounded_variables{}; // indices of the single lower-bounded variables
-      CollectionAdapter<std::vector<size_t>&> single_lower_bounded_variables_collection;
-      std::vector<size_t> single_upper_bounded_variables{}; // indices of the single upper-bounded variables
-      CollectionAdapter<std::vector<size_t>&> single_upper_bounded_variables_collection;
-      Vector<size_t> fixed_variables;
+      ModelPartition partition;
 
       void generate_variables();
       void generate_constraints();
 
+      void compile_expressions(const std::string& file_name, const Options& options);
+      void compute_constraint_jacobian_sparsity();
       void compute_lagrangian_hessian_sparsity();
-      static void determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds, std::vector<BoundType>& status);
    };
 
    // check that an array of integers is in increasing order (x[i] <= x[i+1])
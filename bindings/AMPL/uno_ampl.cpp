@@ -14,6 +14,7 @@
 #include "options/DefaultOptions.hpp"
 #include "options/Options.hpp"
 #include "options/Presets.hpp"
+#include "tools/HugePageAllocator.hpp"
 #include "tools/Logger.hpp"
 
 /*
@@ -137,6 +138,7 @@ int main(int argc, char* argv[]) {
 
          // solve the model
          Logger::set_logger(options.get_string("logger"));
+         HugePages::set_policy(options.get_string("huge_pages"));
          run_uno_ampl(model_name, options);
       }
    }
@@ -0,0 +1,108 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "Uno.hpp"
+#include "model/ModelFactory.hpp"
+#include "model/nl/NLModel.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/HugePageAllocator.hpp"
+#include "tools/Logger.hpp"
+#include "tools/UserCallbacks.hpp"
+
+namespace uno {
+   void run_uno_nl(const std::string& model_name, const Options& options) {
+      try {
+         // .nl model read without ASL
+         std::unique_ptr<Model> nl_model = std::make_unique<NLModel>(model_name, options);
+         DISCRETE << "Original model " << nl_model->name << '\n' << nl_model->number_variables << " variables, " <<
+            nl_model->number_constraints << " constraints\n";
+
+         // reformulate (scale, add slacks, relax the bounds, ...) if necessary
+         std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(nl_model), options);
+         DISCRETE << "Reformulated model " << model->name << '\n' << model->number_variables << " variables, " <<
+                  model->number_constraints << " constraints\n";
+
+         // initialize initial primal and dual points
+         Iterate initial_iterate(model->number_variables, model->number_constraints);
+         model->initial_primal_point(initial_iterate.primals);
+         model->project_onto_variable_bounds(initial_iterate.primals);
+         model->initial_dual_point(initial_iterate.multipliers.constraints);
+         initial_iterate.feasibility_multipliers.reset();
+
+         // create the constraint relaxation strategy, the globalization mechanism and the Uno solver
+         auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
+         auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+         Uno uno = Uno(*globalization_mechanism, options);
+
+         // solve the instance
+         NoUserCallbacks user_callbacks{};
+         uno.solve(*model, initial_iterate, options, user_callbacks);
+      }
+      catch (std::exception& exception) {
+         DISCRETE << exception.what() << '\n';
+      }
+   }
+
+   void print_uno_nl_instructions() {
+      std::cout << "Welcome in Uno " << Uno::current_version() << '\n';
+      std::cout << "To solve an AMPL model without ASL, type ./uno_nl model.nl [-AMPL] [option_name=option_value ...]\n";
+      std::cout << "The text and binary .nl formats are supported\n";
+   }
+} // namespace
+
+int main(int argc, char* argv[]) {
+   using namespace uno;
+
+   try {
+      if (argc < 2 || std::string(argv[1]) == "--v") {
+         print_uno_nl_instructions();
+      }
+      else {
+         // ./uno_nl model.nl [-AMPL] [option_name=option_value, ...]
+         const std::string model_name = std::string(argv[1]);
+         const int first_option_index = (argc >= 3 && std::string(argv[2]) == "-AMPL") ? 3 : 2;
+
+         Options options = DefaultOptions::load();
+
+         // determine the default solvers based on the available libraries
+         Options solvers_options = DefaultOptions::determine_solvers();
+         options.overwrite_with(solvers_options);
+
+         // get the command line arguments
+         Options command_line_options = Options::get_command_line_options(argc, argv, static_cast<size_t>(first_option_index));
+
+         // possibly set options from an option file
+         const auto optional_option_file = command_line_options.get_string_optional("option_file");
+         if (optional_option_file.has_value()) {
+            Options file_options = Options::load_option_file(*optional_option_file);
+            options.overwrite_with(file_options);
+         }
+
+         // possibly set a preset
+         const auto optional_preset = command_line_options.get_string_optional("preset");
+         Options preset_options = Presets::get_preset_options(optional_preset);
+         options.overwrite_with(preset_options);
+
+         // overwrite the options with the command line arguments
+         options.overwrite_with(command_line_options);
+
+         // solve the model
+         Logger::set_logger(options.get_string("logger"));
+         HugePages::set_policy(options.get_string("huge_pages"));
+         run_uno_nl(model_name, options);
+      }
+   }
+   catch (std::exception& exception) {
+      DISCRETE << exception.what() << '\n';
+   }
+   return EXIT_SUCCESS;
+}
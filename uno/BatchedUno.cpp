@@ -0,0 +1,88 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "BatchedUno.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/subproblem_solvers/BatchedLDLSolver.hpp"
+#include "model/Model.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/TaskScheduler.hpp"
+
+namespace uno {
+   BatchedUno::BatchedUno(const Options& options): batch_size(options.get_unsigned_int("batch_size")) {
+      if (this->batch_size == 0) {
+         throw std::invalid_argument("The batch size should be positive");
+      }
+   }
+
+   std::vector<Result> BatchedUno::solve(const std::vector<const Model*>& models, std::vector<Iterate>& initial_iterates, const Options& options) {
+      if (models.size() != initial_iterates.size()) {
+         throw std::invalid_argument("BatchedUno: the numbers of models and initial iterates differ");
+      }
+      std::vector<std::optional<Result>> results(models.size());
+      std::vector<std::exception_ptr> errors(models.size());
+      for (size_t first_instance = 0; first_instance < models.size(); first_instance += this->batch_size) {
+         const size_t number_lanes = std::min(this->batch_size, models.size() - first_instance);
+         FactorizationBatch batch(number_lanes);
+         // each lane has its own copy of the options (querying the options is not thread-safe)
+         std::vector<Options> lane_options(number_lanes, options);
+         for (size_t lane: Range(number_lanes)) {
+            lane_options[lane]["linear_solver"] = "batched_LDL";
+            // one solution file per instance
+            if (options.get_string("binary_solution_file") != "none") {
+               lane_options[lane]["binary_solution_file"] = options.get_string("binary_solution_file") + "." + std::to_string(first_instance + lane);
+            }
+         }
+
+         std::vector<std::thread> threads{};
+         threads.reserve(number_lanes);
+         for (size_t lane: Range(number_lanes)) {
+            threads.emplace_back([&, lane]() {
+               const size_t instance_index = first_instance + lane;
+               FactorizationBatch::Membership membership(batch, lane);
+               // the lanes share the thread budget: the linear algebra backends are sequential
+               ParallelRegionScope parallel_region_scope{};
+               try {
+                  const Model& model = *models[instance_index];
+                  auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(model, lane_options[lane]);
+                  auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, lane_options[lane]);
+                  Uno uno = Uno(*globalization_mechanism, lane_options[lane]);
+                  results[instance_index].emplace(uno.solve(model, initial_iterates[instance_index], lane_options[lane]));
+               }
+               catch (...) {
+                  errors[instance_index] = std::current_exception();
+               }
+            });
+         }
+         for (std::thread& thread: threads) {
+            thread.join();
+         }
+         this->batched_factorizations += batch.number_batched_factorizations();
+      }
+
+      std::vector<Result> batch_results{};
+      batch_results.reserve(models.size());
+      for (size_t instance_index: Range(models.size())) {
+         if (errors[instance_index] != nullptr) {
+            std::rethrow_exception(errors[instance_index]);
+         }
+         batch_results.emplace_back(std::move(*results[instance_index]));
+      }
+      return batch_results;
+   }
+
+   size_t BatchedUno::number_batched_factorizations() const {
+      return this->batched_factorizations;
+   }
+} // namespace
@@ -0,0 +1,36 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BATCHEDUNO_H
+#define UNO_BATCHEDUNO_H
+
+#include <vector>
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class Options;
+
+   /*! \class BatchedUno
+    * \brief Lockstep solver for many instances with the same structure (same sparsity, different data)
+    *
+    *  The instances are solved in batches of batch_size, one thread per instance. Each instance has its own strategies, and therefore
+    *  its own globalization decisions and termination; the KKT factorizations are performed in lockstep by a shared batched
+    *  factorization (batched_LDL linear solver) with a single symbolic analysis. A terminated instance leaves its batch.
+    */
+   class BatchedUno {
+   public:
+      explicit BatchedUno(const Options& options);
+
+      [[nodiscard]] std::vector<Result> solve(const std::vector<const Model*>& models, std::vector<Iterate>& initial_iterates,
+            const Options& options);
+      [[nodiscard]] size_t number_batched_factorizations() const;
+
+   private:
+      const size_t batch_size;
+      size_t batched_factorizations{0};
+   };
+} // namespace
+
+#endif // UNO_BATCHEDUNO_H
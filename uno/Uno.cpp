@@ -13,12 +13,16 @@
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "model/Model.hpp"
+#include "optimization/BinarySolutionFile.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
 #include "tools/Logger.hpp"
 #include "optimization/OptimizationStatus.hpp"
 #include "options/Options.hpp"
 #include "tools/Statistics.hpp"
+#include "tools/HugePageAllocator.hpp"
+#include "tools/PerformanceCounters.hpp"
+#include "tools/TaskScheduler.hpp"
 #include "tools/Timer.hpp"
 #include "tools/UserCallbacks.hpp"
 
@@ -28,6 +32,7 @@ namespace uno {
          max_iterations(options.get_unsigned_int("max_iterations")),
          time_limit(options.get_double("time_limit")),
          print_solution(options.get_bool("print_solution")),
+         binary_solution_file(options.get_string("binary_solution_file")),
          strategy_combination(Uno::get_strategy_combination(options)) { }
    
    Level Logger::level = INFO;
@@ -42,6 +47,14 @@ namespace uno {
    // solve with user callbacks
    Result Uno::solve(const Model& model, Iterate& current_iterate, const Options& options, UserCallbacks& user_callbacks) {
       Timer timer{};
+      if (not options.get_bool("hardware_counters")) {
+         PerformanceCounters::disable();
+      }
+      else if (not PerformanceCounters::enable()) {
+         WARNING << "The hardware performance counters are unavailable\n";
+      }
+      TaskScheduler::configure(options.get_unsigned_int("threads"));
+      HugePages::set_policy(options.get_string("huge_pages"));
       Statistics statistics = Uno::create_statistics(model, options);
       WarmstartInformation warmstart_information{};
       warmstart_information.whole_problem_changed();
@@ -91,6 +104,9 @@ namespace uno {
       }
       Result result = this->create_result(model, optimization_status, current_iterate, major_iterations, timer);
       this->print_optimization_summary(result);
+      if (this->binary_solution_file != "none") {
+         BinarySolutionFile::write(this->binary_solution_file, result);
+      }
       return result;
    }
 
@@ -146,7 +162,8 @@ namespace uno {
       const size_t number_hessian_evaluations = this->globalization_mechanism.get_hessian_evaluation_count();
       return {optimization_status, std::move(current_iterate), model.number_variables, model.number_constraints, major_iterations,
             timer.get_duration(), Iterate::number_eval_objective, Iterate::number_eval_constraints, Iterate::number_eval_objective_gradient,
-            Iterate::number_eval_jacobian, number_hessian_evaluations, number_subproblems_solved};
+            Iterate::number_eval_jacobian, number_hessian_evaluations, number_subproblems_solved,
+            PerformanceCounters::get_report(), HugePages::get_report()};
    }
 
    std::string Uno::current_version() {
@@ -34,6 +34,7 @@ namespace uno {
       const size_t max_iterations; /*!< Maximum number of iterations */
       const double time_limit; /*!< CPU time limit (can be inf) */
       const bool print_solution;
+      const std::string binary_solution_file;
       const std::string strategy_combination;
 
       void initialize(Statistics& statistics, Iterate& current_iterate, const Options& options);
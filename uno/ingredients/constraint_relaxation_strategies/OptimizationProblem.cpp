@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "OptimizationProblem.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
    OptimizationProblem::OptimizationProblem(const Model& model, size_t number_variables, size_t number_constraints):
@@ -20,6 +21,26 @@ namespace uno {
       return (not this->model.get_fixed_variables().empty());
    }
 
+   void OptimizationProblem::add_problem_hessian_terms(const Vector<double>& /*x*/, SymmetricMatrix<size_t, double>& /*hessian*/) const {
+      // by default, the Lagrangian Hessian is that of the model
+   }
+
+   void OptimizationProblem::get_stages(std::vector<size_t>& stages) const {
+      stages.clear();
+      if (this->model.number_stages() == 0) {
+         return;
+      }
+      std::vector<size_t> variable_stages{}, constraint_stages{};
+      this->model.get_stages(variable_stages, constraint_stages);
+      stages.resize(this->number_variables + this->number_constraints, 0);
+      for (size_t variable_index: Range(this->model.number_variables)) {
+         stages[variable_index] = variable_stages[variable_index];
+      }
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         stages[this->number_variables + constraint_index] = constraint_stages[constraint_index];
+      }
+   }
+
    size_t OptimizationProblem::get_number_original_variables() const {
       return this->model.number_variables;
    }
@@ -42,6 +42,12 @@ namespace uno {
       virtual void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const = 0;
       virtual void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const = 0;
       virtual void evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const = 0;
+      // terms that the problem adds to the Lagrangian Hessian of the model (e.g. proximal or barrier terms). Used by the Hessian models
+      // that approximate the Hessian of the model
+      virtual void add_problem_hessian_terms(const Vector<double>& x, SymmetricMatrix<size_t, double>& hessian) const;
+      // stages of the variables, then of the constraints (empty if the model has no stage structure). The additional variables of
+      // the problem belong to the first stage, unless the problem assigns them a stage
+      virtual void get_stages(std::vector<size_t>& stages) const;
 
       [[nodiscard]] size_t get_number_original_variables() const;
       [[nodiscard]] virtual double variable_lower_bound(size_t variable_index) const = 0;
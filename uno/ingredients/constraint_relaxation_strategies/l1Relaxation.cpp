@@ -10,6 +10,7 @@
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
 #include "symbolic/VectorView.hpp"
+#include "tools/PerformanceCounters.hpp"
 #include "tools/Statistics.hpp"
 #include "tools/UserCallbacks.hpp"
 
@@ -141,7 +142,10 @@ namespace uno {
 
       // solve the subproblem
       direction.set_dimensions(problem.number_variables, problem.number_constraints);
-      this->inequality_handling_method->solve(statistics, problem, current_iterate, current_multipliers, direction, warmstart_information);
+      {
+         PerformanceCounterScope counter_scope(SolverPhase::SUBPROBLEM);
+         this->inequality_handling_method->solve(statistics, problem, current_iterate, current_multipliers, direction, warmstart_information);
+      }
       direction.norm = norm_inf(view(direction.primals, 0, this->model.number_variables));
       DEBUG3 << direction << '\n';
       assert(direction.status == SubproblemStatus::OPTIMAL && "The subproblem was not solved to optimality");
@@ -97,8 +97,16 @@ namespace uno {
    void l1RelaxedProblem::evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers,
          SymmetricMatrix<size_t, double>& hessian) const {
       this->model.evaluate_lagrangian_hessian(x, this->objective_multiplier, multipliers, hessian);
+      this->add_problem_hessian_terms(x, hessian);
 
-      // proximal contribution
+      // extend the dimension of the Hessian by finalizing the remaining columns (note: the elastics do not enter the Hessian)
+      for (size_t constraint_index: Range(this->model.number_variables, this->number_variables)) {
+         hessian.finalize_column(constraint_index);
+      }
+   }
+
+   // proximal contribution
+   void l1RelaxedProblem::add_problem_hessian_terms(const Vector<double>& /*x*/, SymmetricMatrix<size_t, double>& hessian) const {
       if (this->proximal_center != nullptr && this->proximal_coefficient != 0.) {
          for (size_t variable_index: Range(this->model.number_variables)) {
             const double scaling = std::min(1., 1./std::abs(this->proximal_center[variable_index]));
@@ -106,10 +114,18 @@ namespace uno {
             hessian.insert(proximal_term, variable_index, variable_index);
          }
       }
+   }
 
-      // extend the dimension of the Hessian by finalizing the remaining columns (note: the elastics do not enter the Hessian)
-      for (size_t constraint_index: Range(this->model.number_variables, this->number_variables)) {
-         hessian.finalize_column(constraint_index);
+   // the elastic variables belong to the stage of their constraint
+   void l1RelaxedProblem::get_stages(std::vector<size_t>& stages) const {
+      OptimizationProblem::get_stages(stages);
+      if (not stages.empty()) {
+         for (const auto [constraint_index, elastic_index]: this->elastic_variables.positive) {
+            stages[elastic_index] = stages[this->number_variables + constraint_index];
+         }
+         for (const auto [constraint_index, elastic_index]: this->elastic_variables.negative) {
+            stages[elastic_index] = stages[this->number_variables + constraint_index];
+         }
       }
    }
 
@@ -17,7 +17,11 @@ namespace uno {
          GlobalizationMechanism(constraint_relaxation_strategy),
          backtracking_ratio(options.get_double("LS_backtracking_ratio")),
          minimum_step_length(options.get_double("LS_min_step_length")),
-         scale_duals_with_step_length(options.get_bool("LS_scale_duals_with_step_length")) {
+         scale_duals_with_step_length(options.get_bool("LS_scale_duals_with_step_length")),
+         prefetch_derivatives(options.get_bool("LS_prefetch_derivatives")),
+         tolerance(options.get_double("tolerance")),
+         derivative_prefetcher(this->constraint_relaxation_strategy.maximum_number_variables(),
+               this->constraint_relaxation_strategy.maximum_number_constraints()) {
       // check the initial and minimal step lengths
       assert(0 < this->backtracking_ratio && this->backtracking_ratio < 1. && "The LS backtracking ratio should be in (0, 1)");
       assert(0 < this->minimum_step_length && this->minimum_step_length < 1. && "The LS minimum step length should be in (0, 1)");
@@ -36,12 +40,47 @@ namespace uno {
 
       this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, this->direction, warmstart_information);
       BacktrackingLineSearch::check_unboundedness(this->direction);
-      this->backtrack_along_direction(statistics, model, current_iterate, trial_iterate, warmstart_information, user_callbacks);
+      if (this->direction.is_tiny_step) {
+         this->take_tiny_step(statistics, model, current_iterate, trial_iterate, warmstart_information, user_callbacks);
+      }
+      else {
+         this->backtrack_along_direction(statistics, model, current_iterate, trial_iterate, warmstart_information, user_callbacks);
+      }
+   }
+
+   // tiny step (Section 3.9 of the Ipopt paper): the primals do not change up to machine precision. The full step is taken without
+   // line search and the functions are not evaluated (the evaluations at the current iterate are reused)
+   void BacktrackingLineSearch::take_tiny_step(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
+         WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) {
+      DEBUG << "\n\tTiny step taken without line search\n";
+      GlobalizationMechanism::assemble_trial_iterate(model, current_iterate, trial_iterate, this->direction, 1., 1.);
+      trial_iterate.evaluations = current_iterate.evaluations;
+      trial_iterate.is_objective_computed = current_iterate.is_objective_computed;
+      trial_iterate.are_constraints_computed = current_iterate.are_constraints_computed;
+      trial_iterate.is_objective_gradient_computed = current_iterate.is_objective_gradient_computed;
+      trial_iterate.is_constraint_jacobian_computed = current_iterate.is_constraint_jacobian_computed;
+      // the acceptance test updates the progress measures and the phase; its verdict is ignored
+      [[maybe_unused]] const bool is_acceptable = this->constraint_relaxation_strategy.is_iterate_acceptable(statistics, current_iterate,
+            trial_iterate, this->direction, 1., warmstart_information, user_callbacks);
+      this->set_statistics(statistics, trial_iterate, this->direction, 1., 1);
+      statistics.set("status", "tiny step");
+
+      trial_iterate.status = this->constraint_relaxation_strategy.check_termination(trial_iterate);
+      // a repeated tiny step cannot make progress: terminate
+      if (trial_iterate.status == IterateStatus::NOT_OPTIMAL && this->direction.is_repeated_tiny_step) {
+         trial_iterate.status = (trial_iterate.progress.infeasibility <= this->tolerance) ? IterateStatus::FEASIBLE_SMALL_STEP :
+               IterateStatus::INFEASIBLE_SMALL_STEP;
+      }
+      this->constraint_relaxation_strategy.set_dual_residuals_statistics(statistics, trial_iterate);
+      if (Logger::level == INFO) statistics.print_current_line();
    }
 
    // go a fraction along the direction by finding an acceptable step length
    void BacktrackingLineSearch::backtrack_along_direction(Statistics& statistics, const Model& model, Iterate& current_iterate,
          Iterate& trial_iterate, WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) {
+      const bool prefetch_derivatives = this->can_prefetch_derivatives(model);
+      // the user is notified once the background evaluations are over
+      SynchronizedUserCallbacks synchronized_user_callbacks(user_callbacks, this->derivative_prefetcher);
       double step_length = 1.;
       bool termination = false;
       size_t number_iterations = 0;
@@ -57,15 +96,30 @@ namespace uno {
             GlobalizationMechanism::assemble_trial_iterate(model, current_iterate, trial_iterate, this->direction, step_length,
                   // scale or not the constraint dual direction with the LS step length
                   this->scale_duals_with_step_length ? step_length : 1.);
+            if (prefetch_derivatives) {
+               // if the functions can be evaluated at the trial iterate, evaluate its derivatives in the background during the
+               // acceptance test (which may evaluate the thread-safe model concurrently, e.g. when switching phases)
+               trial_iterate.evaluate_objective(model);
+               trial_iterate.evaluate_constraints(model);
+               this->derivative_prefetcher.start(model, trial_iterate);
+            }
 
             is_acceptable = this->constraint_relaxation_strategy.is_iterate_acceptable(statistics, current_iterate, trial_iterate, this->direction,
-                  step_length, warmstart_information, user_callbacks);
+                  step_length, warmstart_information, synchronized_user_callbacks);
             this->set_statistics(statistics, trial_iterate, this->direction, step_length, number_iterations);
          }
          catch (const EvaluationError& e) {
             this->set_statistics(statistics, number_iterations);
             statistics.set("status", "eval. error");
          }
+         if (this->derivative_prefetcher.is_running()) {
+            if (is_acceptable) {
+               this->derivative_prefetcher.commit(trial_iterate);
+            }
+            else {
+               this->derivative_prefetcher.discard();
+            }
+         }
 
          if (is_acceptable) {
             trial_iterate.status = this->constraint_relaxation_strategy.check_termination(trial_iterate);
@@ -100,6 +154,15 @@ namespace uno {
       } // end while loop
    }
 
+   // the derivatives are evaluated in the background only if the model can be evaluated concurrently by the acceptance test
+   bool BacktrackingLineSearch::can_prefetch_derivatives(const Model& model) {
+      if (this->prefetch_derivatives && not model.is_thread_safe()) {
+         WARNING << "The model is not thread safe: the derivatives are not prefetched\n";
+         this->prefetch_derivatives = false;
+      }
+      return this->prefetch_derivatives;
+   }
+
    bool BacktrackingLineSearch::terminate_with_small_step_length(Statistics& statistics, Iterate& trial_iterate) {
       bool termination = false;
       trial_iterate.status = this->constraint_relaxation_strategy.check_termination(trial_iterate);
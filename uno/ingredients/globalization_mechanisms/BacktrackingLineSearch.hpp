@@ -5,6 +5,7 @@
 #define UNO_BACKTRACKINGLINESEARCH_H
 
 #include "GlobalizationMechanism.hpp"
+#include "optimization/DerivativePrefetcher.hpp"
 
 namespace uno {
    // forward declaration
@@ -22,9 +23,15 @@ namespace uno {
       const double backtracking_ratio;
       const double minimum_step_length;
       const bool scale_duals_with_step_length;
+      bool prefetch_derivatives;
+      const double tolerance;
+      DerivativePrefetcher derivative_prefetcher;
 
       void backtrack_along_direction(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
             WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks);
+      void take_tiny_step(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
+            WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks);
+      [[nodiscard]] bool can_prefetch_derivatives(const Model& model);
       [[nodiscard]] bool terminate_with_small_step_length(Statistics& statistics, Iterate& trial_iterate);
       [[nodiscard]] double decrease_step_length(double step_length) const;
       static void check_unboundedness(const Direction& direction);
@@ -1,10 +1,14 @@
 // Copyright (c) 2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
 #include "ConvexifiedHessian.hpp"
+#include "ExactHessian.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "ingredients/hessian_models/UnstableRegularization.hpp"
-#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
@@ -14,39 +18,118 @@
 
 namespace uno {
    ConvexifiedHessian::ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options):
+         ConvexifiedHessian(std::make_unique<ExactHessian>(), dimension, maximum_number_nonzeros, options) {
+   }
+
+   ConvexifiedHessian::ConvexifiedHessian(std::unique_ptr<HessianModel> hessian_model, size_t dimension, size_t maximum_number_nonzeros,
+         const Options& options):
          HessianModel(),
-         // inertia-based convexification needs a linear solver
-         linear_solver(SymmetricIndefiniteLinearSolverFactory::create(dimension, maximum_number_nonzeros, options)),
+         hessian_model(std::move(hessian_model)),
+         use_cholesky_factorization(options.get_string("convexification_method") == "cholesky"),
+         // Cholesky-based convexification needs a sparse Cholesky solver, inertia-based convexification a symmetric indefinite linear solver
+         cholesky_solver(this->use_cholesky_factorization ? std::make_unique<SparseCholeskySolver>(dimension, maximum_number_nonzeros) : nullptr),
+         linear_solver(this->use_cholesky_factorization ? nullptr :
+            SymmetricIndefiniteLinearSolverFactory::create(dimension, maximum_number_nonzeros, options)),
          regularization_initial_value(options.get_double("regularization_initial_value")),
          regularization_increase_factor(options.get_double("regularization_increase_factor")),
-         regularization_failure_threshold(options.get_double("regularization_failure_threshold")) {
+         regularization_failure_threshold(options.get_double("regularization_failure_threshold")),
+         gershgorin_radii(dimension) {
+      if (not this->use_cholesky_factorization && options.get_string("convexification_method") != "inertia") {
+         throw std::invalid_argument("The convexification method " + options.get_string("convexification_method") + " does not exist");
+      }
    }
 
    void ConvexifiedHessian::initialize_statistics(Statistics& statistics, const Options& options) const {
+      this->hessian_model->initialize_statistics(statistics, options);
       statistics.add_column("regulariz", Statistics::double_width - 4, options.get_int("statistics_regularization_column_order"));
    }
 
    void ConvexifiedHessian::evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
          const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
-      // evaluate Lagrangian Hessian
-      hessian.set_dimension(problem.number_variables);
-      problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, hessian);
-      this->evaluation_count++;
+      this->hessian_model->evaluate(statistics, problem, primal_variables, constraint_multipliers, hessian);
+      this->evaluation_count = this->hessian_model->evaluation_count;
+      this->sparsity_changed = this->hessian_model->sparsity_changed;
+      this->convexify(statistics, problem, hessian);
+   }
+
+   void ConvexifiedHessian::convexify(Statistics& statistics, const OptimizationProblem& problem, SymmetricMatrix<size_t, double>& hessian) {
       // regularize (only on the original variables) to convexify the problem
       this->regularize(statistics, hessian, problem.get_number_original_variables());
    }
 
+   bool ConvexifiedHessian::is_convex(const OptimizationProblem& problem, SymmetricMatrix<size_t, double>& hessian) {
+      const size_t number_original_variables = problem.get_number_original_variables();
+      if (0. <= this->gershgorin_lower_bound(hessian, number_original_variables)) {
+         return true;
+      }
+      if (this->use_cholesky_factorization) {
+         // conservative: a singular positive semidefinite matrix has a zero pivot and is reported as nonconvex
+         this->cholesky_solver->do_symbolic_analysis(hessian, number_original_variables);
+         return this->cholesky_solver->do_numerical_factorization(hessian);
+      }
+      else {
+         // the inertia of the unregularized matrix: zero eigenvalues are allowed
+         this->linear_solver->do_symbolic_analysis(hessian);
+         this->linear_solver->do_numerical_factorization(hessian);
+         DEBUG << "Inertia test: " << this->linear_solver->number_negative_eigenvalues() << " negative eigenvalues\n";
+         return this->linear_solver->number_negative_eigenvalues() == 0;
+      }
+   }
+
    // Nocedal and Wright, p51
    void ConvexifiedHessian::regularize(Statistics& statistics, SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables) {
       DEBUG << "Current Hessian:\n" << hessian << '\n';
       const double smallest_diagonal_entry = hessian.smallest_diagonal_entry(number_original_variables);
       DEBUG << "The minimal diagonal entry of the matrix is " << smallest_diagonal_entry << '\n';
+      // Gershgorin: H + delta I is positive definite for any delta > -lower_bound
+      const double gershgorin_bound = this->gershgorin_lower_bound(hessian, number_original_variables);
+      const double sufficient_regularization_factor = this->regularization_initial_value - gershgorin_bound;
+      DEBUG << "The Gershgorin lower bound on the eigenvalues is " << gershgorin_bound << '\n';
 
       double regularization_factor = (smallest_diagonal_entry > 0.) ? 0. : this->regularization_initial_value - smallest_diagonal_entry;
-      bool good_inertia = false;
+      bool good_inertia = (0. < gershgorin_bound);
       bool symbolic_analysis_performed = false;
       while (not good_inertia) {
-         DEBUG << "Testing factorization with regularization factor " << regularization_factor << '\n';
+         if (sufficient_regularization_factor <= regularization_factor) {
+            // no need to factorize the matrix
+            regularization_factor = sufficient_regularization_factor;
+            good_inertia = true;
+            DEBUG << "The Gershgorin regularization factor " << regularization_factor << " is sufficient\n";
+         }
+         else if (this->is_positive_definite(hessian, number_original_variables, regularization_factor, symbolic_analysis_performed)) {
+            good_inertia = true;
+            DEBUG << "Factorization was a success\n";
+         }
+         else {
+            // the Gershgorin regularization factor is sufficient: the increased factor is clamped before the failure test
+            regularization_factor = std::min(sufficient_regularization_factor, (regularization_factor == 0.) ? this->regularization_initial_value :
+               this->regularization_increase_factor * regularization_factor);
+            if (regularization_factor > this->regularization_failure_threshold) {
+               throw UnstableRegularization();
+            }
+         }
+      }
+      if (0. < regularization_factor) {
+         hessian.set_regularization([=](size_t variable_index) {
+            return (variable_index < number_original_variables) ? regularization_factor : 0.;
+         });
+      }
+      statistics.set("regulariz", regularization_factor);
+   }
+
+   bool ConvexifiedHessian::is_positive_definite(SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables,
+         double regularization_factor, bool& symbolic_analysis_performed) {
+      DEBUG << "Testing factorization with regularization factor " << regularization_factor << '\n';
+      if (this->use_cholesky_factorization) {
+         // the ordering and symbolic factorization are reused as long as the sparsity pattern does not change
+         if (not symbolic_analysis_performed && this->cholesky_solver->sparsity_changed(hessian, number_original_variables)) {
+            this->cholesky_solver->do_symbolic_analysis(hessian, number_original_variables);
+         }
+         symbolic_analysis_performed = true;
+         // the regularization is added to the diagonal of the factorization only: the Hessian is modified once the factor is found
+         return this->cholesky_solver->do_numerical_factorization(hessian, regularization_factor);
+      }
+      else {
          if (0. < regularization_factor) {
             hessian.set_regularization([=](size_t variable_index) {
                return (variable_index < number_original_variables) ? regularization_factor : 0.;
@@ -61,17 +144,31 @@ namespace uno {
          }
          this->linear_solver->do_numerical_factorization(hessian);
          if (this->linear_solver->rank() == number_original_variables && this->linear_solver->number_negative_eigenvalues() == 0) {
-            good_inertia = true;
-            DEBUG << "Factorization was a success\n";
+            return true;
          }
-         else {
-            DEBUG << "rank: " << this->linear_solver->rank() << ", negative eigenvalues: " << this->linear_solver->number_negative_eigenvalues() << '\n';
-            regularization_factor = (regularization_factor == 0.) ? this->regularization_initial_value : this->regularization_increase_factor * regularization_factor;
-            if (regularization_factor > this->regularization_failure_threshold) {
-               throw UnstableRegularization();
+         DEBUG << "rank: " << this->linear_solver->rank() << ", negative eigenvalues: " << this->linear_solver->number_negative_eigenvalues() << '\n';
+         return false;
+      }
+   }
+
+   // lower bound on the smallest eigenvalue: min_i (H_ii - sum_{j != i} |H_ij|)
+   double ConvexifiedHessian::gershgorin_lower_bound(const SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables) {
+      std::fill(this->gershgorin_radii.begin(), this->gershgorin_radii.begin() + static_cast<std::ptrdiff_t>(number_original_variables), 0.);
+      for (const auto [row_index, column_index, entry]: hessian) {
+         if (row_index < number_original_variables && column_index < number_original_variables) {
+            if (row_index == column_index) {
+               this->gershgorin_radii[row_index] -= entry;
+            }
+            else {
+               this->gershgorin_radii[row_index] += std::abs(entry);
+               this->gershgorin_radii[column_index] += std::abs(entry);
             }
          }
       }
-      statistics.set("regulariz", regularization_factor);
+      double lower_bound = INF<double>;
+      for (size_t variable_index: Range(number_original_variables)) {
+         lower_bound = std::min(lower_bound, -this->gershgorin_radii[variable_index]);
+      }
+      return lower_bound;
    }
 } // namespace
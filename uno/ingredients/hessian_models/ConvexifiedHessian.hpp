@@ -2,7 +2,9 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <memory>
+#include <vector>
 #include "HessianModel.hpp"
+#include "ingredients/subproblem_solvers/SparseCholeskySolver.hpp"
 
 namespace uno {
    // forward declarations
@@ -10,21 +12,33 @@ namespace uno {
    class DirectSymmetricIndefiniteLinearSolver;
    class Options;
 
-   // Hessian with convexification (inertia correction)
+   // Hessian (exact or approximated by another Hessian model) with convexification (inertia correction)
    class ConvexifiedHessian : public HessianModel {
    public:
       ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options);
+      ConvexifiedHessian(std::unique_ptr<HessianModel> hessian_model, size_t dimension, size_t maximum_number_nonzeros, const Options& options);
 
       void initialize_statistics(Statistics& statistics, const Options& options) const override;
       void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
             const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) override;
+      // convexifies a Hessian evaluated by another Hessian model
+      void convexify(Statistics& statistics, const OptimizationProblem& problem, SymmetricMatrix<size_t, double>& hessian);
+      // tests whether the unregularized Hessian has no negative eigenvalue (Gershgorin bound, then factorization)
+      [[nodiscard]] bool is_convex(const OptimizationProblem& problem, SymmetricMatrix<size_t, double>& hessian);
 
    protected:
+      const std::unique_ptr<HessianModel> hessian_model;
+      const bool use_cholesky_factorization;
+      std::unique_ptr<SparseCholeskySolver> cholesky_solver; /*!< Solver that tests positive definiteness */
       std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> linear_solver; /*!< Solver that computes the inertia */
       const double regularization_initial_value{};
       const double regularization_increase_factor{};
       const double regularization_failure_threshold{};
+      std::vector<double> gershgorin_radii;
 
       void regularize(Statistics& statistics, SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables);
+      [[nodiscard]] bool is_positive_definite(SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables,
+            double regularization_factor, bool& symbolic_analysis_performed);
+      [[nodiscard]] double gershgorin_lower_bound(const SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables);
    };
 } // namespace
\ No newline at end of file
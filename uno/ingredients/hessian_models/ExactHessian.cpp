@@ -5,6 +5,7 @@
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "options/Options.hpp"
+#include "tools/PerformanceCounters.hpp"
 
 namespace uno {
    // exact Hessian
@@ -16,6 +17,7 @@ namespace uno {
    void ExactHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem, const Vector<double>& primal_variables,
          const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
       // evaluate Lagrangian Hessian
+      PerformanceCounterScope counter_scope(SolverPhase::EVALUATION);
       hessian.set_dimension(problem.number_variables);
       problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, hessian);
       this->evaluation_count++;
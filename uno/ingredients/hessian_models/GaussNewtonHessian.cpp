@@ -0,0 +1,119 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <stdexcept>
+#include "GaussNewtonHessian.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   GaussNewtonHessian::GaussNewtonHessian(size_t dimension, size_t maximum_number_nonzeros):
+         HessianModel(),
+         constraint_hessian(dimension, maximum_number_nonzeros, false, "COO"),
+         residual_jacobian_columns(dimension),
+         constraint_hessian_columns(dimension),
+         column_accumulator(dimension),
+         is_row_in_column(dimension, false) {
+      this->column_rows.reserve(dimension);
+   }
+
+   void GaussNewtonHessian::initialize_statistics(Statistics& /*statistics*/, const Options& /*options*/) const { }
+
+   void GaussNewtonHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
+      const Model& model = problem.model;
+      if (model.number_residuals() == 0) {
+         throw std::runtime_error("The Gauss-Newton Hessian model requires a model with a least-squares objective");
+      }
+      const double objective_multiplier = problem.get_objective_multiplier();
+
+      // objective curvature: J_r. When the objective is ignored, the previous J_r provides structural zeros: the sparsity pattern
+      // of the Hessian does not depend on the objective multiplier (the symbolic analysis of the linear solver is reused)
+      if (objective_multiplier != 0. || this->number_allocated_residuals == 0) {
+         this->compute_residual_jacobian_columns(model, primal_variables);
+      }
+      // constraint curvature: Lagrangian Hessian with a zero objective multiplier (only if some constraints are nonlinear)
+      for (auto& column: this->constraint_hessian_columns) {
+         column.clear();
+      }
+      if (model.get_linear_constraints().size() < model.number_constraints) {
+         this->compute_constraint_hessian_columns(model, primal_variables, constraint_multipliers);
+      }
+
+      // assemble the upper triangular part column by column (compatible with the CSC format)
+      hessian.set_dimension(problem.number_variables);
+      hessian.reset();
+      for (size_t column_index: Range(problem.number_variables)) {
+         if (column_index < model.number_variables) {
+            // objective_multiplier * (J_r^T J_r)_{ij} = objective_multiplier * sum_k (J_r)_{ki} (J_r)_{kj} for i <= j
+            for (const auto& [residual_index, column_derivative]: this->residual_jacobian_columns[column_index]) {
+               for (const auto [row_index, row_derivative]: this->residual_jacobian[residual_index]) {
+                  if (row_index <= column_index) {
+                     this->accumulate(row_index, objective_multiplier * row_derivative * column_derivative);
+                  }
+               }
+            }
+            for (const auto& [row_index, entry]: this->constraint_hessian_columns[column_index]) {
+               this->accumulate(row_index, entry);
+            }
+            // flush the accumulator into the Hessian
+            std::sort(this->column_rows.begin(), this->column_rows.end());
+            for (size_t row_index: this->column_rows) {
+               hessian.insert(this->column_accumulator[row_index], row_index, column_index);
+               this->column_accumulator[row_index] = 0.;
+               this->is_row_in_column[row_index] = false;
+            }
+            this->column_rows.clear();
+         }
+         hessian.finalize_column(column_index);
+      }
+      // the problem terms (e.g. the barrier terms) are accounted for by the problem, not by the sparsity pattern of the model
+      if (hessian.capacity() < hessian.number_nonzeros()) {
+         throw std::runtime_error("The Gauss-Newton Hessian has more nonzeros than the Lagrangian Hessian sparsity pattern");
+      }
+      problem.add_problem_hessian_terms(primal_variables, hessian);
+      DEBUG2 << "Gauss-Newton Hessian:\n" << hessian << '\n';
+      this->evaluation_count++;
+   }
+
+   void GaussNewtonHessian::compute_residual_jacobian_columns(const Model& model, const Vector<double>& primal_variables) {
+      const size_t number_residuals = model.number_residuals();
+      // allocate J_r at the first evaluation (the number of residuals is not known at construction)
+      if (this->number_allocated_residuals != number_residuals) {
+         this->residual_jacobian = RectangularMatrix<double>(number_residuals, model.number_variables);
+         this->number_allocated_residuals = number_residuals;
+      }
+      this->residual_jacobian.clear();
+      model.evaluate_residual_jacobian(primal_variables, this->residual_jacobian);
+
+      // transpose J_r
+      for (auto& column: this->residual_jacobian_columns) {
+         column.clear();
+      }
+      for (size_t residual_index: Range(number_residuals)) {
+         for (const auto [variable_index, derivative]: this->residual_jacobian[residual_index]) {
+            this->residual_jacobian_columns[variable_index].emplace_back(residual_index, derivative);
+         }
+      }
+   }
+
+   void GaussNewtonHessian::compute_constraint_hessian_columns(const Model& model, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers) {
+      this->constraint_hessian.set_dimension(model.number_variables);
+      model.evaluate_lagrangian_hessian(primal_variables, 0., constraint_multipliers, this->constraint_hessian);
+      for (const auto [row_index, column_index, entry]: this->constraint_hessian) {
+         // keep the upper triangular part
+         this->constraint_hessian_columns[std::max(row_index, column_index)].emplace_back(std::min(row_index, column_index), entry);
+      }
+   }
+
+   void GaussNewtonHessian::accumulate(size_t row_index, double entry) {
+      if (not this->is_row_in_column[row_index]) {
+         this->is_row_in_column[row_index] = true;
+         this->column_rows.emplace_back(row_index);
+      }
+      this->column_accumulator[row_index] += entry;
+   }
+} // namespace
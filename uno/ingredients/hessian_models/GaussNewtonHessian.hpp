@@ -0,0 +1,46 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_GAUSSNEWTONHESSIAN_H
+#define UNO_GAUSSNEWTONHESSIAN_H
+
+#include <utility>
+#include <vector>
+#include "HessianModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declaration
+   class Model;
+
+   // Gauss-Newton Hessian for least-squares objectives f(x) = 1/2 ||r(x)||^2:
+   // the objective curvature is approximated by J_r^T J_r, the constraint curvature is exact
+   class GaussNewtonHessian : public HessianModel {
+   public:
+      GaussNewtonHessian(size_t dimension, size_t maximum_number_nonzeros);
+
+      void initialize_statistics(Statistics& statistics, const Options& options) const override;
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) override;
+
+   protected:
+      RectangularMatrix<double> residual_jacobian{0, 0};
+      size_t number_allocated_residuals{0};
+      SymmetricMatrix<size_t, double> constraint_hessian;
+      // column-wise copies of J_r (residual index, entry) and of the constraint Hessian (row index, entry)
+      std::vector<std::vector<std::pair<size_t, double>>> residual_jacobian_columns;
+      std::vector<std::vector<std::pair<size_t, double>>> constraint_hessian_columns;
+      // sparse accumulator of the current column
+      Vector<double> column_accumulator;
+      std::vector<bool> is_row_in_column;
+      std::vector<size_t> column_rows{};
+
+      void compute_residual_jacobian_columns(const Model& model, const Vector<double>& primal_variables);
+      void compute_constraint_hessian_columns(const Model& model, const Vector<double>& primal_variables, const Vector<double>& constraint_multipliers);
+      void accumulate(size_t row_index, double entry);
+   };
+} // namespace
+
+#endif // UNO_GAUSSNEWTONHESSIAN_H
@@ -22,6 +22,8 @@ namespace uno {
       virtual ~HessianModel();
 
       size_t evaluation_count{0};
+      // set by evaluate if the sparsity pattern differs from that of the previous evaluation (a new symbolic analysis is required)
+      bool sparsity_changed{false};
 
       virtual void initialize_statistics(Statistics& statistics, const Options& options) const = 0;
       virtual void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
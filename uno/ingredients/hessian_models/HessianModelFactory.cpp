@@ -6,6 +6,9 @@
 #include "HessianModel.hpp"
 #include "ConvexifiedHessian.hpp"
 #include "ExactHessian.hpp"
+#include "GaussNewtonHessian.hpp"
+#include "HybridHessian.hpp"
+#include "PartitionedQuasiNewtonHessian.hpp"
 #include "ZeroHessian.hpp"
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 
@@ -20,6 +23,29 @@ namespace uno {
             return std::make_unique<ExactHessian>();
          }
       }
+      // J_r^T J_r is positive semidefinite, but the exact constraint curvature is indefinite in general
+      else if (hessian_model == "gauss_newton") {
+         if (convexify) {
+            return std::make_unique<ConvexifiedHessian>(std::make_unique<GaussNewtonHessian>(dimension, maximum_number_nonzeros), dimension,
+                  maximum_number_nonzeros + dimension, options);
+         }
+         else {
+            return std::make_unique<GaussNewtonHessian>(dimension, maximum_number_nonzeros);
+         }
+      }
+      // the SR1 element approximations and the constraint terms are indefinite in general
+      else if (hessian_model == "partitioned_quasi_newton") {
+         if (convexify) {
+            return std::make_unique<ConvexifiedHessian>(std::make_unique<PartitionedQuasiNewtonHessian>(options), dimension,
+                  maximum_number_nonzeros + dimension, options);
+         }
+         else {
+            return std::make_unique<PartitionedQuasiNewtonHessian>(options);
+         }
+      }
+      else if (hessian_model == "hybrid") {
+         return std::make_unique<HybridHessian>(dimension, maximum_number_nonzeros, convexify, options);
+      }
       else if (hessian_model == "zero") {
          return std::make_unique<ZeroHessian>();
       }
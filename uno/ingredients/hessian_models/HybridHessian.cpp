@@ -0,0 +1,172 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "HybridHessian.hpp"
+#include "ConvexifiedHessian.hpp"
+#include "HessianModelFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "symbolic/VectorView.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Statistics.hpp"
+
+namespace uno {
+   namespace {
+      // weight of the new measurement in the moving averages
+      constexpr double averaging_weight = 0.5;
+      // the local phase starts after this number of consecutive small steps and ends if a step is larger by this factor
+      constexpr size_t local_phase_small_steps = 2;
+      constexpr double local_phase_exit_factor = 10.;
+
+      void update_average(std::optional<double>& average, double measurement) {
+         average = average.has_value() ? (1. - averaging_weight) * *average + averaging_weight * measurement : measurement;
+      }
+
+      double seconds(std::chrono::steady_clock::duration duration) {
+         return std::chrono::duration<double>(duration).count();
+      }
+   } // namespace
+
+   HybridHessian::HybridHessian(size_t dimension, size_t maximum_number_nonzeros, bool convexify, const Options& options):
+         HessianModel(),
+         exact_hessian(HessianModelFactory::create("exact", dimension, maximum_number_nonzeros, false, options)),
+         quasi_newton_hessian(options),
+         convexified_hessian(convexify ? std::make_unique<ConvexifiedHessian>(dimension, maximum_number_nonzeros + dimension, options) : nullptr),
+         cost_ratio(options.get_double("hybrid_hessian_cost_ratio")),
+         min_iterations(options.get_unsigned_int("hybrid_hessian_min_iterations")),
+         local_step_tolerance(options.get_double("hybrid_hessian_local_step_tolerance")),
+         previous_primals(dimension) {
+   }
+
+   HybridHessian::~HybridHessian() { }
+
+   void HybridHessian::initialize_statistics(Statistics& statistics, const Options& options) const {
+      this->exact_hessian->initialize_statistics(statistics, options);
+      if (this->convexified_hessian != nullptr) {
+         this->convexified_hessian->initialize_statistics(statistics, options);
+      }
+      statistics.add_column("hessian", Statistics::int_width, options.get_int("statistics_hessian_column_order"));
+   }
+
+   void HybridHessian::evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
+      const Clock::time_point evaluation_start = this->current_time();
+      const size_t number_variables = problem.model.number_variables;
+      // a re-evaluation at unchanged primals (e.g. new multipliers or a switch to the feasibility problem) is not a new iteration:
+      // neither the time nor the step are measured
+      bool is_new_iteration = true;
+      if (not this->has_previous_evaluation) {
+         this->is_quasi_newton_available = (0 < problem.model.number_elements());
+         if (not this->is_quasi_newton_available) {
+            DEBUG << "The model has no element functions: the hybrid Hessian model uses the exact Hessian\n";
+         }
+      }
+      else {
+         const double step_norm = this->compute_step_norm(primal_variables, number_variables);
+         is_new_iteration = (0. < step_norm);
+         if (is_new_iteration) {
+            update_average(this->iteration_time, seconds(evaluation_start - this->previous_evaluation_end - this->reevaluation_time));
+            this->reevaluation_time = Clock::duration::zero();
+            this->detect_local_phase(step_norm, norm_inf(view(primal_variables, 0, number_variables)));
+         }
+      }
+      if (is_new_iteration) {
+         for (size_t variable_index: Range(number_variables)) {
+            this->previous_primals[variable_index] = primal_variables[variable_index];
+         }
+         // the approximation is kept up to date only if the exact Hessian is not negligible
+         if (this->is_quasi_newton_available && (not this->use_exact_hessian ||
+               this->cost_ratio * this->iteration_time.value_or(0.) <= 2. * this->exact_hessian_time.value_or(0.))) {
+            this->quasi_newton_hessian.update(problem.model, primal_variables);
+         }
+         this->select_mode();
+      }
+
+      const Clock::time_point hessian_start = this->current_time();
+      if (this->use_exact_hessian) {
+         this->exact_hessian->evaluate(statistics, problem, primal_variables, constraint_multipliers, hessian);
+         update_average(this->exact_hessian_time, seconds(this->current_time() - hessian_start));
+      }
+      else {
+         this->quasi_newton_hessian.evaluate(statistics, problem, primal_variables, constraint_multipliers, hessian);
+      }
+      if (this->convexified_hessian != nullptr) {
+         this->convexified_hessian->convexify(statistics, problem, hessian);
+      }
+      statistics.set("hessian", this->use_exact_hessian ? "exact" : "QN");
+      this->evaluation_count = this->exact_hessian->evaluation_count + this->quasi_newton_hessian.evaluation_count;
+      // the exact Hessian and the approximation (union of the element patterns) have different sparsity patterns
+      this->sparsity_changed = this->has_previous_evaluation && (this->use_exact_hessian != this->previous_evaluation_exact);
+      this->previous_evaluation_exact = this->use_exact_hessian;
+      this->has_previous_evaluation = true;
+      if (is_new_iteration) {
+         this->previous_evaluation_end = this->current_time();
+      }
+      else {
+         this->reevaluation_time += this->current_time() - evaluation_start;
+      }
+   }
+
+   bool HybridHessian::is_using_exact_hessian() const {
+      return this->use_exact_hessian;
+   }
+
+   size_t HybridHessian::number_switches() const {
+      return this->switches;
+   }
+
+   HybridHessian::Clock::time_point HybridHessian::current_time() const {
+      return Clock::now();
+   }
+
+   double HybridHessian::compute_step_norm(const Vector<double>& primal_variables, size_t number_variables) const {
+      double step_norm = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         step_norm = std::max(step_norm, std::abs(primal_variables[variable_index] - this->previous_primals[variable_index]));
+      }
+      return step_norm;
+   }
+
+   // the local phase starts after consecutive small steps and ends if the steps become much larger (hysteresis)
+   void HybridHessian::detect_local_phase(double step_norm, double primal_norm) {
+      const double relative_step_norm = step_norm / std::max(1., primal_norm);
+      if (relative_step_norm <= this->local_step_tolerance) {
+         this->consecutive_small_steps++;
+         if (local_phase_small_steps <= this->consecutive_small_steps && not this->is_local_phase) {
+            DEBUG << "Hybrid Hessian: local phase\n";
+            this->is_local_phase = true;
+         }
+      }
+      else {
+         this->consecutive_small_steps = 0;
+         if (this->is_local_phase && local_phase_exit_factor * this->local_step_tolerance < relative_step_norm) {
+            this->is_local_phase = false;
+         }
+      }
+   }
+
+   void HybridHessian::select_mode() {
+      bool use_exact_hessian = this->use_exact_hessian;
+      if (not this->is_quasi_newton_available || this->is_local_phase) {
+         use_exact_hessian = true;
+      }
+      else if (this->min_iterations <= this->iterations_in_mode) {
+         // the approximation needs more iterations: it pays off if the exact Hessian costs more than the additional iterations
+         use_exact_hessian = (this->exact_hessian_time.value_or(0.) < this->cost_ratio * this->iteration_time.value_or(0.));
+      }
+      if (use_exact_hessian != this->use_exact_hessian) {
+         DEBUG << "Hybrid Hessian: switching to the " << (use_exact_hessian ? "exact Hessian" : "quasi-Newton approximation") << '\n';
+         this->use_exact_hessian = use_exact_hessian;
+         this->iterations_in_mode = 0;
+         this->switches++;
+      }
+      this->iterations_in_mode++;
+   }
+} // namespace
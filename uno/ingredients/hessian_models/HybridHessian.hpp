@@ -0,0 +1,70 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_HYBRIDHESSIAN_H
+#define UNO_HYBRIDHESSIAN_H
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include "HessianModel.hpp"
+#include "PartitionedQuasiNewtonHessian.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declaration
+   class ConvexifiedHessian;
+
+   // switches at runtime between the exact Hessian and the partitioned quasi-Newton approximation (kept up to date while the exact
+   // Hessian is not negligible). The evaluation time of the exact Hessian is compared with the time of the rest of the iteration:
+   // the approximation is used when the exact Hessian costs more than the additional iterations of the quasi-Newton method
+   // (hybrid_hessian_cost_ratio iterations per exact iteration). The exact Hessian is used in the local phase (consecutive small
+   // steps) to keep the fast local convergence, and for models without element functions. If a convex model is requested, both
+   // Hessians are convexified
+   class HybridHessian : public HessianModel {
+   public:
+      HybridHessian(size_t dimension, size_t maximum_number_nonzeros, bool convexify, const Options& options);
+      ~HybridHessian() override;
+
+      void initialize_statistics(Statistics& statistics, const Options& options) const override;
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) override;
+
+      [[nodiscard]] bool is_using_exact_hessian() const;
+      [[nodiscard]] size_t number_switches() const;
+
+   protected:
+      using Clock = std::chrono::steady_clock;
+
+      const std::unique_ptr<HessianModel> exact_hessian;
+      PartitionedQuasiNewtonHessian quasi_newton_hessian;
+      // convexification of the selected Hessian (null if the Hessian may be indefinite)
+      const std::unique_ptr<ConvexifiedHessian> convexified_hessian;
+      const double cost_ratio;
+      const size_t min_iterations;
+      const double local_step_tolerance;
+
+      bool is_quasi_newton_available{false};
+      bool is_local_phase{false};
+      size_t consecutive_small_steps{0};
+      bool use_exact_hessian{true};
+      bool previous_evaluation_exact{true};
+      size_t iterations_in_mode{0};
+      size_t switches{0};
+      // moving averages of the times (in seconds) of the rest of the iteration and of the exact Hessian
+      std::optional<double> iteration_time{};
+      std::optional<double> exact_hessian_time{};
+      bool has_previous_evaluation{false};
+      Clock::time_point previous_evaluation_end{};
+      // time spent in re-evaluations at unchanged primals since the previous iteration (excluded from the iteration time)
+      Clock::duration reevaluation_time{};
+      Vector<double> previous_primals{};
+
+      [[nodiscard]] virtual Clock::time_point current_time() const;
+      [[nodiscard]] double compute_step_norm(const Vector<double>& primal_variables, size_t number_variables) const;
+      void detect_local_phase(double step_norm, double primal_norm);
+      void select_mode();
+   };
+} // namespace
+
+#endif // UNO_HYBRIDHESSIAN_H
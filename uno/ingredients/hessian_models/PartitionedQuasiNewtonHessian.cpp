@@ -0,0 +1,268 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "PartitionedQuasiNewtonHessian.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      QuasiNewtonUpdate read_update_type(const std::string& update) {
+         if (update == "SR1") {
+            return QuasiNewtonUpdate::SR1;
+         }
+         else if (update == "BFGS") {
+            return QuasiNewtonUpdate::BFGS;
+         }
+         throw std::invalid_argument("The quasi-Newton update " + update + " does not exist");
+      }
+
+      // relative tolerance below which an update is skipped
+      constexpr double skipping_tolerance = 1e-8;
+   } // namespace
+
+   PartitionedQuasiNewtonHessian::PartitionedQuasiNewtonHessian(const Options& options):
+         HessianModel(),
+         update_type(read_update_type(options.get_string("quasi_newton_update"))) {
+   }
+
+   void PartitionedQuasiNewtonHessian::initialize_statistics(Statistics& /*statistics*/, const Options& /*options*/) const { }
+
+   void PartitionedQuasiNewtonHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem,
+         const Vector<double>& primal_variables, const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
+      const Model& model = problem.model;
+      this->update(model, primal_variables);
+      if (hessian.capacity() < this->entries.size()) {
+         throw std::runtime_error("The partitioned quasi-Newton Hessian has more nonzeros than the Lagrangian Hessian sparsity pattern");
+      }
+
+      // weighted sum of the element approximations
+      const double objective_multiplier = problem.get_objective_multiplier();
+      std::fill(this->entries.begin(), this->entries.end(), 0.);
+      for (size_t element_index: Range(this->elements.size())) {
+         const ElementFunction& element = this->elements[element_index];
+         const double weight = element.constraint_index.has_value() ? -constraint_multipliers[*element.constraint_index] : objective_multiplier;
+         if (weight != 0.) {
+            const size_t dimension = element.variables.size();
+            const double* matrix = this->element_matrices.data() + this->matrix_offsets[element_index];
+            const size_t* positions = this->entry_positions.data() + this->triangle_offsets[element_index];
+            for (size_t local_column: Range(dimension)) {
+               for (size_t local_row: Range(local_column + 1)) {
+                  this->entries[positions[local_column * (local_column + 1) / 2 + local_row]] += weight * matrix[local_column * dimension + local_row];
+               }
+            }
+         }
+      }
+
+      // insert the upper triangular part column by column (compatible with the CSC format)
+      hessian.set_dimension(problem.number_variables);
+      hessian.reset();
+      for (size_t column_index: Range(problem.number_variables)) {
+         if (column_index < model.number_variables) {
+            for (size_t position: Range(this->column_starts[column_index], this->column_starts[column_index + 1])) {
+               hessian.insert(this->entries[position], this->row_indices[position], column_index);
+            }
+         }
+         hessian.finalize_column(column_index);
+      }
+      problem.add_problem_hessian_terms(primal_variables, hessian);
+      DEBUG2 << "Partitioned quasi-Newton Hessian:\n" << hessian << '\n';
+      this->evaluation_count++;
+   }
+
+   void PartitionedQuasiNewtonHessian::update(const Model& model, const Vector<double>& primal_variables) {
+      if (not this->is_initialized) {
+         this->initialize(model);
+      }
+      this->update_elements(model, primal_variables);
+   }
+
+   size_t PartitionedQuasiNewtonHessian::number_skipped_updates() const {
+      return this->skipped_updates;
+   }
+
+   void PartitionedQuasiNewtonHessian::initialize(const Model& model) {
+      if (model.number_elements() == 0) {
+         throw std::runtime_error("The partitioned quasi-Newton Hessian model requires a model with a partially separable structure");
+      }
+      model.get_elements(this->elements);
+
+      // offsets of the elements and identity initial approximations
+      size_t number_gradient_entries = 0;
+      size_t number_matrix_entries = 0;
+      size_t number_triangle_entries = 0;
+      size_t maximum_dimension = 0;
+      for (const ElementFunction& element: this->elements) {
+         const size_t dimension = element.variables.size();
+         this->gradient_offsets.emplace_back(number_gradient_entries);
+         this->matrix_offsets.emplace_back(number_matrix_entries);
+         this->triangle_offsets.emplace_back(number_triangle_entries);
+         number_gradient_entries += dimension;
+         number_matrix_entries += dimension * dimension;
+         number_triangle_entries += dimension * (dimension + 1) / 2;
+         maximum_dimension = std::max(maximum_dimension, dimension);
+      }
+      this->element_matrices.resize(number_matrix_entries, 0.);
+      for (size_t element_index: Range(this->elements.size())) {
+         const size_t dimension = this->elements[element_index].variables.size();
+         for (size_t local_index: Range(dimension)) {
+            this->element_matrices[this->matrix_offsets[element_index] + local_index * dimension + local_index] = 1.;
+         }
+      }
+      this->is_element_scaled.resize(this->elements.size(), false);
+      this->previous_primals.resize(model.number_variables);
+      this->previous_gradients.resize(number_gradient_entries);
+      this->current_gradients.resize(number_gradient_entries);
+      this->step.resize(maximum_dimension);
+      this->gradient_difference.resize(maximum_dimension);
+      this->product.resize(maximum_dimension);
+
+      // union of the upper triangular patterns of the elements, sorted by columns
+      std::vector<std::pair<size_t, size_t>> pattern{}; // (column, row)
+      pattern.reserve(number_triangle_entries);
+      for (const ElementFunction& element: this->elements) {
+         for (size_t local_column: Range(element.variables.size())) {
+            for (size_t local_row: Range(local_column + 1)) {
+               const size_t row_index = element.variables[local_row];
+               const size_t column_index = element.variables[local_column];
+               pattern.emplace_back(std::max(row_index, column_index), std::min(row_index, column_index));
+            }
+         }
+      }
+      std::sort(pattern.begin(), pattern.end());
+      pattern.erase(std::unique(pattern.begin(), pattern.end()), pattern.end());
+      this->column_starts.assign(model.number_variables + 1, 0);
+      for (const auto& [column_index, row_index]: pattern) {
+         this->column_starts[column_index + 1]++;
+         this->row_indices.emplace_back(row_index);
+      }
+      for (size_t column_index: Range(model.number_variables)) {
+         this->column_starts[column_index + 1] += this->column_starts[column_index];
+      }
+      this->entries.resize(pattern.size());
+
+      // position of each local entry in the union
+      this->entry_positions.reserve(number_triangle_entries);
+      for (const ElementFunction& element: this->elements) {
+         for (size_t local_column: Range(element.variables.size())) {
+            for (size_t local_row: Range(local_column + 1)) {
+               const size_t row_index = std::min(element.variables[local_row], element.variables[local_column]);
+               const size_t column_index = std::max(element.variables[local_row], element.variables[local_column]);
+               const auto first_row = this->row_indices.begin() + static_cast<std::ptrdiff_t>(this->column_starts[column_index]);
+               const auto last_row = this->row_indices.begin() + static_cast<std::ptrdiff_t>(this->column_starts[column_index + 1]);
+               this->entry_positions.emplace_back(static_cast<size_t>(std::lower_bound(first_row, last_row, row_index) -
+                     this->row_indices.begin()));
+            }
+         }
+      }
+      DEBUG << "Partitioned quasi-Newton Hessian with " << this->elements.size() << " elements and " << pattern.size() << " nonzeros\n";
+      this->is_initialized = true;
+   }
+
+   // the approximations are updated when the point changed since the last evaluation
+   void PartitionedQuasiNewtonHessian::update_elements(const Model& model, const Vector<double>& primal_variables) {
+      bool point_changed = not this->has_previous_point;
+      for (size_t variable_index: Range(this->previous_primals.size())) {
+         point_changed = point_changed || (primal_variables[variable_index] != this->previous_primals[variable_index]);
+      }
+      if (not point_changed) {
+         return;
+      }
+      // the point may have more variables than the model (e.g. elastic variables): they do not enter the elements
+      model.evaluate_element_gradients(primal_variables, this->current_gradients);
+      if (this->has_previous_point) {
+         for (size_t element_index: Range(this->elements.size())) {
+            if (not this->update_element(element_index, primal_variables)) {
+               this->skipped_updates++;
+            }
+         }
+      }
+      for (size_t variable_index: Range(this->previous_primals.size())) {
+         this->previous_primals[variable_index] = primal_variables[variable_index];
+      }
+      std::swap(this->previous_gradients, this->current_gradients);
+      this->has_previous_point = true;
+   }
+
+   bool PartitionedQuasiNewtonHessian::update_element(size_t element_index, const Vector<double>& primal_variables) {
+      const ElementFunction& element = this->elements[element_index];
+      const size_t dimension = element.variables.size();
+      double* matrix = this->element_matrices.data() + this->matrix_offsets[element_index];
+      const size_t gradient_offset = this->gradient_offsets[element_index];
+
+      // s = x_e - x_e^previous and y = g_e(x) - g_e(x^previous)
+      double step_squared_norm = 0.;
+      double difference_squared_norm = 0.;
+      double curvature = 0.; // s^T y
+      for (size_t local_index: Range(dimension)) {
+         this->step[local_index] = primal_variables[element.variables[local_index]] - this->previous_primals[element.variables[local_index]];
+         this->gradient_difference[local_index] = this->current_gradients[gradient_offset + local_index] -
+               this->previous_gradients[gradient_offset + local_index];
+         step_squared_norm += this->step[local_index] * this->step[local_index];
+         difference_squared_norm += this->gradient_difference[local_index] * this->gradient_difference[local_index];
+         curvature += this->step[local_index] * this->gradient_difference[local_index];
+      }
+      if (step_squared_norm == 0.) {
+         return true;
+      }
+      // BFGS: scaling of the initial identity before the first update (Nocedal and Wright, (6.20)). The SR1 update is not scaled: the
+      // first SR1 approximations of the nonconvex elements are then often nearly singular
+      if (this->update_type == QuasiNewtonUpdate::BFGS && not this->is_element_scaled[element_index] && 0. < curvature) {
+         for (size_t local_index: Range(dimension)) {
+            matrix[local_index * dimension + local_index] = difference_squared_norm / curvature;
+         }
+         this->is_element_scaled[element_index] = true;
+      }
+      // B s
+      double step_product = 0.; // s^T B s
+      for (size_t local_row: Range(dimension)) {
+         this->product[local_row] = 0.;
+         for (size_t local_column: Range(dimension)) {
+            this->product[local_row] += matrix[local_column * dimension + local_row] * this->step[local_column];
+         }
+         step_product += this->step[local_row] * this->product[local_row];
+      }
+
+      if (this->update_type == QuasiNewtonUpdate::SR1) {
+         // B + r r^T / (r^T s) with r = y - B s
+         double denominator = 0.;
+         double residual_squared_norm = 0.;
+         for (size_t local_index: Range(dimension)) {
+            this->product[local_index] = this->gradient_difference[local_index] - this->product[local_index];
+            denominator += this->product[local_index] * this->step[local_index];
+            residual_squared_norm += this->product[local_index] * this->product[local_index];
+         }
+         if (std::abs(denominator) <= skipping_tolerance * std::sqrt(residual_squared_norm * step_squared_norm)) {
+            return false;
+         }
+         for (size_t local_column: Range(dimension)) {
+            for (size_t local_row: Range(dimension)) {
+               matrix[local_column * dimension + local_row] += this->product[local_row] * this->product[local_column] / denominator;
+            }
+         }
+      }
+      else {
+         // B - B s s^T B / (s^T B s) + y y^T / (y^T s), skipped if the curvature condition does not hold
+         if (curvature <= skipping_tolerance * std::sqrt(difference_squared_norm * step_squared_norm) || step_product <= 0.) {
+            return false;
+         }
+         for (size_t local_column: Range(dimension)) {
+            for (size_t local_row: Range(dimension)) {
+               matrix[local_column * dimension + local_row] += -this->product[local_row] * this->product[local_column] / step_product +
+                     this->gradient_difference[local_row] * this->gradient_difference[local_column] / curvature;
+            }
+         }
+      }
+      return true;
+   }
+} // namespace
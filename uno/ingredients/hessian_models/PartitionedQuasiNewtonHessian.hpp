@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PARTITIONEDQUASINEWTONHESSIAN_H
+#define UNO_PARTITIONEDQUASINEWTONHESSIAN_H
+
+#include <vector>
+#include "HessianModel.hpp"
+#include "model/Model.hpp"
+
+namespace uno {
+   enum class QuasiNewtonUpdate {SR1, BFGS};
+
+   // partitioned quasi-Newton Hessian (as in LANCELOT) for partially separable models: each element function of the objective and of
+   // the constraints has a small dense approximation B_e of its Hessian, updated with the variation of its gradient (SR1 or BFGS).
+   // The Lagrangian Hessian objective_multiplier sum_{e in f} B_e - sum_j multipliers_j sum_{e in c_j} B_e is assembled into the union
+   // of the dense patterns of the elements, which must fit into the sparsity pattern of the Lagrangian Hessian.
+   // The approximation is indefinite in general (SR1 updates, constraints): HessianModelFactory wraps it into a ConvexifiedHessian
+   // when the subproblem requires a convex model
+   class PartitionedQuasiNewtonHessian : public HessianModel {
+   public:
+      explicit PartitionedQuasiNewtonHessian(const Options& options);
+
+      void initialize_statistics(Statistics& statistics, const Options& options) const override;
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) override;
+
+      // updates the element approximations at a new point without assembling the Hessian (keeps the approximations warm when
+      // another Hessian model is used)
+      void update(const Model& model, const Vector<double>& primal_variables);
+      [[nodiscard]] size_t number_skipped_updates() const;
+
+   protected:
+      const QuasiNewtonUpdate update_type;
+      bool is_initialized{false};
+      bool has_previous_point{false};
+      std::vector<ElementFunction> elements{};
+      // offsets of the elements in the concatenated gradients, in the dense matrices (column major) and in the local upper triangles
+      std::vector<size_t> gradient_offsets{};
+      std::vector<size_t> matrix_offsets{};
+      std::vector<size_t> triangle_offsets{};
+      std::vector<double> element_matrices{};
+      std::vector<bool> is_element_scaled{};
+      // previous point and element gradients
+      std::vector<double> previous_primals{};
+      std::vector<double> previous_gradients{};
+      std::vector<double> current_gradients{};
+      // union of the element patterns (upper triangular part, compressed by columns) and position of the local entries in the union
+      std::vector<size_t> column_starts{};
+      std::vector<size_t> row_indices{};
+      std::vector<size_t> entry_positions{};
+      std::vector<double> entries{};
+      // workspace of the element updates
+      std::vector<double> step{};
+      std::vector<double> gradient_difference{};
+      std::vector<double> product{};
+      size_t skipped_updates{0};
+
+      void initialize(const Model& model);
+      void update_elements(const Model& model, const Vector<double>& primal_variables);
+      // returns false if the update was skipped
+      bool update_element(size_t element_index, const Vector<double>& primal_variables);
+   };
+} // namespace
+
+#endif // UNO_PARTITIONEDQUASINEWTONHESSIAN_H
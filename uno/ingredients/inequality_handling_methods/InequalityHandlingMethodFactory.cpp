@@ -6,6 +6,7 @@
 #include "InequalityHandlingMethodFactory.hpp"
 #include "inequality_constrained_methods/QPSubproblem.hpp"
 #include "inequality_constrained_methods/LPSubproblem.hpp"
+#include "inequality_constrained_methods/ReducedQPSubproblem.hpp"
 #include "interior_point_methods/PrimalDualInteriorPointMethod.hpp"
 #include "ingredients/subproblem_solvers/QPSolverFactory.hpp"
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
@@ -24,6 +25,9 @@ namespace uno {
          return std::make_unique<LPSubproblem>(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
                options);
       }
+      else if (subproblem_strategy == "reduced_QP") {
+         return std::make_unique<ReducedQPSubproblem>(number_variables, number_constraints, options);
+      }
       // interior-point method
       else if (subproblem_strategy == "primal_dual_interior_point") {
          return std::make_unique<PrimalDualInteriorPointMethod>(number_variables, number_constraints, number_jacobian_nonzeros,
@@ -38,6 +42,8 @@ namespace uno {
          strategies.emplace_back("QP");
          strategies.emplace_back("LP");
       }
+      // the reduced QP subproblem relies on built-in factorizations
+      strategies.emplace_back("reduced_QP");
       if (not SymmetricIndefiniteLinearSolverFactory::available_solvers().empty()) {
          strategies.emplace_back("primal_dual_interior_point");
       }
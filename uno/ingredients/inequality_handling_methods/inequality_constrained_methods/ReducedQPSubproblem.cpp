@@ -0,0 +1,513 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "ReducedQPSubproblem.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      // in-place dense Cholesky factorization and solve (row-major). Returns false if the matrix is not positive definite
+      bool dense_cholesky_solve(std::vector<double>& matrix, size_t dimension, std::vector<double>& rhs) {
+         for (size_t column_index: Range(dimension)) {
+            double pivot = matrix[column_index * dimension + column_index];
+            for (size_t k: Range(column_index)) {
+               pivot -= matrix[column_index * dimension + k] * matrix[column_index * dimension + k];
+            }
+            if (not (0. < pivot)) {
+               return false;
+            }
+            pivot = std::sqrt(pivot);
+            matrix[column_index * dimension + column_index] = pivot;
+            for (size_t row_index: Range(column_index + 1, dimension)) {
+               double entry = matrix[row_index * dimension + column_index];
+               for (size_t k: Range(column_index)) {
+                  entry -= matrix[row_index * dimension + k] * matrix[column_index * dimension + k];
+               }
+               matrix[row_index * dimension + column_index] = entry / pivot;
+            }
+         }
+         // forward and backward substitutions
+         for (size_t row_index: Range(dimension)) {
+            for (size_t k: Range(row_index)) {
+               rhs[row_index] -= matrix[row_index * dimension + k] * rhs[k];
+            }
+            rhs[row_index] /= matrix[row_index * dimension + row_index];
+         }
+         for (size_t row_index = dimension; row_index-- > 0;) {
+            for (size_t k: Range(row_index + 1, dimension)) {
+               rhs[row_index] -= matrix[k * dimension + row_index] * rhs[k];
+            }
+            rhs[row_index] /= matrix[row_index * dimension + row_index];
+         }
+         return true;
+      }
+   } // namespace
+
+   ReducedQPSubproblem::ReducedQPSubproblem(size_t number_variables, size_t number_constraints, const Options& options) :
+         InequalityConstrainedMethod("zero", number_variables, number_constraints, 0, false, options),
+         maximum_degrees_of_freedom(options.get_unsigned_int("reduced_QP_max_degrees_of_freedom")),
+         maximum_basis_repairs(options.get_unsigned_int("reduced_QP_max_basis_repairs")),
+         basis_factorization(number_constraints, number_variables, options.get_double("reduced_QP_pivot_threshold")),
+         column_priorities(number_variables),
+         previous_primals(number_variables),
+         dense_objective_gradient(number_variables),
+         constraint_workspace(number_constraints),
+         basic_workspace(number_constraints) {
+   }
+
+   void ReducedQPSubproblem::generate_initial_iterate(const OptimizationProblem& /*problem*/, Iterate& /*initial_iterate*/) {
+   }
+
+   void ReducedQPSubproblem::solve(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& warmstart_information) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      if (number_variables < number_constraints || this->maximum_degrees_of_freedom < number_variables - number_constraints) {
+         throw std::runtime_error("The reduced QP subproblem supports at most " + std::to_string(this->maximum_degrees_of_freedom) +
+               " degrees of freedom");
+      }
+
+      // function evaluations
+      if (warmstart_information.objective_changed) {
+         problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
+      }
+      if (warmstart_information.constraints_changed) {
+         problem.evaluate_constraints(current_iterate, this->constraints);
+         problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
+      }
+      this->set_direction_bounds(problem, current_iterate);
+      this->set_linearized_constraint_bounds(problem, this->constraints);
+      for (size_t constraint_index: Range(number_constraints)) {
+         if (problem.constraint_lower_bound(constraint_index) != problem.constraint_upper_bound(constraint_index)) {
+            throw std::invalid_argument("The reduced QP subproblem requires an equality-constrained problem");
+         }
+      }
+
+      // basis partition J = [B N]: the factors are reused as long as the Jacobian is unchanged
+      if (warmstart_information.constraints_changed || not this->is_basis_factorized) {
+         if (not this->update_basis(problem, current_iterate)) {
+            DEBUG << "The Jacobian is rank deficient, no basis could be found\n";
+            direction.status = SubproblemStatus::INFEASIBLE;
+            this->number_subproblems_solved++;
+            return;
+         }
+      }
+      const bool iterate_changed = warmstart_information.objective_changed || warmstart_information.constraints_changed;
+
+      bool bounds_violated = false;
+      for (size_t basis_repair = 0;; basis_repair++) {
+         const std::vector<size_t>& basic_variables = this->basis_factorization.get_basic_columns();
+         this->compute_reduced_gradient(number_constraints, direction.multipliers.constraints);
+         if (iterate_changed && basis_repair == 0) {
+            this->update_reduced_hessian(current_iterate);
+         }
+
+         // bound-constrained QP in the nonbasic variables
+         const size_t number_nonbasic_variables = this->nonbasic_variables.size();
+         for (size_t index: Range(number_nonbasic_variables)) {
+            this->reduced_lower_bounds[index] = this->direction_lower_bounds[this->nonbasic_variables[index]];
+            this->reduced_upper_bounds[index] = this->direction_upper_bounds[this->nonbasic_variables[index]];
+         }
+         if (not this->solve_bound_constrained_qp()) {
+            direction.status = SubproblemStatus::ERROR;
+            this->number_subproblems_solved++;
+            return;
+         }
+
+         // basic variables: B d_B = (c_L - c) - N d_N
+         direction.primals.fill(0.);
+         for (size_t index: Range(number_nonbasic_variables)) {
+            direction.primals[this->nonbasic_variables[index]] = this->reduced_direction[index];
+         }
+         for (size_t constraint_index: Range(number_constraints)) {
+            double rhs = this->linearized_constraints_lower_bounds[constraint_index];
+            for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+               rhs -= derivative * direction.primals[variable_index];
+            }
+            this->constraint_workspace[constraint_index] = rhs;
+         }
+         this->basis_factorization.solve(this->constraint_workspace, this->basic_workspace);
+         bounds_violated = false;
+         for (size_t position: Range(number_constraints)) {
+            const size_t variable_index = basic_variables[position];
+            direction.primals[variable_index] = this->basic_workspace[position];
+            if (direction.primals[variable_index] < this->direction_lower_bounds[variable_index] ||
+                  this->direction_upper_bounds[variable_index] < direction.primals[variable_index]) {
+               // the basic variable leaves the basis: its bounds are then enforced by the reduced QP
+               this->column_priorities[variable_index] = -1.;
+               bounds_violated = true;
+            }
+         }
+         if (not bounds_violated || basis_repair == this->maximum_basis_repairs || not this->factorize_basis(number_variables, number_constraints)) {
+            break;
+         }
+         DEBUG << "The basic variables violate their bounds, the basis is repaired\n";
+      }
+      // the linearized constraints could not be satisfied within the bounds
+      if (bounds_violated) {
+         DEBUG << "The basic variables violate their bounds, the reduced QP is declared infeasible\n";
+         direction.status = SubproblemStatus::INFEASIBLE;
+         this->number_subproblems_solved++;
+         return;
+      }
+      direction.status = SubproblemStatus::OPTIMAL;
+      direction.subproblem_objective = dot(direction.primals, this->objective_gradient) +
+            0.5 * this->reduced_quadratic_product(this->reduced_direction);
+      if (iterate_changed) {
+         this->save_iterate(current_iterate);
+      }
+
+      // bound multipliers of the nonbasic variables: QP gradient
+      direction.multipliers.lower_bounds.fill(0.);
+      direction.multipliers.upper_bounds.fill(0.);
+      for (size_t index: Range(this->nonbasic_variables.size())) {
+         const size_t variable_index = this->nonbasic_variables[index];
+         if (this->bound_status[index] == BoundStatus::AT_LOWER_BOUND) {
+            direction.multipliers.lower_bounds[variable_index] = std::max(0., this->qp_gradient[index]);
+         }
+         else if (this->bound_status[index] == BoundStatus::AT_UPPER_BOUND) {
+            direction.multipliers.upper_bounds[variable_index] = std::min(0., this->qp_gradient[index]);
+         }
+      }
+      InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
+      this->number_subproblems_solved++;
+      // reset the initial point
+      this->initial_point.fill(0.);
+   }
+
+   double ReducedQPSubproblem::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      double product = 0.;
+      const size_t number_nonbasic_variables = this->nonbasic_variables.size();
+      for (size_t row_index: Range(number_nonbasic_variables)) {
+         double row_product = 0.;
+         for (size_t column_index: Range(number_nonbasic_variables)) {
+            row_product += this->reduced_hessian[row_index * number_nonbasic_variables + column_index] *
+                  primal_direction[this->nonbasic_variables[column_index]];
+         }
+         product += primal_direction[this->nonbasic_variables[row_index]] * row_product;
+      }
+      return product;
+   }
+
+   // select the basic variables among the variables far from their bounds and factorize B
+   bool ReducedQPSubproblem::update_basis(const OptimizationProblem& problem, const Iterate& current_iterate) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      for (size_t variable_index: Range(number_variables)) {
+         const double value = current_iterate.primals[variable_index];
+         const double distance_to_bounds = std::min(value - problem.variable_lower_bound(variable_index),
+               problem.variable_upper_bound(variable_index) - value);
+         const double scale = 1. + std::abs(value);
+         this->column_priorities[variable_index] = (distance_to_bounds <= 1e-8 * scale) ? 0. : (distance_to_bounds <= 1e-2 * scale) ? 1. : 2.;
+      }
+
+      const bool same_dimensions = this->is_basis_factorized && this->basis_factorization.get_basic_columns().size() == number_constraints &&
+            this->nonbasic_variables.size() + number_constraints == number_variables;
+      if (same_dimensions) {
+         // keep the basis if its variables are far from their bounds and the pivots remain stable
+         const auto& basic_variables = this->basis_factorization.get_basic_columns();
+         const bool basis_is_interior = std::all_of(basic_variables.begin(), basic_variables.end(), [&](size_t variable_index) {
+            return this->column_priorities[variable_index] == 2.;
+         });
+         if (basis_is_interior && this->basis_factorization.refactorize(this->constraint_jacobian)) {
+            return true;
+         }
+      }
+      return this->factorize_basis(number_variables, number_constraints);
+   }
+
+   bool ReducedQPSubproblem::factorize_basis(size_t number_variables, size_t number_constraints) {
+      this->is_basis_factorized = this->basis_factorization.factorize(this->constraint_jacobian, number_constraints, number_variables,
+            this->column_priorities);
+      if (not this->is_basis_factorized) {
+         return false;
+      }
+      DEBUG << "New basis with " << this->basis_factorization.number_factor_nonzeros() << " nonzeros in the LU factors\n";
+      std::vector<size_t> previous_nonbasic_variables{};
+      previous_nonbasic_variables.swap(this->nonbasic_variables);
+      for (size_t variable_index: Range(number_variables)) {
+         if (not this->basis_factorization.is_basic(variable_index)) {
+            this->nonbasic_variables.emplace_back(variable_index);
+         }
+      }
+      if (this->nonbasic_variables != previous_nonbasic_variables) {
+         this->restrict_reduced_hessian(previous_nonbasic_variables, number_variables);
+      }
+      return true;
+   }
+
+   // keep the curvature of the variables that remain nonbasic; the new nonbasic variables start with the average diagonal
+   void ReducedQPSubproblem::restrict_reduced_hessian(const std::vector<size_t>& previous_nonbasic_variables, size_t number_variables) {
+      const size_t previous_dimension = previous_nonbasic_variables.size();
+      const size_t dimension = this->nonbasic_variables.size();
+      std::vector<size_t> previous_position(number_variables, SparseLUFactorization::NOT_BASIC);
+      double average_diagonal = 0.;
+      for (size_t index: Range(previous_dimension)) {
+         if (previous_nonbasic_variables[index] < number_variables) {
+            previous_position[previous_nonbasic_variables[index]] = index;
+         }
+         average_diagonal += this->reduced_hessian[index * previous_dimension + index];
+      }
+      average_diagonal = (0 < previous_dimension) ? average_diagonal / static_cast<double>(previous_dimension) : 1.;
+
+      std::vector<double> hessian(dimension * dimension, 0.);
+      for (size_t row: Range(dimension)) {
+         const size_t previous_row = previous_position[this->nonbasic_variables[row]];
+         for (size_t column: Range(dimension)) {
+            const size_t previous_column = previous_position[this->nonbasic_variables[column]];
+            if (previous_row != SparseLUFactorization::NOT_BASIC && previous_column != SparseLUFactorization::NOT_BASIC) {
+               hessian[row * dimension + column] = this->reduced_hessian[previous_row * previous_dimension + previous_column];
+            }
+         }
+         if (previous_row == SparseLUFactorization::NOT_BASIC) {
+            hessian[row * dimension + row] = average_diagonal;
+         }
+      }
+      this->reduced_hessian.swap(hessian);
+      this->is_hessian_initial = (previous_dimension == 0) || this->is_hessian_initial;
+      // the previous reduced gradient refers to another basis
+      this->has_previous_iterate = false;
+      this->reduced_gradient.resize(dimension);
+      this->reduced_direction.resize(dimension);
+      this->reduced_lower_bounds.resize(dimension);
+      this->reduced_upper_bounds.resize(dimension);
+      this->qp_gradient.resize(dimension);
+      this->bound_status.resize(dimension);
+      this->previous_reduced_gradient.resize(dimension);
+   }
+
+   // constraint multipliers B^T lambda = g_B and reduced gradient g_N - N^T lambda
+   void ReducedQPSubproblem::compute_reduced_gradient(size_t number_constraints, Vector<double>& constraint_multipliers) {
+      const std::vector<size_t>& basic_variables = this->basis_factorization.get_basic_columns();
+      this->dense_objective_gradient.fill(0.);
+      for (const auto [variable_index, derivative]: this->objective_gradient) {
+         this->dense_objective_gradient[variable_index] += derivative;
+      }
+      for (size_t position: Range(number_constraints)) {
+         this->basic_workspace[position] = this->dense_objective_gradient[basic_variables[position]];
+      }
+      this->basis_factorization.solve_transpose(this->basic_workspace, this->constraint_workspace);
+      for (size_t constraint_index: Range(number_constraints)) {
+         constraint_multipliers[constraint_index] = this->constraint_workspace[constraint_index];
+         // the Jacobian-transpose product is accumulated in the gradient
+         for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+            this->dense_objective_gradient[variable_index] -= this->constraint_workspace[constraint_index] * derivative;
+         }
+      }
+      for (size_t index: Range(this->nonbasic_variables.size())) {
+         this->reduced_gradient[index] = this->dense_objective_gradient[this->nonbasic_variables[index]];
+      }
+   }
+
+   // damped BFGS update (Powell) with s = difference of nonbasic variables and y = difference of reduced gradients
+   void ReducedQPSubproblem::update_reduced_hessian(const Iterate& current_iterate) {
+      const size_t number_nonbasic_variables = this->nonbasic_variables.size();
+      if (this->has_previous_iterate) {
+         std::vector<double>& s = this->reduced_lower_bounds; // workspaces (overwritten before the QP)
+         std::vector<double>& y = this->reduced_upper_bounds;
+         double ss = 0., sy = 0., yy = 0.;
+         for (size_t index: Range(number_nonbasic_variables)) {
+            const size_t variable_index = this->nonbasic_variables[index];
+            s[index] = current_iterate.primals[variable_index] - this->previous_primals[variable_index];
+            y[index] = this->reduced_gradient[index] - this->previous_reduced_gradient[index];
+            ss += s[index] * s[index];
+            sy += s[index] * y[index];
+            yy += y[index] * y[index];
+         }
+         if (1e-20 < ss) {
+            // initial scaling of the identity
+            if (this->is_hessian_initial && 0. < sy) {
+               for (size_t index: Range(number_nonbasic_variables)) {
+                  this->reduced_hessian[index * number_nonbasic_variables + index] = yy / sy;
+               }
+            }
+            this->is_hessian_initial = false;
+            // Bs is stored in qp_gradient
+            std::vector<double>& Bs = this->qp_gradient;
+            double sBs = 0.;
+            for (size_t row_index: Range(number_nonbasic_variables)) {
+               Bs[row_index] = 0.;
+               for (size_t column_index: Range(number_nonbasic_variables)) {
+                  Bs[row_index] += this->reduced_hessian[row_index * number_nonbasic_variables + column_index] * s[column_index];
+               }
+               sBs += s[row_index] * Bs[row_index];
+            }
+            // damping: r = theta y + (1 - theta) Bs guarantees s^T r >= 0.2 s^T B s
+            const double theta = (sy < 0.2 * sBs) ? 0.8 * sBs / (sBs - sy) : 1.;
+            double sr = 0.;
+            for (size_t index: Range(number_nonbasic_variables)) {
+               y[index] = theta * y[index] + (1. - theta) * Bs[index];
+               sr += s[index] * y[index];
+            }
+            if (0. < sBs && 0. < sr) {
+               for (size_t row_index: Range(number_nonbasic_variables)) {
+                  for (size_t column_index: Range(number_nonbasic_variables)) {
+                     this->reduced_hessian[row_index * number_nonbasic_variables + column_index] += y[row_index] * y[column_index] / sr -
+                           Bs[row_index] * Bs[column_index] / sBs;
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   void ReducedQPSubproblem::save_iterate(const Iterate& current_iterate) {
+      for (size_t variable_index: Range(this->nonbasic_variables.size() + this->basis_factorization.get_basic_columns().size())) {
+         this->previous_primals[variable_index] = current_iterate.primals[variable_index];
+      }
+      std::copy(this->reduced_gradient.begin(), this->reduced_gradient.end(), this->previous_reduced_gradient.begin());
+      this->has_previous_iterate = true;
+   }
+
+   // active-set method with projected search for min g^T d + 1/2 d^T H d s.t. l <= d <= u with H positive definite
+   bool ReducedQPSubproblem::solve_bound_constrained_qp() {
+      const size_t dimension = this->nonbasic_variables.size();
+      const double tolerance = 1e-10;
+      // start from the projection of 0 onto the box
+      for (size_t index: Range(dimension)) {
+         this->reduced_direction[index] = std::min(std::max(0., this->reduced_lower_bounds[index]), this->reduced_upper_bounds[index]);
+         if (this->reduced_direction[index] == this->reduced_lower_bounds[index]) {
+            this->bound_status[index] = BoundStatus::AT_LOWER_BOUND;
+         }
+         else if (this->reduced_direction[index] == this->reduced_upper_bounds[index]) {
+            this->bound_status[index] = BoundStatus::AT_UPPER_BOUND;
+         }
+         else {
+            this->bound_status[index] = BoundStatus::FREE;
+         }
+      }
+
+      const size_t maximum_iterations = 10 * (dimension + 1);
+      for (size_t iteration = 0; iteration < maximum_iterations; iteration++) {
+         // Newton point in the subspace of the free variables: H_FF d_F = -(g_F + H_FA d_A)
+         this->free_variables.clear();
+         for (size_t index: Range(dimension)) {
+            if (this->bound_status[index] == BoundStatus::FREE) {
+               this->free_variables.emplace_back(index);
+            }
+         }
+         const size_t number_free_variables = this->free_variables.size();
+         this->dense_factor.resize(number_free_variables * number_free_variables);
+         this->free_direction.resize(number_free_variables);
+         for (size_t row: Range(number_free_variables)) {
+            const size_t row_index = this->free_variables[row];
+            double rhs = -this->reduced_gradient[row_index];
+            for (size_t column_index: Range(dimension)) {
+               if (this->bound_status[column_index] != BoundStatus::FREE) {
+                  rhs -= this->reduced_hessian[row_index * dimension + column_index] * this->reduced_direction[column_index];
+               }
+            }
+            this->free_direction[row] = rhs;
+            for (size_t column: Range(number_free_variables)) {
+               this->dense_factor[row * number_free_variables + column] = this->reduced_hessian[row_index * dimension + this->free_variables[column]];
+            }
+         }
+         if (not dense_cholesky_solve(this->dense_factor, number_free_variables, this->free_direction)) {
+            WARNING << "The reduced Hessian is not positive definite\n";
+            return false;
+         }
+
+         // projected search along the Newton displacement: several bounds may become active at once
+         const double current_objective = this->reduced_quadratic_model(this->reduced_direction);
+         bool new_active_bounds = false;
+         bool is_step_accepted = false;
+         for (double step_length = 1.; 1e-12 < step_length && not is_step_accepted; step_length /= 2.) {
+            this->trial_direction = this->reduced_direction;
+            new_active_bounds = false;
+            for (size_t row: Range(number_free_variables)) {
+               const size_t index = this->free_variables[row];
+               const double value = this->reduced_direction[index] + step_length * (this->free_direction[row] - this->reduced_direction[index]);
+               this->trial_direction[index] = std::min(std::max(value, this->reduced_lower_bounds[index]), this->reduced_upper_bounds[index]);
+               new_active_bounds = new_active_bounds || (this->trial_direction[index] != value);
+            }
+            // the unprojected Newton point minimizes the QP on the current face
+            is_step_accepted = not new_active_bounds || this->reduced_quadratic_model(this->trial_direction) < current_objective;
+         }
+         if (is_step_accepted) {
+            this->reduced_direction.swap(this->trial_direction);
+         }
+         else {
+            // degenerate case: move to the first blocking bound (ratio test)
+            double step_length = 1.;
+            for (size_t row: Range(number_free_variables)) {
+               const size_t index = this->free_variables[row];
+               const double displacement = this->free_direction[row] - this->reduced_direction[index];
+               if (displacement < 0.) {
+                  step_length = std::min(step_length, (this->reduced_lower_bounds[index] - this->reduced_direction[index]) / displacement);
+               }
+               else if (0. < displacement) {
+                  step_length = std::min(step_length, (this->reduced_upper_bounds[index] - this->reduced_direction[index]) / displacement);
+               }
+            }
+            for (size_t row: Range(number_free_variables)) {
+               const size_t index = this->free_variables[row];
+               const double value = this->reduced_direction[index] + step_length * (this->free_direction[row] - this->reduced_direction[index]);
+               this->reduced_direction[index] = std::min(std::max(value, this->reduced_lower_bounds[index]), this->reduced_upper_bounds[index]);
+            }
+            new_active_bounds = true;
+         }
+         if (new_active_bounds) {
+            for (size_t index: this->free_variables) {
+               if (this->reduced_direction[index] == this->reduced_lower_bounds[index]) {
+                  this->bound_status[index] = BoundStatus::AT_LOWER_BOUND;
+               }
+               else if (this->reduced_direction[index] == this->reduced_upper_bounds[index]) {
+                  this->bound_status[index] = BoundStatus::AT_UPPER_BOUND;
+               }
+            }
+            continue;
+         }
+
+         // QP gradient g + H d: release the active bounds with a negative multiplier
+         bool released_bounds = false;
+         for (size_t row_index: Range(dimension)) {
+            double gradient = this->reduced_gradient[row_index];
+            for (size_t column_index: Range(dimension)) {
+               gradient += this->reduced_hessian[row_index * dimension + column_index] * this->reduced_direction[column_index];
+            }
+            this->qp_gradient[row_index] = gradient;
+            const bool is_fixed = (this->reduced_lower_bounds[row_index] == this->reduced_upper_bounds[row_index]);
+            const double multiplier = (this->bound_status[row_index] == BoundStatus::AT_LOWER_BOUND) ? gradient :
+                  (this->bound_status[row_index] == BoundStatus::AT_UPPER_BOUND) ? -gradient : 0.;
+            if (not is_fixed && multiplier < -tolerance) {
+               this->bound_status[row_index] = BoundStatus::FREE;
+               released_bounds = true;
+            }
+         }
+         if (not released_bounds) {
+            return true;
+         }
+      }
+      WARNING << "The reduced bound-constrained QP reached the maximum number of iterations\n";
+      return false;
+   }
+
+   double ReducedQPSubproblem::reduced_quadratic_model(const std::vector<double>& x) const {
+      double objective = 0.;
+      for (size_t index: Range(x.size())) {
+         objective += this->reduced_gradient[index] * x[index];
+      }
+      return objective + 0.5 * this->reduced_quadratic_product(x);
+   }
+
+   double ReducedQPSubproblem::reduced_quadratic_product(const std::vector<double>& x) const {
+      const size_t dimension = this->nonbasic_variables.size();
+      double product = 0.;
+      for (size_t row_index: Range(dimension)) {
+         for (size_t column_index: Range(dimension)) {
+            product += x[row_index] * this->reduced_hessian[row_index * dimension + column_index] * x[column_index];
+         }
+      }
+      return product;
+   }
+} // namespace
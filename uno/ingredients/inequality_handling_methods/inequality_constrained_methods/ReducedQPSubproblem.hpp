@@ -0,0 +1,73 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REDUCEDQPSUBPROBLEM_H
+#define UNO_REDUCEDQPSUBPROBLEM_H
+
+#include <vector>
+#include "InequalityConstrainedMethod.hpp"
+#include "ingredients/subproblem_solvers/SparseLUFactorization.hpp"
+
+namespace uno {
+   // null-space (reduced-space) SQP subproblem for equality-constrained problems with bounds and few degrees of freedom.
+   // The variables are partitioned into basic and nonbasic variables with a sparse LU factorization of the Jacobian J = [B N].
+   // The QP is solved in the space of the nonbasic variables with a dense damped BFGS approximation of the reduced Hessian Z^T H Z:
+   //   d_B = -B^{-1} (c + N d_N) and min (g_N - N^T B^{-T} g_B)^T d_N + 1/2 d_N^T H_r d_N s.t. bounds on d_N.
+   // The LU factors are reused as long as the Jacobian is not reevaluated. The basic variables that would violate their bounds are
+   // moved out of the basis and the QP is solved again; if the bounds are still violated, the subproblem is declared infeasible.
+   class ReducedQPSubproblem : public InequalityConstrainedMethod {
+   public:
+      ReducedQPSubproblem(size_t number_variables, size_t number_constraints, const Options& options);
+
+      void generate_initial_iterate(const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            Direction& direction, WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+
+   private:
+      enum class BoundStatus {FREE, AT_LOWER_BOUND, AT_UPPER_BOUND};
+
+      const size_t maximum_degrees_of_freedom;
+      const size_t maximum_basis_repairs;
+      SparseLUFactorization basis_factorization;
+      bool is_basis_factorized{false};
+      std::vector<size_t> nonbasic_variables{};
+      std::vector<double> column_priorities{};
+
+      // dense reduced Hessian (row-major) and previous iterate for the BFGS update
+      std::vector<double> reduced_hessian{};
+      bool is_hessian_initial{true};
+      bool has_previous_iterate{false};
+      Vector<double> previous_primals{};
+      std::vector<double> previous_reduced_gradient{};
+
+      // reduced bound-constrained QP
+      std::vector<double> reduced_gradient{};
+      std::vector<double> reduced_direction{};
+      std::vector<double> reduced_lower_bounds{};
+      std::vector<double> reduced_upper_bounds{};
+      std::vector<double> qp_gradient{};
+      std::vector<BoundStatus> bound_status{};
+      std::vector<size_t> free_variables{};
+      std::vector<double> dense_factor{};
+      std::vector<double> free_direction{};
+      std::vector<double> trial_direction{};
+
+      // workspace
+      Vector<double> dense_objective_gradient;
+      Vector<double> constraint_workspace;
+      Vector<double> basic_workspace;
+
+      [[nodiscard]] bool update_basis(const OptimizationProblem& problem, const Iterate& current_iterate);
+      [[nodiscard]] bool factorize_basis(size_t number_variables, size_t number_constraints);
+      void restrict_reduced_hessian(const std::vector<size_t>& previous_nonbasic_variables, size_t number_variables);
+      void compute_reduced_gradient(size_t number_constraints, Vector<double>& constraint_multipliers);
+      void update_reduced_hessian(const Iterate& current_iterate);
+      void save_iterate(const Iterate& current_iterate);
+      [[nodiscard]] bool solve_bound_constrained_qp();
+      [[nodiscard]] double reduced_quadratic_model(const std::vector<double>& x) const;
+      [[nodiscard]] double reduced_quadratic_product(const std::vector<double>& x) const;
+   };
+} // namespace
+
+#endif // UNO_REDUCEDQPSUBPROBLEM_H
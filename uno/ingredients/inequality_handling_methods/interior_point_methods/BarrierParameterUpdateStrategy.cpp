@@ -64,6 +64,18 @@ namespace uno {
       return parameter_updated;
    }
 
+   // decrease the barrier parameter regardless of the primal-dual error. Returns false if the barrier parameter is already minimal
+   bool BarrierParameterUpdateStrategy::decrease_barrier_parameter() {
+      const double tolerance_fraction = this->tolerance / this->parameters.update_fraction;
+      if (this->barrier_parameter <= tolerance_fraction) {
+         return false;
+      }
+      this->barrier_parameter = std::max(tolerance_fraction, std::min(this->parameters.k_mu * this->barrier_parameter,
+            std::pow(this->barrier_parameter, this->parameters.theta_mu)));
+      DEBUG << "Barrier parameter mu decreased to " << this->barrier_parameter << '\n';
+      return true;
+   }
+
    double BarrierParameterUpdateStrategy::compute_shifted_complementarity_error(const OptimizationProblem& problem, const Vector<double>& primals,
          const Multipliers& multipliers, double shift_value) {
       const Range variables_range = Range(problem.number_variables);
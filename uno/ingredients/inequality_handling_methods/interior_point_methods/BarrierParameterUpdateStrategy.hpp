@@ -28,6 +28,7 @@ namespace uno {
       void set_barrier_parameter(double new_barrier_parameter);
       [[nodiscard]] bool update_barrier_parameter(const OptimizationProblem& problem, const Iterate& current_iterate, const Multipliers& current_multipliers,
             const DualResiduals& residuals);
+      [[nodiscard]] bool decrease_barrier_parameter();
 
    protected:
       double barrier_parameter;
@@ -8,6 +8,7 @@
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "linear_algebra/SparseStorageFactory.hpp"
+#include "linear_algebra/VectorPrinting.hpp"
 #include "optimization/Direction.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
@@ -18,7 +19,7 @@
 namespace uno {
    PrimalDualInteriorPointMethod::PrimalDualInteriorPointMethod(size_t number_variables, size_t number_constraints,
          size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options):
-         InequalityHandlingMethod("exact", number_variables, number_hessian_nonzeros, false, options),
+         InequalityHandlingMethod(options.get_string("hessian_model"), number_variables, number_hessian_nonzeros, false, options),
          objective_gradient(2 * number_variables), // original variables + barrier terms
          constraints(number_constraints),
          constraint_jacobian(number_constraints, number_variables),
@@ -43,10 +44,14 @@ namespace uno {
                options.get_double("barrier_k_sigma"),
                options.get_double("barrier_regularization_exponent"),
                options.get_double("barrier_small_direction_factor"),
+               options.get_double("barrier_tiny_step_infeasibility_tolerance"),
                options.get_double("barrier_push_variable_to_interior_k1"),
                options.get_double("barrier_push_variable_to_interior_k2")
          }),
          least_square_multiplier_max_norm(options.get_double("least_square_multiplier_max_norm")),
+         iterative_least_square_multipliers(options.get_string("least_square_multiplier_method") == "LSMR"),
+         least_square_multiplier_tolerance(options.get_double("least_square_multiplier_tolerance")),
+         least_square_multiplier_max_iterations(options.get_unsigned_int("least_square_multiplier_max_iterations")),
          damping_factor(options.get_double("barrier_damping_factor")),
          l1_constraint_violation_coefficient(options.get_double("l1_constraint_violation_coefficient")) {
    }
@@ -123,7 +128,7 @@ namespace uno {
    }
 
    void PrimalDualInteriorPointMethod::evaluate_functions(Statistics& statistics, const PrimalDualInteriorPointProblem& barrier_problem,
-         Iterate& current_iterate, const Multipliers& current_multipliers, const WarmstartInformation& warmstart_information) {
+         Iterate& current_iterate, const Multipliers& current_multipliers, WarmstartInformation& warmstart_information) {
       // barrier objective gradient
       if (warmstart_information.objective_changed) {
          barrier_problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
@@ -138,6 +143,10 @@ namespace uno {
       // barrier Lagrangian Hessian
       if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
          this->hessian_model->evaluate(statistics, barrier_problem, current_iterate.primals, current_multipliers.constraints, this->hessian);
+         // e.g. the hybrid Hessian model switched between the exact Hessian and the quasi-Newton approximation
+         if (this->hessian_model->sparsity_changed) {
+            warmstart_information.hessian_sparsity_changed = true;
+         }
       }
    }
 
@@ -171,6 +180,7 @@ namespace uno {
       this->augmented_system.solve(*this->linear_solver);
       assert(direction.status == SubproblemStatus::OPTIMAL && "The primal-dual perturbed subproblem was not solved to optimality");
       this->number_subproblems_solved++;
+      this->detect_tiny_step(problem, current_iterate, direction);
 
       this->assemble_primal_dual_direction(problem, current_iterate.primals, current_multipliers, direction.primals, direction.multipliers);
       direction.subproblem_objective = this->evaluate_subproblem_objective(direction);
@@ -184,6 +194,11 @@ namespace uno {
          const Multipliers& current_multipliers, WarmstartInformation& warmstart_information) {
       // assemble, factorize and regularize the augmented matrix
       this->augmented_system.assemble_matrix(this->hessian, this->constraint_jacobian, problem.number_variables, problem.number_constraints);
+      // the stage structure of the rows is needed by the structure-exploiting solvers before the symbolic analysis
+      if ((warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed) && 0 < problem.model.number_stages()) {
+         problem.get_stages(this->stages);
+         this->linear_solver->set_stages(this->stages);
+      }
       DEBUG << "Testing factorization with regularization factors (0, 0)\n";
       this->augmented_system.factorize_matrix(*this->linear_solver, warmstart_information);
       const double dual_regularization_parameter = std::pow(this->barrier_parameter(), this->parameters.regularization_exponent);
@@ -202,6 +217,7 @@ namespace uno {
    void PrimalDualInteriorPointMethod::initialize_feasibility_problem(const l1RelaxedProblem& /*problem*/, Iterate& current_iterate) {
       this->solving_feasibility_problem = true;
       this->first_feasibility_iteration = true;
+      this->previous_step_was_tiny = false;
       this->subproblem_definition_changed = true;
 
       // temporarily update the objective multiplier
@@ -255,6 +271,7 @@ namespace uno {
       assert(this->solving_feasibility_problem && "The barrier subproblem did not know it was solving the feasibility problem.");
       this->barrier_parameter_update_strategy.set_barrier_parameter(this->previous_barrier_parameter);
       this->solving_feasibility_problem = false;
+      this->previous_step_was_tiny = false;
       this->compute_least_square_multipliers(problem, trial_iterate, trial_iterate.multipliers.constraints);
    }
 
@@ -309,8 +326,17 @@ namespace uno {
 
    void PrimalDualInteriorPointMethod::update_barrier_parameter(const OptimizationProblem& problem, const Iterate& current_iterate,
          const Multipliers& current_multipliers, const DualResiduals& residuals) {
-      const bool barrier_parameter_updated = this->barrier_parameter_update_strategy.update_barrier_parameter(problem, current_iterate,
-            current_multipliers, residuals);
+      bool barrier_parameter_updated = false;
+      this->barrier_parameter_is_minimal = false;
+      if (this->previous_step_was_tiny) {
+         // the barrier problem cannot be solved more accurately: the barrier parameter is decreased regardless of the primal-dual error
+         barrier_parameter_updated = this->barrier_parameter_update_strategy.decrease_barrier_parameter();
+         this->barrier_parameter_is_minimal = not barrier_parameter_updated;
+      }
+      else {
+         barrier_parameter_updated = this->barrier_parameter_update_strategy.update_barrier_parameter(problem, current_iterate,
+               current_multipliers, residuals);
+      }
       // the barrier parameter may have been changed earlier when entering restoration
       this->subproblem_definition_changed = this->subproblem_definition_changed || barrier_parameter_updated;
    }
@@ -326,6 +352,20 @@ namespace uno {
       return (norm_inf(relative_direction_size) <= this->parameters.small_direction_factor * machine_epsilon);
    }
 
+   // a tiny step is taken without line search. A tiny step after a tiny step at the minimal barrier parameter means that no further
+   // progress can be made
+   void PrimalDualInteriorPointMethod::detect_tiny_step(const OptimizationProblem& problem, const Iterate& current_iterate,
+         Direction& direction) {
+      // the primal part of the solution of the augmented system (before the fraction-to-boundary rule)
+      direction.is_tiny_step = (current_iterate.progress.infeasibility <= this->parameters.tiny_step_infeasibility_tolerance) &&
+            this->is_small_step(problem, current_iterate.primals, this->augmented_system.solution);
+      direction.is_repeated_tiny_step = direction.is_tiny_step && this->previous_step_was_tiny && this->barrier_parameter_is_minimal;
+      if (direction.is_tiny_step) {
+         DEBUG << "This is a tiny step\n";
+      }
+      this->previous_step_was_tiny = direction.is_tiny_step;
+   }
+
    double PrimalDualInteriorPointMethod::evaluate_subproblem_objective(const Direction& direction) const {
       const double linear_term = dot(direction.primals, this->objective_gradient);
       const double quadratic_term = this->hessian.quadratic_product(direction.primals, direction.primals) / 2.;
@@ -411,12 +451,6 @@ namespace uno {
             problem.number_variables + problem.number_constraints);
       this->compute_bound_dual_direction(problem, current_primals, current_multipliers, direction_primals, direction_multipliers);
 
-      // determine if the direction is a "small direction" (Section 3.9 of the Ipopt paper) TODO
-      const bool is_small_step = PrimalDualInteriorPointMethod::is_small_step(problem, current_primals, direction_primals);
-      if (is_small_step) {
-         DEBUG << "This is a small step\n";
-      }
-
       // "fraction-to-boundary" rule for primal variables and constraints multipliers
       const double tau = std::max(this->parameters.tau_min, 1. - this->barrier_parameter());
       const double primal_step_length = PrimalDualInteriorPointMethod::primal_fraction_to_boundary(problem, current_primals, direction_primals, tau);
@@ -451,6 +485,13 @@ namespace uno {
 
    void PrimalDualInteriorPointMethod::compute_least_square_multipliers(const OptimizationProblem& problem, Iterate& iterate,
          Vector<double>& constraint_multipliers) {
+      if (this->iterative_least_square_multipliers) {
+         if (Preprocessing::compute_iterative_least_square_multipliers(problem.model, iterate, constraint_multipliers,
+               this->least_square_multiplier_max_norm, this->least_square_multiplier_tolerance, this->least_square_multiplier_max_iterations)) {
+            return;
+         }
+         DEBUG << "Falling back to the direct computation of the least-square multipliers\n";
+      }
       this->augmented_system.matrix.set_dimension(problem.number_variables + problem.number_constraints);
       this->augmented_system.matrix.reset();
       Preprocessing::compute_least_square_multipliers(problem.model, this->augmented_system.matrix, this->augmented_system.rhs, *this->linear_solver,
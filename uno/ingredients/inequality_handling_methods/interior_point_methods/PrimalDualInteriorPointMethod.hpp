@@ -20,6 +20,7 @@ namespace uno {
       double k_sigma;
       double regularization_exponent;
       double small_direction_factor;
+      double tiny_step_infeasibility_tolerance;
       double push_variable_to_interior_k1;
       double push_variable_to_interior_k2;
    };
@@ -56,25 +57,33 @@ namespace uno {
 
       SymmetricIndefiniteLinearSystem<double> augmented_system;
       const std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> linear_solver;
+      std::vector<size_t> stages{}; /*!< Stage of each row of the augmented system (multistage problems) */
 
       BarrierParameterUpdateStrategy barrier_parameter_update_strategy;
       double previous_barrier_parameter;
       const double default_multiplier;
       const InteriorPointParameters parameters;
       const double least_square_multiplier_max_norm;
+      const bool iterative_least_square_multipliers;
+      const double least_square_multiplier_tolerance;
+      const size_t least_square_multiplier_max_iterations;
       const double damping_factor; // (Section 3.7 in IPOPT paper)
       const double l1_constraint_violation_coefficient; // (rho in Section 3.3.1 in IPOPT paper)
 
       bool solving_feasibility_problem{false};
       bool first_feasibility_iteration{false};
+      // tiny steps (Section 3.9 of the Ipopt paper)
+      bool previous_step_was_tiny{false};
+      bool barrier_parameter_is_minimal{false};
 
       [[nodiscard]] double barrier_parameter() const;
       [[nodiscard]] double push_variable_to_interior(double variable_value, double lower_bound, double upper_bound) const;
       void evaluate_functions(Statistics& statistics, const PrimalDualInteriorPointProblem& barrier_problem, Iterate& current_iterate,
-            const Multipliers& current_multipliers, const WarmstartInformation& warmstart_information);
+            const Multipliers& current_multipliers, WarmstartInformation& warmstart_information);
       void update_barrier_parameter(const OptimizationProblem& problem, const Iterate& current_iterate, const Multipliers& current_multipliers,
             const DualResiduals& residuals);
       [[nodiscard]] bool is_small_step(const OptimizationProblem& problem, const Vector<double>& current_primals, const Vector<double>& direction_primals) const;
+      void detect_tiny_step(const OptimizationProblem& problem, const Iterate& current_iterate, Direction& direction);
       [[nodiscard]] double evaluate_subproblem_objective(const Direction& direction) const;
       [[nodiscard]] double compute_barrier_term_directional_derivative(const Model& model, const Iterate& current_iterate,
             const Vector<double>& primal_direction) const;
@@ -52,8 +52,15 @@ namespace uno {
          SymmetricMatrix<size_t, double>& hessian) const {
       // original Lagrangian Hessian
       this->problem.evaluate_lagrangian_hessian(x, multipliers, hessian);
+      this->add_barrier_hessian_terms(x, hessian);
+   }
 
-      // barrier terms
+   void PrimalDualInteriorPointProblem::add_problem_hessian_terms(const Vector<double>& x, SymmetricMatrix<size_t, double>& hessian) const {
+      this->problem.add_problem_hessian_terms(x, hessian);
+      this->add_barrier_hessian_terms(x, hessian);
+   }
+
+   void PrimalDualInteriorPointProblem::add_barrier_hessian_terms(const Vector<double>& x, SymmetricMatrix<size_t, double>& hessian) const {
       for (size_t variable_index: Range(this->problem.number_variables)) {
          double diagonal_barrier_term = 0.;
          if (is_finite(this->problem.variable_lower_bound(variable_index))) { // lower bounded
@@ -18,6 +18,7 @@ namespace uno {
       void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const override;
+      void add_problem_hessian_terms(const Vector<double>& x, SymmetricMatrix<size_t, double>& hessian) const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -42,6 +43,8 @@ namespace uno {
       const Multipliers& current_multipliers;
       const double barrier_parameter;
       const double damping_factor{1e-5};
+
+      void add_barrier_hessian_terms(const Vector<double>& x, SymmetricMatrix<size_t, double>& hessian) const;
    };
 } // namespace
 
@@ -12,6 +12,7 @@
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
 #include "tools/Infinity.hpp"
+#include "tools/IntegerCast.hpp"
 #include "tools/Logger.hpp"
 #include "fortran_interface.h"
 
@@ -20,12 +21,14 @@
 #define BQPD FC_GLOBAL(bqpd, BQPD)
 #define hessian_vector_product FC_GLOBAL(gdotx, GDOTX)
 
+using uno::bqpd_int;
+
 extern "C" {
-   void hessian_vector_product(int *n, const double x[], const double ws[], const int lws[], double v[]);
+   void hessian_vector_product(bqpd_int *n, const double x[], const double ws[], const bqpd_int lws[], double v[]);
 
    // fortran common block used in bqpd/bqpd.f
    extern struct {
-      int kk, ll, kkk, lll, mxws, mxlws;
+      bqpd_int kk, ll, kkk, lll, mxws, mxlws;
    } WSC;
 
    // fortran common for inertia correction in wdotd
@@ -34,9 +37,9 @@ extern "C" {
    } ALPHAC;
 
    extern void
-   BQPD(const int* n, const int* m, int* k, int* kmax, double* a, int* la, double* x, double* bl, double* bu, double* f, double* fmin, double* g,
-         double* r, double* w, double* e, int* ls, double* alp, int* lp, int* mlp, int* peq, double* ws, int* lws, const int* mode, int* ifail,
-         int* info, int* iprint, int* nout);
+   BQPD(const bqpd_int* n, const bqpd_int* m, bqpd_int* k, bqpd_int* kmax, double* a, bqpd_int* la, double* x, double* bl, double* bu, double* f,
+         double* fmin, double* g, double* r, double* w, double* e, bqpd_int* ls, double* alp, bqpd_int* lp, bqpd_int* mlp, bqpd_int* peq,
+         double* ws, bqpd_int* lws, const bqpd_int* mode, bqpd_int* ifail, bqpd_int* info, bqpd_int* iprint, bqpd_int* nout);
 }
 
 namespace uno {
@@ -68,9 +71,14 @@ namespace uno {
          workspace_sparsity(this->size_hessian_sparsity_workspace),
          current_hessian_indices(number_variables),
          print_subproblem(options.get_bool("print_subproblem")) {
+      // the sizes passed to BQPD must fit in its integer type
+      checked_integer_cast<bqpd_int>(number_variables + number_constraints, "BQPD: the number of variables and constraints");
+      checked_integer_cast<bqpd_int>(this->bqpd_jacobian_sparsity.size(), "BQPD: the length of the Jacobian sparsity");
+      checked_integer_cast<bqpd_int>(this->size_hessian_workspace, "BQPD: the length of the real workspace");
+      checked_integer_cast<bqpd_int>(this->size_hessian_sparsity_workspace, "BQPD: the length of the integer workspace");
       // default active set
       for (size_t variable_index: Range(number_variables + number_constraints)) {
-         this->active_set[variable_index] = static_cast<int>(variable_index) + this->fortran_shift;
+         this->active_set[variable_index] = static_cast<bqpd_int>(variable_index) + this->fortran_shift;
       }
    }
 
@@ -106,8 +114,8 @@ namespace uno {
          const WarmstartInformation& warmstart_information) {
       // initialize wsc_ common block (Hessian & workspace for BQPD)
       // setting the common block here ensures that several instances of BQPD can run simultaneously
-      WSC.mxws = static_cast<int>(this->size_hessian_workspace);
-      WSC.mxlws = static_cast<int>(this->size_hessian_sparsity_workspace);
+      WSC.mxws = static_cast<bqpd_int>(this->size_hessian_workspace);
+      WSC.mxlws = static_cast<bqpd_int>(this->size_hessian_sparsity_workspace);
       ALPHAC.alpha = 0; // inertia control
 
       // function evaluations
@@ -173,11 +181,11 @@ namespace uno {
       }
 
       direction.primals = initial_point;
-      const int n = static_cast<int>(problem.number_variables);
-      const int m = static_cast<int>(problem.number_constraints);
+      const bqpd_int n = static_cast<bqpd_int>(problem.number_variables);
+      const bqpd_int m = static_cast<bqpd_int>(problem.number_constraints);
 
       const BQPDMode mode = BQPDSolver::determine_mode(warmstart_information);
-      const int mode_integer = static_cast<int>(mode);
+      const bqpd_int mode_integer = static_cast<bqpd_int>(mode);
 
       // solve the LP/QP
       DEBUG2 << "Running BQPD\n";
@@ -216,10 +224,10 @@ namespace uno {
    void BQPDSolver::save_hessian_to_local_format() {
       const size_t header_size = 1;
       // pointers withing the single array
-      int* row_indices = &this->workspace_sparsity[header_size];
-      int* column_starts = &this->workspace_sparsity[header_size + this->hessian.number_nonzeros()];
+      bqpd_int* row_indices = &this->workspace_sparsity[header_size];
+      bqpd_int* column_starts = &this->workspace_sparsity[header_size + this->hessian.number_nonzeros()];
       // header
-      this->workspace_sparsity[0] = static_cast<int>(this->hessian.number_nonzeros() + 1);
+      this->workspace_sparsity[0] = static_cast<bqpd_int>(this->hessian.number_nonzeros() + 1);
       // count the elements in each column
       for (size_t column_index: Range(this->hessian.dimension() + 1)) {
          column_starts[column_index] = 0;
@@ -241,39 +249,39 @@ namespace uno {
          assert(index <= static_cast<size_t>(column_starts[column_index + 1]) &&
                 "BQPD: error in converting the Hessian matrix to the local format. Try setting the sparse format to CSC");
          this->workspace[index] = element;
-         row_indices[index] = static_cast<int>(row_index) + this->fortran_shift;
+         row_indices[index] = static_cast<bqpd_int>(row_index) + this->fortran_shift;
          this->current_hessian_indices[column_index]++;
       }
-      WSC.kk = static_cast<int>(this->hessian.number_nonzeros()); // length of ws that is used by gdotx
-      WSC.ll = static_cast<int>(this->hessian.number_nonzeros() + this->hessian.dimension() + 2); // length of lws that is used by gdotx
+      WSC.kk = static_cast<bqpd_int>(this->hessian.number_nonzeros()); // length of ws that is used by gdotx
+      WSC.ll = static_cast<bqpd_int>(this->hessian.number_nonzeros() + this->hessian.dimension() + 2); // length of lws that is used by gdotx
    }
 
    void BQPDSolver::save_gradients_to_local_format(size_t number_constraints) {
       size_t current_index = 0;
       for (const auto [variable_index, derivative]: this->linear_objective) {
          this->bqpd_jacobian[current_index] = derivative;
-         this->bqpd_jacobian_sparsity[current_index + 1] = static_cast<int>(variable_index) + this->fortran_shift;
+         this->bqpd_jacobian_sparsity[current_index + 1] = static_cast<bqpd_int>(variable_index) + this->fortran_shift;
          current_index++;
       }
       for (size_t constraint_index: Range(number_constraints)) {
          for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
             this->bqpd_jacobian[current_index] = derivative;
-            this->bqpd_jacobian_sparsity[current_index + 1] = static_cast<int>(variable_index) + this->fortran_shift;
+            this->bqpd_jacobian_sparsity[current_index + 1] = static_cast<bqpd_int>(variable_index) + this->fortran_shift;
             current_index++;
          }
       }
       current_index++;
-      this->bqpd_jacobian_sparsity[0] = static_cast<int>(current_index);
+      this->bqpd_jacobian_sparsity[0] = static_cast<bqpd_int>(current_index);
       // header
       size_t size = 1;
-      this->bqpd_jacobian_sparsity[current_index] = static_cast<int>(size);
+      this->bqpd_jacobian_sparsity[current_index] = static_cast<bqpd_int>(size);
       current_index++;
       size += this->linear_objective.size();
-      this->bqpd_jacobian_sparsity[current_index] = static_cast<int>(size);
+      this->bqpd_jacobian_sparsity[current_index] = static_cast<bqpd_int>(size);
       current_index++;
       for (size_t constraint_index: Range(number_constraints)) {
          size += this->constraint_jacobian[constraint_index].size();
-         this->bqpd_jacobian_sparsity[current_index] = static_cast<int>(size);
+         this->bqpd_jacobian_sparsity[current_index] = static_cast<bqpd_int>(size);
          current_index++;
       }
    }
@@ -307,7 +315,7 @@ namespace uno {
       }
    }
 
-   BQPDStatus BQPDSolver::bqpd_status_from_int(int ifail) {
+   BQPDStatus BQPDSolver::bqpd_status_from_int(bqpd_int ifail) {
       assert(0 <= ifail && ifail <= 9 && "BQPDSolver.bqpd_status_from_int: ifail does not belong to [0, 9]");
       return static_cast<BQPDStatus>(ifail);
    }
@@ -347,17 +355,17 @@ namespace uno {
    }
 } // namespace
 
-void hessian_vector_product(int *n, const double x[], const double ws[], const int lws[], double v[]) {
+void hessian_vector_product(bqpd_int *n, const double x[], const double ws[], const bqpd_int lws[], double v[]) {
    assert(n != nullptr && "BQPDSolver::hessian_vector_product: the dimension n passed by pointer is NULL");
 
    for (size_t i = 0; i < static_cast<size_t>(*n); i++) {
       v[i] = 0.;
    }
 
-   int footer_start = lws[0];
-   for (int i = 0; i < *n; i++) {
-      for (int k = lws[footer_start + i]; k < lws[footer_start + i + 1]; k++) {
-         int j = lws[k] - 1;
+   bqpd_int footer_start = lws[0];
+   for (bqpd_int i = 0; i < *n; i++) {
+      for (bqpd_int k = lws[footer_start + i]; k < lws[footer_start + i + 1]; k++) {
+         bqpd_int j = lws[k] - 1;
          v[i] += ws[k - 1] * x[j];
          if (j != i) {
             // off-diagonal term
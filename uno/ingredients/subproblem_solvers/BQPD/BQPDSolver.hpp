@@ -5,6 +5,7 @@
 #define UNO_BQPDSOLVER_H
 
 #include <array>
+#include <cstdint>
 #include <vector>
 #include "ingredients/subproblem_solvers/SubproblemStatus.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
@@ -12,6 +13,7 @@
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "ingredients/subproblem_solvers/QPSolver.hpp"
+#include "tools/HugePageAllocator.hpp"
 
 namespace uno {
    // forward declarations
@@ -20,6 +22,13 @@ namespace uno {
    template <typename IndexType, typename ElementType>
    class SymmetricMatrix;
 
+   // integer type of the BQPD Fortran interface (64-bit if BQPD was compiled with 64-bit default integers)
+#ifdef BQPD_INT64
+   using bqpd_int = std::int64_t;
+#else
+   using bqpd_int = int;
+#endif
+
    // see bqpd.f
    enum class BQPDStatus {
       OPTIMAL = 0,
@@ -66,26 +75,26 @@ namespace uno {
       SparseVector<double> linear_objective;
       RectangularMatrix<double> constraint_jacobian;
       std::vector<double> bqpd_jacobian{};
-      std::vector<int> bqpd_jacobian_sparsity{};
+      std::vector<bqpd_int> bqpd_jacobian_sparsity{};
       SymmetricMatrix<size_t, double> hessian;
 
-      int kmax{0}, mlp{1000};
+      bqpd_int kmax{0}, mlp{1000};
       size_t mxwk0{2000000}, mxiwk0{500000};
-      std::array<int, 100> info{};
+      std::array<bqpd_int, 100> info{};
       std::vector<double> alp{};
-      std::vector<int> lp{}, active_set{};
+      std::vector<bqpd_int> lp{}, active_set{};
       std::vector<double> w{}, gradient_solution{}, residuals{}, e{};
       size_t size_hessian_sparsity{};
       size_t size_hessian_workspace{};
       size_t size_hessian_sparsity_workspace{};
-      std::vector<double> workspace{};
-      std::vector<int> workspace_sparsity{};
-      int k{0};
-      int iprint{0}, nout{6};
+      HugePageVector<double> workspace{};
+      HugePageVector<bqpd_int> workspace_sparsity{};
+      bqpd_int k{0};
+      bqpd_int iprint{0}, nout{6};
       double fmin{-1e20};
-      int peq_solution{0}, ifail{0};
-      const int fortran_shift{1};
-      Vector<int> current_hessian_indices{};
+      bqpd_int peq_solution{0}, ifail{0};
+      const bqpd_int fortran_shift{1};
+      Vector<bqpd_int> current_hessian_indices{};
 
       const bool print_subproblem;
 
@@ -97,7 +106,7 @@ namespace uno {
       void save_hessian_to_local_format();
       void save_gradients_to_local_format(size_t number_constraints);
       void set_multipliers(size_t number_variables, Multipliers& direction_multipliers);
-      static BQPDStatus bqpd_status_from_int(int ifail);
+      static BQPDStatus bqpd_status_from_int(bqpd_int ifail);
       static SubproblemStatus status_from_bqpd_status(BQPDStatus bqpd_status);
    };
 } // namespace
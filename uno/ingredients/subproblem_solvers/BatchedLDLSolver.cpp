@@ -0,0 +1,336 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include "BatchedLDLSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   namespace {
+      // batch and lane of the calling thread
+      struct LaneMembership {
+         FactorizationBatch* batch{nullptr};
+         size_t lane{0};
+         size_t number_created_solvers{0};
+      };
+      thread_local LaneMembership membership{};
+   } // namespace
+
+   BatchedLDLFactorization::BatchedLDLFactorization(size_t dimension, size_t number_nonzeros, size_t number_lanes):
+         SparseSymbolicFactorization(dimension, number_nonzeros),
+         number_lanes(number_lanes),
+         pivots(number_lanes),
+         row_entries(number_lanes),
+         number_positive_pivots(number_lanes),
+         number_negative_pivots(number_lanes),
+         number_zero_pivots(number_lanes) {
+   }
+
+   bool BatchedLDLFactorization::is_analyzed() const {
+      return this->analyzed;
+   }
+
+   bool BatchedLDLFactorization::has_same_sparsity(const SymmetricMatrix<size_t, double>& matrix) const {
+      return not this->sparsity_changed(matrix, matrix.dimension());
+   }
+
+   void BatchedLDLFactorization::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
+      SparseSymbolicFactorization::do_symbolic_analysis(matrix, matrix.dimension());
+      this->batch_permuted_entries.assign(this->permuted_row_indices.size() * this->number_lanes, 0.);
+      this->batch_factor_entries.assign(this->factor_row_indices.size() * this->number_lanes, 0.);
+      this->batch_workspace.assign(this->factorized_dimension * this->number_lanes, 0.);
+      this->analyzed = true;
+   }
+
+   void BatchedLDLFactorization::set_entries(size_t lane, const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.number_nonzeros() == this->permuted_position.size() && "BatchedLDLFactorization: the symbolic analysis is out of date");
+      for (size_t position: Range(this->permuted_row_indices.size())) {
+         this->batch_permuted_entries[position * this->number_lanes + lane] = 0.;
+      }
+      size_t nonzero_index = 0;
+      for (const auto [row_index, column_index, entry]: matrix) {
+         const size_t position = this->permuted_position[nonzero_index];
+         if (position != NO_INDEX) {
+            this->batch_permuted_entries[position * this->number_lanes + lane] += entry;
+         }
+         nonzero_index++;
+      }
+   }
+
+   // same up-looking factorization as QuasidefiniteLDLSolver, with the lanes in the innermost loops
+   void BatchedLDLFactorization::do_numerical_factorization() {
+      const size_t lanes = this->number_lanes;
+      double* workspace = this->batch_workspace.data();
+      double* factor = this->batch_factor_entries.data();
+      const double* entries = this->batch_permuted_entries.data();
+      double* pivot = this->pivots.data();
+      double* row_entry = this->row_entries.data();
+
+      std::copy(this->factor_column_starts.begin(), this->factor_column_starts.begin() + static_cast<std::ptrdiff_t>(this->factorized_dimension),
+            this->next_position.begin());
+      std::fill(this->marker.begin(), this->marker.end(), NO_INDEX);
+      std::fill(this->number_positive_pivots.begin(), this->number_positive_pivots.end(), 0);
+      std::fill(this->number_negative_pivots.begin(), this->number_negative_pivots.end(), 0);
+      std::fill(this->number_zero_pivots.begin(), this->number_zero_pivots.end(), 0);
+      for (size_t k: Range(this->factorized_dimension)) {
+         const size_t top = this->compute_row_pattern(k);
+         // scatter the k-th column of the upper triangular part
+         for (size_t position: Range(this->permuted_column_starts[k], this->permuted_column_starts[k + 1])) {
+            double* workspace_row = workspace + this->permuted_row_indices[position] * lanes;
+            const double* entries_position = entries + position * lanes;
+            for (size_t lane = 0; lane < lanes; lane++) {
+               workspace_row[lane] += entries_position[lane];
+            }
+         }
+         double* workspace_k = workspace + k * lanes;
+         for (size_t lane = 0; lane < lanes; lane++) {
+            pivot[lane] = workspace_k[lane];
+            workspace_k[lane] = 0.;
+         }
+         // sparse triangular solve with the rows of the pattern (in topological order)
+         for (size_t pattern_index: Range(top, this->factorized_dimension)) {
+            const size_t row_index = this->row_pattern[pattern_index];
+            double* workspace_row = workspace + row_index * lanes;
+            for (size_t lane = 0; lane < lanes; lane++) {
+               row_entry[lane] = workspace_row[lane];
+               workspace_row[lane] = 0.;
+            }
+            for (size_t position: Range(this->factor_column_starts[row_index] + 1, this->next_position[row_index])) {
+               double* workspace_target = workspace + this->factor_row_indices[position] * lanes;
+               const double* factor_position = factor + position * lanes;
+               for (size_t lane = 0; lane < lanes; lane++) {
+                  workspace_target[lane] -= factor_position[lane] * row_entry[lane];
+               }
+            }
+            const double* diagonal = factor + this->factor_column_starts[row_index] * lanes;
+            const size_t position = this->next_position[row_index]++;
+            this->factor_row_indices[position] = k;
+            double* factor_position = factor + position * lanes;
+            for (size_t lane = 0; lane < lanes; lane++) {
+               const double factor_entry = row_entry[lane] / diagonal[lane];
+               pivot[lane] -= factor_entry * row_entry[lane];
+               factor_position[lane] = factor_entry;
+            }
+         }
+         // static pivoting: a tiny pivot is replaced by a static pivot of the same sign
+         for (size_t lane = 0; lane < lanes; lane++) {
+            if (std::abs(pivot[lane]) <= BatchedLDLFactorization::zero_pivot_tolerance) {
+               this->number_zero_pivots[lane]++;
+               pivot[lane] = (pivot[lane] < 0.) ? -BatchedLDLFactorization::static_pivot : BatchedLDLFactorization::static_pivot;
+            }
+            else if (0. < pivot[lane]) {
+               this->number_positive_pivots[lane]++;
+            }
+            else {
+               this->number_negative_pivots[lane]++;
+            }
+         }
+         const size_t position = this->next_position[k]++;
+         this->factor_row_indices[position] = k;
+         std::copy(pivot, pivot + lanes, factor + position * lanes);
+      }
+   }
+
+   void BatchedLDLFactorization::solve_indefinite_system(size_t lane, const Vector<double>& rhs, Vector<double>& result,
+         std::vector<double>& workspace) const {
+      const size_t lanes = this->number_lanes;
+      workspace.resize(this->factorized_dimension);
+      // permute the right-hand side
+      for (size_t index: Range(this->factorized_dimension)) {
+         workspace[index] = rhs[this->permutation[index]];
+      }
+      // forward substitution with L (unit diagonal)
+      for (size_t column_index: Range(this->factorized_dimension)) {
+         for (size_t position: Range(this->factor_column_starts[column_index] + 1, this->factor_column_starts[column_index + 1])) {
+            workspace[this->factor_row_indices[position]] -= this->batch_factor_entries[position * lanes + lane] * workspace[column_index];
+         }
+      }
+      // diagonal solve with D
+      for (size_t index: Range(this->factorized_dimension)) {
+         workspace[index] /= this->batch_factor_entries[this->factor_column_starts[index] * lanes + lane];
+      }
+      // backward substitution with L^T
+      for (size_t column_index = this->factorized_dimension; column_index-- > 0;) {
+         for (size_t position: Range(this->factor_column_starts[column_index] + 1, this->factor_column_starts[column_index + 1])) {
+            workspace[column_index] -= this->batch_factor_entries[position * lanes + lane] * workspace[this->factor_row_indices[position]];
+         }
+      }
+      // permute back the solution
+      for (size_t index: Range(this->factorized_dimension)) {
+         result[this->permutation[index]] = workspace[index];
+      }
+   }
+
+   std::tuple<size_t, size_t, size_t> BatchedLDLFactorization::get_inertia(size_t lane) const {
+      return std::make_tuple(this->number_positive_pivots[lane], this->number_negative_pivots[lane], this->number_zero_pivots[lane]);
+   }
+
+   // FactorizationBatch
+   FactorizationBatch::FactorizationBatch(size_t number_lanes):
+         number_lanes(number_lanes),
+         number_active_lanes(number_lanes),
+         requests(number_lanes, FactorizationRequest{0, nullptr, false}),
+         factorized_in_batch(number_lanes, false) {
+   }
+
+   FactorizationBatch::Membership::Membership(FactorizationBatch& batch, size_t lane) {
+      assert(lane < batch.number_lanes && "FactorizationBatch: the lane does not exist");
+      membership = LaneMembership{&batch, lane, 0};
+   }
+
+   FactorizationBatch::Membership::~Membership() {
+      membership.batch->leave();
+      membership = LaneMembership{};
+   }
+
+   std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> FactorizationBatch::create_solver(size_t dimension,
+         size_t number_nonzeros) {
+      if (membership.batch == nullptr) {
+         throw std::invalid_argument("The linear solver batched_LDL is only available in a batched solve");
+      }
+      const size_t group_index = membership.number_created_solvers++;
+      BatchedLDLFactorization& group = membership.batch->join_group(group_index, dimension, number_nonzeros);
+      return std::make_unique<BatchedLDLSolver>(*membership.batch, group, group_index, membership.lane, dimension, number_nonzeros);
+   }
+
+   // a lane that requests a factorization waits until all the active lanes have requested one. Returns false if the sparsity
+   // pattern of the matrix differs from that of the group (the matrix was not factorized)
+   bool FactorizationBatch::factorize(size_t group_index, size_t lane, const SymmetricMatrix<size_t, double>& matrix, bool analysis_requested) {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->requests[lane] = FactorizationRequest{group_index, &matrix, analysis_requested};
+      this->factorized_in_batch[lane] = false;
+      this->number_waiting_lanes++;
+      if (this->number_waiting_lanes == this->number_active_lanes) {
+         this->factorize_requested_matrices();
+      }
+      else {
+         const size_t current_generation = this->generation;
+         this->condition.wait(lock, [&]() {
+            return this->generation != current_generation;
+         });
+      }
+      return this->factorized_in_batch[lane];
+   }
+
+   size_t FactorizationBatch::number_batched_factorizations() const {
+      return this->batched_factorizations;
+   }
+
+   // the k-th solver created by each lane belongs to the k-th group
+   BatchedLDLFactorization& FactorizationBatch::join_group(size_t group_index, size_t dimension, size_t number_nonzeros) {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (group_index == this->groups.size()) {
+         this->groups.emplace_back(std::make_unique<BatchedLDLFactorization>(dimension, number_nonzeros, this->number_lanes));
+      }
+      return *this->groups[group_index];
+   }
+
+   void FactorizationBatch::leave() {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->number_active_lanes--;
+      // the remaining lanes may all be waiting
+      if (0 < this->number_waiting_lanes && this->number_waiting_lanes == this->number_active_lanes) {
+         this->factorize_requested_matrices();
+      }
+   }
+
+   // called with the mutex held, while all active lanes wait
+   void FactorizationBatch::factorize_requested_matrices() {
+      for (size_t group_index: Range(this->groups.size())) {
+         BatchedLDLFactorization& group = *this->groups[group_index];
+         bool is_group_requested = false;
+         for (size_t lane: Range(this->number_lanes)) {
+            const FactorizationRequest& request = this->requests[lane];
+            if (request.matrix == nullptr || request.group_index != group_index) {
+               continue;
+            }
+            // the first matrix with a new sparsity pattern determines the symbolic analysis of the group
+            if (not group.is_analyzed() || (not is_group_requested && request.analysis_requested && not group.has_same_sparsity(*request.matrix))) {
+               group.do_symbolic_analysis(*request.matrix);
+            }
+            // a matrix with a different sparsity pattern is factorized sequentially by its lane
+            else if (not group.has_same_sparsity(*request.matrix)) {
+               continue;
+            }
+            group.set_entries(lane, *request.matrix);
+            this->factorized_in_batch[lane] = true;
+            is_group_requested = true;
+         }
+         // all the lanes are factorized at once (the lanes without request keep their previous factors)
+         if (is_group_requested) {
+            group.do_numerical_factorization();
+            this->batched_factorizations++;
+         }
+      }
+      std::fill(this->requests.begin(), this->requests.end(), FactorizationRequest{0, nullptr, false});
+      this->number_waiting_lanes = 0;
+      this->generation++;
+      this->condition.notify_all();
+   }
+
+   // BatchedLDLSolver
+   BatchedLDLSolver::BatchedLDLSolver(FactorizationBatch& batch, const BatchedLDLFactorization& group, size_t group_index, size_t lane,
+         size_t dimension, size_t number_nonzeros):
+         DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension),
+         batch(batch), group(group), group_index(group_index), lane(lane), number_nonzeros(number_nonzeros), workspace(dimension) {
+   }
+
+   // the symbolic analysis is shared by the lanes and performed by the batch
+   void BatchedLDLSolver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& /*matrix*/) {
+      this->analysis_requested = true;
+      this->sequential_analysis_required = true;
+   }
+
+   void BatchedLDLSolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "BatchedLDLSolver: the dimension of the matrix is larger than the preallocated size");
+      this->factorized_sequentially = not this->batch.factorize(this->group_index, this->lane, matrix, this->analysis_requested);
+      this->analysis_requested = false;
+      // the sparsity pattern of the matrix differs from that of the other lanes
+      if (this->factorized_sequentially) {
+         if (this->sequential_solver == nullptr) {
+            this->sequential_solver = std::make_unique<QuasidefiniteLDLSolver>(this->dimension, this->number_nonzeros);
+         }
+         if (this->sequential_analysis_required) {
+            this->sequential_solver->do_symbolic_analysis(matrix);
+            this->sequential_analysis_required = false;
+         }
+         this->sequential_solver->do_numerical_factorization(matrix);
+      }
+   }
+
+   void BatchedLDLSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs,
+         Vector<double>& result) {
+      if (this->factorized_sequentially) {
+         this->sequential_solver->solve_indefinite_system(matrix, rhs, result);
+      }
+      else {
+         this->group.solve_indefinite_system(this->lane, rhs, result, this->workspace);
+      }
+   }
+
+   std::tuple<size_t, size_t, size_t> BatchedLDLSolver::get_inertia() const {
+      return this->factorized_sequentially ? this->sequential_solver->get_inertia() : this->group.get_inertia(this->lane);
+   }
+
+   size_t BatchedLDLSolver::number_negative_eigenvalues() const {
+      return std::get<1>(this->get_inertia());
+   }
+
+   bool BatchedLDLSolver::matrix_is_singular() const {
+      return (0 < std::get<2>(this->get_inertia()));
+   }
+
+   size_t BatchedLDLSolver::rank() const {
+      const auto [number_positive_pivots, number_negative_pivots, number_zero_pivots] = this->get_inertia();
+      return number_positive_pivots + number_negative_pivots;
+   }
+
+   bool BatchedLDLSolver::requires_quasidefinite_matrix() const {
+      return true;
+   }
+} // namespace
@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BATCHEDLDLSOLVER_H
+#define UNO_BATCHEDLDLSOLVER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "QuasidefiniteLDLSolver.hpp"
+#include "SparseSymbolicFactorization.hpp"
+
+namespace uno {
+   /*! \class BatchedLDLFactorization
+    * \brief Static-pivot LDL^T factorizations of a batch of quasidefinite matrices with the same sparsity pattern
+    *
+    *  The symbolic analysis is performed once. The numerical values are stored in a structure-of-arrays layout (the values of a nonzero
+    *  for all lanes are contiguous): since static pivoting does not depend on the values, the factorization follows the same path for
+    *  all lanes and the innermost loops run over the lanes.
+    */
+   class BatchedLDLFactorization: protected SparseSymbolicFactorization {
+   public:
+      BatchedLDLFactorization(size_t dimension, size_t number_nonzeros, size_t number_lanes);
+
+      [[nodiscard]] bool is_analyzed() const;
+      [[nodiscard]] bool has_same_sparsity(const SymmetricMatrix<size_t, double>& matrix) const;
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix);
+      void set_entries(size_t lane, const SymmetricMatrix<size_t, double>& matrix);
+      void do_numerical_factorization();
+      void solve_indefinite_system(size_t lane, const Vector<double>& rhs, Vector<double>& result, std::vector<double>& workspace) const;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia(size_t lane) const;
+
+   protected:
+      const size_t number_lanes;
+      bool analyzed{false};
+      // values in structure-of-arrays layout: entry (position, lane) is stored at position * number_lanes + lane
+      HugePageVector<double> batch_permuted_entries{};
+      HugePageVector<double> batch_factor_entries{};
+      std::vector<double> batch_workspace{};
+      std::vector<double> pivots;
+      std::vector<double> row_entries;
+      std::vector<size_t> number_positive_pivots;
+      std::vector<size_t> number_negative_pivots;
+      std::vector<size_t> number_zero_pivots;
+      static constexpr double zero_pivot_tolerance{1e-14};
+      static constexpr double static_pivot{1e-8};
+   };
+
+   /*! \class FactorizationBatch
+    * \brief Rendezvous of the linear solvers of instances solved in lockstep, one instance per thread (lane)
+    *
+    *  A lane that requests a factorization waits until all the active lanes have requested one, then the matrices are factorized
+    *  together: the k-th linear solver created by each lane belongs to the k-th group of batched factorizations. A lane leaves the
+    *  batch when its instance terminates. A matrix whose sparsity pattern differs from that of its group is factorized sequentially.
+    */
+   class FactorizationBatch {
+   public:
+      explicit FactorizationBatch(size_t number_lanes);
+
+      // membership of the calling thread (RAII): the linear solvers created by the thread join the batch
+      class Membership {
+      public:
+         Membership(FactorizationBatch& batch, size_t lane);
+         ~Membership();
+      };
+
+      // linear solver of the calling thread's lane
+      [[nodiscard]] static std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> create_solver(size_t dimension,
+            size_t number_nonzeros);
+
+      [[nodiscard]] bool factorize(size_t group_index, size_t lane, const SymmetricMatrix<size_t, double>& matrix, bool analysis_requested);
+      [[nodiscard]] size_t number_batched_factorizations() const;
+
+   protected:
+      const size_t number_lanes;
+      size_t number_active_lanes;
+      size_t number_waiting_lanes{0};
+      size_t generation{0};
+      size_t batched_factorizations{0};
+      std::mutex mutex{};
+      std::condition_variable condition{};
+      std::vector<std::unique_ptr<BatchedLDLFactorization>> groups{};
+
+      struct FactorizationRequest {
+         size_t group_index;
+         const SymmetricMatrix<size_t, double>* matrix;
+         bool analysis_requested;
+      };
+      std::vector<FactorizationRequest> requests;
+      std::vector<bool> factorized_in_batch;
+
+      BatchedLDLFactorization& join_group(size_t group_index, size_t dimension, size_t number_nonzeros);
+      void leave();
+      void factorize_requested_matrices();
+   };
+
+   // linear solver of a lane: the factorizations are delegated to the batch
+   class BatchedLDLSolver: public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   public:
+      BatchedLDLSolver(FactorizationBatch& batch, const BatchedLDLFactorization& group, size_t group_index, size_t lane, size_t dimension,
+            size_t number_nonzeros);
+      ~BatchedLDLSolver() override = default;
+
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] bool requires_quasidefinite_matrix() const override;
+
+   protected:
+      FactorizationBatch& batch;
+      const BatchedLDLFactorization& group;
+      const size_t group_index;
+      const size_t lane;
+      const size_t number_nonzeros;
+      bool analysis_requested{false};
+      std::vector<double> workspace;
+      // fallback when the sparsity pattern differs from that of the other lanes
+      std::unique_ptr<QuasidefiniteLDLSolver> sequential_solver{};
+      bool sequential_analysis_required{true};
+      bool factorized_sequentially{false};
+   };
+} // namespace
+
+#endif // UNO_BATCHEDLDLSOLVER_H
@@ -4,6 +4,7 @@
 #ifndef UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
 #define UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
 
+#include <vector>
 #include "SymmetricIndefiniteLinearSolver.hpp"
 
 namespace uno {
@@ -13,6 +14,8 @@ namespace uno {
       explicit DirectSymmetricIndefiniteLinearSolver(size_t dimension) : SymmetricIndefiniteLinearSolver<IndexType, ElementType>(dimension) { };
       virtual ~DirectSymmetricIndefiniteLinearSolver() = default;
 
+      // stage of each row of the matrix (multistage problems). Ignored by the general sparse solvers
+      virtual void set_stages(const std::vector<size_t>& /*stages*/) { }
       virtual void do_symbolic_analysis(const SymmetricMatrix<IndexType, ElementType>& matrix) = 0;
       virtual void do_numerical_factorization(const SymmetricMatrix<IndexType, ElementType>& matrix) = 0;
 
@@ -21,6 +24,8 @@ namespace uno {
       // [[nodiscard]] virtual bool matrix_is_positive_definite() const = 0;
       [[nodiscard]] virtual bool matrix_is_singular() const = 0;
       [[nodiscard]] virtual size_t rank() const = 0;
+      // static pivoting solvers factorize quasidefinite matrices only (the dual block must be regularized)
+      [[nodiscard]] virtual bool requires_quasidefinite_matrix() const { return false; }
    };
 } // namespace
 
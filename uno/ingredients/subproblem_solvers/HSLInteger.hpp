@@ -0,0 +1,18 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_HSLINTEGER_H
+#define UNO_HSLINTEGER_H
+
+#include <cstdint>
+
+namespace uno {
+   // integer type of the HSL Fortran interfaces (64-bit with the 64-bit integer version of the HSL library)
+#ifdef HSL_INT64
+   using hsl_int = std::int64_t;
+#else
+   using hsl_int = int;
+#endif
+} // namespace
+
+#endif // UNO_HSLINTEGER_H
@@ -1,21 +1,30 @@
+#include <algorithm>
 #include <cassert>
+#include <thread>
 #include "HiGHSSolver.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "ingredients/hessian_models/ConvexifiedHessian.hpp"
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "linear_algebra/VectorPrinting.hpp"
 #include "optimization/Direction.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
 #include "symbolic/VectorView.hpp"
+#include "tools/Logger.hpp"
+#include "tools/TaskScheduler.hpp"
 
 namespace uno {
    HiGHSSolver::HiGHSSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
-         size_t number_jacobian_nonzeros, size_t /*number_hessian_nonzeros*/, const Options& options):
-         LPSolver(),
+         size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options):
+         QPSolver(),
          constraints(number_constraints),
          linear_objective(number_objective_gradient_nonzeros),
          constraint_jacobian(number_constraints, number_variables),
+         // the diagonal may be regularized if HiGHS detects nonconvexity
+         hessian(number_variables, number_hessian_nonzeros, true, "COO"),
          print_subproblem(options.get_bool("print_subproblem")) {
       this->model.lp_.sense_ = ObjSense::kMinimize;
       this->model.lp_.offset_ = 0.;
@@ -34,15 +43,90 @@ namespace uno {
       this->model.lp_.a_matrix_.start_.reserve(number_variables + 1);
 
       this->highs_solver.setOptionValue("output_flag", "false");
+      // the threads of HiGHS are part of Uno's thread budget (0: number of hardware threads). The option is set once, at construction
+      // (before Uno configures the TaskScheduler): HiGHS restarts its scheduler when the number of threads changes
+      size_t number_threads = TaskScheduler::is_in_parallel_region() ? 1 : options.get_unsigned_int("threads");
+      if (number_threads == 0) {
+         number_threads = std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+      }
+      this->highs_solver.setOptionValue("threads", static_cast<HighsInt>(number_threads));
+
+      // HiGHS only solves convex QPs: the Hessian model (exact or approximate) is not convexified upfront in a trust-region method
+      // without convexify_QP
+      const bool hessian_may_be_nonconvex = (options.get_string("hessian_model") != "zero") &&
+            (options.get_string("globalization_mechanism") == "TR") && not options.get_bool("convexify_QP");
+      if (0 < number_hessian_nonzeros && hessian_may_be_nonconvex) {
+         try {
+            this->convexified_hessian = std::make_unique<ConvexifiedHessian>(number_variables, number_hessian_nonzeros + number_variables, options);
+         }
+         catch (const std::exception& exception) {
+            WARNING << "HiGHS will not be able to solve nonconvex QPs: " << exception.what() << '\n';
+         }
+      }
    }
 
+   HiGHSSolver::~HiGHSSolver() { }
+
    void HiGHSSolver::solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& /*initial_point*/,
          Direction& direction, double trust_region_radius, const WarmstartInformation& warmstart_information) {
       if (this->print_subproblem) {
          DEBUG << "LP:\n";
       }
+      // discard the Hessian of a previous QP
+      if (0 < this->model.hessian_.dim_) {
+         this->model.hessian_.clear();
+         this->model_passed = false;
+      }
       this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information);
-      this->solve_subproblem(problem, direction);
+      this->pass_subproblem(warmstart_information);
+      const HighsStatus return_status = this->highs_solver.run();
+      this->solve_subproblem(problem, return_status, direction);
+   }
+
+   void HiGHSSolver::solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& current_multipliers, const Vector<double>& /*initial_point*/, Direction& direction, HessianModel& hessian_model,
+         double trust_region_radius, const WarmstartInformation& warmstart_information) {
+      this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information);
+      bool hessian_convexified = false;
+      const auto convexify_hessian = [&]() {
+         if (this->number_convexifications == 0) {
+            WARNING << "HiGHS was handed a nonconvex Hessian: it is convexified (set convexify_QP=yes to convexify it upfront)\n";
+         }
+         // the Hessian evaluated by the Hessian model is regularized
+         this->convexified_hessian->convexify(statistics, problem, this->hessian);
+         this->number_convexifications++;
+         hessian_convexified = true;
+      };
+
+      if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
+         hessian_model.evaluate(statistics, problem, current_iterate.primals, current_multipliers, this->hessian);
+         // the inertia of the Hessian detects nonconvexity (a positive diagonal does not certify convexity): HiGHS would reject the QP
+         if (this->convexified_hessian != nullptr && not this->convexified_hessian->is_convex(problem, this->hessian)) {
+            convexify_hessian();
+         }
+         this->save_hessian_to_local_format();
+      }
+      if (this->print_subproblem) {
+         DEBUG << "QP:\n";
+      }
+      DEBUG << "Hessian: " << this->hessian;
+      this->pass_subproblem(warmstart_information);
+      HighsStatus return_status = this->highs_solver.run();
+
+      // HiGHS may detect the nonconvexity during the solve: convexify the Hessian and solve again
+      if (this->solver_rejected_hessian(return_status) && this->convexified_hessian != nullptr && not hessian_convexified) {
+         DEBUG << "HiGHS rejected the Hessian, solving again with a convexified Hessian\n";
+         convexify_hessian();
+         this->save_hessian_to_local_format();
+         this->model_passed = false;
+         this->pass_subproblem(warmstart_information);
+         return_status = this->highs_solver.run();
+      }
+      this->solve_subproblem(problem, return_status, direction);
+   }
+
+   double HiGHSSolver::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      return this->hessian.quadratic_product(primal_direction, primal_direction);
    }
 
    void HiGHSSolver::set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
@@ -129,21 +213,87 @@ namespace uno {
       }
    }
 
-   void HiGHSSolver::solve_subproblem(const OptimizationProblem& problem, Direction& direction) {
-      // solve the LP
-      HighsStatus return_status = this->highs_solver.passModel(this->model);
-      assert(return_status == HighsStatus::kOk);
+   // HiGHS expects the lower triangle in CSC format without duplicate entries
+   void HiGHSSolver::save_hessian_to_local_format() {
+      this->hessian_triplets.clear();
+      for (const auto [row_index, column_index, element]: this->hessian) {
+         this->hessian_triplets.emplace_back(std::min(row_index, column_index), std::max(row_index, column_index), element);
+      }
+      std::sort(this->hessian_triplets.begin(), this->hessian_triplets.end());
 
-      return_status = this->highs_solver.run(); // solve
+      const size_t dimension = this->hessian.dimension();
+      HighsHessian& highs_hessian = this->model.hessian_;
+      highs_hessian.dim_ = static_cast<HighsInt>(dimension);
+      highs_hessian.format_ = HessianFormat::kTriangular;
+      highs_hessian.start_.assign(dimension + 1, 0);
+      highs_hessian.index_.clear();
+      highs_hessian.value_.clear();
+      size_t previous_column_index = dimension;
+      for (const auto& [column_index, row_index, element]: this->hessian_triplets) {
+         // duplicate entries are summed
+         if (column_index == previous_column_index && static_cast<size_t>(highs_hessian.index_.back()) == row_index) {
+            highs_hessian.value_.back() += element;
+         }
+         else {
+            highs_hessian.index_.emplace_back(static_cast<HighsInt>(row_index));
+            highs_hessian.value_.emplace_back(element);
+            highs_hessian.start_[column_index + 1]++;
+         }
+         previous_column_index = column_index;
+      }
+      for (size_t column_index: Range(dimension)) {
+         highs_hessian.start_[column_index + 1] += highs_hessian.start_[column_index];
+      }
+   }
+
+   void HiGHSSolver::pass_subproblem(const WarmstartInformation& warmstart_information) {
+      // if only the bounds changed (e.g. the trust-region radius was reduced), the model is modified in place and HiGHS keeps its basis
+      const bool same_dimensions = (this->highs_solver.getNumCol() == this->model.lp_.num_col_) &&
+            (this->highs_solver.getNumRow() == this->model.lp_.num_row_);
+      const bool only_bounds_changed = not warmstart_information.objective_changed && not warmstart_information.constraints_changed &&
+            not warmstart_information.hessian_sparsity_changed && not warmstart_information.jacobian_sparsity_changed;
+      if (this->model_passed && same_dimensions && only_bounds_changed) {
+         HighsStatus return_status = HighsStatus::kOk;
+         if (warmstart_information.variable_bounds_changed && 0 < this->model.lp_.num_col_) {
+            return_status = this->highs_solver.changeColsBounds(0, this->model.lp_.num_col_ - 1, this->model.lp_.col_lower_.data(),
+                  this->model.lp_.col_upper_.data());
+         }
+         if (warmstart_information.constraint_bounds_changed && 0 < this->model.lp_.num_row_) {
+            return_status = this->highs_solver.changeRowsBounds(0, this->model.lp_.num_row_ - 1, this->model.lp_.row_lower_.data(),
+                  this->model.lp_.row_upper_.data());
+         }
+         assert(return_status != HighsStatus::kError);
+      }
+      else {
+         [[maybe_unused]] const HighsStatus return_status = this->highs_solver.passModel(this->model);
+         assert(return_status != HighsStatus::kError);
+         // warmstart from the basis of the previous subproblem
+         if (this->basis.valid && this->basis.col_status.size() == static_cast<size_t>(this->model.lp_.num_col_) &&
+               this->basis.row_status.size() == static_cast<size_t>(this->model.lp_.num_row_)) {
+            this->highs_solver.setBasis(this->basis);
+         }
+         this->model_passed = true;
+      }
+   }
+
+   bool HiGHSSolver::solver_rejected_hessian(HighsStatus return_status) const {
+      if (this->model.hessian_.dim_ == 0) {
+         return false;
+      }
+      return return_status == HighsStatus::kError || this->highs_solver.getModelStatus() == HighsModelStatus::kSolveError;
+   }
+
+   void HiGHSSolver::solve_subproblem(const OptimizationProblem& problem, HighsStatus return_status, Direction& direction) {
       DEBUG << "HiGHS status: " << static_cast<int>(return_status) << '\n';
 
       // if HiGHS could not optimize (e.g. because of indefinite Hessian), return an error
-      if (return_status == HighsStatus::kError) {
+      HighsModelStatus model_status = highs_solver.getModelStatus();
+      DEBUG << "HiGHS model status: " << static_cast<int>(model_status) << '\n';
+      if (return_status == HighsStatus::kError || model_status == HighsModelStatus::kSolveError) {
          direction.status = SubproblemStatus::ERROR;
+         this->model_passed = false;
          return;
       }
-      HighsModelStatus model_status = highs_solver.getModelStatus();
-      DEBUG << "HiGHS model status: " << static_cast<int>(model_status) << '\n';
 
       if (model_status == HighsModelStatus::kInfeasible) {
          direction.status = SubproblemStatus::INFEASIBLE;
@@ -155,6 +305,10 @@ namespace uno {
       }
       
       direction.status = SubproblemStatus::OPTIMAL;
+      const HighsBasis& current_basis = this->highs_solver.getBasis();
+      if (current_basis.valid) {
+         this->basis = current_basis;
+      }
       const HighsSolution& solution = this->highs_solver.getSolution();
       // read the primal solution and bound dual solution
       for (size_t variable_index = 0; variable_index < problem.number_variables; variable_index++) {
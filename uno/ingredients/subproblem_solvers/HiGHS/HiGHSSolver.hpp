@@ -1,37 +1,60 @@
 #ifndef UNO_HIGHSSOLVER_H
 #define UNO_HIGHSSOLVER_H
 
-#include "ingredients/subproblem_solvers/LPSolver.hpp"
+#include <memory>
+#include <tuple>
+#include "ingredients/subproblem_solvers/QPSolver.hpp"
 #include "Highs.h"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
 
 namespace uno {
-   // forward declaration
+   // forward declarations
+   class ConvexifiedHessian;
    class Options;
 
-   class HiGHSSolver : public LPSolver {
+   // HiGHS solves LPs and convex QPs: nonconvex Hessians are detected and convexified before the QP is passed again
+   class HiGHSSolver : public QPSolver {
    public:
       HiGHSSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
             size_t number_hessian_nonzeros, const Options& options);
+      ~HiGHSSolver() override;
 
       void solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
             double trust_region_radius, const WarmstartInformation& warmstart_information) override;
 
+      void solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& current_multipliers,
+            const Vector<double>& initial_point, Direction& direction, HessianModel& hessian_model, double trust_region_radius,
+            const WarmstartInformation& warmstart_information) override;
+
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      [[nodiscard]] size_t get_number_convexifications() const { return this->number_convexifications; }
+
    protected:
       HighsModel model;
       Highs highs_solver;
+      HighsBasis basis{}; /*!< Basis of the previous subproblem, used to warmstart the next one */
+      bool model_passed{false};
 
       std::vector<double> constraints;
       SparseVector<double> linear_objective;
       RectangularMatrix<double> constraint_jacobian;
+      SymmetricMatrix<size_t, double> hessian;
+      std::vector<std::tuple<size_t, size_t, double>> hessian_triplets{}; /*!< (column, row, entry) of the lower triangle */
+      // fallback when HiGHS is handed a nonconvex Hessian (null if no convexification is available)
+      std::unique_ptr<ConvexifiedHessian> convexified_hessian;
+      size_t number_convexifications{0};
 
       const bool print_subproblem;
 
       void set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
             const WarmstartInformation& warmstart_information);
-      void solve_subproblem(const OptimizationProblem& problem, Direction& direction);
+      void save_hessian_to_local_format();
+      void pass_subproblem(const WarmstartInformation& warmstart_information);
+      [[nodiscard]] bool solver_rejected_hessian(HighsStatus return_status) const;
+      void solve_subproblem(const OptimizationProblem& problem, HighsStatus return_status, Direction& direction);
    };
 } // namespace
 
-#endif // UNO_HIGHSSOLVER_H
\ No newline at end of file
+#endif // UNO_HIGHSSOLVER_H
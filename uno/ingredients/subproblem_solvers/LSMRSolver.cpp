@@ -0,0 +1,131 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include "LSMRSolver.hpp"
+#include "linear_algebra/Norm.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   LSMRSolver::LSMRSolver(size_t number_rows, size_t number_columns): u(number_rows), v(number_columns), h(number_columns),
+         hbar(number_columns), product_result_rows(number_rows), product_result_columns(number_columns) {
+   }
+
+   // Algorithm 1 and Section 7 (estimate of ||r||) in Fong and Saunders, "LSMR: An iterative algorithm for sparse least-squares
+   // problems" (2011), without damping
+   bool LSMRSolver::solve(const Product& product, const Product& transposed_product, const Vector<double>& b, Vector<double>& x,
+         double relative_tolerance, size_t max_iterations) {
+      x.fill(0.);
+      this->iterations = 0;
+      // beta u = b, alpha v = A^T u
+      double beta = norm_2(b);
+      if (beta == 0.) {
+         return true;
+      }
+      for (size_t row_index: Range(this->u.size())) {
+         this->u[row_index] = b[row_index] / beta;
+      }
+      transposed_product(this->u, this->v);
+      double alpha = norm_2(this->v);
+      if (alpha == 0.) {
+         // A^T b = 0: x = 0 is a solution
+         return true;
+      }
+      this->v.scale(1. / alpha);
+
+      const double norm_b = beta;
+      const double initial_normal_residual = alpha * beta; // ||A^T b||
+      double alphabar = alpha;
+      double zetabar = alpha * beta;
+      double rho = 1.;
+      double rhobar = 1.;
+      double cbar = 1.;
+      double sbar = 0.;
+      this->h = this->v;
+      this->hbar.fill(0.);
+      // estimate of ||r||
+      double betadd = beta;
+      double betad = 0.;
+      double rhodold = 1.;
+      double tautildeold = 0.;
+      double thetatilde = 0.;
+      double zeta = 0.;
+
+      while (this->iterations < max_iterations) {
+         this->iterations++;
+         // bidiagonalization: beta u = A v - alpha u, alpha v = A^T u - beta v
+         product(this->v, this->product_result_rows);
+         for (size_t row_index: Range(this->u.size())) {
+            this->u[row_index] = this->product_result_rows[row_index] - alpha * this->u[row_index];
+         }
+         beta = norm_2(this->u);
+         if (0. < beta) {
+            this->u.scale(1. / beta);
+            transposed_product(this->u, this->product_result_columns);
+            for (size_t column_index: Range(this->v.size())) {
+               this->v[column_index] = this->product_result_columns[column_index] - beta * this->v[column_index];
+            }
+            alpha = norm_2(this->v);
+            if (0. < alpha) {
+               this->v.scale(1. / alpha);
+            }
+         }
+
+         // rotations P_k and Pbar_k
+         const double rhoold = rho;
+         rho = std::hypot(alphabar, beta);
+         const double c = alphabar / rho;
+         const double s = beta / rho;
+         const double thetanew = s * alpha;
+         alphabar = c * alpha;
+
+         const double rhobarold = rhobar;
+         const double zetaold = zeta;
+         const double thetabar = sbar * rho;
+         const double rhotemp = cbar * rho;
+         rhobar = std::hypot(rhotemp, thetanew);
+         cbar = rhotemp / rhobar;
+         sbar = thetanew / rhobar;
+         zeta = cbar * zetabar;
+         zetabar = -sbar * zetabar;
+
+         // update of hbar, x and h
+         const double hbar_coefficient = thetabar * rho / (rhoold * rhobarold);
+         const double x_coefficient = zeta / (rho * rhobar);
+         const double h_coefficient = thetanew / rho;
+         for (size_t column_index: Range(x.size())) {
+            this->hbar[column_index] = this->h[column_index] - hbar_coefficient * this->hbar[column_index];
+            x[column_index] += x_coefficient * this->hbar[column_index];
+            this->h[column_index] = this->v[column_index] - h_coefficient * this->h[column_index];
+         }
+
+         // estimate of ||r||
+         const double betahat = c * betadd;
+         betadd = -s * betadd;
+         const double thetatildeold = thetatilde;
+         const double rhotildeold = std::hypot(rhodold, thetabar);
+         const double ctildeold = rhodold / rhotildeold;
+         const double stildeold = thetabar / rhotildeold;
+         thetatilde = stildeold * rhobar;
+         rhodold = ctildeold * rhobar;
+         betad = -stildeold * betad + ctildeold * betahat;
+         tautildeold = (zetaold - thetatildeold * tautildeold) / rhotildeold;
+         const double taud = (zeta - thetatilde * tautildeold) / rhodold;
+         const double residual_norm = std::hypot(betad - taud, betadd);
+         const double normal_residual_norm = std::abs(zetabar);
+
+         if (normal_residual_norm <= relative_tolerance * initial_normal_residual || residual_norm <= relative_tolerance * norm_b) {
+            return true;
+         }
+         // breakdown of the bidiagonalization: the Krylov subspace is invariant and x is the solution
+         if (beta == 0. || alpha == 0.) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   size_t LSMRSolver::number_iterations() const {
+      return this->iterations;
+   }
+} // namespace
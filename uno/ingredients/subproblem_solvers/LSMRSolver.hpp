@@ -0,0 +1,38 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LSMRSOLVER_H
+#define UNO_LSMRSOLVER_H
+
+#include <cstddef>
+#include <functional>
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // LSMR (Fong and Saunders, 2011): iterative solution of the least-squares problem min ||A x - b||_2, where the m x n matrix A is
+   // only accessed through the products A v and A^T u. The norm of the residual of the normal equations A^T (b - A x) decreases
+   // monotonically, which makes early termination safe
+   class LSMRSolver {
+   public:
+      using Product = std::function<void(const Vector<double>& /*input*/, Vector<double>& /*result*/)>;
+
+      LSMRSolver(size_t number_rows, size_t number_columns);
+
+      // returns true if ||A^T (b - A x)|| <= relative_tolerance ||A^T b|| or ||b - A x|| <= relative_tolerance ||b||
+      [[nodiscard]] bool solve(const Product& product, const Product& transposed_product, const Vector<double>& b, Vector<double>& x,
+            double relative_tolerance, size_t max_iterations);
+      [[nodiscard]] size_t number_iterations() const;
+
+   protected:
+      // Golub-Kahan bidiagonalization
+      Vector<double> u;
+      Vector<double> v;
+      Vector<double> h;
+      Vector<double> hbar;
+      Vector<double> product_result_rows;
+      Vector<double> product_result_columns;
+      size_t iterations{0};
+   };
+} // namespace
+
+#endif // UNO_LSMRSOLVER_H
@@ -6,6 +6,7 @@
 #include "MA27Solver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "tools/IntegerCast.hpp"
 #include "tools/Logger.hpp"
 #include "fortran_interface.h"
 
@@ -14,17 +15,19 @@
 #define MA27BD FC_GLOBAL(ma27bd, MA27BD)
 #define MA27CD FC_GLOBAL(ma27cd, MA27CD)
 
+using uno::hsl_int;
+
 extern "C" {
-   void MA27ID(int ICNTL[], double CNTL[]);
+   void MA27ID(hsl_int ICNTL[], double CNTL[]);
 
-   void MA27AD(int* N, int* NZ, int IRN[], int ICN[], int IW[], int* LIW, int IKEEP[], int IW1[],
-         int* NSTEPS, int* IFLAG, int ICNTL[], double CNTL[], int INFO[], double* OPS);
+   void MA27AD(hsl_int* N, hsl_int* NZ, hsl_int IRN[], hsl_int ICN[], hsl_int IW[], hsl_int* LIW, hsl_int IKEEP[], hsl_int IW1[], hsl_int* NSTEPS,
+         hsl_int* IFLAG, hsl_int ICNTL[], double CNTL[], hsl_int INFO[], double* OPS);
 
-   void MA27BD(int* N, int* NZ, int IRN[], int ICN[], double A[], int* LA, int IW[], int* LIW,
-         int IKEEP[], int* NSTEPS, int* MAXFRT, int IW1[], int ICNTL[], double CNTL[], int INFO[]);
+   void MA27BD(hsl_int* N, hsl_int* NZ, hsl_int IRN[], hsl_int ICN[], double A[], hsl_int* LA, hsl_int IW[], hsl_int* LIW, hsl_int IKEEP[],
+         hsl_int* NSTEPS, hsl_int* MAXFRT, hsl_int IW1[], hsl_int ICNTL[], double CNTL[], hsl_int INFO[]);
 
-   void MA27CD(int* N, double A[], int* LA, int IW[], int* LIW, double W[], int* MAXFRT, double RHS[],
-         int IW1[], int* NSTEPS, int ICNTL[], int INFO[]);
+   void MA27CD(hsl_int* N, double A[], hsl_int* LA, hsl_int IW[], hsl_int* LIW, double W[], hsl_int* MAXFRT, double RHS[],
+         hsl_int IW1[], hsl_int* NSTEPS, hsl_int ICNTL[], hsl_int INFO[]);
 }
 
 namespace uno {
@@ -111,7 +114,8 @@ namespace uno {
 
    MA27Solver::MA27Solver(size_t max_dimension, size_t max_number_nonzeros):
          DirectSymmetricIndefiniteLinearSolver<size_t, double>(max_dimension),
-         n(static_cast<int>(max_dimension)), nnz(static_cast<int>(max_number_nonzeros)),
+         n(checked_integer_cast<hsl_int>(max_dimension, "MA27: the dimension of the matrix")),
+         nnz(checked_integer_cast<hsl_int>(max_number_nonzeros, "MA27: the number of nonzeros of the matrix")),
          irn(max_number_nonzeros), icn(max_number_nonzeros),
          iw((2 * max_number_nonzeros + 3 * max_dimension + 1) * 6 / 5), // 20% more than 2*nnz + 3*n + 1
          ikeep(3 * max_dimension), iw1(2 * max_dimension) {
@@ -133,18 +137,18 @@ namespace uno {
       // build the internal matrix representation
       save_matrix_to_local_format(matrix);
 
-      n = static_cast<int>(matrix.dimension());
-      nnz = static_cast<int>(matrix.number_nonzeros());
+      n = checked_integer_cast<hsl_int>(matrix.dimension(), "MA27: the dimension of the matrix");
+      nnz = checked_integer_cast<hsl_int>(matrix.number_nonzeros(), "MA27: the number of nonzeros of the matrix");
 
       // symbolic analysis
-      int liw = static_cast<int>(iw.size());
+      hsl_int liw = checked_integer_cast<hsl_int>(iw.size(), "MA27: the length of the integer workspace");
       MA27AD(&n, &nnz,                                   /* size info */
             irn.data(), icn.data(),                     /* matrix indices */
             iw.data(), &liw, ikeep.data(), iw1.data(),  /* solver workspace */
             &nsteps, &iflag, icntl.data(), cntl.data(), info.data(), &ops);
 
       // resize the factor by at least INFO(5) (here, 50% more)
-      factor.resize(static_cast<size_t>(3 * info[eINFO::NRLNEC] / 2));
+      factor.resize(3 * static_cast<size_t>(info[eINFO::NRLNEC]) / 2);
 
       assert(info[eINFO::IFLAG] == eIFLAG::SUCCESS && "MA27: the symbolic analysis failed");
       if (info[eINFO::IFLAG] != eIFLAG::SUCCESS) {
@@ -154,7 +158,7 @@ namespace uno {
 
    void MA27Solver::do_numerical_factorization([[maybe_unused]] const SymmetricMatrix<size_t, double>& matrix) {
       assert(matrix.dimension() <= iw1.capacity() && "MA27Solver: the dimension of the matrix is larger than the preallocated size");
-      assert(nnz == static_cast<int>(matrix.number_nonzeros()) && "MA27Solver: the numbers of nonzeros do not match");
+      assert(nnz == static_cast<hsl_int>(matrix.number_nonzeros()) && "MA27Solver: the numbers of nonzeros do not match");
 
       // initialize factor with the entries of the matrix. It will be modified by MA27BD
       std::copy(matrix.data_pointer(), matrix.data_pointer() + matrix.number_nonzeros(), factor.begin());
@@ -169,8 +173,8 @@ namespace uno {
             throw std::runtime_error("MA27 reached the maximum number of factorization attempts");
          }
 
-         int la = static_cast<int>(factor.size());
-         int liw = static_cast<int>(iw.size());
+         hsl_int la = checked_integer_cast<hsl_int>(factor.size(), "MA27: the length of the factors");
+         hsl_int liw = checked_integer_cast<hsl_int>(iw.size(), "MA27: the length of the integer workspace");
          MA27BD(&n, &nnz, irn.data(), icn.data(), factor.data(), &la, iw.data(), &liw, ikeep.data(), &nsteps, &maxfrt, iw1.data(), icntl.data(),
                cntl.data(), info.data());
          factorization_done = true;
@@ -193,8 +197,8 @@ namespace uno {
    }
 
    void MA27Solver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& rhs, Vector<double>& result) {
-      int la = static_cast<int>(factor.size());
-      int liw = static_cast<int>(iw.size());
+      hsl_int la = static_cast<hsl_int>(factor.size());
+      hsl_int liw = static_cast<hsl_int>(iw.size());
 
       result = rhs;
 
@@ -235,8 +239,8 @@ namespace uno {
       factor.clear();
       constexpr auto fortran_shift = 1;
       for (const auto [row_index, column_index, element]: matrix) {
-         irn.emplace_back(static_cast<int>(row_index + fortran_shift));
-         icn.emplace_back(static_cast<int>(column_index + fortran_shift));
+         irn.emplace_back(static_cast<hsl_int>(row_index + fortran_shift));
+         icn.emplace_back(static_cast<hsl_int>(column_index + fortran_shift));
          factor.emplace_back(element);
       }
    }
@@ -7,6 +7,8 @@
 #include <array>
 #include <vector>
 #include "../DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "../HSLInteger.hpp"
+#include "tools/HugePageAllocator.hpp"
 
 namespace uno {
    // forward declaration
@@ -30,24 +32,24 @@ namespace uno {
       [[nodiscard]] size_t rank() const override;
 
    private:
-      int n{};                         // dimension of current factorisation (maximal value here is <= max_dimension)
-      int nnz{};                     // number of nonzeros of current factorisation
-      std::array<int, 30> icntl{};      // integer array of length 30; integer control values
+      hsl_int n{};                     // dimension of current factorisation (maximal value here is <= max_dimension)
+      hsl_int nnz{};                   // number of nonzeros of current factorisation
+      std::array<hsl_int, 30> icntl{};  // integer array of length 30; integer control values
       std::array<double, 5> cntl{};     // double array of length 5; double control values
 
-      std::vector<int> irn{};          // row index of input
-      std::vector<int> icn{};          // col index of input
+      std::vector<hsl_int> irn{};      // row index of input
+      std::vector<hsl_int> icn{};      // col index of input
 
-      std::vector<int> iw{};           // integer workspace of length liw
-      std::vector<int> ikeep{};        // integer array of 3*n; pivot sequence
-      std::vector<int> iw1{};          // integer workspace array of length n
-      int nsteps{};                    // integer, to be set by ma27
-      int iflag{};                     // integer; 0 if pivot order chosen automatically; 1 if the pivot order set by ikeep
-      std::array<int, 20> info{};       // integer array of length 20
+      HugePageVector<hsl_int> iw{};    // integer workspace of length liw
+      std::vector<hsl_int> ikeep{};    // integer array of 3*n; pivot sequence
+      std::vector<hsl_int> iw1{};      // integer workspace array of length n
+      hsl_int nsteps{};                // integer, to be set by ma27
+      hsl_int iflag{};                 // integer; 0 if pivot order chosen automatically; 1 if the pivot order set by ikeep
+      std::array<hsl_int, 20> info{};   // integer array of length 20
       double ops{};                    // double, operations count
 
-      std::vector<double> factor{};    // data array of length la;
-      int maxfrt{};                    // integer, to be set by ma27
+      HugePageVector<double> factor{}; // data array of length la;
+      hsl_int maxfrt{};                // integer, to be set by ma27
       std::vector<double> w{};         // double workspace
       const size_t number_factorization_attempts{5};
 
@@ -5,6 +5,7 @@
 #include "MA57Solver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "tools/IntegerCast.hpp"
 #include "tools/Logger.hpp"
 #include "fortran_interface.h"
 
@@ -18,27 +19,29 @@ namespace uno {
    extern "C" {
    // MA57
    // default values of controlling parameters
-   void MA57ID(double cntl[], int icntl[]);
+   void MA57ID(double cntl[], hsl_int icntl[]);
    // symbolic analysis
-   void MA57AD(const int* n, const int* ne, const int irn[], const int jcn[], const int* lkeep, int keep[], int iwork[], int icntl[], int info[], double
-   rinfo[]);
+   void MA57AD(const hsl_int* n, const hsl_int* ne, const hsl_int irn[], const hsl_int jcn[], const hsl_int* lkeep, hsl_int keep[], hsl_int iwork[],
+         hsl_int icntl[], hsl_int info[], double rinfo[]);
    // numerical factorization
-   void MA57BD(const int* n, int* ne, const double a[], /* out */ double fact[], const int* lfact, /* out */ int ifact[], const int* lifact,
-         const int* lkeep, const int keep[], int iwork[], int icntl[], double cntl[], /* out */ int info[], /* out */ double rinfo[]);
+   void MA57BD(const hsl_int* n, hsl_int* ne, const double a[], /* out */ double fact[], const hsl_int* lfact, /* out */ hsl_int ifact[],
+         const hsl_int* lifact, const hsl_int* lkeep, const hsl_int keep[], hsl_int iwork[], hsl_int icntl[], double cntl[], /* out */ hsl_int info[],
+         /* out */ double rinfo[]);
    // linear system solve without iterative refinement
-   void MA57CD(const int* job, const int* n, double fact[], int* lfact, int ifact[], int* lifact, const int* nrhs, double rhs[], const int* lrhs, double
-   work[], int* lwork, int iwork[], int icntl[], int info[]);
+   void MA57CD(const hsl_int* job, const hsl_int* n, double fact[], hsl_int* lfact, hsl_int ifact[], hsl_int* lifact, const hsl_int* nrhs,
+         double rhs[], const hsl_int* lrhs, double work[], hsl_int* lwork, hsl_int iwork[], hsl_int icntl[], hsl_int info[]);
    // linear system solve with iterative refinement
-   void MA57DD(const int* job, const int* n, int* ne, const double a[], const int irn[], const int jcn[], double fact[], int* lfact, int ifact[], int*
-   lifact, const double rhs[], double x[], double resid[], double work[], int iwork[], int icntl[],
-         double cntl[], int info[], double rinfo[]);
+   void MA57DD(const hsl_int* job, const hsl_int* n, hsl_int* ne, const double a[], const hsl_int irn[], const hsl_int jcn[], double fact[],
+         hsl_int* lfact, hsl_int ifact[], hsl_int* lifact, const double rhs[], double x[], double resid[], double work[], hsl_int iwork[],
+         hsl_int icntl[], double cntl[], hsl_int info[], double rinfo[]);
    }
 
    MA57Solver::MA57Solver(size_t dimension, size_t number_nonzeros) : DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension),
-         lkeep(static_cast<int>(5 * dimension + number_nonzeros + std::max(dimension, number_nonzeros) + 42)),
+         lkeep(checked_integer_cast<hsl_int>(5 * dimension + number_nonzeros + std::max(dimension, number_nonzeros) + 42,
+               "MA57: the length of KEEP")),
          keep(static_cast<size_t>(lkeep)),
          iwork(5 * dimension),
-         lwork(static_cast<int>(1.2 * static_cast<double>(dimension))),
+         lwork(static_cast<hsl_int>(1.2 * static_cast<double>(dimension))),
          work(static_cast<size_t>(this->lwork)), residuals(dimension) {
       this->row_indices.reserve(number_nonzeros);
       this->column_indices.reserve(number_nonzeros);
@@ -58,8 +61,8 @@ namespace uno {
       // build the internal matrix representation
       this->save_sparsity_pattern_internally(matrix);
 
-      const int n = static_cast<int>(matrix.dimension());
-      const int nnz = static_cast<int>(matrix.number_nonzeros());
+      const hsl_int n = checked_integer_cast<hsl_int>(matrix.dimension(), "MA57: the dimension of the matrix");
+      const hsl_int nnz = checked_integer_cast<hsl_int>(matrix.number_nonzeros(), "MA57: the number of nonzeros of the matrix");
 
       // symbolic analysis
       MA57AD(/* const */ &n,
@@ -79,8 +82,8 @@ namespace uno {
       }
 
       // get LFACT and LIFACT and resize FACT and IFACT (no effect if resized to <= size)
-      int lfact = 2 * this->info[8];
-      int lifact = 2 * this->info[9];
+      hsl_int lfact = checked_integer_cast<hsl_int>(2 * static_cast<size_t>(this->info[8]), "MA57: the length of the factors");
+      hsl_int lifact = checked_integer_cast<hsl_int>(2 * static_cast<size_t>(this->info[9]), "MA57: the length of the integer factors");
       this->fact.resize(static_cast<size_t>(lfact));
       this->ifact.resize(static_cast<size_t>(lifact));
 
@@ -90,10 +93,10 @@ namespace uno {
 
    void MA57Solver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
       assert(matrix.dimension() <= this->dimension && "MA57Solver: the dimension of the matrix is larger than the preallocated size");
-      assert(this->factorization.nnz == static_cast<int>(matrix.number_nonzeros()) && "MA57Solver: the numbers of nonzeros do not match");
+      assert(this->factorization.nnz == static_cast<hsl_int>(matrix.number_nonzeros()) && "MA57Solver: the numbers of nonzeros do not match");
 
-      const int n = static_cast<int>(matrix.dimension());
-      int nnz = static_cast<int>(matrix.number_nonzeros());
+      const hsl_int n = static_cast<hsl_int>(matrix.dimension());
+      hsl_int nnz = static_cast<hsl_int>(matrix.number_nonzeros());
 
       // numerical factorization
       MA57BD(&n,
@@ -111,9 +114,9 @@ namespace uno {
 
    void MA57Solver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) {
       // solve
-      const int n = static_cast<int>(matrix.dimension());
-      int nnz = static_cast<int>(matrix.number_nonzeros());
-      const int lrhs = n; // integer, length of rhs
+      const hsl_int n = static_cast<hsl_int>(matrix.dimension());
+      hsl_int nnz = static_cast<hsl_int>(matrix.number_nonzeros());
+      const hsl_int lrhs = n; // integer, length of rhs
 
       // solve the linear system
       if (this->use_iterative_refinement) {
@@ -166,8 +169,8 @@ namespace uno {
       this->row_indices.clear();
       this->column_indices.clear();
       for (const auto [row_index, column_index, _]: matrix) {
-         this->row_indices.emplace_back(static_cast<int>(row_index + this->fortran_shift));
-         this->column_indices.emplace_back(static_cast<int>(column_index + this->fortran_shift));
+         this->row_indices.emplace_back(static_cast<hsl_int>(row_index + this->fortran_shift));
+         this->column_indices.emplace_back(static_cast<hsl_int>(column_index + this->fortran_shift));
       }
    }
 } // namespace
@@ -7,6 +7,8 @@
 #include <array>
 #include <vector>
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/HSLInteger.hpp"
+#include "tools/HugePageAllocator.hpp"
 
 namespace uno {
    // forward declaration
@@ -14,10 +16,10 @@ namespace uno {
    class Vector;
 
    struct MA57Factorization {
-      int n{};
-      int nnz{};
-      int lfact{};
-      int lifact{};
+      hsl_int n{};
+      hsl_int nnz{};
+      hsl_int lfact{};
+      hsl_int lifact{};
 
       MA57Factorization() = default;
    };
@@ -45,27 +47,27 @@ namespace uno {
 
    private:
       // internal matrix representation
-      std::vector<int> row_indices;
-      std::vector<int> column_indices;
+      std::vector<hsl_int> row_indices;
+      std::vector<hsl_int> column_indices;
 
       // factorization
       MA57Factorization factorization{};
-      std::vector<double> fact{0}; // do not initialize, resize at every iteration
-      std::vector<int> ifact{0}; // do not initialize, resize at every iteration
-      const int lkeep;
-      std::vector<int> keep{};
-      std::vector<int> iwork{};
-      int lwork;
+      HugePageVector<double> fact{0}; // do not initialize, resize at every iteration
+      HugePageVector<hsl_int> ifact{0}; // do not initialize, resize at every iteration
+      const hsl_int lkeep;
+      std::vector<hsl_int> keep{};
+      std::vector<hsl_int> iwork{};
+      hsl_int lwork;
       std::vector<double> work{};
 
       // for ma57id_ (default values of controlling parameters)
       std::array<double, 5> cntl{};
-      std::array<int, 20> icntl{};
+      std::array<hsl_int, 20> icntl{};
       std::array<double, 20> rinfo{};
-      std::array<int, 40> info{};
+      std::array<hsl_int, 40> info{};
 
-      const int nrhs{1}; // number of right hand side being solved
-      const int job{1};
+      const hsl_int nrhs{1}; // number of right hand side being solved
+      const hsl_int job{1};
       std::vector<double> residuals;
       const size_t fortran_shift{1};
 
@@ -1,8 +1,11 @@
 // Copyright (c) 2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <stdexcept>
+#include <string>
 #include "MUMPSSolver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "tools/IntegerCast.hpp"
 #if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
 #include "mpi.h"
 #endif
@@ -53,8 +56,9 @@ namespace uno {
    
    void MUMPSSolver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
       this->mumps_structure.job = MUMPSSolver::JOB_ANALYSIS;
-      this->mumps_structure.n = static_cast<int>(matrix.dimension());
-      this->mumps_structure.nnz = static_cast<int>(matrix.number_nonzeros());
+      this->mumps_structure.n = checked_integer_cast<MUMPS_INT>(matrix.dimension(), "MUMPS: the dimension of the matrix");
+      // 64-bit number of nonzeros
+      this->mumps_structure.nnz = checked_integer_cast<MUMPS_INT8>(matrix.number_nonzeros(), "MUMPS: the number of nonzeros of the matrix");
       this->mumps_structure.a = nullptr;
       this->save_sparsity_to_local_format(matrix);
       // connect the local sparsity with the pointers in the structure
@@ -62,6 +66,7 @@ namespace uno {
       this->mumps_structure.jcn = this->column_indices.data();
       this->mumps_structure.a = nullptr;
       dmumps_c(&this->mumps_structure);
+      this->check_size_errors();
       this->mumps_structure.icntl[7] = 8; // ICNTL(8) = 8: recompute scaling before factorization
    }
 
@@ -69,6 +74,7 @@ namespace uno {
       this->mumps_structure.job = MUMPSSolver::JOB_FACTORIZATION;
       this->mumps_structure.a = const_cast<double*>(matrix.data_pointer());
       dmumps_c(&this->mumps_structure);
+      this->check_size_errors();
    }
 
    void MUMPSSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& rhs, Vector<double>& result) {
@@ -103,13 +109,22 @@ namespace uno {
       return this->dimension - this->number_zero_eigenvalues();
    }
 
+   void MUMPSSolver::check_size_errors() const {
+      // INFOG(1): -8, -9 (workspaces too small), -13 (allocation failure), -19 (memory limit), -51 (32-bit ordering library)
+      const int error = this->mumps_structure.infog[0];
+      if (error == -8 || error == -9 || error == -13 || error == -19 || error == -51) {
+         throw std::runtime_error("MUMPS failed because of the size of the matrix or of its factors: INFOG(1) = " + std::to_string(error) +
+            ", INFOG(2) = " + std::to_string(this->mumps_structure.infog[1]));
+      }
+   }
+
    void MUMPSSolver::save_sparsity_to_local_format(const SymmetricMatrix<size_t, double>& matrix) {
       // build the internal matrix representation
       this->row_indices.clear();
       this->column_indices.clear();
       for (const auto [row_index, column_index, _]: matrix) {
-         this->row_indices.emplace_back(static_cast<int>(row_index + this->fortran_shift));
-         this->column_indices.emplace_back(static_cast<int>(column_index + this->fortran_shift));
+         this->row_indices.emplace_back(static_cast<MUMPS_INT>(row_index + this->fortran_shift));
+         this->column_indices.emplace_back(static_cast<MUMPS_INT>(column_index + this->fortran_shift));
       }
    }
 } // namespace
@@ -29,8 +29,8 @@ namespace uno {
       DMUMPS_STRUC_C mumps_structure{};
 
       // matrix sparsity
-      std::vector<int> row_indices{};
-      std::vector<int> column_indices{};
+      std::vector<MUMPS_INT> row_indices{};
+      std::vector<MUMPS_INT> column_indices{};
 
       static const int JOB_INIT = -1;
       static const int JOB_END = -2;
@@ -41,6 +41,7 @@ namespace uno {
       static const int GENERAL_SYMMETRIC = 2;
 
       const size_t fortran_shift{1};
+      void check_size_errors() const;
       void save_sparsity_to_local_format(const SymmetricMatrix<size_t, double>& matrix);
    };
 } // namespace
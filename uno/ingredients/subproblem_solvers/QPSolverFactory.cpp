@@ -10,6 +10,9 @@
 #ifdef HAS_BQPD
 #include "ingredients/subproblem_solvers/BQPD/BQPDSolver.hpp"
 #endif
+#ifdef HAS_HIGHS
+#include "ingredients/subproblem_solvers/HiGHS/HiGHSSolver.hpp"
+#endif
 
 namespace uno {
    std::unique_ptr<QPSolver> QPSolverFactory::create([[maybe_unused]] size_t number_variables, [[maybe_unused]] size_t number_constraints,
@@ -22,6 +25,12 @@ namespace uno {
             return std::make_unique<BQPDSolver>(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
                   number_hessian_nonzeros, BQPDProblemType::QP, options);
          }
+#endif
+#ifdef HAS_HIGHS
+         if (QP_solver_name == "HiGHS") {
+            return std::make_unique<HiGHSSolver>(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
+                  number_hessian_nonzeros, options);
+         }
 #endif
          std::string message = "The QP solver ";
          message.append(QP_solver_name).append(" is unknown").append("\n").append("The following values are available: ")
@@ -40,6 +49,18 @@ namespace uno {
       std::vector<std::string> solvers{};
 #ifdef HAS_BQPD
       solvers.emplace_back("BQPD");
+#endif
+#ifdef HAS_HIGHS
+      solvers.emplace_back("HiGHS");
+#endif
+      return solvers;
+   }
+
+   // HiGHS solves convex QPs only: nonconvex Hessians are convexified, which changes the step of the trust-region methods
+   std::vector<std::string> QPSolverFactory::default_solvers() {
+      std::vector<std::string> solvers{};
+#ifdef HAS_BQPD
+      solvers.emplace_back("BQPD");
 #endif
       return solvers;
    }
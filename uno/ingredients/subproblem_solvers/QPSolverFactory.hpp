@@ -21,6 +21,8 @@ namespace uno {
 
       // return the list of available QP solvers
       static std::vector<std::string> available_solvers();
+      // return the list of QP solvers that may be selected by default (HiGHS must be selected explicitly with QP_solver=HiGHS)
+      static std::vector<std::string> default_solvers();
    };
 } // namespace
 
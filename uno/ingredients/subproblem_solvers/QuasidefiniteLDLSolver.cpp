@@ -0,0 +1,247 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "QuasidefiniteLDLSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   QuasidefiniteLDLSolver::QuasidefiniteLDLSolver(size_t dimension, size_t number_nonzeros):
+         DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension),
+         SparseSymbolicFactorization(dimension, number_nonzeros) {
+   }
+
+   void QuasidefiniteLDLSolver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "QuasidefiniteLDLSolver: the dimension of the matrix is larger than the preallocated size");
+      SparseSymbolicFactorization::do_symbolic_analysis(matrix, matrix.dimension());
+      this->factorized_entries.resize(this->permuted_entries.size());
+      this->is_factorized = false;
+      this->factorization_work = 0.;
+      for (size_t column_index: Range(this->factorized_dimension)) {
+         const double column_count = static_cast<double>(this->factor_column_starts[column_index + 1] - this->factor_column_starts[column_index]);
+         this->factorization_work += column_count * column_count;
+      }
+   }
+
+   void QuasidefiniteLDLSolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.number_nonzeros() == this->permuted_position.size() && "QuasidefiniteLDLSolver: the symbolic analysis is out of date");
+      if (this->is_factorized) {
+         // keep the entries represented by the factors to detect the modified entries
+         std::swap(this->permuted_entries, this->factorized_entries);
+      }
+      this->scatter_entries(matrix);
+      if (not this->is_factorized || not this->update_factorization()) {
+         this->factorize();
+      }
+   }
+
+   void QuasidefiniteLDLSolver::factorize() {
+      // up-looking factorization: compute the k-th row of L and the k-th pivot of D at step k. The pivots are stored as the diagonal
+      // entries of L (first entry of each column)
+      std::copy(this->factor_column_starts.begin(), this->factor_column_starts.begin() + static_cast<std::ptrdiff_t>(this->factorized_dimension),
+            this->next_position.begin());
+      std::fill(this->marker.begin(), this->marker.end(), NO_INDEX);
+      this->number_positive_pivots = this->number_negative_pivots = this->number_zero_pivots = 0;
+      for (size_t k: Range(this->factorized_dimension)) {
+         const size_t top = this->compute_row_pattern(k);
+         // scatter the k-th column of the upper triangular part
+         for (size_t position: Range(this->permuted_column_starts[k], this->permuted_column_starts[k + 1])) {
+            this->dense_workspace[this->permuted_row_indices[position]] += this->permuted_entries[position];
+         }
+         double pivot = this->dense_workspace[k];
+         this->dense_workspace[k] = 0.;
+         // sparse triangular solve with the rows of the pattern (in topological order)
+         for (size_t pattern_index: Range(top, this->factorized_dimension)) {
+            const size_t row_index = this->row_pattern[pattern_index];
+            const double entry = this->dense_workspace[row_index];
+            this->dense_workspace[row_index] = 0.;
+            for (size_t position: Range(this->factor_column_starts[row_index] + 1, this->next_position[row_index])) {
+               this->dense_workspace[this->factor_row_indices[position]] -= this->factor_entries[position] * entry;
+            }
+            const double factor_entry = entry / this->factor_entries[this->factor_column_starts[row_index]];
+            pivot -= factor_entry * entry;
+            const size_t position = this->next_position[row_index]++;
+            this->factor_row_indices[position] = k;
+            this->factor_entries[position] = factor_entry;
+         }
+         // static pivoting: no row exchange, a tiny pivot is replaced by a static pivot of the same sign
+         if (std::abs(pivot) <= QuasidefiniteLDLSolver::zero_pivot_tolerance) {
+            this->number_zero_pivots++;
+            pivot = (pivot < 0.) ? -QuasidefiniteLDLSolver::static_pivot : QuasidefiniteLDLSolver::static_pivot;
+         }
+         else if (0. < pivot) {
+            this->number_positive_pivots++;
+         }
+         else {
+            this->number_negative_pivots++;
+         }
+         const size_t position = this->next_position[k]++;
+         this->factor_row_indices[position] = k;
+         this->factor_entries[position] = pivot;
+      }
+      this->is_factorized = true;
+      this->accumulated_updates = 0;
+      this->factorizations++;
+   }
+
+   void QuasidefiniteLDLSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result) {
+      // permute the right-hand side
+      for (size_t index: Range(this->factorized_dimension)) {
+         this->dense_workspace[index] = rhs[this->permutation[index]];
+      }
+      // forward substitution with L (unit diagonal)
+      for (size_t column_index: Range(this->factorized_dimension)) {
+         for (size_t position: Range(this->factor_column_starts[column_index] + 1, this->factor_column_starts[column_index + 1])) {
+            this->dense_workspace[this->factor_row_indices[position]] -= this->factor_entries[position] * this->dense_workspace[column_index];
+         }
+      }
+      // diagonal solve with D
+      for (size_t index: Range(this->factorized_dimension)) {
+         this->dense_workspace[index] /= this->factor_entries[this->factor_column_starts[index]];
+      }
+      // backward substitution with L^T
+      for (size_t column_index = this->factorized_dimension; column_index-- > 0;) {
+         for (size_t position: Range(this->factor_column_starts[column_index] + 1, this->factor_column_starts[column_index + 1])) {
+            this->dense_workspace[column_index] -= this->factor_entries[position] * this->dense_workspace[this->factor_row_indices[position]];
+         }
+      }
+      // permute back the solution
+      for (size_t index: Range(this->factorized_dimension)) {
+         result[this->permutation[index]] = this->dense_workspace[index];
+         this->dense_workspace[index] = 0.;
+      }
+   }
+
+   std::tuple<size_t, size_t, size_t> QuasidefiniteLDLSolver::get_inertia() const {
+      return std::make_tuple(this->number_positive_pivots, this->number_negative_pivots, this->number_zero_pivots);
+   }
+
+   size_t QuasidefiniteLDLSolver::number_negative_eigenvalues() const {
+      return this->number_negative_pivots;
+   }
+
+   bool QuasidefiniteLDLSolver::matrix_is_singular() const {
+      return (0 < this->number_zero_pivots);
+   }
+
+   size_t QuasidefiniteLDLSolver::rank() const {
+      return this->factorized_dimension - this->number_zero_pivots;
+   }
+
+   bool QuasidefiniteLDLSolver::requires_quasidefinite_matrix() const {
+      return true;
+   }
+
+   size_t QuasidefiniteLDLSolver::number_factorizations() const {
+      return this->factorizations;
+   }
+
+   size_t QuasidefiniteLDLSolver::number_factorization_updates() const {
+      return this->updates;
+   }
+
+   // modify the factors with the differences between the permuted matrix and the factorized entries. Returns false if the matrix
+   // must be refactorized (the factors may then be invalid)
+   bool QuasidefiniteLDLSolver::update_factorization() {
+      // the factors of a matrix with static pivots do not represent the matrix exactly
+      if (0 < this->number_zero_pivots) {
+         return false;
+      }
+      // modified entries and work of the modifications along the paths of the elimination tree (a modified entry (i, j) of the upper
+      // triangular part requires 2 rank-1 modifications from i, of which j is an ancestor)
+      this->modified_entries.clear();
+      size_t number_modifications = this->accumulated_updates;
+      double update_work = 0.;
+      for (size_t column_index: Range(this->factorized_dimension)) {
+         for (size_t position: Range(this->permuted_column_starts[column_index], this->permuted_column_starts[column_index + 1])) {
+            const double difference = this->permuted_entries[position] - this->factorized_entries[position];
+            if (difference != 0.) {
+               const size_t row_index = this->permuted_row_indices[position];
+               const size_t rank = (row_index == column_index) ? 1 : 2;
+               number_modifications += rank;
+               if (QuasidefiniteLDLSolver::maximum_accumulated_updates < number_modifications) {
+                  return false;
+               }
+               for (size_t index = row_index; index != NO_INDEX; index = this->parent[index]) {
+                  update_work += static_cast<double>(rank * (this->factor_column_starts[index + 1] - this->factor_column_starts[index]));
+               }
+               if (QuasidefiniteLDLSolver::maximum_relative_update_work * this->factorization_work < update_work) {
+                  return false;
+               }
+               this->modified_entries.emplace_back(ModifiedEntry{row_index, column_index, difference});
+            }
+         }
+      }
+      if (this->modified_entries.empty()) {
+         return true;
+      }
+
+      // A + delta (e_i e_j^T + e_j e_i^T) = A + delta/2 (e_i + e_j)(e_i + e_j)^T - delta/2 (e_i - e_j)(e_i - e_j)^T
+      for (const ModifiedEntry& entry: this->modified_entries) {
+         const bool success = (entry.row_index == entry.column_index) ?
+               this->apply_rank_one_modification(entry.difference, entry.row_index, 1., NO_INDEX, 0.) :
+               (this->apply_rank_one_modification(entry.difference / 2., entry.row_index, 1., entry.column_index, 1.) &&
+                this->apply_rank_one_modification(-entry.difference / 2., entry.row_index, 1., entry.column_index, -1.));
+         if (not success) {
+            std::fill(this->dense_workspace.begin(), this->dense_workspace.end(), 0.);
+            return false;
+         }
+      }
+      DEBUG << "QuasidefiniteLDLSolver: " << this->modified_entries.size() << " modified entries, factors updated\n";
+      this->accumulated_updates = number_modifications;
+      this->updates++;
+      this->count_pivots();
+      return true;
+   }
+
+   // L D L^T + coefficient w w^T with w sparse (at most two nonzeros, the second one being an ancestor of the first one in the
+   // elimination tree). Method C1 of Gill, Golub, Murray and Saunders, restricted to the path of the elimination tree from the first
+   // nonzero (Davis and Hager). Returns false if a pivot becomes tiny
+   bool QuasidefiniteLDLSolver::apply_rank_one_modification(double coefficient, size_t first_index, double first_value,
+         size_t second_index, double second_value) {
+      this->dense_workspace[first_index] += first_value;
+      if (second_index != NO_INDEX) {
+         this->dense_workspace[second_index] += second_value;
+      }
+      for (size_t index = first_index; index != NO_INDEX; index = this->parent[index]) {
+         const double entry = this->dense_workspace[index];
+         this->dense_workspace[index] = 0.;
+         if (entry == 0.) {
+            continue;
+         }
+         const size_t diagonal_position = this->factor_column_starts[index];
+         const double pivot = this->factor_entries[diagonal_position];
+         const double new_pivot = pivot + coefficient * entry * entry;
+         if (std::abs(new_pivot) <= QuasidefiniteLDLSolver::zero_pivot_tolerance) {
+            return false;
+         }
+         const double factor = entry * coefficient / new_pivot;
+         coefficient *= pivot / new_pivot;
+         this->factor_entries[diagonal_position] = new_pivot;
+         for (size_t position: Range(diagonal_position + 1, this->factor_column_starts[index + 1])) {
+            const size_t row_index = this->factor_row_indices[position];
+            this->dense_workspace[row_index] -= entry * this->factor_entries[position];
+            this->factor_entries[position] += factor * this->dense_workspace[row_index];
+         }
+      }
+      return true;
+   }
+
+   void QuasidefiniteLDLSolver::count_pivots() {
+      this->number_positive_pivots = this->number_negative_pivots = this->number_zero_pivots = 0;
+      for (size_t index: Range(this->factorized_dimension)) {
+         if (0. < this->factor_entries[this->factor_column_starts[index]]) {
+            this->number_positive_pivots++;
+         }
+         else {
+            this->number_negative_pivots++;
+         }
+      }
+   }
+} // namespace
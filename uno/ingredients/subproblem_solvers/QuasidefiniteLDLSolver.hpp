@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_QUASIDEFINITELDLSOLVER_H
+#define UNO_QUASIDEFINITELDLSOLVER_H
+
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "SparseSymbolicFactorization.hpp"
+
+namespace uno {
+   // forward declaration
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class QuasidefiniteLDLSolver
+    * \brief LDL^T factorization of quasidefinite matrices with static pivoting
+    *
+    *  Up-looking factorization P A P^T = L D L^T with a fixed ordering computed during the symbolic analysis and no numerical pivoting
+    *  (the QDLDL approach). The factorization exists for any ordering if the matrix is quasidefinite, which the augmented system
+    *  guarantees by always applying a dual regularization. The inertia is read from the signs of D (Sylvester's law of inertia).
+    *  Tiny pivots are replaced by a static pivot of the same sign and counted as zero eigenvalues.
+    *  When a matrix differs from the previously factorized one in a few entries (same sparsity), the factors are modified with sparse
+    *  rank-1 updates/downdates along the paths of the elimination tree (Davis and Hager) instead of being recomputed. The solver
+    *  falls back to a refactorization if the modifications are more expensive than a factorization, if too many modifications
+    *  accumulated since the last factorization, or if a modification produces a tiny pivot.
+    */
+   class QuasidefiniteLDLSolver : public DirectSymmetricIndefiniteLinearSolver<size_t, double>, protected SparseSymbolicFactorization {
+   public:
+      QuasidefiniteLDLSolver(size_t dimension, size_t number_nonzeros);
+      ~QuasidefiniteLDLSolver() override = default;
+
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      // [[nodiscard]] bool matrix_is_positive_definite() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] bool requires_quasidefinite_matrix() const override;
+      using SparseSymbolicFactorization::number_dense_rows;
+      [[nodiscard]] size_t number_factorizations() const;
+      [[nodiscard]] size_t number_factorization_updates() const;
+
+   protected:
+      struct ModifiedEntry {
+         size_t row_index; // permuted
+         size_t column_index; // permuted
+         double difference;
+      };
+
+      size_t number_positive_pivots{0};
+      size_t number_negative_pivots{0};
+      size_t number_zero_pivots{0};
+      // factorization updates
+      bool is_factorized{false};
+      HugePageVector<double> factorized_entries{}; // entries of the permuted matrix represented by the factors
+      std::vector<ModifiedEntry> modified_entries{};
+      double factorization_work{0.}; // sum of the squared column counts of L
+      size_t accumulated_updates{0}; // rank-1 modifications since the last factorization
+      size_t factorizations{0};
+      size_t updates{0};
+      static constexpr double zero_pivot_tolerance{1e-14};
+      static constexpr double static_pivot{1e-8};
+      static constexpr size_t maximum_accumulated_updates{100};
+      static constexpr double maximum_relative_update_work{0.5};
+
+      void factorize();
+      [[nodiscard]] bool update_factorization();
+      [[nodiscard]] bool apply_rank_one_modification(double coefficient, size_t first_index, double first_value, size_t second_index,
+            double second_value);
+      void count_pivots();
+   };
+} // namespace
+
+#endif // UNO_QUASIDEFINITELDLSOLVER_H
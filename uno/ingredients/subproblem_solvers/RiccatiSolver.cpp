@@ -0,0 +1,283 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "RiccatiSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   RiccatiSolver::RiccatiSolver(size_t dimension, size_t number_nonzeros):
+         DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension),
+         number_nonzeros(number_nonzeros),
+         workspace(dimension) {
+   }
+
+   void RiccatiSolver::set_stages(const std::vector<size_t>& new_stages) {
+      this->stages = new_stages;
+   }
+
+   void RiccatiSolver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "RiccatiSolver: the dimension of the matrix is larger than the preallocated size");
+      this->is_block_tridiagonal = this->analyze_stages(matrix);
+      if (not this->is_block_tridiagonal) {
+         if (this->fallback_solver == nullptr) {
+            this->fallback_solver = std::make_unique<QuasidefiniteLDLSolver>(this->dimension, this->number_nonzeros);
+         }
+         this->fallback_solver->do_symbolic_analysis(matrix);
+      }
+   }
+
+   void RiccatiSolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      if (not this->is_block_tridiagonal) {
+         this->fallback_solver->do_numerical_factorization(matrix);
+         return;
+      }
+      assert(matrix.dimension() == this->factorized_dimension && "RiccatiSolver: the symbolic analysis is out of date");
+      // scatter the lower triangular parts of the diagonal blocks and the coupling blocks A_{k,k+1}
+      std::fill(this->diagonal_blocks.begin(), this->diagonal_blocks.end(), 0.);
+      std::fill(this->coupling_blocks.begin(), this->coupling_blocks.end(), 0.);
+      for (const auto [row_index, column_index, element]: matrix) {
+         const size_t row_stage = this->stages[row_index];
+         const size_t column_stage = this->stages[column_index];
+         const size_t local_row = this->local_indices[row_index];
+         const size_t local_column = this->local_indices[column_index];
+         if (row_stage == column_stage) {
+            const size_t size = this->stage_size(row_stage);
+            this->diagonal_blocks[this->diagonal_offsets[row_stage] + std::min(local_row, local_column) * size +
+                  std::max(local_row, local_column)] += element;
+         }
+         else if (row_stage < column_stage) {
+            this->coupling_blocks[this->coupling_offsets[row_stage] + local_column * this->stage_size(row_stage) + local_row] += element;
+         }
+         else {
+            this->coupling_blocks[this->coupling_offsets[column_stage] + local_row * this->stage_size(column_stage) + local_column] += element;
+         }
+      }
+
+      // backward Riccati recursion
+      this->number_positive_pivots = this->number_negative_pivots = this->number_zero_pivots = 0;
+      const size_t number_stages = this->stage_starts.size() - 1;
+      for (size_t stage = number_stages; stage-- > 0;) {
+         const size_t size = this->stage_size(stage);
+         double* block = this->diagonal_blocks.data() + this->diagonal_offsets[stage];
+         if (stage + 1 < number_stages) {
+            const size_t next_size = this->stage_size(stage + 1);
+            const double* next_block = this->diagonal_blocks.data() + this->diagonal_offsets[stage + 1];
+            const double* coupling = this->coupling_blocks.data() + this->coupling_offsets[stage];
+            double* gain = this->gain_blocks.data() + this->coupling_offsets[stage];
+            // G_k = P_{k+1}^{-1} A_{k,k+1}^T, column by column
+            for (size_t column_index: Range(size)) {
+               double* gain_column = gain + column_index * next_size;
+               for (size_t row_index: Range(next_size)) {
+                  gain_column[row_index] = coupling[row_index * size + column_index];
+               }
+               this->solve_block(next_block, next_size, gain_column);
+            }
+            // P_k = A_kk - A_{k,k+1} G_k (lower triangular part)
+            for (size_t column_index: Range(size)) {
+               const double* gain_column = gain + column_index * next_size;
+               for (size_t row_index: Range(column_index, size)) {
+                  double product = 0.;
+                  for (size_t index: Range(next_size)) {
+                     product += coupling[index * size + row_index] * gain_column[index];
+                  }
+                  block[column_index * size + row_index] -= product;
+               }
+            }
+         }
+         this->factorize_block(block, size);
+      }
+   }
+
+   void RiccatiSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) {
+      if (not this->is_block_tridiagonal) {
+         this->fallback_solver->solve_indefinite_system(matrix, rhs, result);
+         return;
+      }
+      for (size_t position: Range(this->factorized_dimension)) {
+         this->workspace[position] = rhs[this->stage_rows[position]];
+      }
+      // backward sweep: b_k <- b_k - G_k^T b_{k+1}
+      const size_t number_stages = this->stage_starts.size() - 1;
+      for (size_t stage = std::max<size_t>(number_stages, 1) - 1; stage-- > 0;) {
+         const size_t size = this->stage_size(stage);
+         const size_t next_size = this->stage_size(stage + 1);
+         const double* gain = this->gain_blocks.data() + this->coupling_offsets[stage];
+         double* current = this->workspace.data() + this->stage_starts[stage];
+         const double* next = this->workspace.data() + this->stage_starts[stage + 1];
+         for (size_t index: Range(size)) {
+            for (size_t next_index: Range(next_size)) {
+               current[index] -= gain[index * next_size + next_index] * next[next_index];
+            }
+         }
+      }
+      // forward sweep: x_k = P_k^{-1} b_k - G_{k-1} x_{k-1}
+      for (size_t stage: Range(number_stages)) {
+         const size_t size = this->stage_size(stage);
+         double* current = this->workspace.data() + this->stage_starts[stage];
+         this->solve_block(this->diagonal_blocks.data() + this->diagonal_offsets[stage], size, current);
+         if (0 < stage) {
+            const size_t previous_size = this->stage_size(stage - 1);
+            const double* gain = this->gain_blocks.data() + this->coupling_offsets[stage - 1];
+            const double* previous = this->workspace.data() + this->stage_starts[stage - 1];
+            for (size_t previous_index: Range(previous_size)) {
+               for (size_t index: Range(size)) {
+                  current[index] -= gain[previous_index * size + index] * previous[previous_index];
+               }
+            }
+         }
+      }
+      for (size_t position: Range(this->factorized_dimension)) {
+         result[this->stage_rows[position]] = this->workspace[position];
+      }
+   }
+
+   std::tuple<size_t, size_t, size_t> RiccatiSolver::get_inertia() const {
+      if (not this->is_block_tridiagonal) {
+         return this->fallback_solver->get_inertia();
+      }
+      return std::make_tuple(this->number_positive_pivots, this->number_negative_pivots, this->number_zero_pivots);
+   }
+
+   size_t RiccatiSolver::number_negative_eigenvalues() const {
+      if (not this->is_block_tridiagonal) {
+         return this->fallback_solver->number_negative_eigenvalues();
+      }
+      return this->number_negative_pivots;
+   }
+
+   bool RiccatiSolver::matrix_is_singular() const {
+      if (not this->is_block_tridiagonal) {
+         return this->fallback_solver->matrix_is_singular();
+      }
+      return (0 < this->number_zero_pivots);
+   }
+
+   size_t RiccatiSolver::rank() const {
+      if (not this->is_block_tridiagonal) {
+         return this->fallback_solver->rank();
+      }
+      return this->factorized_dimension - this->number_zero_pivots;
+   }
+
+   bool RiccatiSolver::requires_quasidefinite_matrix() const {
+      return true;
+   }
+
+   bool RiccatiSolver::uses_recursion() const {
+      return this->is_block_tridiagonal;
+   }
+
+   // group the rows by stage and check that the matrix is block tridiagonal
+   bool RiccatiSolver::analyze_stages(const SymmetricMatrix<size_t, double>& matrix) {
+      const size_t dimension = matrix.dimension();
+      if (this->stages.size() != dimension) {
+         // e.g. no stage structure, or a matrix that is not the augmented system of the problem
+         DEBUG << "RiccatiSolver: no stages for a matrix of dimension " << dimension << ", falling back to the quasidefinite LDL^T solver\n";
+         return false;
+      }
+      for (const auto [row_index, column_index, element]: matrix) {
+         const size_t row_stage = this->stages[row_index];
+         const size_t column_stage = this->stages[column_index];
+         if (1 < std::max(row_stage, column_stage) - std::min(row_stage, column_stage)) {
+            WARNING << "RiccatiSolver: the entry (" << row_index << ", " << column_index << ") couples the nonadjacent stages " << row_stage <<
+               " and " << column_stage << ", falling back to the quasidefinite LDL^T solver\n";
+            return false;
+         }
+      }
+      this->factorized_dimension = dimension;
+      const size_t number_stages = (dimension == 0) ? 0 : *std::max_element(this->stages.begin(), this->stages.end()) + 1;
+
+      // counting sort of the rows by stage
+      this->stage_starts.assign(number_stages + 1, 0);
+      for (size_t row_index: Range(dimension)) {
+         this->stage_starts[this->stages[row_index] + 1]++;
+      }
+      for (size_t stage: Range(number_stages)) {
+         this->stage_starts[stage + 1] += this->stage_starts[stage];
+      }
+      this->stage_rows.resize(dimension);
+      this->local_indices.resize(dimension);
+      std::vector<size_t> next_position(this->stage_starts.begin(), this->stage_starts.end() - 1);
+      for (size_t row_index: Range(dimension)) {
+         const size_t stage = this->stages[row_index];
+         this->local_indices[row_index] = next_position[stage] - this->stage_starts[stage];
+         this->stage_rows[next_position[stage]++] = row_index;
+      }
+
+      // offsets of the dense blocks
+      this->diagonal_offsets.assign(number_stages + 1, 0);
+      this->coupling_offsets.assign(number_stages, 0);
+      size_t maximum_stage_size = 0;
+      for (size_t stage: Range(number_stages)) {
+         const size_t size = this->stage_size(stage);
+         maximum_stage_size = std::max(maximum_stage_size, size);
+         this->diagonal_offsets[stage + 1] = this->diagonal_offsets[stage] + size * size;
+         if (stage + 1 < number_stages) {
+            this->coupling_offsets[stage + 1] = this->coupling_offsets[stage] + size * this->stage_size(stage + 1);
+         }
+      }
+      this->diagonal_blocks.resize(this->diagonal_offsets.back());
+      const size_t coupling_size = (number_stages == 0) ? 0 : this->coupling_offsets[number_stages - 1];
+      this->coupling_blocks.resize(coupling_size);
+      this->gain_blocks.resize(coupling_size);
+      DEBUG << "RiccatiSolver: " << number_stages << " stages of size at most " << maximum_stage_size << '\n';
+      return true;
+   }
+
+   size_t RiccatiSolver::stage_size(size_t stage) const {
+      return this->stage_starts[stage + 1] - this->stage_starts[stage];
+   }
+
+   // in-place dense LDL^T factorization (lower triangular part, column major) with static pivoting
+   void RiccatiSolver::factorize_block(double* block, size_t size) {
+      for (size_t column_index: Range(size)) {
+         // workspace: L_jp d_p for p < j
+         double pivot = block[column_index * size + column_index];
+         for (size_t index: Range(column_index)) {
+            const double factor_entry = block[index * size + column_index];
+            this->workspace[index] = factor_entry * block[index * size + index];
+            pivot -= factor_entry * this->workspace[index];
+         }
+         if (std::abs(pivot) <= RiccatiSolver::zero_pivot_tolerance) {
+            this->number_zero_pivots++;
+            pivot = (pivot < 0.) ? -RiccatiSolver::static_pivot : RiccatiSolver::static_pivot;
+         }
+         else if (0. < pivot) {
+            this->number_positive_pivots++;
+         }
+         else {
+            this->number_negative_pivots++;
+         }
+         block[column_index * size + column_index] = pivot;
+         for (size_t row_index: Range(column_index + 1, size)) {
+            double entry = block[column_index * size + row_index];
+            for (size_t index: Range(column_index)) {
+               entry -= block[index * size + row_index] * this->workspace[index];
+            }
+            block[column_index * size + row_index] = entry / pivot;
+         }
+      }
+   }
+
+   void RiccatiSolver::solve_block(const double* block, size_t size, double* vector) const {
+      for (size_t column_index: Range(size)) {
+         for (size_t row_index: Range(column_index + 1, size)) {
+            vector[row_index] -= block[column_index * size + row_index] * vector[column_index];
+         }
+      }
+      for (size_t index: Range(size)) {
+         vector[index] /= block[index * size + index];
+      }
+      for (size_t column_index = size; column_index-- > 0;) {
+         for (size_t row_index: Range(column_index + 1, size)) {
+            vector[column_index] -= block[column_index * size + row_index] * vector[row_index];
+         }
+      }
+   }
+} // namespace
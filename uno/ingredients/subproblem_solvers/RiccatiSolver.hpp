@@ -0,0 +1,71 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_RICCATISOLVER_H
+#define UNO_RICCATISOLVER_H
+
+#include <memory>
+#include <vector>
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "QuasidefiniteLDLSolver.hpp"
+
+namespace uno {
+   /*! \class RiccatiSolver
+    * \brief Block-tridiagonal factorization of the KKT systems of multistage problems
+    *
+    *  The rows of the matrix are grouped by stage (see Model::get_stages); the matrix is block tridiagonal if every nonzero couples
+    *  rows of the same or of adjacent stages. The backward Riccati recursion P_{S-1} = A_{S-1,S-1},
+    *  P_k = A_kk - A_{k,k+1} P_{k+1}^{-1} A_{k,k+1}^T is a block congruence: the inertia of the matrix is the sum of the inertias of
+    *  the P_k, each factorized with a dense LDL^T factorization with static pivoting (like QuasidefiniteLDLSolver). The cost is linear
+    *  in the number of stages and cubic in the size of the stages.
+    *  Without stages or if the matrix is not block tridiagonal, the solver falls back to the sparse quasidefinite LDL^T factorization.
+    */
+   class RiccatiSolver : public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   public:
+      RiccatiSolver(size_t dimension, size_t number_nonzeros);
+      ~RiccatiSolver() override = default;
+
+      void set_stages(const std::vector<size_t>& stages) override;
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] bool requires_quasidefinite_matrix() const override;
+      [[nodiscard]] bool uses_recursion() const;
+
+   protected:
+      const size_t number_nonzeros;
+      std::vector<size_t> stages{};
+      bool is_block_tridiagonal{false};
+      size_t factorized_dimension{0};
+      // rows sorted by stage, offsets of the stages and local index of each row in its stage
+      std::vector<size_t> stage_starts{};
+      std::vector<size_t> stage_rows{};
+      std::vector<size_t> local_indices{};
+      // dense blocks (column major): diagonal blocks A_kk overwritten by the LDL^T factors of P_k, coupling blocks A_{k,k+1} and
+      // G_k = P_{k+1}^{-1} A_{k,k+1}^T
+      std::vector<size_t> diagonal_offsets{};
+      std::vector<size_t> coupling_offsets{};
+      std::vector<double> diagonal_blocks{};
+      std::vector<double> coupling_blocks{};
+      std::vector<double> gain_blocks{};
+      std::vector<double> workspace{};
+      size_t number_positive_pivots{0};
+      size_t number_negative_pivots{0};
+      size_t number_zero_pivots{0};
+      std::unique_ptr<QuasidefiniteLDLSolver> fallback_solver{};
+      static constexpr double zero_pivot_tolerance{1e-14};
+      static constexpr double static_pivot{1e-8};
+
+      [[nodiscard]] bool analyze_stages(const SymmetricMatrix<size_t, double>& matrix);
+      [[nodiscard]] size_t stage_size(size_t stage) const;
+      void factorize_block(double* block, size_t size);
+      void solve_block(const double* block, size_t size, double* vector) const;
+   };
+} // namespace
+
+#endif // UNO_RICCATISOLVER_H
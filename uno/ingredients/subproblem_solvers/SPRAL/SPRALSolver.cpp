@@ -0,0 +1,171 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include "SPRALSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/IntegerCast.hpp"
+#include "tools/Logger.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace uno {
+   SPRALSolver::SPRALSolver(size_t dimension, size_t number_nonzeros) : DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension) {
+      SPRALSolver::check_openmp_environment();
+      this->column_starts.reserve(dimension + 1);
+      this->row_indices.reserve(number_nonzeros);
+      this->entries.reserve(number_nonzeros);
+      this->positions.reserve(number_nonzeros);
+      // set the default values of the controlling parameters
+      spral_ssids_default_options(&this->options);
+      this->options.array_base = 0; // C indexing
+      this->options.print_level = -1; // no printing
+      this->options.use_gpu = false; // CPU/OpenMP mode
+      this->options.action = true; // continue the factorization of singular matrices
+   }
+
+   SPRALSolver::~SPRALSolver() {
+      spral_ssids_free(&this->akeep, &this->fkeep);
+   }
+
+   void SPRALSolver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "SPRALSolver: the dimension of the matrix is larger than the preallocated size");
+
+      // build the internal matrix representation
+      this->save_sparsity_pattern_internally(matrix);
+
+      // discard the previous analysis and factors
+      spral_ssids_free(&this->akeep, &this->fkeep);
+      // symbolic analysis (the sparsity pattern is clean, no check needed)
+      spral_ssids_analyse(false, this->n, nullptr, this->column_starts.data(), this->row_indices.data(), nullptr, &this->akeep, &this->options,
+            &this->inform);
+      SPRALSolver::check_flag(this->inform, "symbolic analysis");
+   }
+
+   void SPRALSolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(this->akeep != nullptr && "SPRALSolver: the symbolic analysis was not performed");
+      assert(this->positions.size() == matrix.number_nonzeros() && "SPRALSolver: the numbers of nonzeros do not match");
+
+      // scatter the matrix entries into the CSC arrays (duplicates are summed)
+      std::fill(this->entries.begin(), this->entries.end(), 0.);
+      size_t nonzero_index = 0;
+      for (const auto [row_index, column_index, entry]: matrix) {
+         this->entries[this->positions[nonzero_index]] += entry;
+         nonzero_index++;
+      }
+
+      // numerical factorization (the symbolic analysis stored in akeep is reused, the factors in fkeep are overwritten)
+      spral_ssids_factor(false, this->column_starts.data(), this->row_indices.data(), this->entries.data(), nullptr, this->akeep, &this->fkeep,
+            &this->options, &this->inform);
+      SPRALSolver::check_flag(this->inform, "numerical factorization");
+   }
+
+   void SPRALSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& rhs, Vector<double>& result) {
+      // copy rhs into result (overwritten by SSIDS)
+      result = rhs;
+      // the solve resets all the fields of the inform structure: keep the inertia computed by the factorization
+      spral_ssids_inform solve_inform{};
+      spral_ssids_solve1(0, result.data(), this->akeep, this->fkeep, &this->options, &solve_inform);
+      SPRALSolver::check_flag(solve_inform, "solve");
+   }
+
+   std::tuple<size_t, size_t, size_t> SPRALSolver::get_inertia() const {
+      // rank = number_positive_eigenvalues + number_negative_eigenvalues
+      // n = rank + number_zero_eigenvalues
+      const size_t rank = this->rank();
+      const size_t number_negative_eigenvalues = this->number_negative_eigenvalues();
+      const size_t number_positive_eigenvalues = rank - number_negative_eigenvalues;
+      const size_t number_zero_eigenvalues = static_cast<size_t>(this->n) - rank;
+      return std::make_tuple(number_positive_eigenvalues, number_negative_eigenvalues, number_zero_eigenvalues);
+   }
+
+   size_t SPRALSolver::number_negative_eigenvalues() const {
+      return static_cast<size_t>(this->inform.num_neg);
+   }
+
+   bool SPRALSolver::matrix_is_singular() const {
+      return (this->inform.matrix_rank < this->n);
+   }
+
+   size_t SPRALSolver::rank() const {
+      return static_cast<size_t>(this->inform.matrix_rank);
+   }
+
+   void SPRALSolver::save_sparsity_pattern_internally(const SymmetricMatrix<size_t, double>& matrix) {
+      // the row indices are 32-bit integers, the column starts are 64-bit integers
+      this->n = checked_integer_cast<int>(matrix.dimension(), "SSIDS: the dimension of the matrix");
+
+      // sort the nonzeros of the lower triangular part by (column, row): entry (i, j) is stored as (max(i, j), min(i, j))
+      std::vector<std::tuple<size_t, size_t, size_t>> nonzeros{}; // (column, row, index in the iteration order)
+      nonzeros.reserve(matrix.number_nonzeros());
+      for (const auto [row_index, column_index, _]: matrix) {
+         nonzeros.emplace_back(std::min(row_index, column_index), std::max(row_index, column_index), nonzeros.size());
+      }
+      std::sort(nonzeros.begin(), nonzeros.end());
+
+      // build the CSC arrays and merge the duplicates
+      this->column_starts.assign(matrix.dimension() + 1, 0);
+      this->row_indices.clear();
+      this->positions.resize(nonzeros.size());
+      for (size_t nonzero_index: Range(nonzeros.size())) {
+         const auto [column_index, row_index, original_index] = nonzeros[nonzero_index];
+         const bool is_duplicate = (0 < nonzero_index && std::get<0>(nonzeros[nonzero_index - 1]) == column_index &&
+               std::get<1>(nonzeros[nonzero_index - 1]) == row_index);
+         if (not is_duplicate) {
+            this->row_indices.emplace_back(static_cast<int>(row_index));
+            this->column_starts[column_index + 1]++;
+         }
+         this->positions[original_index] = this->row_indices.size() - 1;
+      }
+      for (size_t column_index: Range(matrix.dimension())) {
+         this->column_starts[column_index + 1] += this->column_starts[column_index];
+      }
+      this->entries.resize(this->row_indices.size());
+   }
+
+   // SSIDS fails without OpenMP cancellation and is slow without thread binding. The OpenMP runtime reads the environment variables
+   // at startup: they cannot be set by Uno
+   void SPRALSolver::check_openmp_environment() {
+#ifdef _OPENMP
+      const bool has_cancellation = (omp_get_cancellation() != 0);
+      const bool has_thread_binding = (omp_get_proc_bind() != omp_proc_bind_false);
+#else
+      const auto is_set = [](const char* variable_name, bool is_false_value_allowed) {
+         const char* value = std::getenv(variable_name);
+         if (value == nullptr) {
+            return false;
+         }
+         std::string lowercase_value(value);
+         std::transform(lowercase_value.begin(), lowercase_value.end(), lowercase_value.begin(),
+               [](unsigned char character) { return static_cast<char>(std::tolower(character)); });
+         return is_false_value_allowed ? (lowercase_value != "false") : (lowercase_value == "true");
+      };
+      const bool has_cancellation = is_set("OMP_CANCELLATION", false);
+      // OMP_PROC_BIND also accepts binding policies (close, spread, ...)
+      const bool has_thread_binding = is_set("OMP_PROC_BIND", true);
+#endif
+      if (not has_cancellation || not has_thread_binding) {
+         throw std::runtime_error("SSIDS requires the environment variables OMP_CANCELLATION=TRUE and OMP_PROC_BIND=TRUE, set before "
+               "the program is started");
+      }
+   }
+
+   void SPRALSolver::check_flag(const spral_ssids_inform& inform, const char* phase) {
+      if (inform.flag < 0) {
+         throw std::runtime_error("SSIDS: the " + std::string(phase) + " failed with flag " + std::to_string(inform.flag));
+      }
+      else if (0 < inform.flag) {
+         DEBUG << "SSIDS has issued a warning during the " << phase << ": flag = " << inform.flag << '\n';
+      }
+   }
+} // namespace
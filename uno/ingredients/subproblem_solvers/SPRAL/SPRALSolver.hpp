@@ -0,0 +1,60 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPRALSOLVER_H
+#define UNO_SPRALSOLVER_H
+
+#include <cstdint>
+#include <vector>
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "spral_ssids.h"
+
+namespace uno {
+   // forward declaration
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class SPRALSolver
+    * \brief Interface for SSIDS (SPRAL)
+    * see https://github.com/ralna/spral
+    *
+    *  Interface to the multicore symmetric indefinite linear solver SSIDS (CPU/OpenMP mode).
+    *  SSIDS requires the environment variables OMP_CANCELLATION=TRUE and OMP_PROC_BIND=TRUE (checked at construction).
+    */
+   class SPRALSolver : public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   public:
+      SPRALSolver(size_t dimension, size_t number_nonzeros);
+      ~SPRALSolver() override;
+
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      // [[nodiscard]] bool matrix_is_positive_definite() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+
+   protected:
+      int n{0};
+      spral_ssids_options options{};
+      spral_ssids_inform inform{};
+      // opaque structures that hold the symbolic analysis and the factors
+      void* akeep{nullptr};
+      void* fkeep{nullptr};
+
+      // lower triangular part of the matrix in CSC format (0-based, sorted rows without duplicates)
+      std::vector<int64_t> column_starts{};
+      std::vector<int> row_indices{};
+      std::vector<double> entries{};
+      // position of each matrix nonzero (in the iteration order of the matrix) in the CSC arrays
+      std::vector<size_t> positions{};
+
+      void save_sparsity_pattern_internally(const SymmetricMatrix<size_t, double>& matrix);
+      static void check_openmp_environment();
+      static void check_flag(const spral_ssids_inform& inform, const char* phase);
+   };
+} // namespace
+
+#endif // UNO_SPRALSOLVER_H
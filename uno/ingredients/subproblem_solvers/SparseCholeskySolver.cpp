@@ -0,0 +1,93 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include "SparseCholeskySolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   SparseCholeskySolver::SparseCholeskySolver(size_t dimension, size_t number_nonzeros): SparseSymbolicFactorization(dimension, number_nonzeros) {
+   }
+
+   void SparseCholeskySolver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix, size_t dimension) {
+      this->factorization_successful = false;
+      SparseSymbolicFactorization::do_symbolic_analysis(matrix, dimension);
+   }
+
+   bool SparseCholeskySolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix, double regularization) {
+      assert(matrix.number_nonzeros() == this->permuted_position.size() && "SparseCholeskySolver: the symbolic analysis is out of date");
+      this->scatter_entries(matrix);
+
+      // up-looking factorization: compute the k-th row of L at step k
+      std::copy(this->factor_column_starts.begin(), this->factor_column_starts.begin() + static_cast<std::ptrdiff_t>(this->factorized_dimension),
+            this->next_position.begin());
+      std::fill(this->marker.begin(), this->marker.end(), NO_INDEX);
+      this->factorization_successful = false;
+      for (size_t k: Range(this->factorized_dimension)) {
+         const size_t top = this->compute_row_pattern(k);
+         // scatter the k-th column of the upper triangular part
+         for (size_t position: Range(this->permuted_column_starts[k], this->permuted_column_starts[k + 1])) {
+            this->dense_workspace[this->permuted_row_indices[position]] += this->permuted_entries[position];
+         }
+         double pivot = this->dense_workspace[k] + regularization;
+         this->dense_workspace[k] = 0.;
+         // sparse triangular solve with the rows of the pattern (in topological order)
+         for (size_t pattern_index: Range(top, this->factorized_dimension)) {
+            const size_t row_index = this->row_pattern[pattern_index];
+            const double factor_entry = this->dense_workspace[row_index] / this->factor_entries[this->factor_column_starts[row_index]];
+            this->dense_workspace[row_index] = 0.;
+            for (size_t position: Range(this->factor_column_starts[row_index] + 1, this->next_position[row_index])) {
+               this->dense_workspace[this->factor_row_indices[position]] -= this->factor_entries[position] * factor_entry;
+            }
+            pivot -= factor_entry * factor_entry;
+            const size_t position = this->next_position[row_index]++;
+            this->factor_row_indices[position] = k;
+            this->factor_entries[position] = factor_entry;
+         }
+         // early exit: the matrix is not positive definite
+         if (not (0. < pivot)) {
+            return false;
+         }
+         const size_t position = this->next_position[k]++;
+         this->factor_row_indices[position] = k;
+         this->factor_entries[position] = std::sqrt(pivot);
+      }
+      this->factorization_successful = true;
+      return true;
+   }
+
+   void SparseCholeskySolver::solve(const Vector<double>& rhs, Vector<double>& result) {
+      if (not this->factorization_successful) {
+         throw std::runtime_error("SparseCholeskySolver::solve: the matrix was not successfully factorized");
+      }
+      // permute the right-hand side
+      for (size_t index: Range(this->factorized_dimension)) {
+         this->dense_workspace[index] = rhs[this->permutation[index]];
+      }
+      // forward substitution with L
+      for (size_t column_index: Range(this->factorized_dimension)) {
+         this->dense_workspace[column_index] /= this->factor_entries[this->factor_column_starts[column_index]];
+         for (size_t position: Range(this->factor_column_starts[column_index] + 1, this->factor_column_starts[column_index + 1])) {
+            this->dense_workspace[this->factor_row_indices[position]] -= this->factor_entries[position] * this->dense_workspace[column_index];
+         }
+      }
+      // backward substitution with L^T
+      for (size_t column_index = this->factorized_dimension; column_index-- > 0;) {
+         for (size_t position: Range(this->factor_column_starts[column_index] + 1, this->factor_column_starts[column_index + 1])) {
+            this->dense_workspace[column_index] -= this->factor_entries[position] * this->dense_workspace[this->factor_row_indices[position]];
+         }
+         this->dense_workspace[column_index] /= this->factor_entries[this->factor_column_starts[column_index]];
+      }
+      // permute back the solution
+      for (size_t index: Range(this->factorized_dimension)) {
+         result[this->permutation[index]] = this->dense_workspace[index];
+         this->dense_workspace[index] = 0.;
+      }
+   }
+
+} // namespace
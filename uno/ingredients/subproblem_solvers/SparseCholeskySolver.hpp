@@ -0,0 +1,30 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPARSECHOLESKYSOLVER_H
+#define UNO_SPARSECHOLESKYSOLVER_H
+
+#include "SparseSymbolicFactorization.hpp"
+
+namespace uno {
+   // forward declaration
+   template <typename ElementType>
+   class Vector;
+
+   // up-looking sparse Cholesky factorization P (A + delta I) P^T = L L^T of the leading block of a symmetric matrix.
+   // The numerical factorization stops at the first nonpositive pivot, which makes it a cheap test of positive definiteness.
+   class SparseCholeskySolver : public SparseSymbolicFactorization {
+   public:
+      SparseCholeskySolver(size_t dimension, size_t number_nonzeros);
+
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix, size_t dimension);
+      // returns false if a nonpositive pivot was encountered
+      [[nodiscard]] bool do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix, double regularization = 0.);
+      void solve(const Vector<double>& rhs, Vector<double>& result);
+
+   protected:
+      bool factorization_successful{false};
+   };
+} // namespace
+
+#endif // UNO_SPARSECHOLESKYSOLVER_H
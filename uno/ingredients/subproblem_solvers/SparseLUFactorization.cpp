@@ -0,0 +1,281 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "SparseLUFactorization.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   SparseLUFactorization::SparseLUFactorization(size_t number_rows, size_t number_columns, double pivot_threshold):
+         pivot_threshold(pivot_threshold),
+         active_rows(number_rows),
+         column_rows(number_columns),
+         column_counts(number_columns),
+         is_row_active(number_rows),
+         dense_workspace(number_rows) {
+      this->pivot_rows.reserve(number_rows);
+      this->basic_columns.reserve(number_rows);
+      this->column_position.reserve(number_columns);
+   }
+
+   bool SparseLUFactorization::factorize(const RectangularMatrix<double>& matrix, size_t number_rows, size_t number_columns,
+         const std::vector<double>& column_priorities) {
+      this->number_rows = number_rows;
+      this->number_columns = number_columns;
+      this->pivot_rows.assign(number_rows, 0);
+      this->basic_columns.assign(number_rows, 0);
+      this->column_position.assign(number_columns, NOT_BASIC);
+      if (number_columns < number_rows) {
+         return false;
+      }
+      this->load_matrix(matrix);
+
+      double maximum_priority = -INF<double>;
+      for (size_t column_index: Range(number_columns)) {
+         maximum_priority = std::max(maximum_priority, column_priorities[column_index]);
+      }
+      for (size_t step: Range(number_rows)) {
+         // Markowitz pivoting with a relative threshold: the rows are visited by increasing number of nonzeros until a column with
+         // the largest priority is found. Among the stable candidates, prefer a larger priority, then a smaller Markowitz count
+         size_t pivot_row = NOT_BASIC;
+         size_t pivot_column = NOT_BASIC;
+         size_t pivot_markowitz_count = 0;
+         for (const auto& [row_count, row_index]: this->rows_by_count) {
+            const auto& row = this->active_rows[row_index];
+            double largest_entry = 0.;
+            for (const auto& [column_index, entry]: row) {
+               largest_entry = std::max(largest_entry, std::abs(entry));
+            }
+            // numerically empty row: the matrix is rank deficient
+            if (largest_entry <= 1e-12) {
+               return false;
+            }
+            for (const auto& [column_index, entry]: row) {
+               if (this->pivot_threshold * largest_entry <= std::abs(entry)) {
+                  const size_t markowitz_count = (row_count - 1) * (this->column_counts[column_index] - 1);
+                  if (pivot_column == NOT_BASIC || column_priorities[pivot_column] < column_priorities[column_index] ||
+                        (column_priorities[pivot_column] == column_priorities[column_index] && markowitz_count < pivot_markowitz_count)) {
+                     pivot_row = row_index;
+                     pivot_column = column_index;
+                     pivot_markowitz_count = markowitz_count;
+                  }
+               }
+            }
+            if (column_priorities[pivot_column] == maximum_priority) {
+               break;
+            }
+         }
+         this->eliminate(step, pivot_row, pivot_column);
+      }
+      this->extract_upper_factor();
+      return true;
+   }
+
+   bool SparseLUFactorization::refactorize(const RectangularMatrix<double>& matrix) {
+      this->load_matrix(matrix);
+      for (size_t step: Range(this->number_rows)) {
+         const size_t pivot_row = this->pivot_rows[step];
+         const size_t pivot_column = this->basic_columns[step];
+         double largest_entry = 0.;
+         for (const auto& [column_index, entry]: this->active_rows[pivot_row]) {
+            largest_entry = std::max(largest_entry, std::abs(entry));
+         }
+         // the previous pivot must remain (loosely) stable
+         const double pivot = SparseLUFactorization::find_entry(this->active_rows[pivot_row], pivot_column);
+         if (largest_entry <= 1e-12 || std::abs(pivot) < 0.1 * this->pivot_threshold * largest_entry) {
+            return false;
+         }
+         this->eliminate(step, pivot_row, pivot_column);
+      }
+      this->extract_upper_factor();
+      return true;
+   }
+
+   void SparseLUFactorization::solve(const Vector<double>& rhs, Vector<double>& result) const {
+      for (size_t row_index: Range(this->number_rows)) {
+         this->dense_workspace[row_index] = rhs[row_index];
+      }
+      // apply the elimination steps
+      for (size_t step: Range(this->number_rows)) {
+         const double pivot_rhs = this->dense_workspace[this->pivot_rows[step]];
+         for (const auto& [row_index, multiplier]: this->lower_factor[step]) {
+            this->dense_workspace[row_index] -= multiplier * pivot_rhs;
+         }
+      }
+      // backward substitution with U
+      for (size_t step = this->number_rows; step-- > 0;) {
+         double value = this->dense_workspace[this->pivot_rows[step]];
+         for (const auto& [position, entry]: this->upper_factor[step]) {
+            value -= entry * result[position];
+         }
+         result[step] = value / this->pivots[step];
+      }
+   }
+
+   void SparseLUFactorization::solve_transpose(const Vector<double>& rhs, Vector<double>& result) const {
+      // forward substitution with U^T (column-oriented)
+      for (size_t step: Range(this->number_rows)) {
+         this->dense_workspace[step] = rhs[step];
+      }
+      for (size_t step: Range(this->number_rows)) {
+         const double value = this->dense_workspace[step] / this->pivots[step];
+         this->dense_workspace[step] = value;
+         for (const auto& [position, entry]: this->upper_factor[step]) {
+            this->dense_workspace[position] -= entry * value;
+         }
+      }
+      for (size_t step: Range(this->number_rows)) {
+         result[this->pivot_rows[step]] = this->dense_workspace[step];
+      }
+      // apply the transposed elimination steps in reverse order
+      for (size_t step = this->number_rows; step-- > 0;) {
+         double value = result[this->pivot_rows[step]];
+         for (const auto& [row_index, multiplier]: this->lower_factor[step]) {
+            value -= multiplier * result[row_index];
+         }
+         result[this->pivot_rows[step]] = value;
+      }
+   }
+
+   const std::vector<size_t>& SparseLUFactorization::get_basic_columns() const {
+      return this->basic_columns;
+   }
+
+   bool SparseLUFactorization::is_basic(size_t column_index) const {
+      return (this->column_position[column_index] != NOT_BASIC);
+   }
+
+   size_t SparseLUFactorization::number_factor_nonzeros() const {
+      size_t number_nonzeros = this->number_rows;
+      for (size_t step: Range(this->number_rows)) {
+         number_nonzeros += this->lower_factor[step].size() + this->upper_factor[step].size();
+      }
+      return number_nonzeros;
+   }
+
+   void SparseLUFactorization::load_matrix(const RectangularMatrix<double>& matrix) {
+      this->rows_by_count.clear();
+      std::fill(this->column_counts.begin(), this->column_counts.begin() + static_cast<std::ptrdiff_t>(this->number_columns), 0);
+      for (size_t column_index: Range(this->number_columns)) {
+         this->column_rows[column_index].clear();
+      }
+      this->lower_factor.resize(this->number_rows);
+      this->upper_factor.resize(this->number_rows);
+      this->eliminated_rows.resize(this->number_rows);
+      this->pivots.resize(this->number_rows);
+      for (size_t row_index: Range(this->number_rows)) {
+         this->lower_factor[row_index].clear();
+         this->upper_factor[row_index].clear();
+         // sort the row and merge the duplicates
+         auto& row = this->active_rows[row_index];
+         row.clear();
+         for (const auto [column_index, entry]: matrix[row_index]) {
+            row.emplace_back(column_index, entry);
+         }
+         std::sort(row.begin(), row.end(), [](const auto& entry1, const auto& entry2) { return entry1.first < entry2.first; });
+         size_t number_unique_entries = 0;
+         for (size_t index: Range(row.size())) {
+            if (0 < number_unique_entries && row[number_unique_entries - 1].first == row[index].first) {
+               row[number_unique_entries - 1].second += row[index].second;
+            }
+            else {
+               row[number_unique_entries++] = row[index];
+            }
+         }
+         row.resize(number_unique_entries);
+         for (const auto& [column_index, entry]: row) {
+            this->column_rows[column_index].emplace_back(row_index);
+            this->column_counts[column_index]++;
+         }
+         this->is_row_active[row_index] = true;
+         this->rows_by_count.emplace(row.size(), row_index);
+      }
+   }
+
+   void SparseLUFactorization::eliminate(size_t step, size_t pivot_row, size_t pivot_column) {
+      assert(this->is_row_active[pivot_row] && "SparseLUFactorization: the pivot row was already eliminated");
+      this->pivot_rows[step] = pivot_row;
+      this->basic_columns[step] = pivot_column;
+      this->column_position[pivot_column] = step;
+      this->rows_by_count.erase({this->active_rows[pivot_row].size(), pivot_row});
+      this->is_row_active[pivot_row] = false;
+      const auto& pivot_entries = this->active_rows[pivot_row];
+      for (const auto& [column_index, entry]: pivot_entries) {
+         this->column_counts[column_index]--;
+      }
+      const double pivot = SparseLUFactorization::find_entry(pivot_entries, pivot_column);
+      this->pivots[step] = pivot;
+
+      // row_i := row_i - (a_ic / pivot) * pivot_row for the active rows i with a nonzero in the pivot column
+      for (size_t row_index: this->column_rows[pivot_column]) {
+         if (not this->is_row_active[row_index]) {
+            continue;
+         }
+         auto& row = this->active_rows[row_index];
+         const double multiplier = SparseLUFactorization::find_entry(row, pivot_column) / pivot;
+         this->lower_factor[step].emplace_back(row_index, multiplier);
+         this->rows_by_count.erase({row.size(), row_index});
+
+         this->merged_row.clear();
+         size_t row_position = 0, pivot_position = 0;
+         while (row_position < row.size() || pivot_position < pivot_entries.size()) {
+            const size_t row_column = (row_position < row.size()) ? row[row_position].first : NOT_BASIC;
+            const size_t pivot_entries_column = (pivot_position < pivot_entries.size()) ? pivot_entries[pivot_position].first : NOT_BASIC;
+            if (row_column == pivot_column) { // eliminated entry
+               this->column_counts[pivot_column]--;
+               row_position++;
+               if (pivot_entries_column == pivot_column) {
+                  pivot_position++;
+               }
+            }
+            else if (pivot_entries_column == pivot_column) {
+               pivot_position++;
+            }
+            else if (row_column == pivot_entries_column) {
+               this->merged_row.emplace_back(row_column, row[row_position].second - multiplier * pivot_entries[pivot_position].second);
+               row_position++;
+               pivot_position++;
+            }
+            else if (row_column < pivot_entries_column) {
+               this->merged_row.emplace_back(row[row_position]);
+               row_position++;
+            }
+            else { // fill-in
+               this->merged_row.emplace_back(pivot_entries_column, -multiplier * pivot_entries[pivot_position].second);
+               this->column_rows[pivot_entries_column].emplace_back(row_index);
+               this->column_counts[pivot_entries_column]++;
+               pivot_position++;
+            }
+         }
+         row.swap(this->merged_row);
+         this->rows_by_count.emplace(row.size(), row_index);
+      }
+      this->column_rows[pivot_column].clear();
+      this->eliminated_rows[step].swap(this->active_rows[pivot_row]);
+   }
+
+   // keep the basic columns of the eliminated rows (the nonbasic part is not needed to solve with B)
+   void SparseLUFactorization::extract_upper_factor() {
+      for (size_t step: Range(this->number_rows)) {
+         for (const auto& [column_index, entry]: this->eliminated_rows[step]) {
+            const size_t position = this->column_position[column_index];
+            if (position != NOT_BASIC && position != step) {
+               assert(step < position && "SparseLUFactorization: the factor U is not upper triangular");
+               this->upper_factor[step].emplace_back(position, entry);
+            }
+         }
+      }
+   }
+
+   double SparseLUFactorization::find_entry(const std::vector<std::pair<size_t, double>>& row, size_t column_index) {
+      const auto iterator = std::lower_bound(row.begin(), row.end(), column_index, [](const auto& entry, size_t index) {
+         return entry.first < index;
+      });
+      return (iterator != row.end() && iterator->first == column_index) ? iterator->second : 0.;
+   }
+} // namespace
@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPARSELUFACTORIZATION_H
+#define UNO_SPARSELUFACTORIZATION_H
+
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace uno {
+   // forward declaration
+   template <typename ElementType>
+   class RectangularMatrix;
+   template <typename ElementType>
+   class Vector;
+
+   // right-looking sparse LU factorization of a basis B = A[:, basic] of a rectangular m x n matrix A (m <= n) stored by rows.
+   // The basic columns are selected during the factorization (Markowitz pivoting with a relative threshold); the columns with a larger
+   // priority are preferred, even in denser rows. The k-th pivot is (pivot_rows[k], basic_columns[k]).
+   class SparseLUFactorization {
+   public:
+      SparseLUFactorization(size_t number_rows, size_t number_columns, double pivot_threshold);
+
+      // selects the basic columns and factorizes B. Returns false if A is (numerically) rank deficient
+      [[nodiscard]] bool factorize(const RectangularMatrix<double>& matrix, size_t number_rows, size_t number_columns,
+            const std::vector<double>& column_priorities);
+      // numerical factorization with the current pivot sequence. Returns false if a pivot became unstable
+      [[nodiscard]] bool refactorize(const RectangularMatrix<double>& matrix);
+
+      // B x = rhs: rhs is indexed by the rows of A, result[k] is the value of the basic variable basic_columns[k]
+      void solve(const Vector<double>& rhs, Vector<double>& result) const;
+      // B^T y = rhs: rhs[k] corresponds to the basic variable basic_columns[k], result is indexed by the rows of A
+      void solve_transpose(const Vector<double>& rhs, Vector<double>& result) const;
+
+      [[nodiscard]] const std::vector<size_t>& get_basic_columns() const;
+      [[nodiscard]] bool is_basic(size_t column_index) const;
+      [[nodiscard]] size_t number_factor_nonzeros() const;
+
+      static constexpr size_t NOT_BASIC = static_cast<size_t>(-1);
+
+   protected:
+      const double pivot_threshold;
+      size_t number_rows{0};
+      size_t number_columns{0};
+
+      // pivot sequence
+      std::vector<size_t> pivot_rows{};
+      std::vector<size_t> basic_columns{};
+      std::vector<size_t> column_position{}; // position of each column in the pivot sequence (or NOT_BASIC)
+
+      // factors: multipliers of the k-th elimination step (row, multiplier) and k-th row of U (pivot position, entry), diagonal excluded
+      std::vector<std::vector<std::pair<size_t, double>>> lower_factor{};
+      std::vector<std::vector<std::pair<size_t, double>>> upper_factor{};
+      std::vector<double> pivots{};
+
+      // active submatrix (rows sorted by column index) and column -> rows lists (may contain stale rows)
+      std::vector<std::vector<std::pair<size_t, double>>> active_rows{};
+      std::vector<std::vector<size_t>> column_rows{};
+      std::vector<size_t> column_counts{};
+      std::vector<bool> is_row_active{};
+      std::set<std::pair<size_t, size_t>> rows_by_count{}; // (number of nonzeros, row)
+      std::vector<std::pair<size_t, double>> merged_row{}; // workspace
+      // pivot rows in their state at elimination time
+      std::vector<std::vector<std::pair<size_t, double>>> eliminated_rows{};
+      mutable std::vector<double> dense_workspace{};
+
+      void load_matrix(const RectangularMatrix<double>& matrix);
+      void eliminate(size_t step, size_t pivot_row, size_t pivot_column);
+      void extract_upper_factor();
+      [[nodiscard]] static double find_entry(const std::vector<std::pair<size_t, double>>& row, size_t column_index);
+   };
+} // namespace
+
+#endif // UNO_SPARSELUFACTORIZATION_H
@@ -0,0 +1,225 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "SparseSymbolicFactorization.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "preprocessing/ReverseCuthillMcKee.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      // a row is dense if it has more than max(16, 10 sqrt(n)) off-diagonal nonzeros
+      constexpr size_t minimum_dense_degree = 16;
+      constexpr double dense_degree_factor = 10.;
+   } // namespace
+
+   SparseSymbolicFactorization::SparseSymbolicFactorization(size_t dimension, size_t number_nonzeros) {
+      this->matrix_row_indices.reserve(number_nonzeros);
+      this->matrix_column_indices.reserve(number_nonzeros);
+      this->permuted_row_indices.reserve(number_nonzeros);
+      this->permuted_entries.reserve(number_nonzeros);
+      this->permuted_position.reserve(number_nonzeros);
+      this->permutation.reserve(dimension);
+      this->inverse_permutation.reserve(dimension);
+   }
+
+   bool SparseSymbolicFactorization::sparsity_changed(const SymmetricMatrix<size_t, double>& matrix, size_t dimension) const {
+      if (dimension != this->factorized_dimension || matrix.number_nonzeros() != this->matrix_row_indices.size()) {
+         return true;
+      }
+      size_t nonzero_index = 0;
+      for (const auto [row_index, column_index, entry]: matrix) {
+         if (row_index != this->matrix_row_indices[nonzero_index] || column_index != this->matrix_column_indices[nonzero_index]) {
+            return true;
+         }
+         nonzero_index++;
+      }
+      return false;
+   }
+
+   void SparseSymbolicFactorization::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix, size_t dimension) {
+      this->factorized_dimension = dimension;
+      // save the sparsity pattern
+      this->matrix_row_indices.clear();
+      this->matrix_column_indices.clear();
+      for (const auto [row_index, column_index, entry]: matrix) {
+         this->matrix_row_indices.emplace_back(row_index);
+         this->matrix_column_indices.emplace_back(column_index);
+      }
+
+      // allocate the workspaces
+      this->dense_workspace.assign(dimension, 0.);
+      this->marker.resize(dimension);
+      this->row_pattern.resize(dimension);
+      this->stack.resize(dimension);
+      this->next_position.resize(dimension);
+
+      this->compute_ordering();
+      this->compute_permuted_pattern();
+      this->compute_elimination_tree();
+      this->compute_factor_pattern();
+   }
+
+   size_t SparseSymbolicFactorization::number_dense_rows() const {
+      return this->dense_rows.size();
+   }
+
+   size_t SparseSymbolicFactorization::number_factor_nonzeros() const {
+      return this->factor_column_starts.empty() ? 0 : this->factor_column_starts[this->factorized_dimension];
+   }
+
+   // reverse Cuthill-McKee ordering of the adjacency graph of the matrix. The dense rows (e.g. a budget constraint in the Jacobian or a
+   // dense Hessian column) are removed from the graph and ordered last: otherwise, they connect all the nodes and the ordering produces
+   // a catastrophic fill. The factor is then that of the sparse remainder, bordered by the rows of the small dense Schur complement
+   void SparseSymbolicFactorization::compute_ordering() {
+      std::vector<std::vector<size_t>> adjacency(this->factorized_dimension);
+      for (size_t nonzero_index: Range(this->matrix_row_indices.size())) {
+         const size_t row_index = this->matrix_row_indices[nonzero_index];
+         const size_t column_index = this->matrix_column_indices[nonzero_index];
+         if (row_index != column_index && row_index < this->factorized_dimension && column_index < this->factorized_dimension) {
+            adjacency[row_index].emplace_back(column_index);
+            adjacency[column_index].emplace_back(row_index);
+         }
+      }
+      // dense rows (threshold of AMD)
+      const size_t dense_threshold = std::max(minimum_dense_degree,
+            static_cast<size_t>(dense_degree_factor * std::sqrt(static_cast<double>(this->factorized_dimension))));
+      std::vector<bool> is_dense(this->factorized_dimension, false);
+      this->dense_rows.clear();
+      for (size_t row_index: Range(this->factorized_dimension)) {
+         std::vector<size_t>& neighbors = adjacency[row_index];
+         std::sort(neighbors.begin(), neighbors.end());
+         neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+         if (dense_threshold < neighbors.size()) {
+            is_dense[row_index] = true;
+            this->dense_rows.emplace_back(row_index);
+         }
+      }
+      if (not this->dense_rows.empty()) {
+         DEBUG << "Symbolic analysis: " << this->dense_rows.size() << " dense rows (more than " << dense_threshold << " nonzeros) ordered last\n";
+         for (size_t row_index: Range(this->factorized_dimension)) {
+            std::vector<size_t>& neighbors = adjacency[row_index];
+            if (is_dense[row_index]) {
+               neighbors.clear();
+            }
+            else {
+               neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(), [&](size_t neighbor) { return is_dense[neighbor]; }),
+                     neighbors.end());
+            }
+         }
+      }
+      this->permutation = compute_reverse_cuthill_mckee_ordering(adjacency);
+      if (not this->dense_rows.empty()) {
+         // the dense rows are isolated nodes of the sparse graph: move them to the end
+         std::stable_partition(this->permutation.begin(), this->permutation.end(), [&](size_t index) { return not is_dense[index]; });
+      }
+      this->inverse_permutation = invert_permutation(this->permutation);
+   }
+
+   // upper triangular part of P A P^T in CSC format
+   void SparseSymbolicFactorization::compute_permuted_pattern() {
+      const size_t number_nonzeros = this->matrix_row_indices.size();
+      this->permuted_column_starts.assign(this->factorized_dimension + 1, 0);
+      for (size_t nonzero_index: Range(number_nonzeros)) {
+         const size_t row_index = this->matrix_row_indices[nonzero_index];
+         const size_t column_index = this->matrix_column_indices[nonzero_index];
+         if (row_index < this->factorized_dimension && column_index < this->factorized_dimension) {
+            const size_t permuted_column = std::max(this->inverse_permutation[row_index], this->inverse_permutation[column_index]);
+            this->permuted_column_starts[permuted_column + 1]++;
+         }
+      }
+      for (size_t column_index: Range(this->factorized_dimension)) {
+         this->permuted_column_starts[column_index + 1] += this->permuted_column_starts[column_index];
+      }
+
+      std::copy(this->permuted_column_starts.begin(), this->permuted_column_starts.begin() + static_cast<std::ptrdiff_t>(this->factorized_dimension),
+            this->next_position.begin());
+      this->permuted_row_indices.resize(this->permuted_column_starts[this->factorized_dimension]);
+      this->permuted_entries.resize(this->permuted_column_starts[this->factorized_dimension]);
+      this->permuted_position.assign(number_nonzeros, NO_INDEX);
+      for (size_t nonzero_index: Range(number_nonzeros)) {
+         const size_t row_index = this->matrix_row_indices[nonzero_index];
+         const size_t column_index = this->matrix_column_indices[nonzero_index];
+         if (row_index < this->factorized_dimension && column_index < this->factorized_dimension) {
+            const size_t permuted_row = std::min(this->inverse_permutation[row_index], this->inverse_permutation[column_index]);
+            const size_t permuted_column = std::max(this->inverse_permutation[row_index], this->inverse_permutation[column_index]);
+            const size_t position = this->next_position[permuted_column]++;
+            this->permuted_row_indices[position] = permuted_row;
+            this->permuted_position[nonzero_index] = position;
+         }
+      }
+   }
+
+   // Liu's algorithm with path compression (Davis, Direct Methods for Sparse Linear Systems, 4.1)
+   void SparseSymbolicFactorization::compute_elimination_tree() {
+      this->parent.assign(this->factorized_dimension, NO_INDEX);
+      std::vector<size_t>& ancestor = this->stack;
+      std::fill(ancestor.begin(), ancestor.end(), NO_INDEX);
+      for (size_t k: Range(this->factorized_dimension)) {
+         for (size_t position: Range(this->permuted_column_starts[k], this->permuted_column_starts[k + 1])) {
+            size_t index = this->permuted_row_indices[position];
+            while (index != NO_INDEX && index < k) {
+               const size_t next_index = ancestor[index];
+               ancestor[index] = k;
+               if (next_index == NO_INDEX) {
+                  this->parent[index] = k;
+               }
+               index = next_index;
+            }
+         }
+      }
+   }
+
+   // column counts of L (including the diagonal) from the row patterns
+   void SparseSymbolicFactorization::compute_factor_pattern() {
+      std::vector<size_t>& column_counts = this->next_position;
+      std::fill(column_counts.begin(), column_counts.end(), 1);
+      std::fill(this->marker.begin(), this->marker.end(), NO_INDEX);
+      for (size_t k: Range(this->factorized_dimension)) {
+         const size_t top = this->compute_row_pattern(k);
+         for (size_t pattern_index: Range(top, this->factorized_dimension)) {
+            column_counts[this->row_pattern[pattern_index]]++;
+         }
+      }
+      this->factor_column_starts.assign(this->factorized_dimension + 1, 0);
+      for (size_t column_index: Range(this->factorized_dimension)) {
+         this->factor_column_starts[column_index + 1] = this->factor_column_starts[column_index] + column_counts[column_index];
+      }
+      this->factor_row_indices.resize(this->factor_column_starts[this->factorized_dimension]);
+      this->factor_entries.resize(this->factor_column_starts[this->factorized_dimension]);
+   }
+
+   // nonzero pattern of the k-th row of L (excluding the diagonal) stored in row_pattern[top:dimension] in topological order
+   size_t SparseSymbolicFactorization::compute_row_pattern(size_t k) {
+      size_t top = this->factorized_dimension;
+      this->marker[k] = k;
+      for (size_t position: Range(this->permuted_column_starts[k], this->permuted_column_starts[k + 1])) {
+         // walk up the elimination tree until a marked node is reached
+         size_t length = 0;
+         for (size_t index = this->permuted_row_indices[position]; this->marker[index] != k; index = this->parent[index]) {
+            this->stack[length++] = index;
+            this->marker[index] = k;
+         }
+         while (0 < length) {
+            this->row_pattern[--top] = this->stack[--length];
+         }
+      }
+      return top;
+   }
+
+   // copy the entries of the leading block of the matrix into the permuted matrix
+   void SparseSymbolicFactorization::scatter_entries(const SymmetricMatrix<size_t, double>& matrix) {
+      std::fill(this->permuted_entries.begin(), this->permuted_entries.end(), 0.);
+      size_t nonzero_index = 0;
+      for (const auto [row_index, column_index, entry]: matrix) {
+         const size_t position = this->permuted_position[nonzero_index];
+         if (position != NO_INDEX) {
+            this->permuted_entries[position] += entry;
+         }
+         nonzero_index++;
+      }
+   }
+} // namespace
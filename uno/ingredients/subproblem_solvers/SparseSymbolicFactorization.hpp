@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPARSESYMBOLICFACTORIZATION_H
+#define UNO_SPARSESYMBOLICFACTORIZATION_H
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "tools/HugePageAllocator.hpp"
+
+namespace uno {
+   // forward declaration
+   template <typename IndexType, typename ElementType>
+   class SymmetricMatrix;
+
+   // index of a matrix nonzero that does not belong to the factorized block, or of a root of the elimination tree
+   constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+   // symbolic analysis shared by the up-looking sparse factorizations (LL^T and LDL^T) of the leading block of a symmetric matrix:
+   // ordering P (reverse Cuthill-McKee, with the dense rows last), upper triangular part of P A P^T, elimination tree and sparsity of
+   // the factor L. The analysis is cached until the sparsity of the matrix changes.
+   class SparseSymbolicFactorization {
+   public:
+      SparseSymbolicFactorization(size_t dimension, size_t number_nonzeros);
+
+      [[nodiscard]] bool sparsity_changed(const SymmetricMatrix<size_t, double>& matrix, size_t dimension) const;
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix, size_t dimension);
+
+      [[nodiscard]] size_t number_dense_rows() const;
+      [[nodiscard]] size_t number_factor_nonzeros() const;
+
+   protected:
+      size_t factorized_dimension{0};
+      // sparsity pattern of the matrix (in its iteration order) used for the symbolic analysis
+      std::vector<size_t> matrix_row_indices{};
+      std::vector<size_t> matrix_column_indices{};
+
+      // ordering: permutation[new index] = old index
+      std::vector<size_t> permutation{};
+      std::vector<size_t> inverse_permutation{};
+      std::vector<size_t> dense_rows{}; // ordered last
+
+      // upper triangular part of the permuted matrix in CSC format
+      std::vector<size_t> permuted_column_starts{};
+      HugePageVector<size_t> permuted_row_indices{};
+      HugePageVector<double> permuted_entries{};
+      std::vector<size_t> permuted_position{}; // position of each matrix nonzero in the permuted matrix (if in the leading block)
+
+      // elimination tree and factor L in CSC format (the diagonal entry comes first in each column)
+      std::vector<size_t> parent{};
+      std::vector<size_t> factor_column_starts{};
+      HugePageVector<size_t> factor_row_indices{};
+      HugePageVector<double> factor_entries{};
+
+      // workspaces
+      std::vector<double> dense_workspace{};
+      std::vector<size_t> marker{};
+      std::vector<size_t> row_pattern{};
+      std::vector<size_t> stack{};
+      std::vector<size_t> next_position{};
+
+      void scatter_entries(const SymmetricMatrix<size_t, double>& matrix);
+      [[nodiscard]] size_t compute_row_pattern(size_t row_index);
+
+   private:
+      void compute_ordering();
+      void compute_permuted_pattern();
+      void compute_elimination_tree();
+      void compute_factor_pattern();
+   };
+} // namespace
+
+#endif // UNO_SPARSESYMBOLICFACTORIZATION_H
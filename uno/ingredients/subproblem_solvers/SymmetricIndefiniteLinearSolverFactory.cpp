@@ -4,7 +4,10 @@
 #include <stdexcept>
 #include <string>
 #include "SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "BatchedLDLSolver.hpp"
 #include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "QuasidefiniteLDLSolver.hpp"
+#include "RiccatiSolver.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
 
@@ -28,6 +31,10 @@ namespace uno {
 #include "ingredients/subproblem_solvers/MUMPS/MUMPSSolver.hpp"
 #endif
 
+#ifdef HAS_SPRAL
+#include "ingredients/subproblem_solvers/SPRAL/SPRALSolver.hpp"
+#endif
+
 namespace uno {
    std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> SymmetricIndefiniteLinearSolverFactory::create([[maybe_unused]] size_t dimension,
          [[maybe_unused]] size_t number_nonzeros, const Options& options) {
@@ -58,6 +65,23 @@ namespace uno {
             return std::make_unique<MUMPSSolver>(dimension, number_nonzeros);
          }
 #endif
+
+#ifdef HAS_SPRAL
+         if (linear_solver_name == "SPRAL") {
+            return std::make_unique<SPRALSolver>(dimension, number_nonzeros);
+         }
+#endif
+
+         if (linear_solver_name == "quasidefinite_LDL") {
+            return std::make_unique<QuasidefiniteLDLSolver>(dimension, number_nonzeros);
+         }
+         if (linear_solver_name == "riccati") {
+            return std::make_unique<RiccatiSolver>(dimension, number_nonzeros);
+         }
+         // set by BatchedUno: the factorizations of the instances of a batch are performed in lockstep
+         if (linear_solver_name == "batched_LDL") {
+            return FactorizationBatch::create_solver(dimension, number_nonzeros);
+         }
          std::string message = "The linear solver ";
          message.append(linear_solver_name).append(" is unknown").append("\n").append("The following values are available: ")
                .append(join(SymmetricIndefiniteLinearSolverFactory::available_solvers(), ", "));
@@ -91,6 +115,12 @@ namespace uno {
 #ifdef HAS_MUMPS
       solvers.emplace_back("MUMPS");
 #endif
+
+#ifdef HAS_SPRAL
+      solvers.emplace_back("SPRAL");
+#endif
+      solvers.emplace_back("quasidefinite_LDL");
+      solvers.emplace_back("riccati");
       return solvers;
    }
 } // namespace
@@ -8,6 +8,7 @@
 #include <vector>
 #include "SparseStorage.hpp"
 #include "symbolic/Range.hpp"
+#include "tools/HugePageAllocator.hpp"
 
 namespace uno {
    /*
@@ -42,7 +43,7 @@ namespace uno {
       }
 
    protected:
-      std::vector<ElementType> entries;
+      HugePageVector<ElementType> entries;
       std::vector<IndexType> row_indices;
       std::vector<IndexType> column_indices;
 
@@ -8,6 +8,8 @@
 #include <vector>
 #include "SparseStorage.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "linear_algebra/VectorPrinting.hpp"
+#include "tools/HugePageAllocator.hpp"
 #include "tools/Infinity.hpp"
 #include "symbolic/VectorView.hpp"
 
@@ -32,7 +34,7 @@ namespace uno {
       void print(std::ostream& stream) const override;
 
    protected:
-      std::vector<ElementType> entries;
+      HugePageVector<ElementType> entries;
       // entries and row_indices have nnz elements
       // column_starts has dimension+1 elements
       Vector<IndexType> column_starts{};
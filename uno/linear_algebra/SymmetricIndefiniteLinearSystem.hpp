@@ -4,6 +4,8 @@
 #ifndef UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 #define UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include "SymmetricMatrix.hpp"
 #include "SparseStorageFactory.hpp"
@@ -13,7 +15,9 @@
 #include "model/Model.hpp"
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
+#include "tools/PerformanceCounters.hpp"
 #include "tools/Statistics.hpp"
+#include "tools/TaskScheduler.hpp"
 
 namespace uno {
    template <typename ElementType>
@@ -37,6 +41,7 @@ namespace uno {
       ElementType primal_regularization{0.};
       ElementType dual_regularization{0.};
       ElementType previous_primal_regularization{0.};
+      size_t size_primal_block{0};
       const ElementType regularization_failure_threshold;
       const ElementType primal_regularization_initial_factor;
       const ElementType dual_regularization_fraction;
@@ -45,6 +50,15 @@ namespace uno {
       const ElementType primal_regularization_fast_increase_factor;
       const ElementType primal_regularization_slow_increase_factor;
       const size_t threshold_unsuccessful_attempts;
+      // quasidefinite mode (static pivoting solvers)
+      const ElementType quasidefinite_dual_regularization;
+      const size_t quasidefinite_refinement_iterations;
+      const ElementType quasidefinite_refinement_tolerance;
+      Vector<ElementType> residual{};
+      Vector<ElementType> correction{};
+
+      void set_regularization();
+      void refine_solution(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver);
    };
 
    template <typename ElementType>
@@ -60,14 +74,23 @@ namespace uno {
          primal_regularization_decrease_factor(ElementType(options.get_double("primal_regularization_decrease_factor"))),
          primal_regularization_fast_increase_factor(ElementType(options.get_double("primal_regularization_fast_increase_factor"))),
          primal_regularization_slow_increase_factor(ElementType(options.get_double("primal_regularization_slow_increase_factor"))),
-         threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")) {
+         threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")),
+         quasidefinite_dual_regularization(ElementType(options.get_double("quasidefinite_dual_regularization"))),
+         quasidefinite_refinement_iterations(options.get_unsigned_int("quasidefinite_refinement_iterations")),
+         quasidefinite_refinement_tolerance(ElementType(options.get_double("quasidefinite_refinement_tolerance"))),
+         residual(dimension),
+         correction(dimension) {
    }
 
    template <typename ElementType>
    void SymmetricIndefiniteLinearSystem<ElementType>::assemble_matrix(const SymmetricMatrix<size_t, double>& hessian,
          const RectangularMatrix<double>& constraint_jacobian, size_t number_variables, size_t number_constraints) {
+      PerformanceCounterScope counter_scope(SolverPhase::ASSEMBLY);
       this->matrix.set_dimension(number_variables + number_constraints);
       this->matrix.reset();
+      this->size_primal_block = number_variables;
+      this->primal_regularization = ElementType(0.);
+      this->dual_regularization = ElementType(0.);
       // copy the Lagrangian Hessian in the top left block
       //size_t current_column = 0;
       for (const auto [row_index, column_index, element]: hessian) {
@@ -91,6 +114,13 @@ namespace uno {
    template <typename ElementType>
    void SymmetricIndefiniteLinearSystem<ElementType>::factorize_matrix(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
          WarmstartInformation& warmstart_information) {
+      PerformanceCounterScope counter_scope(SolverPhase::FACTORIZATION);
+      BackendThreadScope backend_thread_scope(SolverPhase::FACTORIZATION);
+      if (linear_solver.requires_quasidefinite_matrix() && this->dual_regularization < this->quasidefinite_dual_regularization) {
+         // quasidefinite mode: the dual block is always regularized
+         this->dual_regularization = this->quasidefinite_dual_regularization;
+         this->set_regularization();
+      }
       if (warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed) {
          DEBUG << "Performing symbolic analysis of the indefinite system\n";
          linear_solver.do_symbolic_analysis(this->matrix);
@@ -107,7 +137,7 @@ namespace uno {
          ElementType dual_regularization_parameter, WarmstartInformation& warmstart_information) {
       DEBUG2 << "Original matrix\n" << this->matrix << '\n';
       this->primal_regularization = ElementType(0.);
-      this->dual_regularization = ElementType(0.);
+      this->dual_regularization = linear_solver.requires_quasidefinite_matrix() ? this->quasidefinite_dual_regularization : ElementType(0.);
       size_t number_attempts = 1;
       DEBUG << "Number of attempts: " << number_attempts << "\n\n";
 
@@ -124,7 +154,7 @@ namespace uno {
       // set the constraint regularization coefficient
       if (linear_solver.matrix_is_singular()) {
          DEBUG << "Matrix is singular\n";
-         this->dual_regularization = this->dual_regularization_fraction * dual_regularization_parameter;
+         this->dual_regularization = std::max(this->dual_regularization, this->dual_regularization_fraction * dual_regularization_parameter);
       }
       // set the Hessian regularization coefficient
       if (this->previous_primal_regularization == 0.) {
@@ -136,9 +166,7 @@ namespace uno {
       }
 
       // regularize the augmented matrix
-      this->matrix.set_regularization([=](size_t row_index) {
-         return (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
-      });
+      this->set_regularization();
 
       bool good_inertia = false;
       while (not good_inertia) {
@@ -167,9 +195,7 @@ namespace uno {
 
             if (this->primal_regularization <= this->regularization_failure_threshold) {
                // regularize the augmented matrix
-               this->matrix.set_regularization([=](size_t row_index) {
-                  return (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
-               });
+               this->set_regularization();
             }
             else {
                throw UnstableRegularization();
@@ -181,7 +207,61 @@ namespace uno {
 
    template <typename ElementType>
    void SymmetricIndefiniteLinearSystem<ElementType>::solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) {
+      PerformanceCounterScope counter_scope(SolverPhase::SOLVE);
+      BackendThreadScope backend_thread_scope(SolverPhase::SOLVE);
       linear_solver.solve_indefinite_system(this->matrix, this->rhs, this->solution);
+      if (linear_solver.requires_quasidefinite_matrix()) {
+         this->refine_solution(linear_solver);
+      }
+   }
+
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::set_regularization() {
+      this->matrix.set_regularization([=](size_t row_index) {
+         return (row_index < this->size_primal_block) ? this->primal_regularization : -this->dual_regularization;
+      });
+   }
+
+   // iterative refinement that removes the static dual regularization of the quasidefinite mode (a larger dual regularization
+   // applied because the matrix is singular is kept)
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::refine_solution(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) {
+      const size_t dimension = this->matrix.dimension();
+      const ElementType static_dual_regularization = (this->dual_regularization == this->quasidefinite_dual_regularization) ?
+            this->dual_regularization : ElementType(0.);
+      ElementType rhs_norm = ElementType(0.);
+      for (size_t index: Range(dimension)) {
+         rhs_norm = std::max(rhs_norm, std::abs(this->rhs[index]));
+      }
+      for (size_t iteration: Range(this->quasidefinite_refinement_iterations + 1)) {
+         // residual of the system without static regularization: rhs - (matrix + static_dual_regularization * I_dual) solution
+         for (size_t index: Range(dimension)) {
+            this->residual[index] = this->rhs[index];
+         }
+         for (const auto [row_index, column_index, element]: this->matrix) {
+            this->residual[row_index] -= element * this->solution[column_index];
+            if (row_index != column_index) {
+               this->residual[column_index] -= element * this->solution[row_index];
+            }
+         }
+         ElementType residual_norm = ElementType(0.);
+         for (size_t index: Range(dimension)) {
+            if (this->size_primal_block <= index) {
+               this->residual[index] -= static_dual_regularization * this->solution[index];
+            }
+            residual_norm = std::max(residual_norm, std::abs(this->residual[index]));
+         }
+         DEBUG2 << "Iterative refinement " << iteration << ": residual norm = " << residual_norm << '\n';
+         if (residual_norm <= this->quasidefinite_refinement_tolerance * (ElementType(1.) + rhs_norm) ||
+               iteration == this->quasidefinite_refinement_iterations) {
+            return;
+         }
+         // correct the solution
+         linear_solver.solve_indefinite_system(this->matrix, this->residual, this->correction);
+         for (size_t index: Range(dimension)) {
+            this->solution[index] += this->correction[index];
+         }
+      }
    }
 
    /*
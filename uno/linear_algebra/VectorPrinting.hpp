@@ -0,0 +1,38 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_VECTORPRINTING_H
+#define UNO_VECTORPRINTING_H
+
+#include <iostream>
+#include "symbolic/Range.hpp"
+#include "tools/BufferedWriter.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   // buffered output with the precision of the stream
+   template <typename Array>
+   void print_vector(std::ostream& stream, const Array& x) {
+      BufferedWriter writer(stream, static_cast<int>(stream.precision()));
+      for (size_t index: Range(x.size())) {
+         writer << x[index] << ' ';
+      }
+      writer << '\n';
+   }
+
+   // temporary streams (e.g. std::ostringstream{})
+   template <typename Array>
+   void print_vector(std::ostream&& stream, const Array& x) {
+      print_vector(stream, x);
+   }
+
+   // logger (DEBUG, WARNING, etc): nothing is formatted if the level is disabled
+   template <typename Array>
+   void print_vector(const Level& level, const Array& x) {
+      if (level <= Logger::level) {
+         print_vector(std::cout, x);
+      }
+   }
+} // namespace
+
+#endif // UNO_VECTORPRINTING_H
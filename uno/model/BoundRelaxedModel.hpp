@@ -32,6 +32,25 @@ namespace uno {
             SymmetricMatrix<size_t, double>& hessian) const override {
          this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
       }
+      [[nodiscard]] size_t number_residuals() const override { return this->model->number_residuals(); }
+      void evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const override {
+         this->model->evaluate_residuals(x, residuals);
+      }
+      void evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const override {
+         this->model->evaluate_residual_jacobian(x, residual_jacobian);
+      }
+      [[nodiscard]] size_t number_elements() const override { return this->model->number_elements(); }
+      void get_elements(std::vector<ElementFunction>& elements) const override {
+         this->model->get_elements(elements);
+      }
+      void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override {
+         this->model->evaluate_element_gradients(x, element_gradients);
+      }
+      [[nodiscard]] size_t number_stages() const override { return this->model->number_stages(); }
+      void get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         this->model->get_stages(variable_stages, constraint_stages);
+      }
+      [[nodiscard]] bool is_thread_safe() const override { return this->model->is_thread_safe(); }
 
       // only these two functions are redefined
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
@@ -74,6 +74,47 @@ namespace uno {
       this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
    }
 
+   size_t FixedBoundsConstraintsModel::number_residuals() const {
+      return this->model->number_residuals();
+   }
+
+   void FixedBoundsConstraintsModel::evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const {
+      this->model->evaluate_residuals(x, residuals);
+   }
+
+   void FixedBoundsConstraintsModel::evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const {
+      this->model->evaluate_residual_jacobian(x, residual_jacobian);
+   }
+
+   size_t FixedBoundsConstraintsModel::number_elements() const {
+      return this->model->number_elements();
+   }
+
+   void FixedBoundsConstraintsModel::get_elements(std::vector<ElementFunction>& elements) const {
+      this->model->get_elements(elements);
+   }
+
+   void FixedBoundsConstraintsModel::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      this->model->evaluate_element_gradients(x, element_gradients);
+   }
+
+   size_t FixedBoundsConstraintsModel::number_stages() const {
+      return this->model->number_stages();
+   }
+
+   void FixedBoundsConstraintsModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      this->model->get_stages(variable_stages, constraint_stages);
+      // the constraint of a fixed variable belongs to the stage of the variable
+      constraint_stages.resize(this->model->number_constraints);
+      for (size_t fixed_variable_index: this->model->get_fixed_variables()) {
+         constraint_stages.emplace_back(variable_stages[fixed_variable_index]);
+      }
+   }
+
+   bool FixedBoundsConstraintsModel::is_thread_safe() const {
+      return this->model->is_thread_safe();
+   }
+
    double FixedBoundsConstraintsModel::variable_lower_bound(size_t variable_index) const {
       if (this->model->variable_lower_bound(variable_index) == this->model->variable_upper_bound(variable_index)) {
       // remove bounds of fixed variables
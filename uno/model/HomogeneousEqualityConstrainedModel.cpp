@@ -101,6 +101,48 @@ namespace uno {
       }
    }
 
+   size_t HomogeneousEqualityConstrainedModel::number_residuals() const {
+      return this->model->number_residuals();
+   }
+
+   void HomogeneousEqualityConstrainedModel::evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const {
+      this->model->evaluate_residuals(x, residuals);
+   }
+
+   void HomogeneousEqualityConstrainedModel::evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const {
+      this->model->evaluate_residual_jacobian(x, residual_jacobian);
+   }
+
+   size_t HomogeneousEqualityConstrainedModel::number_elements() const {
+      return this->model->number_elements();
+   }
+
+   void HomogeneousEqualityConstrainedModel::get_elements(std::vector<ElementFunction>& elements) const {
+      this->model->get_elements(elements);
+   }
+
+   void HomogeneousEqualityConstrainedModel::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      this->model->evaluate_element_gradients(x, element_gradients);
+   }
+
+   size_t HomogeneousEqualityConstrainedModel::number_stages() const {
+      return this->model->number_stages();
+   }
+
+   void HomogeneousEqualityConstrainedModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      this->model->get_stages(variable_stages, constraint_stages);
+      // the slack of an inequality constraint belongs to the stage of the constraint
+      variable_stages.resize(this->number_variables);
+      for (size_t inequality_index: Range(this->constraint_index_of_inequality_index.size())) {
+         variable_stages[this->model->number_variables + inequality_index] =
+               constraint_stages[this->constraint_index_of_inequality_index[inequality_index]];
+      }
+   }
+
+   bool HomogeneousEqualityConstrainedModel::is_thread_safe() const {
+      return this->model->is_thread_safe();
+   }
+
    double HomogeneousEqualityConstrainedModel::variable_lower_bound(size_t variable_index) const {
       if (variable_index < this->model->number_variables) { // original variable
          return this->model->variable_lower_bound(variable_index);
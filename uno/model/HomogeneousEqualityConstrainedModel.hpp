@@ -26,6 +26,15 @@ namespace uno {
       void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const override;
+      [[nodiscard]] size_t number_residuals() const override;
+      void evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const override;
+      void evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const override;
+      [[nodiscard]] size_t number_elements() const override;
+      void get_elements(std::vector<ElementFunction>& elements) const override;
+      void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override;
+      [[nodiscard]] size_t number_stages() const override;
+      void get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+      [[nodiscard]] bool is_thread_safe() const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 #include "Model.hpp"
 #include "linear_algebra/Vector.hpp"
@@ -13,6 +14,46 @@ namespace uno {
          name(std::move(name)), number_variables(number_variables), number_constraints(number_constraints), objective_sign(objective_sign) {
    }
 
+   // by default, the objective has no least-squares structure
+   size_t Model::number_residuals() const {
+      return 0;
+   }
+
+   void Model::evaluate_residuals(const Vector<double>& /*x*/, std::vector<double>& /*residuals*/) const {
+      throw std::runtime_error("The objective of the model " + this->name + " does not have a least-squares structure");
+   }
+
+   void Model::evaluate_residual_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& /*residual_jacobian*/) const {
+      throw std::runtime_error("The objective of the model " + this->name + " does not have a least-squares structure");
+   }
+
+   // by default, the functions have no partially separable structure
+   size_t Model::number_elements() const {
+      return 0;
+   }
+
+   void Model::get_elements(std::vector<ElementFunction>& /*elements*/) const {
+      throw std::runtime_error("The model " + this->name + " does not have a partially separable structure");
+   }
+
+   void Model::evaluate_element_gradients(const Vector<double>& /*x*/, std::vector<double>& /*element_gradients*/) const {
+      throw std::runtime_error("The model " + this->name + " does not have a partially separable structure");
+   }
+
+   // by default, the model has no stage structure
+   size_t Model::number_stages() const {
+      return 0;
+   }
+
+   void Model::get_stages(std::vector<size_t>& /*variable_stages*/, std::vector<size_t>& /*constraint_stages*/) const {
+      throw std::runtime_error("The model " + this->name + " does not have a stage structure");
+   }
+
+   // by default, the evaluations may share a state (e.g. the buffers of a third-party library)
+   bool Model::is_thread_safe() const {
+      return false;
+   }
+
    void Model::project_onto_variable_bounds(Vector<double>& x) const {
       for (size_t variable_index: Range(this->number_variables)) {
          x[variable_index] = std::max(std::min(x[variable_index], this->variable_upper_bound(variable_index)), this->variable_lower_bound(variable_index));
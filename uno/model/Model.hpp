@@ -4,6 +4,7 @@
 #ifndef UNO_MODEL_H
 #define UNO_MODEL_H
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "linear_algebra/Norm.hpp"
@@ -29,6 +30,12 @@ namespace uno {
    // forward declaration
    class Iterate;
 
+   // element function of a partially separable function: depends on a few variables only
+   struct ElementFunction {
+      std::optional<size_t> constraint_index{}; // empty for the objective
+      std::vector<size_t> variables{}; // distinct indices
+   };
+
    /*! \class Problem
     * \brief Optimization problem
     *
@@ -52,6 +59,24 @@ namespace uno {
       virtual void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const = 0;
 
+      // optional least-squares structure of the objective f(x) = 1/2 ||r(x)||^2 (used by the Gauss-Newton Hessian model)
+      [[nodiscard]] virtual size_t number_residuals() const;
+      virtual void evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const;
+      virtual void evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const;
+      // optional partially separable structure: the nonlinear part of each function is a sum of element functions
+      // (used by the partitioned quasi-Newton Hessian model). The gradients of the elements (with respect to their variables) are
+      // concatenated in the order of the elements
+      [[nodiscard]] virtual size_t number_elements() const;
+      virtual void get_elements(std::vector<ElementFunction>& elements) const;
+      virtual void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const;
+      // optional stage structure of multistage problems (e.g. optimal control): stage of each variable and of each constraint. The
+      // constraints of a stage depend on the variables of this stage and of the next stage, and the Lagrangian Hessian couples the
+      // variables of the same or of adjacent stages (used by the Riccati linear solver)
+      [[nodiscard]] virtual size_t number_stages() const;
+      virtual void get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const;
+      // true if the functions can be evaluated concurrently by several threads (used to evaluate the derivatives in the background)
+      [[nodiscard]] virtual bool is_thread_safe() const;
+
       // purely virtual functions
       [[nodiscard]] virtual double variable_lower_bound(size_t variable_index) const = 0;
       [[nodiscard]] virtual double variable_upper_bound(size_t variable_index) const = 0;
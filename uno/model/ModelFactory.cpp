@@ -1,15 +1,25 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <stdexcept>
 #include "ModelFactory.hpp"
 #include "FixedBoundsConstraintsModel.hpp"
 #include "HomogeneousEqualityConstrainedModel.hpp"
 #include "BoundRelaxedModel.hpp"
+#include "ReorderedModel.hpp"
 #include "options/Options.hpp"
 
 namespace uno {
    // note: ownership of the pointer is transferred
    std::unique_ptr<Model> ModelFactory::reformulate(std::unique_ptr<Model> model, const Options& options) {
+      // permute the variables and constraints of the original model
+      const std::string& model_reordering = options.get_string("model_reordering");
+      if (model_reordering == "RCM") {
+         model = std::make_unique<ReorderedModel>(std::move(model));
+      }
+      else if (model_reordering != "none") {
+         throw std::invalid_argument("The model reordering " + model_reordering + " does not exist");
+      }
       if (options.get_string("subproblem") == "primal_dual_interior_point") {
          // move the fixed variables to the set of general constraints
          if (not model->get_fixed_variables().empty()) {
@@ -20,6 +30,10 @@ namespace uno {
          // slightly relax the bound constraints
          model = std::make_unique<BoundRelaxedModel>(std::move(model), options);
       }
+      else if (options.get_string("subproblem") == "reduced_QP") {
+         // the null-space method partitions the variables of an equality-constrained problem
+         model = std::make_unique<HomogeneousEqualityConstrainedModel>(std::move(model));
+      }
       return model;
    }
 } // namespace
\ No newline at end of file
@@ -0,0 +1,136 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cassert>
+#include "ModelPartition.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   ModelPartition::ModelPartition(size_t number_variables, size_t number_constraints):
+         variable_status(number_variables),
+         constraint_status(number_constraints),
+         linear_constraints_collection(this->linear_constraints),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables) {
+      this->lower_bounded_variables.reserve(number_variables);
+      this->upper_bounded_variables.reserve(number_variables);
+      this->single_lower_bounded_variables.reserve(number_variables);
+      this->single_upper_bounded_variables.reserve(number_variables);
+      this->equality_constraints.reserve(number_constraints);
+      this->inequality_constraints.reserve(number_constraints);
+      this->linear_constraints.reserve(number_constraints);
+   }
+
+   void ModelPartition::compute(const std::vector<double>& variable_lower_bounds, const std::vector<double>& variable_upper_bounds,
+         const std::vector<double>& constraint_lower_bounds, const std::vector<double>& constraint_upper_bounds,
+         const std::vector<FunctionType>& constraint_type) {
+      assert(constraint_type.size() == this->constraint_status.size());
+      // variables
+      ModelPartition::determine_bounds_types(variable_lower_bounds, variable_upper_bounds, this->variable_status);
+      for (size_t variable_index: Range(this->variable_status.size())) {
+         const BoundType status = this->variable_status[variable_index];
+         if (status == EQUAL_BOUNDS) {
+            this->fixed_variables.emplace_back(variable_index);
+         }
+         if (status == BOUNDED_LOWER || status == BOUNDED_BOTH_SIDES) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_LOWER) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (status == BOUNDED_UPPER || status == BOUNDED_BOTH_SIDES) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_UPPER) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+
+      // constraints
+      ModelPartition::determine_bounds_types(constraint_lower_bounds, constraint_upper_bounds, this->constraint_status);
+      for (size_t constraint_index: Range(this->constraint_status.size())) {
+         if (this->constraint_status[constraint_index] == EQUAL_BOUNDS) {
+            this->equality_constraints.emplace_back(constraint_index);
+         }
+         else {
+            this->inequality_constraints.emplace_back(constraint_index);
+         }
+         if (constraint_type[constraint_index] == LINEAR) {
+            this->linear_constraints.emplace_back(constraint_index);
+         }
+      }
+   }
+
+   BoundType ModelPartition::get_variable_bound_type(size_t variable_index) const {
+      return this->variable_status[variable_index];
+   }
+
+   const Collection<size_t>& ModelPartition::get_lower_bounded_variables() const {
+      return this->lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ModelPartition::get_upper_bounded_variables() const {
+      return this->upper_bounded_variables_collection;
+   }
+
+   const SparseVector<size_t>& ModelPartition::get_slacks() const {
+      return this->slacks;
+   }
+
+   const Collection<size_t>& ModelPartition::get_single_lower_bounded_variables() const {
+      return this->single_lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ModelPartition::get_single_upper_bounded_variables() const {
+      return this->single_upper_bounded_variables_collection;
+   }
+
+   const Vector<size_t>& ModelPartition::get_fixed_variables() const {
+      return this->fixed_variables;
+   }
+
+   BoundType ModelPartition::get_constraint_bound_type(size_t constraint_index) const {
+      return this->constraint_status[constraint_index];
+   }
+
+   const Collection<size_t>& ModelPartition::get_equality_constraints() const {
+      return this->equality_constraints_collection;
+   }
+
+   const Collection<size_t>& ModelPartition::get_inequality_constraints() const {
+      return this->inequality_constraints_collection;
+   }
+
+   const Collection<size_t>& ModelPartition::get_linear_constraints() const {
+      return this->linear_constraints_collection;
+   }
+
+   void ModelPartition::determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds,
+         std::vector<BoundType>& status) {
+      assert(lower_bounds.size() == status.size());
+      assert(upper_bounds.size() == status.size());
+      // build the "status" vector as a mapping (map/transform operation) of the "bounds" vector
+      for (size_t index: Range(lower_bounds.size())) {
+         if (lower_bounds[index] == upper_bounds[index]) {
+            status[index] = EQUAL_BOUNDS;
+         }
+         else if (is_finite(lower_bounds[index]) && is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_BOTH_SIDES;
+         }
+         else if (is_finite(lower_bounds[index])) {
+            status[index] = BOUNDED_LOWER;
+         }
+         else if (is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_UPPER;
+         }
+         else {
+            status[index] = UNBOUNDED;
+         }
+      }
+   }
+} // namespace
@@ -0,0 +1,69 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MODELPARTITION_H
+#define UNO_MODELPARTITION_H
+
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   /*! \class ModelPartition
+    * \brief Bound types and partitions of the variables and constraints of a model
+    *
+    *  Bookkeeping shared by the models that store their bounds (AMPL, .nl and synthetic models). compute() determines the bound
+    *  types and the lists of variables and constraints; the models forward the corresponding Model queries.
+    */
+   class ModelPartition {
+   public:
+      ModelPartition(size_t number_variables, size_t number_constraints);
+      ModelPartition(const ModelPartition&) = delete;
+      ModelPartition& operator=(const ModelPartition&) = delete;
+
+      void compute(const std::vector<double>& variable_lower_bounds, const std::vector<double>& variable_upper_bounds,
+            const std::vector<double>& constraint_lower_bounds, const std::vector<double>& constraint_upper_bounds,
+            const std::vector<FunctionType>& constraint_type);
+
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const;
+
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const;
+
+      static void determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds, std::vector<BoundType>& status);
+
+   private:
+      std::vector<BoundType> variable_status; /*!< Status of the variables (EQUAL_BOUNDS, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES, UNBOUNDED) */
+      std::vector<BoundType> constraint_status; /*!< Status of the constraints (EQUAL_BOUNDS, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES, UNBOUNDED) */
+
+      // lists of variables and constraints + corresponding collection objects
+      std::vector<size_t> linear_constraints{};
+      CollectionAdapter<std::vector<size_t>&> linear_constraints_collection;
+      std::vector<size_t> equality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> equality_constraints_collection;
+      std::vector<size_t> inequality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> inequality_constraints_collection;
+      SparseVector<size_t> slacks{};
+      std::vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> lower_bounded_variables_collection;
+      std::vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> upper_bounded_variables_collection;
+      std::vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_lower_bounded_variables_collection;
+      std::vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_upper_bounded_variables_collection;
+      Vector<size_t> fixed_variables{};
+   };
+} // namespace
+
+#endif // UNO_MODELPARTITION_H
@@ -0,0 +1,425 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <stdexcept>
+#include "ReorderedModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "preprocessing/ReverseCuthillMcKee.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   // sum over the rows of the Jacobian of the distance between the first and last nonzeros
+   size_t jacobian_envelope(const RectangularMatrix<double>& jacobian, size_t number_constraints, const std::vector<size_t>& column_map) {
+      size_t envelope = 0;
+      for (size_t constraint_index: Range(number_constraints)) {
+         if (0 < jacobian[constraint_index].size()) {
+            size_t first_column = column_map.size();
+            size_t last_column = 0;
+            for (const auto [variable_index, _]: jacobian[constraint_index]) {
+               first_column = std::min(first_column, column_map[variable_index]);
+               last_column = std::max(last_column, column_map[variable_index]);
+            }
+            envelope += last_column - first_column;
+         }
+      }
+      return envelope;
+   }
+
+   ReorderedModel::ReorderedModel(std::unique_ptr<Model> original_model):
+         Model(original_model->name + " -> reordered", original_model->number_variables, original_model->number_constraints,
+               original_model->objective_sign),
+         model(std::move(original_model)),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables),
+         slacks(this->model->get_slacks().size()),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         linear_constraints_collection(this->linear_constraints),
+         original_hessian(this->model->number_variables, this->model->number_hessian_nonzeros(), false, "COO"),
+         original_primals(this->model->number_variables),
+         original_multipliers(this->model->number_constraints),
+         original_constraints(this->model->number_constraints),
+         original_gradient(this->model->number_variables),
+         // the rows grow on demand: reserving n entries per row would allocate a dense matrix
+         original_jacobian(this->model->number_constraints, 0),
+         original_residual_jacobian(this->model->number_residuals(), 0) {
+      this->compute_orderings();
+      this->compute_hessian_insertion_order();
+      this->permute_collections();
+   }
+
+   double ReorderedModel::evaluate_objective(const Vector<double>& x) const {
+      this->to_original_primals(x);
+      return this->model->evaluate_objective(this->original_primals);
+   }
+
+   void ReorderedModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->to_original_primals(x);
+      this->original_gradient.clear();
+      this->model->evaluate_objective_gradient(this->original_primals, this->original_gradient);
+      for (const auto [variable_index, derivative]: this->original_gradient) {
+         gradient.insert(this->variable_inverse_permutation[variable_index], derivative);
+      }
+   }
+
+   void ReorderedModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      this->to_original_primals(x);
+      this->model->evaluate_constraints(this->original_primals, this->original_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraints[constraint_index] = this->original_constraints[this->constraint_permutation[constraint_index]];
+      }
+   }
+
+   void ReorderedModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      this->to_original_primals(x);
+      this->original_gradient.clear();
+      this->model->evaluate_constraint_gradient(this->original_primals, this->constraint_permutation[constraint_index], this->original_gradient);
+      gradient.clear();
+      for (const auto [variable_index, derivative]: this->original_gradient) {
+         gradient.insert(this->variable_inverse_permutation[variable_index], derivative);
+      }
+   }
+
+   void ReorderedModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->to_original_primals(x);
+      this->model->evaluate_constraint_jacobian(this->original_primals, this->original_jacobian);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_jacobian[constraint_index].clear();
+         for (const auto [variable_index, derivative]: this->original_jacobian[this->constraint_permutation[constraint_index]]) {
+            constraint_jacobian[constraint_index].insert(this->variable_inverse_permutation[variable_index], derivative);
+         }
+      }
+   }
+
+   void ReorderedModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      this->to_original_primals(x);
+      this->to_original_multipliers(multipliers);
+      this->original_hessian.reset();
+      this->model->evaluate_lagrangian_hessian(this->original_primals, objective_multiplier, this->original_multipliers, this->original_hessian);
+      if (this->original_hessian.number_nonzeros() != this->permuted_hessian_indices.size()) {
+         throw std::runtime_error("ReorderedModel: the sparsity pattern of the Lagrangian Hessian changed since the reordering");
+      }
+      size_t nonzero_index = 0;
+      for (const auto [row_index, column_index, entry]: this->original_hessian) {
+         this->hessian_entries[nonzero_index++] = entry;
+      }
+
+      // insert the permuted upper triangular part column by column
+      hessian.reset();
+      for (size_t column_index: Range(this->number_variables)) {
+         for (size_t position: Range(this->hessian_column_starts[column_index], this->hessian_column_starts[column_index + 1])) {
+            const size_t original_nonzero_index = this->hessian_insertion_order[position];
+            const auto [permuted_row, permuted_column] = this->permuted_hessian_indices[original_nonzero_index];
+            hessian.insert(this->hessian_entries[original_nonzero_index], permuted_row, permuted_column);
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   size_t ReorderedModel::number_residuals() const {
+      return this->model->number_residuals();
+   }
+
+   void ReorderedModel::evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const {
+      this->to_original_primals(x);
+      this->model->evaluate_residuals(this->original_primals, residuals);
+   }
+
+   void ReorderedModel::evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const {
+      // the residuals are not permuted, only the variables
+      this->to_original_primals(x);
+      this->original_residual_jacobian.clear();
+      this->model->evaluate_residual_jacobian(this->original_primals, this->original_residual_jacobian);
+      for (size_t residual_index: Range(this->number_residuals())) {
+         for (const auto [variable_index, derivative]: this->original_residual_jacobian[residual_index]) {
+            residual_jacobian[residual_index].insert(this->variable_inverse_permutation[variable_index], derivative);
+         }
+      }
+   }
+
+   size_t ReorderedModel::number_elements() const {
+      return this->model->number_elements();
+   }
+
+   void ReorderedModel::get_elements(std::vector<ElementFunction>& elements) const {
+      this->model->get_elements(elements);
+      for (ElementFunction& element: elements) {
+         if (element.constraint_index.has_value()) {
+            element.constraint_index = this->constraint_inverse_permutation[*element.constraint_index];
+         }
+         for (size_t& variable_index: element.variables) {
+            variable_index = this->variable_inverse_permutation[variable_index];
+         }
+      }
+   }
+
+   // the variables of the elements are permuted, not their order: the gradients are aligned
+   void ReorderedModel::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      this->to_original_primals(x);
+      this->model->evaluate_element_gradients(this->original_primals, element_gradients);
+   }
+
+   size_t ReorderedModel::number_stages() const {
+      return this->model->number_stages();
+   }
+
+   void ReorderedModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      std::vector<size_t> original_variable_stages{}, original_constraint_stages{};
+      this->model->get_stages(original_variable_stages, original_constraint_stages);
+      variable_stages.resize(this->number_variables);
+      for (size_t variable_index: Range(this->number_variables)) {
+         variable_stages[variable_index] = original_variable_stages[this->variable_permutation[variable_index]];
+      }
+      constraint_stages.resize(this->number_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_stages[constraint_index] = original_constraint_stages[this->constraint_permutation[constraint_index]];
+      }
+   }
+
+   // the evaluations permute the variables and the results in shared workspaces
+   bool ReorderedModel::is_thread_safe() const {
+      return false;
+   }
+
+   double ReorderedModel::variable_lower_bound(size_t variable_index) const {
+      return this->model->variable_lower_bound(this->variable_permutation[variable_index]);
+   }
+
+   double ReorderedModel::variable_upper_bound(size_t variable_index) const {
+      return this->model->variable_upper_bound(this->variable_permutation[variable_index]);
+   }
+
+   BoundType ReorderedModel::get_variable_bound_type(size_t variable_index) const {
+      return this->model->get_variable_bound_type(this->variable_permutation[variable_index]);
+   }
+
+   const Collection<size_t>& ReorderedModel::get_lower_bounded_variables() const {
+      return this->lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_upper_bounded_variables() const {
+      return this->upper_bounded_variables_collection;
+   }
+
+   const SparseVector<size_t>& ReorderedModel::get_slacks() const {
+      return this->slacks;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_single_lower_bounded_variables() const {
+      return this->single_lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_single_upper_bounded_variables() const {
+      return this->single_upper_bounded_variables_collection;
+   }
+
+   const Vector<size_t>& ReorderedModel::get_fixed_variables() const {
+      return this->fixed_variables;
+   }
+
+   double ReorderedModel::constraint_lower_bound(size_t constraint_index) const {
+      return this->model->constraint_lower_bound(this->constraint_permutation[constraint_index]);
+   }
+
+   double ReorderedModel::constraint_upper_bound(size_t constraint_index) const {
+      return this->model->constraint_upper_bound(this->constraint_permutation[constraint_index]);
+   }
+
+   FunctionType ReorderedModel::get_constraint_type(size_t constraint_index) const {
+      return this->model->get_constraint_type(this->constraint_permutation[constraint_index]);
+   }
+
+   BoundType ReorderedModel::get_constraint_bound_type(size_t constraint_index) const {
+      return this->model->get_constraint_bound_type(this->constraint_permutation[constraint_index]);
+   }
+
+   const Collection<size_t>& ReorderedModel::get_equality_constraints() const {
+      return this->equality_constraints_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_inequality_constraints() const {
+      return this->inequality_constraints_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_linear_constraints() const {
+      return this->linear_constraints_collection;
+   }
+
+   void ReorderedModel::initial_primal_point(Vector<double>& x) const {
+      this->model->initial_primal_point(this->original_primals);
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] = this->original_primals[this->variable_permutation[variable_index]];
+      }
+   }
+
+   void ReorderedModel::initial_dual_point(Vector<double>& multipliers) const {
+      this->model->initial_dual_point(this->original_multipliers);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         multipliers[constraint_index] = this->original_multipliers[this->constraint_permutation[constraint_index]];
+      }
+   }
+
+   void ReorderedModel::postprocess_solution(Iterate& iterate, IterateStatus termination_status) const {
+      // restore the original order of the primal and dual variables and of the constraints
+      // (the derivatives stored in the iterate are left in the permuted order)
+      const auto restore_order = [](auto& values, const std::vector<size_t>& permutation, auto& workspace) {
+         for (size_t index: Range(permutation.size())) {
+            workspace[permutation[index]] = values[index];
+         }
+         for (size_t index: Range(permutation.size())) {
+            values[index] = workspace[index];
+         }
+      };
+      restore_order(iterate.primals, this->variable_permutation, this->original_primals);
+      restore_order(iterate.multipliers.lower_bounds, this->variable_permutation, this->original_primals);
+      restore_order(iterate.multipliers.upper_bounds, this->variable_permutation, this->original_primals);
+      restore_order(iterate.multipliers.constraints, this->constraint_permutation, this->original_constraints);
+      if (iterate.are_constraints_computed) {
+         restore_order(iterate.evaluations.constraints, this->constraint_permutation, this->original_constraints);
+      }
+      this->model->postprocess_solution(iterate, termination_status);
+   }
+
+   size_t ReorderedModel::number_objective_gradient_nonzeros() const {
+      return this->model->number_objective_gradient_nonzeros();
+   }
+
+   size_t ReorderedModel::number_jacobian_nonzeros() const {
+      return this->model->number_jacobian_nonzeros();
+   }
+
+   size_t ReorderedModel::number_hessian_nonzeros() const {
+      return this->model->number_hessian_nonzeros();
+   }
+
+   const std::vector<size_t>& ReorderedModel::get_variable_permutation() const {
+      return this->variable_permutation;
+   }
+
+   const std::vector<size_t>& ReorderedModel::get_constraint_permutation() const {
+      return this->constraint_permutation;
+   }
+
+   void ReorderedModel::compute_orderings() {
+      // sparsity patterns at the initial point (unit multipliers so that the constraint curvature is included)
+      this->model->initial_primal_point(this->original_primals);
+      this->model->project_onto_variable_bounds(this->original_primals);
+      this->model->evaluate_constraint_jacobian(this->original_primals, this->original_jacobian);
+      this->original_multipliers.fill(1.);
+      this->model->evaluate_lagrangian_hessian(this->original_primals, 1., this->original_multipliers, this->original_hessian);
+
+      // bipartite graph: the nodes [0, n) are the variables, the nodes [n, n+m) are the constraints
+      std::vector<std::vector<size_t>> adjacency(this->number_variables + this->number_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         for (const auto [variable_index, _]: this->original_jacobian[constraint_index]) {
+            adjacency[variable_index].emplace_back(this->number_variables + constraint_index);
+            adjacency[this->number_variables + constraint_index].emplace_back(variable_index);
+         }
+      }
+      for (const auto [row_index, column_index, _]: this->original_hessian) {
+         if (row_index != column_index) {
+            adjacency[row_index].emplace_back(column_index);
+            adjacency[column_index].emplace_back(row_index);
+         }
+      }
+      const std::vector<size_t> permutation = compute_reverse_cuthill_mckee_ordering(adjacency);
+
+      // split the ordering into variables and constraints (their relative order is preserved)
+      this->variable_permutation.reserve(this->number_variables);
+      this->constraint_permutation.reserve(this->number_constraints);
+      for (size_t node: permutation) {
+         if (node < this->number_variables) {
+            this->variable_permutation.emplace_back(node);
+         }
+         else {
+            this->constraint_permutation.emplace_back(node - this->number_variables);
+         }
+      }
+      this->variable_inverse_permutation = invert_permutation(this->variable_permutation);
+      this->constraint_inverse_permutation = invert_permutation(this->constraint_permutation);
+
+      std::vector<size_t> identity(this->number_variables);
+      for (size_t variable_index: Range(this->number_variables)) {
+         identity[variable_index] = variable_index;
+      }
+      INFO << "Reordering of the variables and constraints: Jacobian envelope " <<
+         jacobian_envelope(this->original_jacobian, this->number_constraints, identity) << " -> " <<
+         jacobian_envelope(this->original_jacobian, this->number_constraints, this->variable_inverse_permutation) << '\n';
+   }
+
+   void ReorderedModel::compute_hessian_insertion_order() {
+      // permuted upper triangular indices of the Hessian nonzeros, sorted by column then row
+      const size_t number_nonzeros = this->original_hessian.number_nonzeros();
+      this->permuted_hessian_indices.reserve(number_nonzeros);
+      this->hessian_column_starts.assign(this->number_variables + 1, 0);
+      for (const auto [row_index, column_index, _]: this->original_hessian) {
+         const size_t permuted_row = this->variable_inverse_permutation[row_index];
+         const size_t permuted_column = this->variable_inverse_permutation[column_index];
+         this->permuted_hessian_indices.emplace_back(std::min(permuted_row, permuted_column), std::max(permuted_row, permuted_column));
+         this->hessian_column_starts[std::max(permuted_row, permuted_column) + 1]++;
+      }
+      for (size_t column_index: Range(this->number_variables)) {
+         this->hessian_column_starts[column_index + 1] += this->hessian_column_starts[column_index];
+      }
+      this->hessian_insertion_order.resize(number_nonzeros);
+      std::vector<size_t> next_position(this->hessian_column_starts.begin(), this->hessian_column_starts.end() - 1);
+      for (size_t nonzero_index: Range(number_nonzeros)) {
+         this->hessian_insertion_order[next_position[this->permuted_hessian_indices[nonzero_index].second]++] = nonzero_index;
+      }
+      for (size_t column_index: Range(this->number_variables)) {
+         std::sort(this->hessian_insertion_order.begin() + static_cast<std::ptrdiff_t>(this->hessian_column_starts[column_index]),
+               this->hessian_insertion_order.begin() + static_cast<std::ptrdiff_t>(this->hessian_column_starts[column_index + 1]),
+               [&](size_t nonzero_index1, size_t nonzero_index2) {
+                  return this->permuted_hessian_indices[nonzero_index1].first < this->permuted_hessian_indices[nonzero_index2].first;
+               });
+      }
+      this->hessian_entries.resize(number_nonzeros);
+   }
+
+   void ReorderedModel::permute_collections() {
+      const auto permute = [](const Collection<size_t>& collection, const std::vector<size_t>& inverse_permutation, std::vector<size_t>& result) {
+         result.reserve(collection.size());
+         for (size_t index: collection) {
+            result.emplace_back(inverse_permutation[index]);
+         }
+         std::sort(result.begin(), result.end());
+      };
+      permute(this->model->get_lower_bounded_variables(), this->variable_inverse_permutation, this->lower_bounded_variables);
+      permute(this->model->get_upper_bounded_variables(), this->variable_inverse_permutation, this->upper_bounded_variables);
+      permute(this->model->get_single_lower_bounded_variables(), this->variable_inverse_permutation, this->single_lower_bounded_variables);
+      permute(this->model->get_single_upper_bounded_variables(), this->variable_inverse_permutation, this->single_upper_bounded_variables);
+      permute(this->model->get_equality_constraints(), this->constraint_inverse_permutation, this->equality_constraints);
+      permute(this->model->get_inequality_constraints(), this->constraint_inverse_permutation, this->inequality_constraints);
+      permute(this->model->get_linear_constraints(), this->constraint_inverse_permutation, this->linear_constraints);
+
+      std::vector<size_t> permuted_fixed_variables{};
+      for (size_t variable_index: this->model->get_fixed_variables()) {
+         permuted_fixed_variables.emplace_back(this->variable_inverse_permutation[variable_index]);
+      }
+      std::sort(permuted_fixed_variables.begin(), permuted_fixed_variables.end());
+      this->fixed_variables.reserve(permuted_fixed_variables.size());
+      for (size_t variable_index: permuted_fixed_variables) {
+         this->fixed_variables.emplace_back(variable_index);
+      }
+      for (const auto [constraint_index, slack_index]: this->model->get_slacks()) {
+         this->slacks.insert(this->constraint_inverse_permutation[constraint_index], this->variable_inverse_permutation[slack_index]);
+      }
+   }
+
+   void ReorderedModel::to_original_primals(const Vector<double>& x) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->original_primals[this->variable_permutation[variable_index]] = x[variable_index];
+      }
+   }
+
+   void ReorderedModel::to_original_multipliers(const Vector<double>& multipliers) const {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->original_multipliers[this->constraint_permutation[constraint_index]] = multipliers[constraint_index];
+      }
+   }
+} // namespace
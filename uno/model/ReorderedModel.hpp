@@ -0,0 +1,119 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REORDEREDMODEL_H
+#define UNO_REORDEREDMODEL_H
+
+#include <memory>
+#include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   // permutes the variables and the constraints of a model to improve memory locality and bandwidth.
+   // The ordering is a reverse Cuthill-McKee ordering of the bipartite graph variables/constraints of the Jacobian, augmented with the
+   // off-diagonal Hessian nonzeros: the variables and the constraints are numbered in the relative order in which they appear.
+   // The sparsity patterns are those evaluated at the initial point.
+   // permutation[new index] = original index, inverse_permutation[original index] = new index
+   class ReorderedModel: public Model {
+   public:
+      explicit ReorderedModel(std::unique_ptr<Model> original_model);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      [[nodiscard]] size_t number_residuals() const override;
+      void evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const override;
+      void evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const override;
+      [[nodiscard]] size_t number_elements() const override;
+      void get_elements(std::vector<ElementFunction>& elements) const override;
+      void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override;
+      [[nodiscard]] size_t number_stages() const override;
+      void get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+      [[nodiscard]] bool is_thread_safe() const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override;
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+
+      [[nodiscard]] const std::vector<size_t>& get_variable_permutation() const;
+      [[nodiscard]] const std::vector<size_t>& get_constraint_permutation() const;
+
+   private:
+      const std::unique_ptr<Model> model;
+      std::vector<size_t> variable_permutation{};
+      std::vector<size_t> variable_inverse_permutation{};
+      std::vector<size_t> constraint_permutation{};
+      std::vector<size_t> constraint_inverse_permutation{};
+
+      // permuted collections
+      std::vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> lower_bounded_variables_collection;
+      std::vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> upper_bounded_variables_collection;
+      std::vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_lower_bounded_variables_collection;
+      std::vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_upper_bounded_variables_collection;
+      Vector<size_t> fixed_variables{};
+      SparseVector<size_t> slacks{};
+      std::vector<size_t> equality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> equality_constraints_collection;
+      std::vector<size_t> inequality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> inequality_constraints_collection;
+      std::vector<size_t> linear_constraints{};
+      CollectionAdapter<std::vector<size_t>&> linear_constraints_collection;
+
+      // Hessian of the original model and insertion order of its nonzeros in the permuted Hessian (column by column)
+      mutable SymmetricMatrix<size_t, double> original_hessian;
+      std::vector<size_t> hessian_column_starts{};
+      std::vector<size_t> hessian_insertion_order{};
+      std::vector<std::pair<size_t, size_t>> permuted_hessian_indices{}; // (row, column) with row <= column
+      mutable std::vector<double> hessian_entries{};
+
+      // workspaces in the original order
+      mutable Vector<double> original_primals;
+      mutable Vector<double> original_multipliers;
+      mutable std::vector<double> original_constraints;
+      mutable SparseVector<double> original_gradient;
+      mutable RectangularMatrix<double> original_jacobian;
+      mutable RectangularMatrix<double> original_residual_jacobian;
+
+      void compute_orderings();
+      void compute_hessian_insertion_order();
+      void permute_collections();
+      void to_original_primals(const Vector<double>& x) const;
+      void to_original_multipliers(const Vector<double>& multipliers) const;
+   };
+} // namespace
+
+#endif // UNO_REORDEREDMODEL_H
@@ -1,6 +1,7 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <cmath>
 #include "ScaledModel.hpp"
 #include "Model.hpp"
 #include "optimization/Iterate.hpp"
@@ -31,6 +32,9 @@ namespace uno {
       for ([[maybe_unused]] size_t constraint_index: Range(this->number_constraints)) {
          assert(0 < this->scaling.get_constraint_scaling(constraint_index) && "Constraint scaling failed.");
       }
+      if (0 < this->model->number_elements()) {
+         this->model->get_elements(this->elements);
+      }
    }
 
    double ScaledModel::evaluate_objective(const Vector<double>& x) const {
@@ -74,6 +78,60 @@ namespace uno {
       this->model->evaluate_lagrangian_hessian(x, scaled_objective_multiplier, scaled_multipliers, hessian);
    }
 
+   size_t ScaledModel::number_residuals() const {
+      return this->model->number_residuals();
+   }
+
+   // f = 1/2 ||r||^2 is scaled by s_f: the residuals are scaled by sqrt(s_f)
+   void ScaledModel::evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const {
+      this->model->evaluate_residuals(x, residuals);
+      const double residual_scaling = std::sqrt(this->scaling.get_objective_scaling());
+      for (double& residual: residuals) {
+         residual *= residual_scaling;
+      }
+   }
+
+   void ScaledModel::evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const {
+      this->model->evaluate_residual_jacobian(x, residual_jacobian);
+      const double residual_scaling = std::sqrt(this->scaling.get_objective_scaling());
+      for (size_t residual_index: Range(this->number_residuals())) {
+         scale(residual_jacobian[residual_index], residual_scaling);
+      }
+   }
+
+   size_t ScaledModel::number_elements() const {
+      return this->model->number_elements();
+   }
+
+   void ScaledModel::get_elements(std::vector<ElementFunction>& elements) const {
+      this->model->get_elements(elements);
+   }
+
+   void ScaledModel::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      this->model->evaluate_element_gradients(x, element_gradients);
+      size_t offset = 0;
+      for (const ElementFunction& element: this->elements) {
+         const double element_scaling = element.constraint_index.has_value() ?
+               this->scaling.get_constraint_scaling(*element.constraint_index) : this->scaling.get_objective_scaling();
+         for (size_t local_index: Range(element.variables.size())) {
+            element_gradients[offset + local_index] *= element_scaling;
+         }
+         offset += element.variables.size();
+      }
+   }
+
+   size_t ScaledModel::number_stages() const {
+      return this->model->number_stages();
+   }
+
+   void ScaledModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      this->model->get_stages(variable_stages, constraint_stages);
+   }
+
+   bool ScaledModel::is_thread_safe() const {
+      return this->model->is_thread_safe();
+   }
+
    double ScaledModel::variable_lower_bound(size_t variable_index) const {
       return this->model->variable_lower_bound(variable_index);
    }
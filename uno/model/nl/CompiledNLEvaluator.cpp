@@ -0,0 +1,615 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include "CompiledNLEvaluator.hpp"
+#include "symbolic/Range.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define UNO_HAS_DYNAMIC_LOADING
+#endif
+
+namespace uno {
+   namespace {
+      // forward-mode dual numbers (for the forward-over-reverse Hessians) and Hessian driver, shared by all the kernels
+      const char* source_preamble = R"(// generated by Uno: element kernels of a .nl model
+#include <cmath>
+#include <vector>
+
+namespace {
+   struct Dual {
+      double v;
+      double d;
+      Dual(double v = 0., double d = 0.): v(v), d(d) { }
+   };
+   inline double value(double a) { return a; }
+   inline double value(const Dual& a) { return a.v; }
+   inline Dual operator+(const Dual& a, const Dual& b) { return {a.v + b.v, a.d + b.d}; }
+   inline Dual operator-(const Dual& a, const Dual& b) { return {a.v - b.v, a.d - b.d}; }
+   inline Dual operator*(const Dual& a, const Dual& b) { return {a.v * b.v, a.d * b.v + a.v * b.d}; }
+   inline Dual operator/(const Dual& a, const Dual& b) { return {a.v / b.v, (a.d * b.v - a.v * b.d) / (b.v * b.v)}; }
+   inline Dual operator-(const Dual& a) { return {-a.v, -a.d}; }
+   inline Dual& operator+=(Dual& a, const Dual& b) { a.v += b.v; a.d += b.d; return a; }
+   inline Dual& operator-=(Dual& a, const Dual& b) { a.v -= b.v; a.d -= b.d; return a; }
+
+   using std::sqrt; using std::exp; using std::log; using std::log10; using std::sin; using std::cos; using std::tan; using std::sinh;
+   using std::cosh; using std::tanh; using std::asin; using std::acos; using std::atan; using std::asinh; using std::acosh; using std::atanh;
+   using std::atan2; using std::pow; using std::fabs;
+   inline Dual sqrt(const Dual& a) { const double s = std::sqrt(a.v); return {s, a.d / (2. * s)}; }
+   inline Dual exp(const Dual& a) { const double e = std::exp(a.v); return {e, e * a.d}; }
+   inline Dual log(const Dual& a) { return {std::log(a.v), a.d / a.v}; }
+   inline Dual log10(const Dual& a) { return {std::log10(a.v), a.d / (2.302585092994046 * a.v)}; }
+   inline Dual sin(const Dual& a) { return {std::sin(a.v), std::cos(a.v) * a.d}; }
+   inline Dual cos(const Dual& a) { return {std::cos(a.v), -std::sin(a.v) * a.d}; }
+   inline Dual tan(const Dual& a) { const double t = std::tan(a.v); return {t, (1. + t * t) * a.d}; }
+   inline Dual sinh(const Dual& a) { return {std::sinh(a.v), std::cosh(a.v) * a.d}; }
+   inline Dual cosh(const Dual& a) { return {std::cosh(a.v), std::sinh(a.v) * a.d}; }
+   inline Dual tanh(const Dual& a) { const double t = std::tanh(a.v); return {t, (1. - t * t) * a.d}; }
+   inline Dual asin(const Dual& a) { return {std::asin(a.v), a.d / std::sqrt(1. - a.v * a.v)}; }
+   inline Dual acos(const Dual& a) { return {std::acos(a.v), -a.d / std::sqrt(1. - a.v * a.v)}; }
+   inline Dual atan(const Dual& a) { return {std::atan(a.v), a.d / (1. + a.v * a.v)}; }
+   inline Dual asinh(const Dual& a) { return {std::asinh(a.v), a.d / std::sqrt(a.v * a.v + 1.)}; }
+   inline Dual acosh(const Dual& a) { return {std::acosh(a.v), a.d / std::sqrt(a.v * a.v - 1.)}; }
+   inline Dual atanh(const Dual& a) { return {std::atanh(a.v), a.d / (1. - a.v * a.v)}; }
+   inline Dual atan2(const Dual& y, const Dual& x) {
+      const double r = x.v * x.v + y.v * y.v;
+      return {std::atan2(y.v, x.v), (x.v * y.d - y.v * x.d) / r};
+   }
+   inline Dual fabs(const Dual& a) { return (a.v < 0.) ? -a : a; }
+   inline Dual pow(const Dual& a, double b) { return {std::pow(a.v, b), b * std::pow(a.v, b - 1.) * a.d}; }
+   inline Dual pow(double a, const Dual& b) { const double p = std::pow(a, b.v); return {p, p * std::log(a) * b.d}; }
+   inline Dual pow(const Dual& a, const Dual& b) {
+      const double p = std::pow(a.v, b.v);
+      double d = b.v * std::pow(a.v, b.v - 1.) * a.d;
+      if (b.d != 0.) {
+         d += p * std::log(a.v) * b.d;
+      }
+      return {p, d};
+   }
+
+   // dense upper triangular Hessian (column by column) of an element with K variables: one forward-mode sweep per variable
+   template <int K>
+   void hessian_driver(void (*gradient)(const Dual*, const double*, Dual*), const double* v, const double* c, double* h) {
+      std::vector<Dual> w(K), g(K);
+      for (int d = 0; d < K; d++) {
+         for (int l = 0; l < K; l++) {
+            w[l] = Dual(v[l], (l == d) ? 1. : 0.);
+         }
+         gradient(w.data(), c, g.data());
+         for (int l = 0; l <= d; l++) {
+            h[d * (d + 1) / 2 + l] = g[l].d;
+         }
+      }
+   }
+)";
+
+      std::string format_literal(double number) {
+         std::array<char, 32> buffer{};
+         std::snprintf(buffer.data(), buffer.size(), "%.17g", number);
+         std::string literal(buffer.data());
+         if (literal.find_first_of(".en") == std::string::npos) {
+            literal += ".";
+         }
+         return literal;
+      }
+
+      // code of an element: the constants are replaced by c[j] (the kernel depends on the structure only), except for the exponents
+      struct KernelCode {
+         std::string forward{};
+         std::string reverse{};
+         size_t number_variables{0};
+         size_t root_position{0};
+         bool is_linear{false};
+      };
+
+      class KernelGenerator {
+      public:
+         explicit KernelGenerator(const NLProblem& problem): problem(problem), tape_positions(problem.nodes.size()) { }
+
+         KernelCode generate(const NLElement& element, std::vector<double>& constants) {
+            KernelCode code{};
+            code.number_variables = element.variables.size();
+            code.root_position = element.tape.size() - 1;
+            code.is_linear = element.is_linear;
+            this->is_passive.assign(element.tape.size(), false);
+            std::ostringstream forward, reverse;
+
+            // forward sweep
+            size_t number_constants = 0;
+            for (size_t position: Range(element.tape.size())) {
+               const size_t node_index = element.tape[position];
+               this->tape_positions[node_index] = position;
+               const NLNode& node = this->problem.nodes[node_index];
+               if (node.op == NLOperator::CONSTANT) {
+                  this->is_passive[position] = true;
+                  forward << "      const double t" << position << " = c[" << number_constants++ << "];\n";
+                  constants.emplace_back(node.value);
+                  continue;
+               }
+               if (node.op == NLOperator::VARIABLE) {
+                  const auto local_index = std::lower_bound(element.variables.begin(), element.variables.end(), node.variable_index) -
+                        element.variables.begin();
+                  forward << "      const T t" << position << " = v[" << local_index << "];\n";
+                  continue;
+               }
+               bool all_passive = true;
+               for (size_t argument_index: Range(node.number_arguments)) {
+                  all_passive = all_passive && this->is_passive[this->argument_position(node, argument_index)];
+               }
+               this->is_passive[position] = all_passive || node.op == NLOperator::FLOOR || node.op == NLOperator::CEIL;
+               const std::string type = this->is_passive[position] ? "double" : "T";
+               if (node.op == NLOperator::MIN || node.op == NLOperator::MAX) {
+                  const char* comparison = (node.op == NLOperator::MIN) ? " < " : " > ";
+                  forward << "      " << type << " t" << position << " = " << this->t(node, 0) << "; int s" << position << " = 0;\n";
+                  for (size_t argument_index: Range(1, node.number_arguments)) {
+                     forward << "      if (value(" << this->t(node, argument_index) << ")" << comparison << "value(t" << position << ")) { t" <<
+                           position << " = " << this->t(node, argument_index) << "; s" << position << " = " << argument_index << "; }\n";
+                  }
+               }
+               else {
+                  forward << "      const " << type << " t" << position << " = " << this->forward_expression(node) << ";\n";
+               }
+            }
+
+            // reverse sweep
+            for (size_t position: Range(element.tape.size())) {
+               if (not this->is_passive[position]) {
+                  reverse << "      T a" << position << " = " << ((position == code.root_position) ? "1." : "0.") << ";\n";
+               }
+            }
+            for (size_t position = element.tape.size(); position-- > 0;) {
+               const NLNode& node = this->problem.nodes[element.tape[position]];
+               if (not this->is_passive[position] && node.op != NLOperator::VARIABLE) {
+                  this->reverse_rules(node, position, reverse);
+               }
+            }
+            for (size_t position: Range(element.tape.size())) {
+               const NLNode& node = this->problem.nodes[element.tape[position]];
+               if (node.op == NLOperator::VARIABLE) {
+                  const auto local_index = std::lower_bound(element.variables.begin(), element.variables.end(), node.variable_index) -
+                        element.variables.begin();
+                  reverse << "      g[" << local_index << "] = a" << position << ";\n";
+               }
+            }
+            code.forward = forward.str();
+            code.reverse = reverse.str();
+            return code;
+         }
+
+      private:
+         const NLProblem& problem;
+         std::vector<size_t> tape_positions; // position of the nodes in the tape of the current element
+         std::vector<bool> is_passive; // the node does not depend on the variables
+
+         [[nodiscard]] size_t argument_position(const NLNode& node, size_t argument_index) const {
+            return this->tape_positions[this->problem.argument(node, argument_index)];
+         }
+
+         [[nodiscard]] std::string t(const NLNode& node, size_t argument_index) const {
+            return "t" + std::to_string(this->argument_position(node, argument_index));
+         }
+
+         [[nodiscard]] bool is_active(const NLNode& node, size_t argument_index) const {
+            return not this->is_passive[this->argument_position(node, argument_index)];
+         }
+
+         [[nodiscard]] const NLNode* constant_exponent(const NLNode& node) const {
+            const NLNode& exponent = this->problem.nodes[this->problem.argument(node, 1)];
+            return (exponent.op == NLOperator::CONSTANT) ? &exponent : nullptr;
+         }
+
+         [[nodiscard]] std::string forward_expression(const NLNode& node) const {
+            const std::string x = this->t(node, 0);
+            switch (node.op) {
+               case NLOperator::PLUS: return x + " + " + this->t(node, 1);
+               case NLOperator::MINUS: return x + " - " + this->t(node, 1);
+               case NLOperator::MULT: return x + " * " + this->t(node, 1);
+               case NLOperator::DIV: return x + " / " + this->t(node, 1);
+               case NLOperator::UMINUS: return "-" + x;
+               case NLOperator::SUM: {
+                  std::string sum = x;
+                  for (size_t argument_index: Range(1, node.number_arguments)) {
+                     sum += " + " + this->t(node, argument_index);
+                  }
+                  return sum;
+               }
+               case NLOperator::POW: {
+                  const NLNode* exponent = this->constant_exponent(node);
+                  if (exponent != nullptr && exponent->value == 2.) {
+                     return x + " * " + x;
+                  }
+                  return "pow(" + x + ", " + ((exponent != nullptr) ? format_literal(exponent->value) : this->t(node, 1)) + ")";
+               }
+               case NLOperator::FLOOR: return "std::floor(value(" + x + "))";
+               case NLOperator::CEIL: return "std::ceil(value(" + x + "))";
+               case NLOperator::ABS: return "fabs(" + x + ")";
+               case NLOperator::SQRT: return "sqrt(" + x + ")";
+               case NLOperator::EXP: return "exp(" + x + ")";
+               case NLOperator::LOG: return "log(" + x + ")";
+               case NLOperator::LOG10: return "log10(" + x + ")";
+               case NLOperator::SIN: return "sin(" + x + ")";
+               case NLOperator::COS: return "cos(" + x + ")";
+               case NLOperator::TAN: return "tan(" + x + ")";
+               case NLOperator::SINH: return "sinh(" + x + ")";
+               case NLOperator::COSH: return "cosh(" + x + ")";
+               case NLOperator::TANH: return "tanh(" + x + ")";
+               case NLOperator::ASIN: return "asin(" + x + ")";
+               case NLOperator::ACOS: return "acos(" + x + ")";
+               case NLOperator::ATAN: return "atan(" + x + ")";
+               case NLOperator::ASINH: return "asinh(" + x + ")";
+               case NLOperator::ACOSH: return "acosh(" + x + ")";
+               case NLOperator::ATANH: return "atanh(" + x + ")";
+               case NLOperator::ATAN2: return "atan2(" + x + ", " + this->t(node, 1) + ")";
+               default: throw std::runtime_error("CompiledNLEvaluator: unexpected operator");
+            }
+         }
+
+         // propagate the adjoint of a node to its (active) arguments
+         void reverse_rules(const NLNode& node, size_t position, std::ostringstream& reverse) const {
+            const std::string a = "a" + std::to_string(position);
+            const std::string t_node = "t" + std::to_string(position);
+            const auto update = [&](size_t argument_index, const char* operation, const std::string& expression) {
+               if (this->is_active(node, argument_index)) {
+                  reverse << "      a" << this->argument_position(node, argument_index) << operation << expression << ";\n";
+               }
+            };
+            const std::string x = this->t(node, 0);
+            switch (node.op) {
+               case NLOperator::PLUS: update(0, " += ", a); update(1, " += ", a); break;
+               case NLOperator::MINUS: update(0, " += ", a); update(1, " -= ", a); break;
+               case NLOperator::MULT: update(0, " += ", a + " * " + this->t(node, 1)); update(1, " += ", a + " * " + x); break;
+               case NLOperator::DIV:
+                  update(0, " += ", a + " / " + this->t(node, 1));
+                  update(1, " -= ", a + " * " + t_node + " / " + this->t(node, 1));
+                  break;
+               case NLOperator::UMINUS: update(0, " -= ", a); break;
+               case NLOperator::SUM:
+                  for (size_t argument_index: Range(node.number_arguments)) {
+                     update(argument_index, " += ", a);
+                  }
+                  break;
+               case NLOperator::MIN: case NLOperator::MAX:
+                  for (size_t argument_index: Range(node.number_arguments)) {
+                     if (this->is_active(node, argument_index)) {
+                        reverse << "      if (s" << position << " == " << argument_index << ") { a" << this->argument_position(node, argument_index) <<
+                              " += " << a << "; }\n";
+                     }
+                  }
+                  break;
+               case NLOperator::POW: {
+                  const NLNode* exponent = this->constant_exponent(node);
+                  if (exponent != nullptr && exponent->value == 2.) {
+                     update(0, " += ", a + " * (2. * " + x + ")");
+                  }
+                  else if (exponent != nullptr) {
+                     update(0, " += ", a + " * (" + format_literal(exponent->value) + " * pow(" + x + ", " + format_literal(exponent->value - 1.) + "))");
+                  }
+                  else {
+                     const std::string y = this->t(node, 1);
+                     update(0, " += ", a + " * (" + y + " * pow(" + x + ", " + y + " - 1.))");
+                     update(1, " += ", a + " * (" + t_node + " * log(" + x + "))");
+                  }
+                  break;
+               }
+               case NLOperator::ABS: update(0, " += ", "(value(" + x + ") < 0.) ? -" + a + " : " + a); break;
+               case NLOperator::SQRT: update(0, " += ", a + " / (2. * " + t_node + ")"); break;
+               case NLOperator::EXP: update(0, " += ", a + " * " + t_node); break;
+               case NLOperator::LOG: update(0, " += ", a + " / " + x); break;
+               case NLOperator::LOG10: update(0, " += ", a + " / (2.302585092994046 * " + x + ")"); break;
+               case NLOperator::SIN: update(0, " += ", a + " * cos(" + x + ")"); break;
+               case NLOperator::COS: update(0, " -= ", a + " * sin(" + x + ")"); break;
+               case NLOperator::TAN: update(0, " += ", a + " * (1. + " + t_node + " * " + t_node + ")"); break;
+               case NLOperator::SINH: update(0, " += ", a + " * cosh(" + x + ")"); break;
+               case NLOperator::COSH: update(0, " += ", a + " * sinh(" + x + ")"); break;
+               case NLOperator::TANH: update(0, " += ", a + " * (1. - " + t_node + " * " + t_node + ")"); break;
+               case NLOperator::ASIN: update(0, " += ", a + " / sqrt(1. - " + x + " * " + x + ")"); break;
+               case NLOperator::ACOS: update(0, " -= ", a + " / sqrt(1. - " + x + " * " + x + ")"); break;
+               case NLOperator::ATAN: update(0, " += ", a + " / (1. + " + x + " * " + x + ")"); break;
+               case NLOperator::ASINH: update(0, " += ", a + " / sqrt(" + x + " * " + x + " + 1.)"); break;
+               case NLOperator::ACOSH: update(0, " += ", a + " / sqrt(" + x + " * " + x + " - 1.)"); break;
+               case NLOperator::ATANH: update(0, " += ", a + " / (1. - " + x + " * " + x + ")"); break;
+               case NLOperator::ATAN2: {
+                  // atan2(y, x)
+                  const std::string y = x;
+                  const std::string x2 = this->t(node, 1);
+                  const std::string r = "(" + y + " * " + y + " + " + x2 + " * " + x2 + ")";
+                  update(0, " += ", a + " * " + x2 + " / " + r);
+                  update(1, " -= ", a + " * " + y + " / " + r);
+                  break;
+               }
+               default: break;
+            }
+         }
+      };
+
+      // 64-bit FNV-1a hash
+      std::string hash(const std::string& text) {
+         uint64_t hash_value = 14695981039346656037ULL;
+         for (const char character: text) {
+            hash_value ^= static_cast<uint8_t>(character);
+            hash_value *= 1099511628211ULL;
+         }
+         std::ostringstream stream;
+         stream << std::hex << std::setw(16) << std::setfill('0') << hash_value;
+         return stream.str();
+      }
+
+#ifdef UNO_HAS_DYNAMIC_LOADING
+      // the cached libraries are loaded into the process: the directory and the libraries must belong to the user and must not be
+      // writable by the other users, otherwise they could substitute their own code
+      void check_ownership(const std::filesystem::path& path, bool is_directory) {
+         struct stat status{};
+         if (lstat(path.c_str(), &status) != 0) {
+            throw std::runtime_error("CompiledNLEvaluator: " + path.string() + " cannot be accessed");
+         }
+         const bool has_expected_type = is_directory ? S_ISDIR(status.st_mode) : S_ISREG(status.st_mode);
+         if (not has_expected_type || status.st_uid != geteuid() || (status.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+            throw std::runtime_error("CompiledNLEvaluator: " + path.string() + " is not a " + (is_directory ? "directory" : "file") +
+                  " owned by the current user and protected from writing by the other users");
+         }
+      }
+
+      // a new cache directory is private to the user
+      void prepare_cache_directory(const std::filesystem::path& directory_path) {
+         if (std::filesystem::create_directories(directory_path)) {
+            std::filesystem::permissions(directory_path, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace);
+         }
+         check_ownership(directory_path, true);
+      }
+
+      // runs the compiler without a shell. The compiler option is split at the spaces (program and optional flags) and the paths are
+      // passed as separate arguments. The output of the compiler is redirected to the log file
+      bool run_compiler(const std::string& compiler, const std::vector<std::string>& arguments, const std::string& log_path) {
+         std::vector<std::string> command{};
+         std::istringstream compiler_stream(compiler);
+         for (std::string word; compiler_stream >> word;) {
+            command.emplace_back(std::move(word));
+         }
+         if (command.empty()) {
+            throw std::runtime_error("CompiledNLEvaluator: no compiler was specified");
+         }
+         command.insert(command.end(), arguments.begin(), arguments.end());
+         std::vector<char*> argv{};
+         for (std::string& argument: command) {
+            argv.emplace_back(argument.data());
+         }
+         argv.emplace_back(nullptr);
+
+         const int log_descriptor = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+         if (log_descriptor < 0) {
+            throw std::runtime_error("CompiledNLEvaluator: the log file " + log_path + " could not be created");
+         }
+         const pid_t process = fork();
+         if (process == 0) {
+            // child process: only async-signal-safe calls
+            dup2(log_descriptor, STDOUT_FILENO);
+            dup2(log_descriptor, STDERR_FILENO);
+            execvp(argv[0], argv.data());
+            _exit(127);
+         }
+         close(log_descriptor);
+         if (process < 0) {
+            throw std::runtime_error("CompiledNLEvaluator: the compiler process could not be created");
+         }
+         int status = 0;
+         while (waitpid(process, &status, 0) < 0) {
+            if (errno != EINTR) {
+               return false;
+            }
+         }
+         return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+      }
+#endif
+   } // namespace
+
+   CompiledNLEvaluator::CompiledNLEvaluator(NLProblem problem, const std::string& compiler, const std::string& directory):
+         NLEvaluator(std::move(problem)) {
+      const std::string source = this->generate_source();
+      this->compile_and_load(source, compiler, directory);
+   }
+
+   CompiledNLEvaluator::~CompiledNLEvaluator() {
+#ifdef UNO_HAS_DYNAMIC_LOADING
+      if (this->library_handle != nullptr) {
+         dlclose(this->library_handle);
+      }
+#endif
+   }
+
+   size_t CompiledNLEvaluator::number_kernels() const {
+      return this->value_kernels.size();
+   }
+
+   // per-user cache: $XDG_CACHE_HOME/uno, ~/.cache/uno or the uno-<user id> subdirectory of the temporary directory
+   std::string CompiledNLEvaluator::default_directory() {
+#ifdef UNO_HAS_DYNAMIC_LOADING
+      if (const char* cache_home = std::getenv("XDG_CACHE_HOME"); cache_home != nullptr && std::filesystem::path(cache_home).is_absolute()) {
+         return (std::filesystem::path(cache_home) / "uno").string();
+      }
+      if (const char* home = std::getenv("HOME"); home != nullptr && std::filesystem::path(home).is_absolute()) {
+         return (std::filesystem::path(home) / ".cache" / "uno").string();
+      }
+      return (std::filesystem::temp_directory_path() / ("uno-" + std::to_string(geteuid()))).string();
+#else
+      return (std::filesystem::temp_directory_path() / "uno").string();
+#endif
+   }
+
+   const std::string& CompiledNLEvaluator::get_library_path() const {
+      return this->library_path;
+   }
+
+   double CompiledNLEvaluator::evaluate_elements(size_t function_index, const double* x) const {
+      const std::vector<NLElement>& elements = this->problem.functions[function_index].elements;
+      double* local_variables = this->get_workspace().local_variables.data();
+      double result = 0.;
+      for (size_t element_index: Range(elements.size())) {
+         const size_t index = this->function_element_starts[function_index] + element_index;
+         CompiledNLEvaluator::gather_variables(elements[element_index], x, local_variables);
+         result += elements[element_index].coefficient * this->value_kernels[this->element_kernels[index]](local_variables,
+               this->constants.data() + this->element_constant_starts[index]);
+      }
+      return result;
+   }
+
+   void CompiledNLEvaluator::evaluate_element_gradient(size_t function_index, size_t element_index, const double* x,
+         double* local_gradient) const {
+      const size_t index = this->function_element_starts[function_index] + element_index;
+      double* local_variables = this->get_workspace().local_variables.data();
+      CompiledNLEvaluator::gather_variables(this->problem.functions[function_index].elements[element_index], x, local_variables);
+      this->gradient_kernels[this->element_kernels[index]](local_variables, this->constants.data() + this->element_constant_starts[index],
+            local_gradient);
+   }
+
+   void CompiledNLEvaluator::add_element_hessians(const double* x, const double* weights, double* hessian) const {
+      Workspace& workspace = this->get_workspace();
+      for (size_t function_index: Range(this->problem.functions.size())) {
+         if (weights[function_index] == 0.) {
+            continue;
+         }
+         const std::vector<NLElement>& elements = this->problem.functions[function_index].elements;
+         for (size_t element_index: Range(elements.size())) {
+            const NLElement& element = elements[element_index];
+            if (not element.is_linear) {
+               const size_t index = this->function_element_starts[function_index] + element_index;
+               CompiledNLEvaluator::gather_variables(element, x, workspace.local_variables.data());
+               this->hessian_kernels[this->element_kernels[index]](workspace.local_variables.data(), this->constants.data() +
+                     this->element_constant_starts[index], workspace.local_hessian.data());
+               const double scaling = weights[function_index] * element.coefficient;
+               for (size_t local_index: Range(element.hessian_positions.size())) {
+                  hessian[element.hessian_positions[local_index]] += scaling * workspace.local_hessian[local_index];
+               }
+            }
+         }
+      }
+   }
+
+   void CompiledNLEvaluator::gather_variables(const NLElement& element, const double* x, double* local_variables) {
+      for (size_t local_index: Range(element.variables.size())) {
+         local_variables[local_index] = x[element.variables[local_index]];
+      }
+   }
+
+   // generate the kernels of the distinct element structures and the tables of the elements
+   std::string CompiledNLEvaluator::generate_source() {
+      KernelGenerator generator(this->problem);
+      std::unordered_map<std::string, size_t> kernel_indices{};
+      std::vector<KernelCode> kernels{};
+      for (const NLFunction& function: this->problem.functions) {
+         this->function_element_starts.emplace_back(this->element_kernels.size());
+         for (const NLElement& element: function.elements) {
+            this->element_constant_starts.emplace_back(this->constants.size());
+            KernelCode code = generator.generate(element, this->constants);
+            std::string key = code.forward + code.reverse;
+            const auto [iterator, is_new] = kernel_indices.emplace(std::move(key), kernels.size());
+            if (is_new) {
+               kernels.emplace_back(std::move(code));
+            }
+            this->element_kernels.emplace_back(iterator->second);
+         }
+      }
+
+      std::ostringstream source;
+      source << source_preamble;
+      for (size_t kernel_index: Range(kernels.size())) {
+         const KernelCode& kernel = kernels[kernel_index];
+         source << "\n   double value_" << kernel_index << "(const double* v, const double* c) {\n      using T = double;\n" << kernel.forward <<
+               "      return t" << kernel.root_position << ";\n   }\n";
+         source << "   template <typename T>\n   void gradient_" << kernel_index << "(const T* v, const double* c, T* g) {\n" << kernel.forward <<
+               kernel.reverse << "   }\n";
+         if (not kernel.is_linear) {
+            source << "   void hessian_" << kernel_index << "(const double* v, const double* c, double* h) {\n      hessian_driver<" <<
+                  kernel.number_variables << ">(gradient_" << kernel_index << "<Dual>, v, c, h);\n   }\n";
+         }
+      }
+      source << "} // namespace\n\n";
+      source << "typedef double (*uno_value_kernel)(const double*, const double*);\n";
+      source << "typedef void (*uno_derivative_kernel)(const double*, const double*, double*);\n";
+      source << "extern \"C\" unsigned long uno_nl_number_kernels() {\n   return " << kernels.size() << ";\n}\n\n";
+      source << "extern \"C\" void uno_nl_get_kernels(uno_value_kernel* values, uno_derivative_kernel* gradients, "
+                "uno_derivative_kernel* hessians) {\n";
+      for (size_t kernel_index: Range(kernels.size())) {
+         source << "   values[" << kernel_index << "] = value_" << kernel_index << ";\n";
+         source << "   gradients[" << kernel_index << "] = gradient_" << kernel_index << "<double>;\n";
+         source << "   hessians[" << kernel_index << "] = " << (kernels[kernel_index].is_linear ? "nullptr" : "hessian_" +
+               std::to_string(kernel_index)) << ";\n";
+      }
+      source << "}\n";
+      return source.str();
+   }
+
+   void CompiledNLEvaluator::compile_and_load(const std::string& source, const std::string& compiler, const std::string& directory) {
+#ifdef UNO_HAS_DYNAMIC_LOADING
+      const std::filesystem::path directory_path(directory);
+      prepare_cache_directory(directory_path);
+      const std::string library_name = "uno_nl_" + hash(compiler + '\n' + source);
+      this->library_path = (directory_path / (library_name + ".so")).string();
+
+      // compile the source, unless the library is in the cache
+      if (not std::filesystem::exists(this->library_path)) {
+         // concurrent compilations of the same model (by several processes or threads) write to different files
+         const std::string suffix = std::to_string(getpid()) + "_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+         const std::string source_path = (directory_path / (library_name + "." + suffix + ".cpp")).string();
+         const std::string log_path = (directory_path / (library_name + "." + suffix + ".log")).string();
+         const std::string temporary_path = this->library_path + "." + suffix + ".tmp";
+         std::ofstream source_file(source_path);
+         source_file << source;
+         source_file.close();
+         if (not run_compiler(compiler, {"-std=c++17", "-O2", "-fPIC", "-shared", "-w", "-o", temporary_path, source_path}, log_path)) {
+            std::filesystem::remove(temporary_path);
+            throw std::runtime_error("CompiledNLEvaluator: the compilation with " + compiler + " failed, see " + log_path);
+         }
+         // the library is private to the user, regardless of the umask
+         std::filesystem::permissions(temporary_path, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace);
+         std::filesystem::rename(temporary_path, this->library_path);
+         std::filesystem::rename(source_path, (directory_path / (library_name + ".cpp")).string());
+         std::filesystem::remove(log_path);
+      }
+
+      // load the kernels
+      check_ownership(this->library_path, false);
+      this->library_handle = dlopen(this->library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+      if (this->library_handle == nullptr) {
+         throw std::runtime_error("CompiledNLEvaluator: the library " + this->library_path + " could not be loaded: " + dlerror());
+      }
+      using NumberKernelsFunction = unsigned long (*)();
+      using GetKernelsFunction = void (*)(ValueKernel*, GradientKernel*, HessianKernel*);
+      const auto number_kernels_function = reinterpret_cast<NumberKernelsFunction>(dlsym(this->library_handle, "uno_nl_number_kernels"));
+      const auto get_kernels_function = reinterpret_cast<GetKernelsFunction>(dlsym(this->library_handle, "uno_nl_get_kernels"));
+      const size_t expected_number_kernels = this->element_kernels.empty() ? 0 :
+            *std::max_element(this->element_kernels.begin(), this->element_kernels.end()) + 1;
+      if (number_kernels_function == nullptr || get_kernels_function == nullptr || number_kernels_function() != expected_number_kernels) {
+         dlclose(this->library_handle);
+         this->library_handle = nullptr;
+         throw std::runtime_error("CompiledNLEvaluator: the library " + this->library_path + " is invalid");
+      }
+      this->value_kernels.resize(expected_number_kernels);
+      this->gradient_kernels.resize(expected_number_kernels);
+      this->hessian_kernels.resize(expected_number_kernels);
+      get_kernels_function(this->value_kernels.data(), this->gradient_kernels.data(), this->hessian_kernels.data());
+#else
+      (void) source;
+      (void) compiler;
+      (void) directory;
+      throw std::runtime_error("CompiledNLEvaluator: runtime compilation is not supported on this platform");
+#endif
+   }
+} // namespace
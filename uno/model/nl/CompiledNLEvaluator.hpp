@@ -0,0 +1,60 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_COMPILEDNLEVALUATOR_H
+#define UNO_COMPILEDNLEVALUATOR_H
+
+#include <string>
+#include <vector>
+#include "NLEvaluator.hpp"
+
+namespace uno {
+   /*! \class CompiledNLEvaluator
+    * \brief Evaluation of the elements by native code
+    *
+    *  The elements are translated into C++ kernels (value, reverse-mode gradient and forward-over-reverse Hessian), compiled with the
+    *  system compiler into a shared library and loaded at runtime. The constants of the elements are passed at runtime: the
+    *  structurally identical elements (e.g. the instances of an indexed AMPL constraint) share the same kernel, and the library
+    *  only depends on the structure of the model. The library is cached on disk under the hash of its source. The cache directory
+    *  and the libraries must belong to the user and must not be writable by the other users; the compiler is run without a shell.
+    *  Throws std::runtime_error if the library cannot be compiled or loaded.
+    */
+   class CompiledNLEvaluator: public NLEvaluator {
+   public:
+      CompiledNLEvaluator(NLProblem problem, const std::string& compiler, const std::string& directory);
+      ~CompiledNLEvaluator() override;
+
+      // per-user cache directory, created with mode 0700
+      [[nodiscard]] static std::string default_directory();
+      [[nodiscard]] size_t number_kernels() const;
+      [[nodiscard]] const std::string& get_library_path() const;
+
+   protected:
+      [[nodiscard]] double evaluate_elements(size_t function_index, const double* x) const override;
+      void evaluate_element_gradient(size_t function_index, size_t element_index, const double* x, double* local_gradient) const override;
+      void add_element_hessians(const double* x, const double* weights, double* hessian) const override;
+
+   private:
+      using ValueKernel = double (*)(const double*, const double*);
+      using GradientKernel = void (*)(const double*, const double*, double*);
+      using HessianKernel = void (*)(const double*, const double*, double*);
+
+      void* library_handle{nullptr};
+      std::string library_path{};
+      std::vector<ValueKernel> value_kernels{};
+      std::vector<GradientKernel> gradient_kernels{};
+      std::vector<HessianKernel> hessian_kernels{};
+
+      // elements of all the functions (function by function)
+      std::vector<size_t> function_element_starts{};
+      std::vector<size_t> element_kernels{};
+      std::vector<size_t> element_constant_starts{};
+      std::vector<double> constants{};
+
+      [[nodiscard]] std::string generate_source();
+      void compile_and_load(const std::string& source, const std::string& compiler, const std::string& directory);
+      static void gather_variables(const NLElement& element, const double* x, double* local_variables);
+   };
+} // namespace
+
+#endif // UNO_COMPILEDNLEVALUATOR_H
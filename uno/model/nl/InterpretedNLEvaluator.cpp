@@ -0,0 +1,494 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
+#include "InterpretedNLEvaluator.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/TaskScheduler.hpp"
+
+namespace uno {
+   namespace {
+      constexpr double LN10 = 2.302585092994046;
+
+      // forward-mode dual number (for the forward-over-reverse Hessians)
+      struct Dual {
+         double v;
+         double d;
+         Dual(double v = 0., double d = 0.): v(v), d(d) { }
+      };
+      inline double value(double a) { return a; }
+      inline double value(const Dual& a) { return a.v; }
+      inline Dual operator+(const Dual& a, const Dual& b) { return {a.v + b.v, a.d + b.d}; }
+      inline Dual operator-(const Dual& a, const Dual& b) { return {a.v - b.v, a.d - b.d}; }
+      inline Dual operator*(const Dual& a, const Dual& b) { return {a.v * b.v, a.d * b.v + a.v * b.d}; }
+      inline Dual operator/(const Dual& a, const Dual& b) { return {a.v / b.v, (a.d * b.v - a.v * b.d) / (b.v * b.v)}; }
+      inline Dual operator-(const Dual& a) { return {-a.v, -a.d}; }
+      inline Dual& operator+=(Dual& a, const Dual& b) { a.v += b.v; a.d += b.d; return a; }
+      inline Dual& operator-=(Dual& a, const Dual& b) { a.v -= b.v; a.d -= b.d; return a; }
+
+      using std::sqrt; using std::exp; using std::log; using std::log10; using std::sin; using std::cos; using std::tan; using std::sinh;
+      using std::cosh; using std::tanh; using std::asin; using std::acos; using std::atan; using std::asinh; using std::acosh; using std::atanh;
+      using std::atan2; using std::pow; using std::fabs;
+      inline Dual sqrt(const Dual& a) { const double s = std::sqrt(a.v); return {s, a.d / (2. * s)}; }
+      inline Dual exp(const Dual& a) { const double e = std::exp(a.v); return {e, e * a.d}; }
+      inline Dual log(const Dual& a) { return {std::log(a.v), a.d / a.v}; }
+      inline Dual log10(const Dual& a) { return {std::log10(a.v), a.d / (LN10 * a.v)}; }
+      inline Dual sin(const Dual& a) { return {std::sin(a.v), std::cos(a.v) * a.d}; }
+      inline Dual cos(const Dual& a) { return {std::cos(a.v), -std::sin(a.v) * a.d}; }
+      inline Dual tan(const Dual& a) { const double t = std::tan(a.v); return {t, (1. + t * t) * a.d}; }
+      inline Dual sinh(const Dual& a) { return {std::sinh(a.v), std::cosh(a.v) * a.d}; }
+      inline Dual cosh(const Dual& a) { return {std::cosh(a.v), std::sinh(a.v) * a.d}; }
+      inline Dual tanh(const Dual& a) { const double t = std::tanh(a.v); return {t, (1. - t * t) * a.d}; }
+      inline Dual asin(const Dual& a) { return {std::asin(a.v), a.d / std::sqrt(1. - a.v * a.v)}; }
+      inline Dual acos(const Dual& a) { return {std::acos(a.v), -a.d / std::sqrt(1. - a.v * a.v)}; }
+      inline Dual atan(const Dual& a) { return {std::atan(a.v), a.d / (1. + a.v * a.v)}; }
+      inline Dual asinh(const Dual& a) { return {std::asinh(a.v), a.d / std::sqrt(a.v * a.v + 1.)}; }
+      inline Dual acosh(const Dual& a) { return {std::acosh(a.v), a.d / std::sqrt(a.v * a.v - 1.)}; }
+      inline Dual atanh(const Dual& a) { return {std::atanh(a.v), a.d / (1. - a.v * a.v)}; }
+      inline Dual atan2(const Dual& y, const Dual& x) {
+         const double r = x.v * x.v + y.v * y.v;
+         return {std::atan2(y.v, x.v), (x.v * y.d - y.v * x.d) / r};
+      }
+      inline Dual fabs(const Dual& a) { return (a.v < 0.) ? -a : a; }
+      inline Dual pow(const Dual& a, const Dual& b) {
+         const double p = std::pow(a.v, b.v);
+         double d = b.v * std::pow(a.v, b.v - 1.) * a.d;
+         if (b.d != 0.) {
+            d += p * std::log(a.v) * b.d;
+         }
+         return {p, d};
+      }
+
+      // maximum number of instances of a family evaluated together
+      constexpr size_t batch_size = 64;
+      // granularity of the parallel loops: batches of constraint gradients and elements of a sum per task
+      constexpr size_t batches_per_task = 4;
+      constexpr size_t elements_per_task = 1024;
+
+      // variables and tapes of a batch of instances of the calling thread, stored instance by instance ([position * size + instance])
+      struct BatchWorkspace {
+         std::vector<size_t> instances{};
+         std::vector<double> variables{};
+         std::vector<double> values{};
+         std::vector<double> adjoints{};
+         std::vector<Dual> dual_variables{};
+         std::vector<Dual> dual_values{};
+         std::vector<Dual> dual_adjoints{};
+      };
+
+      BatchWorkspace& get_batch_workspace(size_t maximum_tape_size, size_t maximum_element_size) {
+         thread_local BatchWorkspace workspace{};
+         workspace.instances.reserve(batch_size);
+         workspace.variables.resize(maximum_element_size * batch_size);
+         workspace.values.resize(maximum_tape_size * batch_size);
+         workspace.adjoints.resize(maximum_tape_size * batch_size);
+         workspace.dual_variables.resize(maximum_element_size * batch_size);
+         workspace.dual_values.resize(maximum_tape_size * batch_size);
+         workspace.dual_adjoints.resize(maximum_tape_size * batch_size);
+         return workspace;
+      }
+
+      // index of the argument selected by min or max (the first one in case of ties)
+      template <typename Argument>
+      size_t selected_argument(NLOperator op, size_t number_arguments, const Argument& argument) {
+         size_t selected_index = 0;
+         for (size_t argument_index: Range(1, number_arguments)) {
+            const double candidate = value(argument(argument_index));
+            const double current = value(argument(selected_index));
+            if ((op == NLOperator::MIN) ? (candidate < current) : (current < candidate)) {
+               selected_index = argument_index;
+            }
+         }
+         return selected_index;
+      }
+   } // namespace
+
+   InterpretedNLEvaluator::InterpretedNLEvaluator(NLProblem problem): NLEvaluator(std::move(problem)) {
+      // translate the tapes of the elements: the nodes are replaced by their positions in the tape. The elements with the same tape
+      // up to the values of the constants (e.g. the instances of an indexed AMPL constraint) form a family that shares one tape
+      std::map<std::vector<size_t>, size_t> family_indices{};
+      std::vector<size_t> tape_positions(this->problem.nodes.size());
+      std::vector<Instruction> tape{};
+      std::vector<size_t> tape_arguments{};
+      std::vector<size_t> signature{};
+      std::vector<double> constants{};
+      for (size_t function_index: Range(this->problem.functions.size())) {
+         this->function_element_starts.emplace_back(this->element_families.size());
+         for (const NLElement& element: this->problem.functions[function_index].elements) {
+            tape.clear();
+            tape_arguments.clear();
+            constants.clear();
+            signature.assign({element.variables.size(), element.is_linear ? size_t(1) : size_t(0)});
+            for (size_t position: Range(element.tape.size())) {
+               const size_t node_index = element.tape[position];
+               tape_positions[node_index] = position;
+               const NLNode& node = this->problem.nodes[node_index];
+               Instruction instruction{node.op, tape_arguments.size(), node.number_arguments};
+               if (node.op == NLOperator::CONSTANT) {
+                  instruction.first_argument = constants.size();
+                  constants.emplace_back(node.value);
+               }
+               else if (node.op == NLOperator::VARIABLE) {
+                  instruction.first_argument = static_cast<size_t>(std::lower_bound(element.variables.begin(), element.variables.end(),
+                        node.variable_index) - element.variables.begin());
+               }
+               signature.insert(signature.end(), {static_cast<size_t>(node.op), instruction.first_argument, node.number_arguments});
+               for (size_t argument_index: Range(node.number_arguments)) {
+                  tape_arguments.emplace_back(tape_positions[this->problem.argument(node, argument_index)]);
+                  signature.emplace_back(tape_arguments.back());
+               }
+               tape.emplace_back(instruction);
+            }
+
+            const auto [iterator, is_new] = family_indices.emplace(signature, this->families.size());
+            if (is_new) {
+               Family& family = this->families.emplace_back();
+               family.tape_start = this->instructions.size();
+               family.tape_size = tape.size();
+               family.number_variables = element.variables.size();
+               family.number_constants = constants.size();
+               family.is_linear = element.is_linear;
+               for (Instruction& instruction: tape) {
+                  if (instruction.op != NLOperator::CONSTANT && instruction.op != NLOperator::VARIABLE) {
+                     instruction.first_argument += this->instruction_arguments.size();
+                  }
+                  this->instructions.emplace_back(instruction);
+               }
+               this->instruction_arguments.insert(this->instruction_arguments.end(), tape_arguments.begin(), tape_arguments.end());
+               this->maximum_tape_size = std::max(this->maximum_tape_size, tape.size());
+            }
+            Family& family = this->families[iterator->second];
+            this->element_families.emplace_back(iterator->second);
+            this->element_instances.emplace_back(family.elements.size());
+            family.elements.emplace_back(&element);
+            family.functions.emplace_back(function_index);
+            family.constants.insert(family.constants.end(), constants.begin(), constants.end());
+            // the instances of the constraints come first
+            if (function_index < this->problem.number_constraints) {
+               family.gradient_starts.emplace_back(this->element_gradient_starts[this->element_families.size() - 1]);
+            }
+         }
+      }
+      for (size_t family_index: Range(this->families.size())) {
+         for (size_t batch_start = 0; batch_start < this->families[family_index].gradient_starts.size(); batch_start += batch_size) {
+            this->constraint_batches.emplace_back(family_index, batch_start);
+         }
+      }
+      DEBUG << "The " << this->element_families.size() << " elements form " << this->families.size() << " families\n";
+   }
+
+   size_t InterpretedNLEvaluator::number_families() const {
+      return this->families.size();
+   }
+
+   double InterpretedNLEvaluator::evaluate_elements(size_t function_index, const double* x) const {
+      const auto element_value = [&](size_t element_index) {
+         BatchWorkspace& workspace = get_batch_workspace(this->maximum_tape_size, this->maximum_element_size);
+         const size_t index = this->function_element_starts[function_index] + element_index;
+         const Family& family = this->families[this->element_families[index]];
+         const size_t instance = this->element_instances[index];
+         InterpretedNLEvaluator::gather_variables(family, &instance, 1, x, workspace.variables.data());
+         this->forward_sweep(family, &instance, 1, workspace.variables.data(), workspace.values.data());
+         return family.elements[instance]->coefficient * workspace.values[family.tape_size - 1];
+      };
+      const size_t number_elements = this->problem.functions[function_index].elements.size();
+      if (number_elements <= elements_per_task) {
+         double result = 0.;
+         for (size_t element_index: Range(number_elements)) {
+            result += element_value(element_index);
+         }
+         return result;
+      }
+      // long sums (e.g. an objective with an element per data point) are split into chunks of fixed size: the result does not depend
+      // on the number of threads
+      return TaskScheduler::parallel_reduce(size_t(0), number_elements, elements_per_task, 0., element_value, std::plus<double>());
+   }
+
+   void InterpretedNLEvaluator::evaluate_element_gradient(size_t function_index, size_t element_index, const double* x,
+         double* local_gradient) const {
+      const size_t index = this->function_element_starts[function_index] + element_index;
+      const Family& family = this->families[this->element_families[index]];
+      const size_t instance = this->element_instances[index];
+      BatchWorkspace& workspace = get_batch_workspace(this->maximum_tape_size, this->maximum_element_size);
+      InterpretedNLEvaluator::gather_variables(family, &instance, 1, x, workspace.variables.data());
+      this->forward_sweep(family, &instance, 1, workspace.variables.data(), workspace.values.data());
+      this->reverse_sweep(family, 1, workspace.values.data(), workspace.adjoints.data());
+      std::fill(local_gradient, local_gradient + family.number_variables, 0.);
+      this->add_variable_adjoints(family, 1, workspace.adjoints.data(), &local_gradient);
+   }
+
+   void InterpretedNLEvaluator::add_element_hessians(const double* x, const double* weights, double* hessian) const {
+      BatchWorkspace& workspace = get_batch_workspace(this->maximum_tape_size, this->maximum_element_size);
+      for (const Family& family: this->families) {
+         if (family.is_linear) {
+            continue;
+         }
+         // the instances with nonzero weights, batch by batch
+         size_t next_instance = 0;
+         while (next_instance < family.elements.size()) {
+            workspace.instances.clear();
+            for (; next_instance < family.elements.size() && workspace.instances.size() < batch_size; next_instance++) {
+               if (weights[family.functions[next_instance]] != 0.) {
+                  workspace.instances.emplace_back(next_instance);
+               }
+            }
+            const size_t number_instances = workspace.instances.size();
+            if (number_instances == 0) {
+               continue;
+            }
+            // column d of the Hessians: derivatives of the gradients in the direction of the d-th variable
+            for (size_t direction: Range(family.number_variables)) {
+               for (size_t local_index: Range(family.number_variables)) {
+                  for (size_t batch_index: Range(number_instances)) {
+                     const NLElement& element = *family.elements[workspace.instances[batch_index]];
+                     workspace.dual_variables[local_index * number_instances + batch_index] =
+                           Dual(x[element.variables[local_index]], (local_index == direction) ? 1. : 0.);
+                  }
+               }
+               this->forward_sweep(family, workspace.instances.data(), number_instances, workspace.dual_variables.data(),
+                     workspace.dual_values.data());
+               this->reverse_sweep(family, number_instances, workspace.dual_values.data(), workspace.dual_adjoints.data());
+               for (size_t position: Range(family.tape_size)) {
+                  const Instruction& instruction = this->instructions[family.tape_start + position];
+                  if (instruction.op == NLOperator::VARIABLE && instruction.first_argument <= direction) {
+                     const size_t local_position = direction * (direction + 1) / 2 + instruction.first_argument;
+                     for (size_t batch_index: Range(number_instances)) {
+                        const size_t instance = workspace.instances[batch_index];
+                        const NLElement& element = *family.elements[instance];
+                        hessian[element.hessian_positions[local_position]] += weights[family.functions[instance]] * element.coefficient *
+                              workspace.dual_adjoints[position * number_instances + batch_index].d;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   void InterpretedNLEvaluator::add_constraint_elements(const double* x, double* constraints) const {
+      BatchWorkspace& workspace = get_batch_workspace(this->maximum_tape_size, this->maximum_element_size);
+      for (const Family& family: this->families) {
+         const size_t number_constraint_instances = family.gradient_starts.size();
+         for (size_t batch_start = 0; batch_start < number_constraint_instances; batch_start += batch_size) {
+            const size_t number_instances = std::min(batch_size, number_constraint_instances - batch_start);
+            workspace.instances.resize(number_instances);
+            std::iota(workspace.instances.begin(), workspace.instances.end(), batch_start);
+            InterpretedNLEvaluator::gather_variables(family, workspace.instances.data(), number_instances, x, workspace.variables.data());
+            this->forward_sweep(family, workspace.instances.data(), number_instances, workspace.variables.data(), workspace.values.data());
+            const double* roots = workspace.values.data() + (family.tape_size - 1) * number_instances;
+            for (size_t batch_index: Range(number_instances)) {
+               const size_t instance = batch_start + batch_index;
+               constraints[family.functions[instance]] += family.elements[instance]->coefficient * roots[batch_index];
+            }
+         }
+      }
+   }
+
+   // the batches write to disjoint gradients: they are evaluated in parallel
+   void InterpretedNLEvaluator::evaluate_constraint_element_gradients(const double* x, double* element_gradients) const {
+      TaskScheduler::parallel_for(0, this->constraint_batches.size(), batches_per_task, [&](size_t batch) {
+         const auto [family_index, batch_start] = this->constraint_batches[batch];
+         const Family& family = this->families[family_index];
+         BatchWorkspace& workspace = get_batch_workspace(this->maximum_tape_size, this->maximum_element_size);
+         std::array<double*, batch_size> local_gradients{};
+         const size_t number_instances = std::min(batch_size, family.gradient_starts.size() - batch_start);
+         workspace.instances.resize(number_instances);
+         std::iota(workspace.instances.begin(), workspace.instances.end(), batch_start);
+         InterpretedNLEvaluator::gather_variables(family, workspace.instances.data(), number_instances, x, workspace.variables.data());
+         this->forward_sweep(family, workspace.instances.data(), number_instances, workspace.variables.data(), workspace.values.data());
+         this->reverse_sweep(family, number_instances, workspace.values.data(), workspace.adjoints.data());
+         for (size_t batch_index: Range(number_instances)) {
+            local_gradients[batch_index] = element_gradients + family.gradient_starts[batch_start + batch_index];
+            std::fill(local_gradients[batch_index], local_gradients[batch_index] + family.number_variables, 0.);
+         }
+         this->add_variable_adjoints(family, number_instances, workspace.adjoints.data(), local_gradients.data());
+      });
+   }
+
+   void InterpretedNLEvaluator::gather_variables(const Family& family, const size_t* instances, size_t number_instances, const double* x,
+         double* variables) {
+      for (size_t local_index: Range(family.number_variables)) {
+         for (size_t batch_index: Range(number_instances)) {
+            variables[local_index * number_instances + batch_index] = x[family.elements[instances[batch_index]]->variables[local_index]];
+         }
+      }
+   }
+
+   // the adjoints of the variables are the partial derivatives
+   void InterpretedNLEvaluator::add_variable_adjoints(const Family& family, size_t number_instances, const double* adjoints,
+         double* const* local_gradients) const {
+      for (size_t position: Range(family.tape_size)) {
+         const Instruction& instruction = this->instructions[family.tape_start + position];
+         if (instruction.op == NLOperator::VARIABLE) {
+            for (size_t batch_index: Range(number_instances)) {
+               local_gradients[batch_index][instruction.first_argument] += adjoints[position * number_instances + batch_index];
+            }
+         }
+      }
+   }
+
+   // the operations are applied to all the instances of the batch at once
+   template <typename Number>
+   void InterpretedNLEvaluator::forward_sweep(const Family& family, const size_t* instances, size_t number_instances, const Number* variables,
+         Number* values) const {
+      const size_t n = number_instances;
+      for (size_t position: Range(family.tape_size)) {
+         const Instruction& instruction = this->instructions[family.tape_start + position];
+         const auto argument = [&](size_t argument_index) -> const Number* {
+            return values + this->instruction_arguments[instruction.first_argument + argument_index] * n;
+         };
+         Number* result = values + position * n;
+         const auto apply = [&](const auto& operation) {
+            for (size_t i: Range(n)) {
+               result[i] = operation(i);
+            }
+         };
+         const Number* x = (0 < instruction.number_arguments) ? argument(0) : nullptr;
+         const Number* y = (1 < instruction.number_arguments) ? argument(1) : nullptr;
+         switch (instruction.op) {
+            case NLOperator::CONSTANT:
+               apply([&](size_t i) { return Number(family.constants[instances[i] * family.number_constants + instruction.first_argument]); });
+               break;
+            case NLOperator::VARIABLE: apply([&](size_t i) { return variables[instruction.first_argument * n + i]; }); break;
+            case NLOperator::PLUS: apply([&](size_t i) { return x[i] + y[i]; }); break;
+            case NLOperator::MINUS: apply([&](size_t i) { return x[i] - y[i]; }); break;
+            case NLOperator::MULT: apply([&](size_t i) { return x[i] * y[i]; }); break;
+            case NLOperator::DIV: apply([&](size_t i) { return x[i] / y[i]; }); break;
+            case NLOperator::UMINUS: apply([&](size_t i) { return -x[i]; }); break;
+            case NLOperator::SUM:
+               apply([&](size_t i) { return x[i]; });
+               for (size_t argument_index: Range(1, instruction.number_arguments)) {
+                  const Number* summand = argument(argument_index);
+                  for (size_t i: Range(n)) {
+                     result[i] += summand[i];
+                  }
+               }
+               break;
+            case NLOperator::MIN: case NLOperator::MAX:
+               apply([&](size_t i) {
+                  const auto instance_argument = [&](size_t argument_index) -> const Number& { return argument(argument_index)[i]; };
+                  return instance_argument(selected_argument(instruction.op, instruction.number_arguments, instance_argument));
+               });
+               break;
+            case NLOperator::POW: apply([&](size_t i) { return pow(x[i], y[i]); }); break;
+            case NLOperator::FLOOR: apply([&](size_t i) { return Number(std::floor(value(x[i]))); }); break;
+            case NLOperator::CEIL: apply([&](size_t i) { return Number(std::ceil(value(x[i]))); }); break;
+            case NLOperator::ABS: apply([&](size_t i) { return fabs(x[i]); }); break;
+            case NLOperator::SQRT: apply([&](size_t i) { return sqrt(x[i]); }); break;
+            case NLOperator::EXP: apply([&](size_t i) { return exp(x[i]); }); break;
+            case NLOperator::LOG: apply([&](size_t i) { return log(x[i]); }); break;
+            case NLOperator::LOG10: apply([&](size_t i) { return log10(x[i]); }); break;
+            case NLOperator::SIN: apply([&](size_t i) { return sin(x[i]); }); break;
+            case NLOperator::COS: apply([&](size_t i) { return cos(x[i]); }); break;
+            case NLOperator::TAN: apply([&](size_t i) { return tan(x[i]); }); break;
+            case NLOperator::SINH: apply([&](size_t i) { return sinh(x[i]); }); break;
+            case NLOperator::COSH: apply([&](size_t i) { return cosh(x[i]); }); break;
+            case NLOperator::TANH: apply([&](size_t i) { return tanh(x[i]); }); break;
+            case NLOperator::ASIN: apply([&](size_t i) { return asin(x[i]); }); break;
+            case NLOperator::ACOS: apply([&](size_t i) { return acos(x[i]); }); break;
+            case NLOperator::ATAN: apply([&](size_t i) { return atan(x[i]); }); break;
+            case NLOperator::ASINH: apply([&](size_t i) { return asinh(x[i]); }); break;
+            case NLOperator::ACOSH: apply([&](size_t i) { return acosh(x[i]); }); break;
+            case NLOperator::ATANH: apply([&](size_t i) { return atanh(x[i]); }); break;
+            case NLOperator::ATAN2: apply([&](size_t i) { return atan2(x[i], y[i]); }); break;
+         }
+      }
+   }
+
+   // propagate the adjoints from the roots to the variables. The constants are not differentiated
+   template <typename Number>
+   void InterpretedNLEvaluator::reverse_sweep(const Family& family, size_t number_instances, const Number* values, Number* adjoints) const {
+      const size_t n = number_instances;
+      const size_t tape_size = family.tape_size;
+      std::fill(adjoints, adjoints + (tape_size - 1) * n, Number(0.));
+      std::fill(adjoints + (tape_size - 1) * n, adjoints + tape_size * n, Number(1.));
+      for (size_t position = tape_size; position-- > 0;) {
+         const Instruction& instruction = this->instructions[family.tape_start + position];
+         if (instruction.op == NLOperator::CONSTANT || instruction.op == NLOperator::VARIABLE) {
+            continue;
+         }
+         const Number* adjoint = adjoints + position * n;
+         const auto argument_position = [&](size_t argument_index) {
+            return this->instruction_arguments[instruction.first_argument + argument_index];
+         };
+         const auto is_active = [&](size_t argument_index) {
+            return this->instructions[family.tape_start + argument_position(argument_index)].op != NLOperator::CONSTANT;
+         };
+         // adjoint of the argument += adjoint * partial derivative
+         const auto add = [&](size_t argument_index, const auto& partial_derivative) {
+            if (is_active(argument_index)) {
+               Number* argument_adjoint = adjoints + argument_position(argument_index) * n;
+               for (size_t i: Range(n)) {
+                  argument_adjoint[i] += adjoint[i] * partial_derivative(i);
+               }
+            }
+         };
+         const auto constant = [](double constant_value) {
+            return [=](size_t /*i*/) { return Number(constant_value); };
+         };
+         const Number* x = values + argument_position(0) * n;
+         const Number* y = (1 < instruction.number_arguments) ? values + argument_position(1) * n : nullptr;
+         const Number* result = values + position * n;
+         switch (instruction.op) {
+            case NLOperator::PLUS: add(0, constant(1.)); add(1, constant(1.)); break;
+            case NLOperator::MINUS: add(0, constant(1.)); add(1, constant(-1.)); break;
+            case NLOperator::MULT: add(0, [&](size_t i) { return y[i]; }); add(1, [&](size_t i) { return x[i]; }); break;
+            case NLOperator::DIV:
+               add(0, [&](size_t i) { return Number(1.) / y[i]; });
+               add(1, [&](size_t i) { return -result[i] / y[i]; });
+               break;
+            case NLOperator::UMINUS: add(0, constant(-1.)); break;
+            case NLOperator::SUM:
+               for (size_t argument_index: Range(instruction.number_arguments)) {
+                  add(argument_index, constant(1.));
+               }
+               break;
+            case NLOperator::MIN: case NLOperator::MAX:
+               for (size_t i: Range(n)) {
+                  const auto instance_argument = [&](size_t argument_index) -> const Number& {
+                     return values[argument_position(argument_index) * n + i];
+                  };
+                  const size_t selected_index = selected_argument(instruction.op, instruction.number_arguments, instance_argument);
+                  if (is_active(selected_index)) {
+                     adjoints[argument_position(selected_index) * n + i] += adjoint[i];
+                  }
+               }
+               break;
+            case NLOperator::POW:
+               add(0, [&](size_t i) { return y[i] * pow(x[i], y[i] - Number(1.)); });
+               add(1, [&](size_t i) { return result[i] * log(x[i]); });
+               break;
+            case NLOperator::FLOOR: case NLOperator::CEIL: break;
+            case NLOperator::ABS: add(0, [&](size_t i) { return Number((value(x[i]) < 0.) ? -1. : 1.); }); break;
+            case NLOperator::SQRT: add(0, [&](size_t i) { return Number(1.) / (Number(2.) * result[i]); }); break;
+            case NLOperator::EXP: add(0, [&](size_t i) { return result[i]; }); break;
+            case NLOperator::LOG: add(0, [&](size_t i) { return Number(1.) / x[i]; }); break;
+            case NLOperator::LOG10: add(0, [&](size_t i) { return Number(1.) / (Number(LN10) * x[i]); }); break;
+            case NLOperator::SIN: add(0, [&](size_t i) { return cos(x[i]); }); break;
+            case NLOperator::COS: add(0, [&](size_t i) { return -sin(x[i]); }); break;
+            case NLOperator::TAN: add(0, [&](size_t i) { return Number(1.) + result[i] * result[i]; }); break;
+            case NLOperator::SINH: add(0, [&](size_t i) { return cosh(x[i]); }); break;
+            case NLOperator::COSH: add(0, [&](size_t i) { return sinh(x[i]); }); break;
+            case NLOperator::TANH: add(0, [&](size_t i) { return Number(1.) - result[i] * result[i]; }); break;
+            case NLOperator::ASIN: add(0, [&](size_t i) { return Number(1.) / sqrt(Number(1.) - x[i] * x[i]); }); break;
+            case NLOperator::ACOS: add(0, [&](size_t i) { return Number(-1.) / sqrt(Number(1.) - x[i] * x[i]); }); break;
+            case NLOperator::ATAN: add(0, [&](size_t i) { return Number(1.) / (Number(1.) + x[i] * x[i]); }); break;
+            case NLOperator::ASINH: add(0, [&](size_t i) { return Number(1.) / sqrt(x[i] * x[i] + Number(1.)); }); break;
+            case NLOperator::ACOSH: add(0, [&](size_t i) { return Number(1.) / sqrt(x[i] * x[i] - Number(1.)); }); break;
+            case NLOperator::ATANH: add(0, [&](size_t i) { return Number(1.) / (Number(1.) - x[i] * x[i]); }); break;
+            case NLOperator::ATAN2:
+               // atan2(x, y)
+               add(0, [&](size_t i) { return y[i] / (x[i] * x[i] + y[i] * y[i]); });
+               add(1, [&](size_t i) { return -x[i] / (x[i] * x[i] + y[i] * y[i]); });
+               break;
+            case NLOperator::CONSTANT: case NLOperator::VARIABLE: break;
+         }
+      }
+   }
+} // namespace
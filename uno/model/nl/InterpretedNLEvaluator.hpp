@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_INTERPRETEDNLEVALUATOR_H
+#define UNO_INTERPRETEDNLEVALUATOR_H
+
+#include <utility>
+#include <vector>
+#include "NLEvaluator.hpp"
+
+namespace uno {
+   /*! \class InterpretedNLEvaluator
+    * \brief Evaluation of the elements by a tape interpreter
+    *
+    *  The tape of an element is evaluated by a forward sweep, its gradient by a reverse sweep (reverse mode) and its Hessian by
+    *  forward-over-reverse sweeps (one per variable of the element). Unlike CompiledNLEvaluator, it does not require a compiler.
+    *  The elements that differ only by their variables and constants (e.g. the instances of an indexed AMPL constraint) form a
+    *  family with a single tape. The values, Jacobian rows and Hessians of the constraints are evaluated family by family, on
+    *  batches of instances: each instruction is interpreted once per batch, in a loop over the instances that the compiler vectorizes.
+    *  The batches of constraint gradients and the long sums of elements are distributed over the threads of the TaskScheduler.
+    */
+   class InterpretedNLEvaluator: public NLEvaluator {
+   public:
+      explicit InterpretedNLEvaluator(NLProblem problem);
+
+      [[nodiscard]] size_t number_families() const;
+
+   protected:
+      [[nodiscard]] double evaluate_elements(size_t function_index, const double* x) const override;
+      void evaluate_element_gradient(size_t function_index, size_t element_index, const double* x, double* local_gradient) const override;
+      void add_element_hessians(const double* x, const double* weights, double* hessian) const override;
+      void add_constraint_elements(const double* x, double* constraints) const override;
+      void evaluate_constraint_element_gradients(const double* x, double* element_gradients) const override;
+
+   private:
+      // the arguments of an instruction are positions in the tape of its family
+      struct Instruction {
+         NLOperator op;
+         size_t first_argument; // CONSTANT: index of the constant in the instance, VARIABLE: local index of the variable in the element
+         size_t number_arguments;
+      };
+      // elements with the same tape, function by function: the instances of the constraints come first
+      struct Family {
+         size_t tape_start{0};
+         size_t tape_size{0};
+         size_t number_variables{0};
+         size_t number_constants{0};
+         bool is_linear{false};
+         std::vector<const NLElement*> elements{};
+         std::vector<size_t> functions{};
+         std::vector<double> constants{}; // constants of the instances (instance by instance)
+         std::vector<size_t> gradient_starts{}; // offsets of the gradients of the constraint instances (see element_gradient_starts)
+      };
+      std::vector<Instruction> instructions{};
+      std::vector<size_t> instruction_arguments{};
+      std::vector<Family> families{};
+      // family and instance of the elements of all the functions (function by function)
+      std::vector<size_t> function_element_starts{};
+      std::vector<size_t> element_families{};
+      std::vector<size_t> element_instances{};
+      // family and first instance of the batches of constraint instances
+      std::vector<std::pair<size_t, size_t>> constraint_batches{};
+      size_t maximum_tape_size{0};
+
+      // variables of a batch of instances (variable by variable)
+      static void gather_variables(const Family& family, const size_t* instances, size_t number_instances, const double* x, double* variables);
+      void add_variable_adjoints(const Family& family, size_t number_instances, const double* adjoints, double* const* local_gradients) const;
+      // the values and adjoints of a batch are stored position by position: the value of an instance at a position is at
+      // [position * number_instances + instance]
+      template <typename Number>
+      void forward_sweep(const Family& family, const size_t* instances, size_t number_instances, const Number* variables, Number* values) const;
+      template <typename Number>
+      void reverse_sweep(const Family& family, size_t number_instances, const Number* values, Number* adjoints) const;
+   };
+} // namespace
+
+#endif // UNO_INTERPRETEDNLEVALUATOR_H
@@ -0,0 +1,222 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "NLEvaluator.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   NLEvaluator::NLEvaluator(NLProblem problem): problem(std::move(problem)) {
+      for (const NLFunction& function: this->problem.functions) {
+         for (const NLElement& element: function.elements) {
+            this->maximum_element_size = std::max(this->maximum_element_size, element.variables.size());
+            if (not element.is_linear) {
+               this->nonlinear_elements++;
+            }
+         }
+      }
+      this->element_gradient_starts.emplace_back(0);
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         for (const NLElement& element: this->problem.functions[constraint_index].elements) {
+            this->element_gradient_starts.emplace_back(this->element_gradient_starts.back() + element.variables.size());
+         }
+      }
+   }
+
+   double NLEvaluator::evaluate_objective(const Vector<double>& x) const {
+      return this->problem.objective_sign * this->evaluate_function(this->problem.number_constraints, x.data());
+   }
+
+   void NLEvaluator::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->evaluate_function_gradient(this->problem.number_constraints, x.data(), this->problem.objective_sign, gradient);
+   }
+
+   void NLEvaluator::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         const NLFunction& function = this->problem.functions[constraint_index];
+         double result = function.constant;
+         for (const auto [variable_index, coefficient]: function.linear_part) {
+            result += coefficient * x[variable_index];
+         }
+         constraints[constraint_index] = result;
+      }
+      // the elements of all the constraints at once
+      this->add_constraint_elements(x.data(), constraints.data());
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         if (not std::isfinite(constraints[constraint_index])) {
+            throw FunctionEvaluationError();
+         }
+      }
+   }
+
+   void NLEvaluator::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      this->evaluate_function_gradient(constraint_index, x.data(), 1., gradient);
+   }
+
+   void NLEvaluator::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      Workspace& workspace = this->get_workspace();
+      // the gradients of the elements of all the constraints at once
+      this->evaluate_constraint_element_gradients(x.data(), workspace.element_gradients.data());
+      size_t element_offset = 0;
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         for (const NLElement& element: this->problem.functions[constraint_index].elements) {
+            const double* element_gradient = workspace.element_gradients.data() + this->element_gradient_starts[element_offset];
+            for (size_t local_index: Range(element.variables.size())) {
+               workspace.dense_gradient[element.variables[local_index]] += element.coefficient * element_gradient[local_index];
+            }
+            element_offset++;
+         }
+         constraint_jacobian[constraint_index].clear();
+         this->gather_function_gradient(constraint_index, 1., constraint_jacobian[constraint_index]);
+      }
+   }
+
+   void NLEvaluator::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      Workspace& workspace = this->get_workspace();
+      // weights of the functions in the Lagrangian
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         workspace.weights[constraint_index] = -multipliers[constraint_index];
+      }
+      workspace.weights[this->problem.number_constraints] = this->problem.objective_sign * objective_multiplier;
+
+      std::fill(workspace.hessian_values.begin(), workspace.hessian_values.end(), 0.);
+      this->add_element_hessians(x.data(), workspace.weights.data(), workspace.hessian_values.data());
+
+      // copy the nonzeros column by column
+      hessian.reset();
+      for (size_t column_index: Range(this->problem.number_variables)) {
+         for (size_t nonzero_index: Range(this->problem.hessian_column_starts[column_index], this->problem.hessian_column_starts[column_index + 1])) {
+            hessian.insert(workspace.hessian_values[nonzero_index], this->problem.hessian_row_indices[nonzero_index], column_index);
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   size_t NLEvaluator::number_nonlinear_elements() const {
+      return this->nonlinear_elements;
+   }
+
+   void NLEvaluator::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      std::vector<double>& local_gradient = this->get_workspace().local_gradient;
+      size_t offset = 0;
+      for (size_t function_index: Range(this->problem.functions.size())) {
+         const std::vector<NLElement>& elements = this->problem.functions[function_index].elements;
+         const double sign = (function_index == this->problem.number_constraints) ? this->problem.objective_sign : 1.;
+         for (size_t element_index: Range(elements.size())) {
+            const NLElement& element = elements[element_index];
+            if (not element.is_linear) {
+               this->evaluate_element_gradient(function_index, element_index, x.data(), local_gradient.data());
+               for (size_t local_index: Range(element.variables.size())) {
+                  element_gradients[offset + local_index] = sign * element.coefficient * local_gradient[local_index];
+               }
+               offset += element.variables.size();
+            }
+         }
+      }
+   }
+
+   size_t NLEvaluator::number_objective_gradient_nonzeros() const {
+      return this->problem.objective().linear_part.size();
+   }
+
+   size_t NLEvaluator::number_jacobian_nonzeros() const {
+      size_t number_nonzeros = 0;
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         number_nonzeros += this->problem.functions[constraint_index].linear_part.size();
+      }
+      return number_nonzeros;
+   }
+
+   size_t NLEvaluator::number_hessian_nonzeros() const {
+      return this->problem.number_hessian_nonzeros();
+   }
+
+   NLEvaluator::Workspace& NLEvaluator::get_workspace() const {
+      thread_local Workspace workspace{};
+      // the dense gradient is kept at zero: enlarging it preserves the invariant
+      if (workspace.dense_gradient.size() < this->problem.number_variables) {
+         workspace.dense_gradient.resize(this->problem.number_variables, 0.);
+      }
+      workspace.weights.resize(this->problem.number_constraints + 1);
+      workspace.hessian_values.resize(this->problem.number_hessian_nonzeros());
+      workspace.local_variables.resize(this->maximum_element_size);
+      workspace.local_gradient.resize(this->maximum_element_size);
+      workspace.local_hessian.resize(this->maximum_element_size * (this->maximum_element_size + 1) / 2);
+      workspace.element_gradients.resize(this->element_gradient_starts.back());
+      return workspace;
+   }
+
+   void NLEvaluator::add_constraint_elements(const double* x, double* constraints) const {
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         if (not this->problem.functions[constraint_index].elements.empty()) {
+            constraints[constraint_index] += this->evaluate_elements(constraint_index, x);
+         }
+      }
+   }
+
+   void NLEvaluator::evaluate_constraint_element_gradients(const double* x, double* element_gradients) const {
+      size_t element_offset = 0;
+      for (size_t constraint_index: Range(this->problem.number_constraints)) {
+         for (size_t element_index: Range(this->problem.functions[constraint_index].elements.size())) {
+            this->evaluate_element_gradient(constraint_index, element_index, x, element_gradients + this->element_gradient_starts[element_offset]);
+            element_offset++;
+         }
+      }
+   }
+
+   double NLEvaluator::evaluate_function(size_t function_index, const double* x) const {
+      const NLFunction& function = this->problem.functions[function_index];
+      double result = function.constant;
+      for (const auto [variable_index, coefficient]: function.linear_part) {
+         result += coefficient * x[variable_index];
+      }
+      if (not function.elements.empty()) {
+         result += this->evaluate_elements(function_index, x);
+      }
+      if (not std::isfinite(result)) {
+         throw FunctionEvaluationError();
+      }
+      return result;
+   }
+
+   void NLEvaluator::add_element_gradients(size_t function_index, const double* x, double* gradient) const {
+      const std::vector<NLElement>& elements = this->problem.functions[function_index].elements;
+      std::vector<double>& local_gradient = this->get_workspace().local_gradient;
+      for (size_t element_index: Range(elements.size())) {
+         const NLElement& element = elements[element_index];
+         this->evaluate_element_gradient(function_index, element_index, x, local_gradient.data());
+         for (size_t local_index: Range(element.variables.size())) {
+            gradient[element.variables[local_index]] += element.coefficient * local_gradient[local_index];
+         }
+      }
+   }
+
+   void NLEvaluator::evaluate_function_gradient(size_t function_index, const double* x, double scaling, SparseVector<double>& gradient) const {
+      if (not this->problem.functions[function_index].elements.empty()) {
+         this->add_element_gradients(function_index, x, this->get_workspace().dense_gradient.data());
+      }
+      this->gather_function_gradient(function_index, scaling, gradient);
+   }
+
+   void NLEvaluator::gather_function_gradient(size_t function_index, double scaling, SparseVector<double>& gradient) const {
+      const NLFunction& function = this->problem.functions[function_index];
+      std::vector<double>& dense_gradient = this->get_workspace().dense_gradient;
+      // gather the partial derivatives and reset the dense vector
+      bool is_finite = true;
+      for (const auto [variable_index, coefficient]: function.linear_part) {
+         const double partial_derivative = coefficient + dense_gradient[variable_index];
+         dense_gradient[variable_index] = 0.;
+         is_finite = is_finite && std::isfinite(partial_derivative);
+         gradient.insert(variable_index, scaling * partial_derivative);
+      }
+      if (not is_finite) {
+         throw GradientEvaluationError();
+      }
+   }
+} // namespace
@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NLEVALUATOR_H
+#define UNO_NLEVALUATOR_H
+
+#include <vector>
+#include "NLProblem.hpp"
+
+namespace uno {
+   // forward declarations
+   template <typename ElementType>
+   class RectangularMatrix;
+   template <typename IndexType, typename ElementType>
+   class SymmetricMatrix;
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class NLEvaluator
+    * \brief Evaluation of the functions of a .nl problem
+    *
+    *  Assembles the values, gradients and Lagrangian Hessian from the linear parts and the element functions. The derived classes
+    *  implement the evaluation of the elements. As in Model, the objective is multiplied by its sign.
+    *  The evaluations are reentrant: the workspaces are thread local, so an evaluator can be used concurrently by several threads.
+    */
+   class NLEvaluator {
+   public:
+      explicit NLEvaluator(NLProblem problem);
+      virtual ~NLEvaluator() = default;
+
+      [[nodiscard]] const NLProblem& get_problem() const { return this->problem; }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const;
+      // Hessian of objective_multiplier * f(x) - multipliers^T c(x)
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const;
+
+      // partially separable structure: the nonlinear elements of the constraints, then of the objective
+      [[nodiscard]] size_t number_nonlinear_elements() const;
+      // gradients of the nonlinear elements with respect to their variables (scaled by their coefficients), in the same order
+      void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const;
+      [[nodiscard]] size_t number_hessian_nonzeros() const;
+
+   protected:
+      const NLProblem problem;
+      size_t maximum_element_size{0}; /*!< Maximum number of variables of an element */
+      // offsets of the gradients of the constraint elements (function by function) in a flat array
+      std::vector<size_t> element_gradient_starts{};
+
+      struct Workspace {
+         std::vector<double> dense_gradient{}; // zero between two evaluations
+         std::vector<double> weights{};
+         std::vector<double> hessian_values{};
+         // variables, gradient and upper triangular Hessian of an element
+         std::vector<double> local_variables{};
+         std::vector<double> local_gradient{};
+         std::vector<double> local_hessian{};
+         std::vector<double> element_gradients{}; // gradients of the constraint elements
+      };
+      // workspace of the calling thread, sized for this problem
+      [[nodiscard]] Workspace& get_workspace() const;
+
+      // sum of the elements of a function
+      [[nodiscard]] virtual double evaluate_elements(size_t function_index, const double* x) const = 0;
+      // gradient of an element with respect to its variables (without its coefficient)
+      virtual void evaluate_element_gradient(size_t function_index, size_t element_index, const double* x, double* local_gradient) const = 0;
+      // add the weighted Hessians of the elements of all functions to the nonzeros of the Lagrangian Hessian
+      virtual void add_element_hessians(const double* x, const double* weights, double* hessian) const = 0;
+      // add the elements of all the constraints to their values (by default, constraint by constraint)
+      virtual void add_constraint_elements(const double* x, double* constraints) const;
+      // gradients of the elements of all the constraints (without their coefficients) at element_gradient_starts (by default, element
+      // by element)
+      virtual void evaluate_constraint_element_gradients(const double* x, double* element_gradients) const;
+
+   private:
+      size_t nonlinear_elements{0};
+
+      [[nodiscard]] double evaluate_function(size_t function_index, const double* x) const;
+      void evaluate_function_gradient(size_t function_index, const double* x, double scaling, SparseVector<double>& gradient) const;
+      // add the gradients of the elements of a function to a dense vector
+      void add_element_gradients(size_t function_index, const double* x, double* gradient) const;
+      // add the linear part to the dense vector and move the partial derivatives into the sparse gradient
+      void gather_function_gradient(size_t function_index, double scaling, SparseVector<double>& gradient) const;
+   };
+} // namespace
+
+#endif // UNO_NLEVALUATOR_H
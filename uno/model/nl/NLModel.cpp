@@ -0,0 +1,279 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include "NLModel.hpp"
+#include "CompiledNLEvaluator.hpp"
+#include "InterpretedNLEvaluator.hpp"
+#include "NLReader.hpp"
+#include "Uno.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/BufferedWriter.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   NLModel::NLModel(const std::string& file_name, const Options& options):
+         NLModel(NLModel::create_evaluator(NLReader::read(file_name), options)) {
+      if (options.get_bool("AMPL_write_solution_to_file")) {
+         // the solution of stub.nl is written into stub.sol
+         this->solution_file_name = std::filesystem::path(file_name).replace_extension(".sol").string();
+      }
+   }
+
+   NLModel::NLModel(std::unique_ptr<NLEvaluator> evaluator):
+         Model(evaluator->get_problem().name, evaluator->get_problem().number_variables, evaluator->get_problem().number_constraints,
+            evaluator->get_problem().objective_sign),
+         evaluator(std::move(evaluator)),
+         problem(this->evaluator->get_problem()),
+         constraint_type(this->number_constraints),
+         partition(this->number_variables, this->number_constraints) {
+      this->partition_variables_and_constraints();
+   }
+
+   double NLModel::evaluate_objective(const Vector<double>& x) const {
+      return this->evaluator->evaluate_objective(x);
+   }
+
+   void NLModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->evaluator->evaluate_objective_gradient(x, gradient);
+   }
+
+   void NLModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      this->evaluator->evaluate_constraints(x, constraints);
+   }
+
+   void NLModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      gradient.clear();
+      this->evaluator->evaluate_constraint_gradient(x, constraint_index, gradient);
+   }
+
+   void NLModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->evaluator->evaluate_constraint_jacobian(x, constraint_jacobian);
+   }
+
+   void NLModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      this->evaluator->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+   }
+
+   // the elements are obtained by splitting the top-level sums of the expression graphs
+   size_t NLModel::number_elements() const {
+      return this->evaluator->number_nonlinear_elements();
+   }
+
+   void NLModel::get_elements(std::vector<ElementFunction>& elements) const {
+      elements.clear();
+      elements.reserve(this->number_elements());
+      for (size_t function_index: Range(this->problem.functions.size())) {
+         for (const NLElement& element: this->problem.functions[function_index].elements) {
+            if (not element.is_linear) {
+               ElementFunction& element_function = elements.emplace_back();
+               if (function_index < this->problem.number_constraints) {
+                  element_function.constraint_index = function_index;
+               }
+               element_function.variables = element.variables;
+            }
+         }
+      }
+   }
+
+   void NLModel::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      this->evaluator->evaluate_element_gradients(x, element_gradients);
+   }
+
+   // the workspaces of the evaluator are thread local
+   bool NLModel::is_thread_safe() const {
+      return true;
+   }
+
+   double NLModel::variable_lower_bound(size_t variable_index) const {
+      return this->problem.variable_lower_bounds[variable_index];
+   }
+
+   double NLModel::variable_upper_bound(size_t variable_index) const {
+      return this->problem.variable_upper_bounds[variable_index];
+   }
+
+   BoundType NLModel::get_variable_bound_type(size_t variable_index) const {
+      return this->partition.get_variable_bound_type(variable_index);
+   }
+
+   const Collection<size_t>& NLModel::get_lower_bounded_variables() const {
+      return this->partition.get_lower_bounded_variables();
+   }
+
+   const Collection<size_t>& NLModel::get_upper_bounded_variables() const {
+      return this->partition.get_upper_bounded_variables();
+   }
+
+   const SparseVector<size_t>& NLModel::get_slacks() const {
+      return this->partition.get_slacks();
+   }
+
+   const Collection<size_t>& NLModel::get_single_lower_bounded_variables() const {
+      return this->partition.get_single_lower_bounded_variables();
+   }
+
+   const Collection<size_t>& NLModel::get_single_upper_bounded_variables() const {
+      return this->partition.get_single_upper_bounded_variables();
+   }
+
+   const Vector<size_t>& NLModel::get_fixed_variables() const {
+      return this->partition.get_fixed_variables();
+   }
+
+   double NLModel::constraint_lower_bound(size_t constraint_index) const {
+      return this->problem.constraint_lower_bounds[constraint_index];
+   }
+
+   double NLModel::constraint_upper_bound(size_t constraint_index) const {
+      return this->problem.constraint_upper_bounds[constraint_index];
+   }
+
+   FunctionType NLModel::get_constraint_type(size_t constraint_index) const {
+      return this->constraint_type[constraint_index];
+   }
+
+   BoundType NLModel::get_constraint_bound_type(size_t constraint_index) const {
+      return this->partition.get_constraint_bound_type(constraint_index);
+   }
+
+   const Collection<size_t>& NLModel::get_equality_constraints() const {
+      return this->partition.get_equality_constraints();
+   }
+
+   const Collection<size_t>& NLModel::get_inequality_constraints() const {
+      return this->partition.get_inequality_constraints();
+   }
+
+   const Collection<size_t>& NLModel::get_linear_constraints() const {
+      return this->partition.get_linear_constraints();
+   }
+
+   void NLModel::initial_primal_point(Vector<double>& x) const {
+      assert(x.size() >= this->number_variables);
+      std::copy(this->problem.initial_primals.begin(), this->problem.initial_primals.end(), x.begin());
+   }
+
+   void NLModel::initial_dual_point(Vector<double>& multipliers) const {
+      assert(multipliers.size() >= this->number_constraints);
+      std::copy(this->problem.initial_duals.begin(), this->problem.initial_duals.end(), multipliers.begin());
+   }
+
+   void NLModel::postprocess_solution(Iterate& iterate, IterateStatus iterate_status) const {
+      if (not this->solution_file_name.empty()) {
+         this->write_solution_file(iterate, iterate_status);
+      }
+   }
+
+   size_t NLModel::number_objective_gradient_nonzeros() const {
+      return this->evaluator->number_objective_gradient_nonzeros();
+   }
+
+   size_t NLModel::number_jacobian_nonzeros() const {
+      return this->evaluator->number_jacobian_nonzeros();
+   }
+
+   size_t NLModel::number_hessian_nonzeros() const {
+      return this->evaluator->number_hessian_nonzeros();
+   }
+
+   // the expressions are compiled if requested and possible, and interpreted otherwise
+   std::unique_ptr<NLEvaluator> NLModel::create_evaluator(NLProblem problem, const Options& options) {
+      if (options.get_bool("AMPL_compile_expressions")) {
+         std::string directory = options.get_string("AMPL_compilation_directory");
+         if (directory == "default") {
+            directory = CompiledNLEvaluator::default_directory();
+         }
+         try {
+            auto evaluator = std::make_unique<CompiledNLEvaluator>(problem, options.get_string("AMPL_compiler"), directory);
+            DISCRETE << "The expressions were compiled into " << evaluator->get_library_path() << " (" << evaluator->number_kernels() << " kernels)\n";
+            return evaluator;
+         }
+         catch (const std::exception& exception) {
+            WARNING << "The expressions could not be compiled, they are interpreted instead: " << exception.what() << '\n';
+         }
+      }
+      return std::make_unique<InterpretedNLEvaluator>(std::move(problem));
+   }
+
+   void NLModel::partition_variables_and_constraints() {
+      // a constraint is linear if none of its elements contributes to the Hessian
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const std::vector<NLElement>& elements = this->problem.functions[constraint_index].elements;
+         const bool is_linear = std::all_of(elements.begin(), elements.end(), [](const NLElement& element) {
+            return element.is_linear;
+         });
+         this->constraint_type[constraint_index] = is_linear ? LINEAR : NONLINEAR;
+      }
+      this->partition.compute(this->problem.variable_lower_bounds, this->problem.variable_upper_bounds, this->problem.constraint_lower_bounds,
+         this->problem.constraint_upper_bounds, this->constraint_type);
+      for (size_t variable_index: this->partition.get_fixed_variables()) {
+         WARNING << "Variable x" << variable_index << " has identical bounds\n";
+      }
+   }
+
+   // AMPL .sol file (text format, as written by ASL) with the bound duals as suffixes
+   void NLModel::write_solution_file(const Iterate& iterate, IterateStatus iterate_status) const {
+      int solve_code = 400; // limit
+      if (iterate_status == IterateStatus::FEASIBLE_KKT_POINT) {
+         solve_code = 0;
+      }
+      else if (iterate_status == IterateStatus::FEASIBLE_SMALL_STEP) {
+         solve_code = 100;
+      }
+      else if (iterate_status == IterateStatus::INFEASIBLE_STATIONARY_POINT) {
+         solve_code = 200;
+      }
+      else if (iterate_status == IterateStatus::UNBOUNDED) {
+         solve_code = 300;
+      }
+      else if (iterate_status == IterateStatus::INFEASIBLE_SMALL_STEP) {
+         solve_code = 500;
+      }
+
+      std::ofstream file(this->solution_file_name, std::ios::binary);
+      if (not file) {
+         throw std::runtime_error("NLModel: the solution file " + this->solution_file_name + " could not be opened");
+      }
+      BufferedWriter writer(file);
+      writer << "Uno " << Uno::current_version() << ": " << iterate_status_to_message(iterate_status) << "\n\n";
+      // AMPL options, then the numbers of constraints, duals, variables and primals
+      writer << "Options\n3\n1\n1\n0\n";
+      writer << this->number_constraints << '\n' << this->number_constraints << '\n' << this->number_variables << '\n' <<
+            this->number_variables << '\n';
+      // the signs of the multipliers are flipped if we maximize
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         writer << this->objective_sign * iterate.multipliers.constraints[constraint_index] << '\n';
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         writer << iterate.primals[variable_index] << '\n';
+      }
+      writer << "objno 0 " << solve_code << '\n';
+      const auto write_suffix = [&](std::string_view suffix_name, const Vector<double>& bound_multipliers) {
+         size_t number_nonzeros = 0;
+         for (size_t variable_index: Range(this->number_variables)) {
+            number_nonzeros += (bound_multipliers[variable_index] != 0.) ? 1 : 0;
+         }
+         if (0 < number_nonzeros) {
+            // real suffix on the variables
+            writer << "suffix 4 " << number_nonzeros << ' ' << suffix_name.size() + 1 << " 0 0\n" << suffix_name << '\n';
+            for (size_t variable_index: Range(this->number_variables)) {
+               if (bound_multipliers[variable_index] != 0.) {
+                  writer << variable_index << ' ' << this->objective_sign * bound_multipliers[variable_index] << '\n';
+               }
+            }
+         }
+      };
+      write_suffix("lower_bound_duals", iterate.multipliers.lower_bounds);
+      write_suffix("upper_bound_duals", iterate.multipliers.upper_bounds);
+   }
+} // namespace
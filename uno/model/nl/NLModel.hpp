@@ -0,0 +1,84 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NLMODEL_H
+#define UNO_NLMODEL_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "model/Model.hpp"
+#include "model/ModelPartition.hpp"
+#include "NLEvaluator.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   /*! \class NLModel
+    * \brief Model read from a .nl file without ASL
+    *
+    *  The functions are evaluated by an NLEvaluator (interpreted, or compiled if AMPL_compile_expressions is set). The model has no
+    *  global state: several instances can be created and evaluated concurrently.
+    */
+   class NLModel: public Model {
+   public:
+      NLModel(const std::string& file_name, const Options& options);
+      explicit NLModel(std::unique_ptr<NLEvaluator> evaluator);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      [[nodiscard]] size_t number_elements() const override;
+      void get_elements(std::vector<ElementFunction>& elements) const override;
+      void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override;
+      [[nodiscard]] bool is_thread_safe() const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override;
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus iterate_status) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+
+   private:
+      const std::unique_ptr<NLEvaluator> evaluator;
+      const NLProblem& problem;
+      // AMPL solution file (empty if the solution is not written)
+      std::string solution_file_name{};
+
+      std::vector<FunctionType> constraint_type;
+      ModelPartition partition;
+
+      [[nodiscard]] static std::unique_ptr<NLEvaluator> create_evaluator(NLProblem problem, const Options& options);
+      void partition_variables_and_constraints();
+      void write_solution_file(const Iterate& iterate, IterateStatus iterate_status) const;
+   };
+} // namespace
+
+#endif // UNO_NLMODEL_H
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NLPROBLEM_H
+#define UNO_NLPROBLEM_H
+
+#include <string>
+#include <vector>
+#include "linear_algebra/SparseVector.hpp"
+
+namespace uno {
+   // operators of the .nl expression graphs supported by Uno
+   enum class NLOperator {
+      CONSTANT, VARIABLE, PLUS, MINUS, MULT, DIV, POW, UMINUS, SUM, MIN, MAX, FLOOR, CEIL, ABS, SQRT, EXP, LOG, LOG10, SIN, COS, TAN, SINH,
+      COSH, TANH, ASIN, ACOS, ATAN, ASINH, ACOSH, ATANH, ATAN2
+   };
+
+   // node of the expression DAG. The arguments of a node are stored contiguously in NLProblem::arguments
+   struct NLNode {
+      NLOperator op;
+      double value{0.}; // CONSTANT
+      size_t variable_index{0}; // VARIABLE
+      size_t first_argument{0};
+      size_t number_arguments{0};
+   };
+
+   // element function: term of a nonlinear expression after splitting the top-level sums (partial separability)
+   struct NLElement {
+      size_t root;
+      double coefficient; // scaling of the term in the sum
+      bool is_linear; // the element does not contribute to the Hessian
+      std::vector<size_t> variables{}; // sorted global indices of the variables
+      std::vector<size_t> tape{}; // nodes in topological order (arguments before their parents), the root is last
+      // positions in the Lagrangian Hessian of the local upper triangular entries (row <= column), stored column by column:
+      // entry (l, d) is at d * (d + 1) / 2 + l
+      std::vector<size_t> hessian_positions{};
+   };
+
+   // f(x) = constant + linear_part^T x + sum_e coefficient_e * element_e(x)
+   struct NLFunction {
+      double constant{0.};
+      // sparsity pattern of the gradient with the linear coefficients (zero for the variables that appear nonlinearly only)
+      SparseVector<double> linear_part{};
+      std::vector<NLElement> elements{};
+   };
+
+   /*! \struct NLProblem
+    * \brief In-memory representation of a .nl file
+    *
+    *  The functions are the constraints (indices 0 to number_constraints - 1) followed by the objective (index number_constraints).
+    *  The sparsity pattern of the Lagrangian Hessian (upper triangular part) is stored in compressed sparse column format.
+    */
+   struct NLProblem {
+      std::string name{};
+      size_t number_variables{0};
+      size_t number_constraints{0};
+      double objective_sign{1.}; // 1 for minimization, -1 for maximization
+
+      std::vector<double> variable_lower_bounds{};
+      std::vector<double> variable_upper_bounds{};
+      std::vector<double> constraint_lower_bounds{};
+      std::vector<double> constraint_upper_bounds{};
+      std::vector<double> initial_primals{};
+      std::vector<double> initial_duals{};
+
+      // expression DAG
+      std::vector<NLNode> nodes{};
+      std::vector<size_t> arguments{};
+      std::vector<NLFunction> functions{};
+
+      // upper triangular Lagrangian Hessian
+      std::vector<size_t> hessian_column_starts{};
+      std::vector<size_t> hessian_row_indices{};
+
+      [[nodiscard]] const NLFunction& objective() const { return this->functions[this->number_constraints]; }
+      [[nodiscard]] size_t argument(const NLNode& node, size_t argument_index) const {
+         return this->arguments[node.first_argument + argument_index];
+      }
+      [[nodiscard]] size_t number_hessian_nonzeros() const { return this->hessian_row_indices.size(); }
+   };
+} // namespace
+
+#endif // UNO_NLPROBLEM_H
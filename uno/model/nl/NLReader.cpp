@@ -0,0 +1,783 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "NLReader.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   namespace {
+      constexpr size_t NO_NODE = std::numeric_limits<size_t>::max();
+
+      // tokens of the segments of a .nl file (the header is always in text format)
+      class NLTokenReader {
+      public:
+         explicit NLTokenReader(std::istream& stream): stream(stream) { }
+         virtual ~NLTokenReader() = default;
+
+         // letter of the next segment or expression token, or digit of a bound type. Returns false at the end of the file
+         virtual bool try_read_key(char& key) = 0;
+         virtual int read_integer() = 0;
+         virtual double read_real() = 0;
+         // constant of an expression: n (real), s (short integer) or l (long integer)
+         virtual double read_constant(char kind) = 0;
+         virtual void skip_name() = 0;
+         [[nodiscard]] virtual std::string location() const = 0;
+
+         [[noreturn]] void error(const std::string& message) const {
+            throw std::runtime_error("NLReader: " + this->location() + ": " + message);
+         }
+
+         char read_key() {
+            char key;
+            if (not this->try_read_key(key)) {
+               this->error("unexpected end of file");
+            }
+            return key;
+         }
+
+         size_t read_index() {
+            const int integer = this->read_integer();
+            if (integer < 0) {
+               this->error("expected a nonnegative integer");
+            }
+            return static_cast<size_t>(integer);
+         }
+
+      protected:
+         std::istream& stream;
+      };
+
+      // text format: one token per line, the numbers of a token may continue on the next line
+      class TextTokenReader: public NLTokenReader {
+      public:
+         using NLTokenReader::NLTokenReader;
+
+         bool try_read_key(char& key) override {
+            if (not this->try_read_line()) {
+               return false;
+            }
+            this->position = this->line.find_first_not_of(" \t\r");
+            key = this->line[this->position++];
+            return true;
+         }
+
+         int read_integer() override {
+            const double number = this->read_real();
+            if (number != static_cast<double>(static_cast<int>(number))) {
+               this->error("expected an integer");
+            }
+            return static_cast<int>(number);
+         }
+
+         double read_real() override {
+            double number;
+            if (not this->try_read_number(number)) {
+               if (not this->try_read_line() || not this->try_read_number(number)) {
+                  this->error("expected a number");
+               }
+            }
+            return number;
+         }
+
+         double read_constant(char /*kind*/) override {
+            return this->read_real();
+         }
+
+         void skip_name() override {
+            this->position = this->line.size();
+         }
+
+         [[nodiscard]] std::string location() const override {
+            return "line " + std::to_string(this->line_number);
+         }
+
+         // header lines
+         const std::string& read_line() {
+            if (not this->try_read_line()) {
+               this->error("unexpected end of file");
+            }
+            return this->line;
+         }
+
+         std::vector<size_t> read_line_indices(size_t minimum_number) {
+            this->read_line();
+            std::vector<size_t> indices{};
+            double number;
+            while (this->try_read_number(number)) {
+               if (number < 0.) {
+                  this->error("expected a nonnegative integer");
+               }
+               indices.emplace_back(static_cast<size_t>(number));
+            }
+            if (indices.size() < minimum_number) {
+               this->error("expected " + std::to_string(minimum_number) + " integers");
+            }
+            return indices;
+         }
+
+      private:
+         std::string line{};
+         size_t line_number{0};
+         size_t position{0};
+
+         bool try_read_line() {
+            while (std::getline(this->stream, this->line)) {
+               this->line_number++;
+               // strip the comments
+               const size_t comment_position = this->line.find('#');
+               if (comment_position != std::string::npos) {
+                  this->line.resize(comment_position);
+               }
+               if (this->line.find_first_not_of(" \t\r") != std::string::npos) {
+                  this->position = 0;
+                  return true;
+               }
+            }
+            return false;
+         }
+
+         bool try_read_number(double& number) {
+            const char* start = this->line.c_str() + this->position;
+            char* end = nullptr;
+            number = std::strtod(start, &end);
+            if (end == start) {
+               return false;
+            }
+            this->position += static_cast<size_t>(end - start);
+            return true;
+         }
+      };
+
+      // binary format: one-byte keys, 4-byte integers and 8-byte reals in the byte order of the machine
+      class BinaryTokenReader: public NLTokenReader {
+      public:
+         using NLTokenReader::NLTokenReader;
+
+         bool try_read_key(char& key) override {
+            const int character = this->stream.get();
+            if (character == std::char_traits<char>::eof()) {
+               return false;
+            }
+            this->offset++;
+            key = static_cast<char>(character);
+            return true;
+         }
+
+         int read_integer() override {
+            return static_cast<int>(this->read_number<int32_t>());
+         }
+
+         double read_real() override {
+            return this->read_number<double>();
+         }
+
+         double read_constant(char kind) override {
+            if (kind == 's') {
+               return static_cast<double>(this->read_number<int16_t>());
+            }
+            else if (kind == 'l') {
+               return static_cast<double>(this->read_number<int32_t>());
+            }
+            return this->read_number<double>();
+         }
+
+         void skip_name() override {
+            const size_t length = static_cast<size_t>(this->read_integer());
+            this->stream.ignore(static_cast<std::streamsize>(length));
+            this->offset += length;
+         }
+
+         [[nodiscard]] std::string location() const override {
+            return "byte " + std::to_string(this->offset) + " of the segments";
+         }
+
+      private:
+         size_t offset{0};
+
+         template <typename Number>
+         Number read_number() {
+            Number number;
+            if (not this->stream.read(reinterpret_cast<char*>(&number), sizeof(Number))) {
+               this->error("unexpected end of file");
+            }
+            this->offset += sizeof(Number);
+            return number;
+         }
+      };
+
+      // ASL arithmetic kind of the machine: 1 (little-endian IEEE) or 2 (big-endian IEEE)
+      size_t machine_arithmetic() {
+         const uint16_t probe = 1;
+         return (*reinterpret_cast<const uint8_t*>(&probe) == 1) ? 1 : 2;
+      }
+
+      class NLParser {
+      public:
+         NLParser(std::istream& stream, NLProblem& problem): stream(stream), problem(problem) { }
+
+         void parse() {
+            this->parse_header();
+            this->parse_segments();
+            for (size_t function_index: Range(this->problem.functions.size())) {
+               this->build_elements(function_index);
+            }
+            this->compute_hessian_sparsity();
+         }
+
+      private:
+         std::istream& stream;
+         NLProblem& problem;
+         std::unique_ptr<NLTokenReader> reader{};
+         std::vector<size_t> variable_nodes{};
+         std::vector<size_t> defined_variable_nodes{};
+         std::vector<size_t> function_roots{};
+         // degree of the nodes: 0 (constant), 1 (linear) or 2 (nonlinear)
+         std::vector<int> degrees{};
+         // marker used by the traversals (one stamp per traversal)
+         std::vector<size_t> node_stamps{};
+         size_t current_stamp{0};
+
+         [[noreturn]] void error(const std::string& message) const {
+            this->reader->error(message);
+         }
+
+         void parse_header() {
+            auto header = std::make_unique<TextTokenReader>(this->stream);
+            const std::string format = header->read_line();
+            const bool is_binary = (format[0] == 'b');
+            if (format[0] != 'g' && not is_binary) {
+               header->error("the file is not a .nl file");
+            }
+            // dimensions
+            const std::vector<size_t> dimensions = header->read_line_indices(5);
+            if (5 < dimensions.size() && 0 < dimensions[5]) {
+               header->error("logical constraints are not supported");
+            }
+            this->problem.number_variables = dimensions[0];
+            this->problem.number_constraints = dimensions[1];
+            // nonlinear constraints and objectives, complementarity constraints
+            const std::vector<size_t> nonlinear_functions = header->read_line_indices(2);
+            if (2 < nonlinear_functions.size() && 0 < nonlinear_functions[2]) {
+               header->error("complementarity constraints are not supported");
+            }
+            // network constraints, nonlinear variables
+            header->read_line();
+            header->read_line();
+            // imported functions, arithmetic
+            const std::vector<size_t> linear_network = header->read_line_indices(2);
+            if (0 < linear_network[1]) {
+               header->error("imported functions are not supported");
+            }
+            if (is_binary && 2 < linear_network.size() && 0 < linear_network[2] && linear_network[2] != machine_arithmetic()) {
+               header->error("the binary file was written on a machine with a different byte order");
+            }
+            // discrete variables
+            const std::vector<size_t> discrete_variables = header->read_line_indices(5);
+            size_t number_discrete_variables = 0;
+            for (size_t number: discrete_variables) {
+               number_discrete_variables += number;
+            }
+            if (0 < number_discrete_variables) {
+               throw std::runtime_error("Error: " + std::to_string(number_discrete_variables) + " variables are discrete, which Uno cannot handle");
+            }
+            // nonzeros, name lengths
+            header->read_line();
+            header->read_line();
+            // common expressions (defined variables)
+            size_t number_defined_variables = 0;
+            for (size_t number: header->read_line_indices(5)) {
+               number_defined_variables += number;
+            }
+
+            const size_t number_variables = this->problem.number_variables;
+            const size_t number_constraints = this->problem.number_constraints;
+            this->problem.variable_lower_bounds.resize(number_variables, -INF<double>);
+            this->problem.variable_upper_bounds.resize(number_variables, INF<double>);
+            this->problem.constraint_lower_bounds.resize(number_constraints, -INF<double>);
+            this->problem.constraint_upper_bounds.resize(number_constraints, INF<double>);
+            this->problem.initial_primals.resize(number_variables, 0.);
+            this->problem.initial_duals.resize(number_constraints, 0.);
+            this->problem.functions.resize(number_constraints + 1);
+            this->variable_nodes.resize(number_variables, NO_NODE);
+            this->defined_variable_nodes.resize(number_defined_variables, NO_NODE);
+            this->function_roots.resize(number_constraints + 1, NO_NODE);
+
+            // the segments are in the format of the file
+            if (is_binary) {
+               this->reader = std::make_unique<BinaryTokenReader>(this->stream);
+            }
+            else {
+               this->reader = std::move(header);
+            }
+         }
+
+         void parse_segments() {
+            char segment;
+            while (this->reader->try_read_key(segment)) {
+               if (segment == 'C') {
+                  const size_t constraint_index = this->reader->read_index();
+                  if (this->problem.number_constraints <= constraint_index) {
+                     this->error("invalid constraint index");
+                  }
+                  this->function_roots[constraint_index] = this->parse_expression();
+               }
+               else if (segment == 'O') {
+                  const size_t objective_index = this->reader->read_index();
+                  const size_t objective_type = this->reader->read_index();
+                  const size_t root = this->parse_expression();
+                  // only the first objective is considered
+                  if (objective_index == 0) {
+                     this->function_roots[this->problem.number_constraints] = root;
+                     this->problem.objective_sign = (objective_type == 1) ? -1. : 1.;
+                  }
+               }
+               else if (segment == 'V') {
+                  this->parse_defined_variable();
+               }
+               else if (segment == 'J' || segment == 'G') {
+                  const size_t function_index = this->reader->read_index();
+                  const size_t number_terms = this->reader->read_index();
+                  if (segment == 'J' && this->problem.number_constraints <= function_index) {
+                     this->error("invalid constraint index");
+                  }
+                  NLFunction* function = (segment == 'J') ? &this->problem.functions[function_index] :
+                        (function_index == 0) ? &this->problem.functions[this->problem.number_constraints] : nullptr;
+                  for ([[maybe_unused]] size_t term_index: Range(number_terms)) {
+                     const size_t variable_index = this->reader->read_index();
+                     const double coefficient = this->reader->read_real();
+                     if (this->problem.number_variables <= variable_index) {
+                        this->error("invalid linear term");
+                     }
+                     if (function != nullptr) {
+                        function->linear_part.insert(variable_index, coefficient);
+                     }
+                  }
+               }
+               else if (segment == 'b' || segment == 'r') {
+                  this->parse_bounds(segment == 'b');
+               }
+               else if (segment == 'x' || segment == 'd') {
+                  std::vector<double>& values = (segment == 'x') ? this->problem.initial_primals : this->problem.initial_duals;
+                  const size_t number_values = this->reader->read_index();
+                  for ([[maybe_unused]] size_t value_index: Range(number_values)) {
+                     const size_t index = this->reader->read_index();
+                     const double value = this->reader->read_real();
+                     if (values.size() <= index) {
+                        this->error("invalid initial value");
+                     }
+                     values[index] = value;
+                  }
+               }
+               else if (segment == 'k') {
+                  // cumulative Jacobian column counts: the pattern is rebuilt from the J segments
+                  const size_t number_counts = this->reader->read_index();
+                  for ([[maybe_unused]] size_t count_index: Range(number_counts)) {
+                     this->reader->read_integer();
+                  }
+               }
+               else if (segment == 'S') {
+                  // suffixes are ignored. Bit 4 of the kind indicates real values
+                  const size_t kind = this->reader->read_index();
+                  const size_t number_values = this->reader->read_index();
+                  this->reader->skip_name();
+                  for ([[maybe_unused]] size_t value_index: Range(number_values)) {
+                     this->reader->read_integer();
+                     if ((kind & 4) != 0) {
+                        this->reader->read_real();
+                     }
+                     else {
+                        this->reader->read_integer();
+                     }
+                  }
+               }
+               else if (segment == 'L') {
+                  this->error("logical constraints are not supported");
+               }
+               else if (segment == 'F') {
+                  this->error("imported functions are not supported");
+               }
+               else {
+                  this->error(std::string("unknown segment ") + segment);
+               }
+            }
+         }
+
+         // bound types: 0 (l <= . <= u), 1 (. <= u), 2 (l <= .), 3 (free), 4 (. = c), 5 (complementarity)
+         void parse_bounds(bool variable_bounds) {
+            std::vector<double>& lower_bounds = variable_bounds ? this->problem.variable_lower_bounds : this->problem.constraint_lower_bounds;
+            std::vector<double>& upper_bounds = variable_bounds ? this->problem.variable_upper_bounds : this->problem.constraint_upper_bounds;
+            for (size_t index: Range(lower_bounds.size())) {
+               const int bound_type = this->reader->read_key() - '0';
+               if (bound_type == 5) {
+                  this->error("complementarity constraints are not supported");
+               }
+               else if (bound_type < 0 || 4 < bound_type) {
+                  this->error("invalid bound");
+               }
+               if (bound_type == 0 || bound_type == 2 || bound_type == 4) {
+                  lower_bounds[index] = this->reader->read_real();
+               }
+               if (bound_type == 0 || bound_type == 1) {
+                  upper_bounds[index] = this->reader->read_real();
+               }
+               else if (bound_type == 4) {
+                  upper_bounds[index] = lower_bounds[index];
+               }
+            }
+         }
+
+         // defined variable: linear part followed by the nonlinear expression
+         void parse_defined_variable() {
+            const size_t index = this->reader->read_index();
+            const size_t number_linear_terms = this->reader->read_index();
+            // position of the first use of the defined variable (unused)
+            this->reader->read_integer();
+            const size_t defined_variable_index = index - this->problem.number_variables;
+            if (index < this->problem.number_variables || this->defined_variable_nodes.size() <= defined_variable_index) {
+               this->error("invalid defined variable index");
+            }
+            std::vector<std::pair<size_t, double>> linear_terms{};
+            for ([[maybe_unused]] size_t term_index: Range(number_linear_terms)) {
+               const size_t variable_index = this->reader->read_index();
+               linear_terms.emplace_back(variable_index, this->reader->read_real());
+            }
+            const size_t expression = this->parse_expression();
+            if (linear_terms.empty()) {
+               this->defined_variable_nodes[defined_variable_index] = expression;
+               return;
+            }
+            // sum of the linear terms and the expression
+            std::vector<size_t> terms{};
+            for (const auto& [variable_index, coefficient]: linear_terms) {
+               const size_t variable = this->reference_variable(variable_index);
+               if (coefficient == 1.) {
+                  terms.emplace_back(variable);
+               }
+               else {
+                  const size_t product = this->create_node(NLOperator::MULT, 2);
+                  this->problem.arguments[this->problem.nodes[product].first_argument] = this->create_constant(coefficient);
+                  this->problem.arguments[this->problem.nodes[product].first_argument + 1] = variable;
+                  terms.emplace_back(product);
+               }
+            }
+            terms.emplace_back(expression);
+            const size_t sum = this->create_node(NLOperator::SUM, terms.size());
+            std::copy(terms.begin(), terms.end(), this->problem.arguments.begin() + static_cast<std::ptrdiff_t>(this->problem.nodes[sum].first_argument));
+            this->defined_variable_nodes[defined_variable_index] = sum;
+         }
+
+         size_t create_node(NLOperator op, size_t number_arguments) {
+            NLNode node{op};
+            node.first_argument = this->problem.arguments.size();
+            node.number_arguments = number_arguments;
+            this->problem.arguments.resize(this->problem.arguments.size() + number_arguments, NO_NODE);
+            this->problem.nodes.emplace_back(node);
+            return this->problem.nodes.size() - 1;
+         }
+
+         size_t create_constant(double value) {
+            const size_t node = this->create_node(NLOperator::CONSTANT, 0);
+            this->problem.nodes[node].value = value;
+            return node;
+         }
+
+         // original variables have a unique node. Defined variables refer to the root of their expression
+         size_t reference_variable(size_t index) {
+            if (index < this->problem.number_variables) {
+               if (this->variable_nodes[index] == NO_NODE) {
+                  this->variable_nodes[index] = this->create_node(NLOperator::VARIABLE, 0);
+                  this->problem.nodes[this->variable_nodes[index]].variable_index = index;
+               }
+               return this->variable_nodes[index];
+            }
+            const size_t defined_variable_index = index - this->problem.number_variables;
+            if (this->defined_variable_nodes.size() <= defined_variable_index || this->defined_variable_nodes[defined_variable_index] == NO_NODE) {
+               this->error("reference to an undefined variable v" + std::to_string(index));
+            }
+            return this->defined_variable_nodes[defined_variable_index];
+         }
+
+         // AMPL opcode -> (operator, number of arguments). Variadic operators have 0 arguments (the number follows the opcode)
+         std::pair<NLOperator, size_t> convert_opcode(size_t opcode) const {
+            switch (opcode) {
+               case 0: return {NLOperator::PLUS, 2};
+               case 1: return {NLOperator::MINUS, 2};
+               case 2: return {NLOperator::MULT, 2};
+               case 3: return {NLOperator::DIV, 2};
+               case 5: return {NLOperator::POW, 2};
+               case 11: return {NLOperator::MIN, 0};
+               case 12: return {NLOperator::MAX, 0};
+               case 13: return {NLOperator::FLOOR, 1};
+               case 14: return {NLOperator::CEIL, 1};
+               case 15: return {NLOperator::ABS, 1};
+               case 16: return {NLOperator::UMINUS, 1};
+               case 37: return {NLOperator::TANH, 1};
+               case 38: return {NLOperator::TAN, 1};
+               case 39: return {NLOperator::SQRT, 1};
+               case 40: return {NLOperator::SINH, 1};
+               case 41: return {NLOperator::SIN, 1};
+               case 42: return {NLOperator::LOG10, 1};
+               case 43: return {NLOperator::LOG, 1};
+               case 44: return {NLOperator::EXP, 1};
+               case 45: return {NLOperator::COSH, 1};
+               case 46: return {NLOperator::COS, 1};
+               case 47: return {NLOperator::ATANH, 1};
+               case 48: return {NLOperator::ATAN2, 2};
+               case 49: return {NLOperator::ATAN, 1};
+               case 50: return {NLOperator::ASINH, 1};
+               case 51: return {NLOperator::ASIN, 1};
+               case 52: return {NLOperator::ACOSH, 1};
+               case 53: return {NLOperator::ACOS, 1};
+               case 54: return {NLOperator::SUM, 0};
+               default: this->error("the operator o" + std::to_string(opcode) + " is not supported");
+            }
+         }
+
+         // expressions are written in prefix notation. An explicit stack avoids a deep recursion on long chains of binary operators
+         size_t parse_expression() {
+            struct PartialNode {
+               size_t node;
+               size_t number_parsed_arguments;
+            };
+            std::vector<PartialNode> stack{};
+            while (true) {
+               const char kind = this->reader->read_key();
+               size_t completed_node;
+               if (kind == 'o') {
+                  const auto [op, number_arguments] = this->convert_opcode(this->reader->read_index());
+                  const size_t arity = (number_arguments == 0) ? this->reader->read_index() : number_arguments;
+                  if (arity == 0) {
+                     this->error("variadic operator without arguments");
+                  }
+                  stack.push_back({this->create_node(op, arity), 0});
+                  continue;
+               }
+               else if (kind == 'n' || kind == 's' || kind == 'l') {
+                  completed_node = this->create_constant(this->reader->read_constant(kind));
+               }
+               else if (kind == 'v') {
+                  completed_node = this->reference_variable(this->reader->read_index());
+               }
+               else if (kind == 'f') {
+                  this->error("imported functions are not supported");
+               }
+               else {
+                  this->error(std::string("unsupported expression token ") + kind);
+               }
+               // attach the completed node to its parents
+               while (true) {
+                  if (stack.empty()) {
+                     return completed_node;
+                  }
+                  PartialNode& parent = stack.back();
+                  const NLNode& parent_node = this->problem.nodes[parent.node];
+                  this->problem.arguments[parent_node.first_argument + parent.number_parsed_arguments] = completed_node;
+                  parent.number_parsed_arguments++;
+                  if (parent.number_parsed_arguments < parent_node.number_arguments) {
+                     break;
+                  }
+                  completed_node = parent.node;
+                  stack.pop_back();
+               }
+            }
+         }
+
+         [[nodiscard]] bool is_constant(size_t node) const {
+            return this->problem.nodes[node].op == NLOperator::CONSTANT;
+         }
+
+         // split the top-level sums of the nonlinear expression into element functions
+         void build_elements(size_t function_index) {
+            NLFunction& function = this->problem.functions[function_index];
+            if (this->function_roots[function_index] != NO_NODE) {
+               std::vector<std::pair<size_t, double>> terms{{this->function_roots[function_index], 1.}};
+               while (not terms.empty()) {
+                  const auto [node_index, coefficient] = terms.back();
+                  terms.pop_back();
+                  const NLNode& node = this->problem.nodes[node_index];
+                  const auto argument = [&](size_t argument_index) {
+                     return this->problem.argument(node, argument_index);
+                  };
+                  if (coefficient == 0.) {
+                     continue;
+                  }
+                  if (node.op == NLOperator::CONSTANT) {
+                     function.constant += coefficient * node.value;
+                  }
+                  else if (node.op == NLOperator::PLUS || node.op == NLOperator::SUM) {
+                     for (size_t argument_index: Range(node.number_arguments)) {
+                        terms.emplace_back(argument(argument_index), coefficient);
+                     }
+                  }
+                  else if (node.op == NLOperator::MINUS) {
+                     terms.emplace_back(argument(0), coefficient);
+                     terms.emplace_back(argument(1), -coefficient);
+                  }
+                  else if (node.op == NLOperator::UMINUS) {
+                     terms.emplace_back(argument(0), -coefficient);
+                  }
+                  else if (node.op == NLOperator::MULT && this->is_constant(argument(0))) {
+                     terms.emplace_back(argument(1), coefficient * this->problem.nodes[argument(0)].value);
+                  }
+                  else if (node.op == NLOperator::MULT && this->is_constant(argument(1))) {
+                     terms.emplace_back(argument(0), coefficient * this->problem.nodes[argument(1)].value);
+                  }
+                  else if (node.op == NLOperator::DIV && this->is_constant(argument(1)) && this->problem.nodes[argument(1)].value != 0.) {
+                     terms.emplace_back(argument(0), coefficient / this->problem.nodes[argument(1)].value);
+                  }
+                  else {
+                     function.elements.emplace_back(this->build_element(node_index, coefficient));
+                  }
+               }
+            }
+            this->complete_gradient_pattern(function);
+         }
+
+         NLElement build_element(size_t root, double coefficient) {
+            NLElement element{root, coefficient, false};
+            // post-order traversal of the sub-DAG
+            this->node_stamps.resize(this->problem.nodes.size(), 0);
+            this->degrees.resize(this->problem.nodes.size(), 0);
+            this->current_stamp++;
+            std::vector<std::pair<size_t, size_t>> stack{{root, 0}}; // (node, index of the next argument)
+            this->node_stamps[root] = this->current_stamp;
+            while (not stack.empty()) {
+               const size_t node_index = stack.back().first;
+               const size_t argument_index = stack.back().second;
+               const NLNode& node = this->problem.nodes[node_index];
+               if (argument_index < node.number_arguments) {
+                  stack.back().second++;
+                  const size_t argument = this->problem.argument(node, argument_index);
+                  if (this->node_stamps[argument] != this->current_stamp) {
+                     this->node_stamps[argument] = this->current_stamp;
+                     stack.emplace_back(argument, 0);
+                  }
+               }
+               else {
+                  element.tape.emplace_back(node_index);
+                  if (node.op == NLOperator::VARIABLE) {
+                     element.variables.emplace_back(node.variable_index);
+                  }
+                  this->degrees[node_index] = this->compute_degree(node);
+                  stack.pop_back();
+               }
+            }
+            std::sort(element.variables.begin(), element.variables.end());
+            element.is_linear = (this->degrees[root] <= 1);
+            return element;
+         }
+
+         // degree of a node, given the degrees of its arguments. The nonsmooth operators have a zero Hessian almost everywhere
+         [[nodiscard]] int compute_degree(const NLNode& node) const {
+            const auto argument_degree = [&](size_t argument_index) {
+               return this->degrees[this->problem.argument(node, argument_index)];
+            };
+            int maximum_degree = 0;
+            for (size_t argument_index: Range(node.number_arguments)) {
+               maximum_degree = std::max(maximum_degree, argument_degree(argument_index));
+            }
+            switch (node.op) {
+               case NLOperator::CONSTANT: return 0;
+               case NLOperator::VARIABLE: return 1;
+               case NLOperator::PLUS: case NLOperator::MINUS: case NLOperator::UMINUS: case NLOperator::SUM: case NLOperator::MIN:
+               case NLOperator::MAX: case NLOperator::ABS:
+                  return maximum_degree;
+               case NLOperator::FLOOR: case NLOperator::CEIL: return 0;
+               case NLOperator::MULT: return std::min(2, argument_degree(0) + argument_degree(1));
+               case NLOperator::DIV: return (argument_degree(1) == 0) ? argument_degree(0) : 2;
+               default: return (maximum_degree == 0) ? 0 : 2;
+            }
+         }
+
+         // the variables that appear in the elements must belong to the gradient pattern
+         void complete_gradient_pattern(NLFunction& function) {
+            this->current_stamp++;
+            this->node_stamps.resize(std::max(this->node_stamps.size(), this->problem.number_variables), 0);
+            for (const auto [variable_index, coefficient]: function.linear_part) {
+               this->node_stamps[variable_index] = this->current_stamp;
+            }
+            for (const NLElement& element: function.elements) {
+               for (size_t variable_index: element.variables) {
+                  if (this->node_stamps[variable_index] != this->current_stamp) {
+                     this->node_stamps[variable_index] = this->current_stamp;
+                     function.linear_part.insert(variable_index, 0.);
+                  }
+               }
+            }
+         }
+
+         // the nonlinear elements contribute a dense block to the upper triangular Lagrangian Hessian
+         void compute_hessian_sparsity() {
+            std::vector<std::pair<size_t, size_t>> entries{}; // (column, row)
+            for (const NLFunction& function: this->problem.functions) {
+               for (const NLElement& element: function.elements) {
+                  if (not element.is_linear) {
+                     for (size_t column: Range(element.variables.size())) {
+                        for (size_t row: Range(column + 1)) {
+                           entries.emplace_back(element.variables[column], element.variables[row]);
+                        }
+                     }
+                  }
+               }
+            }
+            std::sort(entries.begin(), entries.end());
+            entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+            // compressed sparse column format
+            this->problem.hessian_column_starts.assign(this->problem.number_variables + 1, 0);
+            this->problem.hessian_row_indices.resize(entries.size());
+            for (size_t nonzero_index: Range(entries.size())) {
+               this->problem.hessian_column_starts[entries[nonzero_index].first + 1]++;
+               this->problem.hessian_row_indices[nonzero_index] = entries[nonzero_index].second;
+            }
+            for (size_t column_index: Range(this->problem.number_variables)) {
+               this->problem.hessian_column_starts[column_index + 1] += this->problem.hessian_column_starts[column_index];
+            }
+
+            // positions of the element entries
+            for (NLFunction& function: this->problem.functions) {
+               for (NLElement& element: function.elements) {
+                  if (not element.is_linear) {
+                     for (size_t column: Range(element.variables.size())) {
+                        const size_t column_index = element.variables[column];
+                        const auto column_begin = this->problem.hessian_row_indices.begin() +
+                              static_cast<std::ptrdiff_t>(this->problem.hessian_column_starts[column_index]);
+                        const auto column_end = this->problem.hessian_row_indices.begin() +
+                              static_cast<std::ptrdiff_t>(this->problem.hessian_column_starts[column_index + 1]);
+                        for (size_t row: Range(column + 1)) {
+                           const auto position = std::lower_bound(column_begin, column_end, element.variables[row]);
+                           element.hessian_positions.emplace_back(static_cast<size_t>(position - this->problem.hessian_row_indices.begin()));
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      };
+   } // namespace
+
+   NLProblem NLReader::read(const std::string& file_name) {
+      std::ifstream file(file_name, std::ios::binary);
+      if (not file) {
+         throw std::runtime_error("NLReader: the file " + file_name + " could not be opened");
+      }
+      return NLReader::read(file, file_name);
+   }
+
+   NLProblem NLReader::read(std::istream& stream, const std::string& name) {
+      NLProblem problem{};
+      problem.name = name;
+      NLParser parser(stream, problem);
+      parser.parse();
+      return problem;
+   }
+} // namespace
@@ -0,0 +1,26 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NLREADER_H
+#define UNO_NLREADER_H
+
+#include <istream>
+#include <string>
+#include "NLProblem.hpp"
+
+namespace uno {
+   /*! \class NLReader
+    * \brief Reader of AMPL .nl files (text and binary formats)
+    *
+    *  Builds the expression DAG of the objective and constraints, splits the nonlinear expressions into element functions and computes
+    *  the sparsity pattern of the Lagrangian Hessian. Discrete variables, logical constraints, complementarity constraints and
+    *  imported functions are not supported.
+    */
+   class NLReader {
+   public:
+      [[nodiscard]] static NLProblem read(const std::string& file_name);
+      [[nodiscard]] static NLProblem read(std::istream& stream, const std::string& name);
+   };
+} // namespace
+
+#endif // UNO_NLREADER_H
@@ -0,0 +1,123 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include "ChainedRosenbrockModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   ChainedRosenbrockModel::ChainedRosenbrockModel(size_t number_variables):
+         SyntheticModel("chained_rosenbrock_" + std::to_string(number_variables), number_variables, 0) {
+      if (number_variables < 2) {
+         throw std::invalid_argument("The chained Rosenbrock model requires at least 2 variables");
+      }
+      this->partition_variables_and_constraints();
+   }
+
+   double ChainedRosenbrockModel::evaluate_objective(const Vector<double>& x) const {
+      double objective = 0.;
+      for (size_t index: Range(this->number_variables - 1)) {
+         const double coupling = x[index + 1] - x[index] * x[index];
+         objective += 50. * coupling * coupling + 0.5 * (1. - x[index]) * (1. - x[index]);
+      }
+      return objective;
+   }
+
+   void ChainedRosenbrockModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      double previous_coupling = 0.;
+      for (size_t index: Range(this->number_variables)) {
+         double derivative = 100. * previous_coupling;
+         if (index < this->number_variables - 1) {
+            const double coupling = x[index + 1] - x[index] * x[index];
+            derivative += -200. * x[index] * coupling - (1. - x[index]);
+            previous_coupling = coupling;
+         }
+         gradient.insert(index, derivative);
+      }
+   }
+
+   void ChainedRosenbrockModel::evaluate_constraints(const Vector<double>& /*x*/, std::vector<double>& /*constraints*/) const {
+      // no constraints
+   }
+
+   void ChainedRosenbrockModel::evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/,
+         SparseVector<double>& /*gradient*/) const {
+      // no constraints
+   }
+
+   void ChainedRosenbrockModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      // tridiagonal Hessian, upper triangular part inserted column by column
+      hessian.reset();
+      for (size_t column_index: Range(this->number_variables)) {
+         double diagonal_entry = 0.;
+         if (0 < column_index) {
+            hessian.insert(objective_multiplier * (-200. * x[column_index - 1]), column_index - 1, column_index);
+            diagonal_entry += 100.;
+         }
+         if (column_index < this->number_variables - 1) {
+            diagonal_entry += 600. * x[column_index] * x[column_index] - 200. * x[column_index + 1] + 1.;
+         }
+         hessian.insert(objective_multiplier * diagonal_entry, column_index, column_index);
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   size_t ChainedRosenbrockModel::number_residuals() const {
+      return 2 * (this->number_variables - 1);
+   }
+
+   void ChainedRosenbrockModel::evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const {
+      for (size_t index: Range(this->number_variables - 1)) {
+         residuals[2 * index] = 10. * (x[index + 1] - x[index] * x[index]);
+         residuals[2 * index + 1] = 1. - x[index];
+      }
+   }
+
+   void ChainedRosenbrockModel::evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const {
+      for (size_t index: Range(this->number_variables - 1)) {
+         residual_jacobian[2 * index].insert(index, -20. * x[index]);
+         residual_jacobian[2 * index].insert(index + 1, 10.);
+         residual_jacobian[2 * index + 1].insert(index, -1.);
+      }
+   }
+
+   size_t ChainedRosenbrockModel::number_elements() const {
+      return this->number_variables - 1;
+   }
+
+   void ChainedRosenbrockModel::get_elements(std::vector<ElementFunction>& elements) const {
+      elements.clear();
+      for (size_t index: Range(this->number_variables - 1)) {
+         elements.emplace_back(ElementFunction{std::nullopt, {index, index + 1}});
+      }
+   }
+
+   void ChainedRosenbrockModel::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      for (size_t index: Range(this->number_variables - 1)) {
+         const double coupling = x[index + 1] - x[index] * x[index];
+         element_gradients[2 * index] = -200. * x[index] * coupling - (1. - x[index]);
+         element_gradients[2 * index + 1] = 100. * coupling;
+      }
+   }
+
+   void ChainedRosenbrockModel::initial_primal_point(Vector<double>& x) const {
+      for (size_t index: Range(this->number_variables)) {
+         x[index] = (index % 2 == 0) ? -1.2 : 1.;
+      }
+   }
+
+   size_t ChainedRosenbrockModel::number_objective_gradient_nonzeros() const {
+      return this->number_variables;
+   }
+
+   size_t ChainedRosenbrockModel::number_jacobian_nonzeros() const {
+      return 0;
+   }
+
+   size_t ChainedRosenbrockModel::number_hessian_nonzeros() const {
+      return 2 * this->number_variables - 1;
+   }
+} // namespace
@@ -0,0 +1,40 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CHAINEDROSENBROCKMODEL_H
+#define UNO_CHAINEDROSENBROCKMODEL_H
+
+#include "SyntheticModel.hpp"
+
+namespace uno {
+   // unconstrained chained Rosenbrock function in least-squares form:
+   // min 1/2 sum_{i=0}^{n-2} [100 (x_{i+1} - x_i^2)^2 + (1 - x_i)^2]
+   // the Hessian is tridiagonal and the residuals r_{2i} = 10 (x_{i+1} - x_i^2), r_{2i+1} = 1 - x_i are exposed, as well as the
+   // elements 1/2 [100 (x_{i+1} - x_i^2)^2 + (1 - x_i)^2] of the variables (x_i, x_{i+1})
+   class ChainedRosenbrockModel: public SyntheticModel {
+   public:
+      explicit ChainedRosenbrockModel(size_t number_variables);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+
+      [[nodiscard]] size_t number_residuals() const override;
+      void evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const override;
+      void evaluate_residual_jacobian(const Vector<double>& x, RectangularMatrix<double>& residual_jacobian) const override;
+      [[nodiscard]] size_t number_elements() const override;
+      void get_elements(std::vector<ElementFunction>& elements) const override;
+      void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+   };
+} // namespace
+
+#endif // UNO_CHAINEDROSENBROCKMODEL_H
@@ -0,0 +1,141 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "NetworkFlowModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   NetworkFlowModel::NetworkFlowModel(size_t number_nodes):
+         SyntheticModel("network_flow_" + std::to_string(number_nodes), 3 * number_nodes, number_nodes),
+         number_nodes(number_nodes),
+         number_arcs(2 * number_nodes),
+         chord_length(std::max(size_t(2), static_cast<size_t>(std::sqrt(static_cast<double>(number_nodes))))) {
+      if (number_nodes < 3) {
+         throw std::invalid_argument("The network flow model requires at least 3 nodes");
+      }
+      // arc capacities
+      for (size_t arc_index: Range(this->number_arcs)) {
+         this->variable_lower_bounds[arc_index] = 0.;
+         this->variable_upper_bounds[arc_index] = 10. + 5. * static_cast<double>(arc_index % 3);
+      }
+      // supply capacities
+      for (size_t node_index: Range(this->number_nodes)) {
+         this->variable_lower_bounds[this->number_arcs + node_index] = 0.;
+         this->variable_upper_bounds[this->number_arcs + node_index] = 20.;
+      }
+      // flow conservation
+      for (size_t node_index: Range(this->number_nodes)) {
+         this->constraint_lower_bounds[node_index] = this->constraint_upper_bounds[node_index] = NetworkFlowModel::demand(node_index);
+      }
+      this->partition_variables_and_constraints();
+   }
+
+   double NetworkFlowModel::evaluate_objective(const Vector<double>& x) const {
+      double objective = 0.;
+      for (size_t arc_index: Range(this->number_arcs)) {
+         objective += 0.5 * this->flow_regularization * x[arc_index] * x[arc_index];
+      }
+      for (size_t node_index: Range(this->number_nodes)) {
+         const double supply = x[this->number_arcs + node_index];
+         objective += NetworkFlowModel::supply_cost(node_index) * supply + 0.5 * this->supply_quadratic_cost * supply * supply;
+      }
+      return objective;
+   }
+
+   void NetworkFlowModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      for (size_t arc_index: Range(this->number_arcs)) {
+         gradient.insert(arc_index, this->flow_regularization * x[arc_index]);
+      }
+      for (size_t node_index: Range(this->number_nodes)) {
+         const size_t variable_index = this->number_arcs + node_index;
+         gradient.insert(variable_index, NetworkFlowModel::supply_cost(node_index) + this->supply_quadratic_cost * x[variable_index]);
+      }
+   }
+
+   void NetworkFlowModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      for (size_t node_index: Range(this->number_nodes)) {
+         constraints[node_index] = x[this->number_arcs + node_index];
+      }
+      for (size_t arc_index: Range(this->number_arcs)) {
+         const double flow = x[arc_index];
+         // the tail loses the flow, the head receives the flow minus the losses
+         const size_t tail = arc_index % this->number_nodes;
+         constraints[tail] -= flow;
+         constraints[this->head(arc_index)] += flow - NetworkFlowModel::loss_coefficient(arc_index) * flow * flow;
+      }
+   }
+
+   void NetworkFlowModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      // outgoing arcs
+      gradient.insert(constraint_index, -1.);
+      gradient.insert(this->number_nodes + constraint_index, -1.);
+      // incoming arcs
+      const size_t ring_arc = (constraint_index + this->number_nodes - 1) % this->number_nodes;
+      const size_t chord_arc = this->number_nodes + (constraint_index + this->number_nodes - this->chord_length) % this->number_nodes;
+      for (size_t arc_index: {ring_arc, chord_arc}) {
+         gradient.insert(arc_index, 1. - 2. * NetworkFlowModel::loss_coefficient(arc_index) * x[arc_index]);
+      }
+      // supply
+      gradient.insert(this->number_arcs + constraint_index, 1.);
+   }
+
+   void NetworkFlowModel::evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      // diagonal Hessian of the Lagrangian objective_multiplier f(x) - multipliers^T c(x)
+      hessian.reset();
+      for (size_t arc_index: Range(this->number_arcs)) {
+         const double entry = objective_multiplier * this->flow_regularization +
+               2. * NetworkFlowModel::loss_coefficient(arc_index) * multipliers[this->head(arc_index)];
+         hessian.insert(entry, arc_index, arc_index);
+         hessian.finalize_column(arc_index);
+      }
+      for (size_t node_index: Range(this->number_nodes)) {
+         const size_t variable_index = this->number_arcs + node_index;
+         hessian.insert(objective_multiplier * this->supply_quadratic_cost, variable_index, variable_index);
+         hessian.finalize_column(variable_index);
+      }
+   }
+
+   void NetworkFlowModel::initial_primal_point(Vector<double>& x) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] = 0.;
+      }
+   }
+
+   size_t NetworkFlowModel::number_objective_gradient_nonzeros() const {
+      return this->number_variables;
+   }
+
+   size_t NetworkFlowModel::number_jacobian_nonzeros() const {
+      // each node has 2 outgoing arcs, 2 incoming arcs and a supply
+      return 5 * this->number_nodes;
+   }
+
+   size_t NetworkFlowModel::number_hessian_nonzeros() const {
+      return this->number_variables;
+   }
+
+   // arc a < N connects a to a+1 (ring), arc N + i connects i to i + chord_length (chord)
+   size_t NetworkFlowModel::head(size_t arc_index) const {
+      if (arc_index < this->number_nodes) {
+         return (arc_index + 1) % this->number_nodes;
+      }
+      return (arc_index - this->number_nodes + this->chord_length) % this->number_nodes;
+   }
+
+   double NetworkFlowModel::supply_cost(size_t node_index) {
+      return (node_index % 10 == 0) ? 1. : 10.;
+   }
+
+   double NetworkFlowModel::loss_coefficient(size_t arc_index) {
+      return 0.01 * (1. + static_cast<double>(arc_index % 7) / 7.);
+   }
+
+   double NetworkFlowModel::demand(size_t node_index) {
+      return 1. + 0.5 * static_cast<double>(node_index % 5);
+   }
+} // namespace
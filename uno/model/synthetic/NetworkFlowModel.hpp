@@ -0,0 +1,46 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NETWORKFLOWMODEL_H
+#define UNO_NETWORKFLOWMODEL_H
+
+#include "SyntheticModel.hpp"
+
+namespace uno {
+   // minimum-cost flow with quadratic losses on a sparse network of N nodes and 2N arcs (a ring and chords of length max(2, floor(sqrt(N))))
+   // min sum_i (c_i s_i + q/2 s_i^2) + epsilon/2 sum_a f_a^2
+   // s.t. s_i + sum_{a in in(i)} (f_a - r_a f_a^2) - sum_{a in out(i)} f_a = d_i
+   //      0 <= f_a <= capacity_a, 0 <= s_i <= 20
+   // where the supply s_i is cheap at every 10th node. Variables: the 2N arc flows, then the N supplies
+   class NetworkFlowModel: public SyntheticModel {
+   public:
+      explicit NetworkFlowModel(size_t number_nodes);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+
+   protected:
+      const size_t number_nodes;
+      const size_t number_arcs;
+      const size_t chord_length;
+      const double supply_quadratic_cost{0.1};
+      const double flow_regularization{1e-3};
+
+      [[nodiscard]] size_t head(size_t arc_index) const;
+      [[nodiscard]] static double supply_cost(size_t node_index);
+      [[nodiscard]] static double loss_coefficient(size_t arc_index);
+      [[nodiscard]] static double demand(size_t node_index);
+   };
+} // namespace
+
+#endif // UNO_NETWORKFLOWMODEL_H
@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include "OptimalControlModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   OptimalControlModel::OptimalControlModel(size_t number_time_steps, bool has_control_budget):
+         SyntheticModel((has_control_budget ? "budget_control_" : "optimal_control_") + std::to_string(number_time_steps),
+               2 * number_time_steps + 1, number_time_steps + 1 + (has_control_budget ? 1 : 0)),
+         number_time_steps(number_time_steps),
+         step_length(1. / static_cast<double>(number_time_steps)),
+         has_control_budget(has_control_budget) {
+      if (number_time_steps == 0) {
+         throw std::invalid_argument("The optimal control model requires at least one time step");
+      }
+      // bounds on the controls
+      for (size_t time_step: Range(number_time_steps)) {
+         this->variable_lower_bounds[this->control_index(time_step)] = -1.;
+         this->variable_upper_bounds[this->control_index(time_step)] = 1.;
+      }
+      // initial condition (linear) and dynamics (nonlinear)
+      this->constraint_lower_bounds[0] = this->constraint_upper_bounds[0] = 1.;
+      this->constraint_type[0] = LINEAR;
+      for (size_t time_step: Range(number_time_steps)) {
+         this->constraint_lower_bounds[time_step + 1] = this->constraint_upper_bounds[time_step + 1] = 0.;
+      }
+      if (this->has_control_budget) {
+         this->constraint_lower_bounds[number_time_steps + 1] = -this->control_budget;
+         this->constraint_type[number_time_steps + 1] = LINEAR;
+      }
+      this->partition_variables_and_constraints();
+   }
+
+   double OptimalControlModel::evaluate_objective(const Vector<double>& x) const {
+      double objective = 0.;
+      for (size_t time_step: Range(this->number_time_steps + 1)) {
+         objective += x[time_step] * x[time_step];
+      }
+      for (size_t time_step: Range(this->number_time_steps)) {
+         const double control = x[this->control_index(time_step)];
+         objective += this->control_weight * control * control;
+      }
+      return 0.5 * this->step_length * objective;
+   }
+
+   void OptimalControlModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      for (size_t time_step: Range(this->number_time_steps + 1)) {
+         gradient.insert(time_step, this->step_length * x[time_step]);
+      }
+      for (size_t time_step: Range(this->number_time_steps)) {
+         const size_t variable_index = this->control_index(time_step);
+         gradient.insert(variable_index, this->control_weight * this->step_length * x[variable_index]);
+      }
+   }
+
+   void OptimalControlModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      constraints[0] = x[0];
+      for (size_t time_step: Range(this->number_time_steps)) {
+         const double state = x[time_step];
+         constraints[time_step + 1] = x[time_step + 1] - state - this->step_length * (x[this->control_index(time_step)] - state * state * state);
+      }
+      if (this->has_control_budget) {
+         double budget = 0.;
+         for (size_t time_step: Range(this->number_time_steps)) {
+            budget += x[this->control_index(time_step)];
+         }
+         constraints[this->number_time_steps + 1] = this->step_length * budget;
+      }
+   }
+
+   void OptimalControlModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      if (constraint_index == 0) {
+         gradient.insert(0, 1.);
+      }
+      else if (constraint_index == this->number_time_steps + 1) {
+         for (size_t time_step: Range(this->number_time_steps)) {
+            gradient.insert(this->control_index(time_step), this->step_length);
+         }
+      }
+      else {
+         const size_t time_step = constraint_index - 1;
+         const double state = x[time_step];
+         gradient.insert(time_step, -1. + 3. * this->step_length * state * state);
+         gradient.insert(time_step + 1, 1.);
+         gradient.insert(this->control_index(time_step), -this->step_length);
+      }
+   }
+
+   void OptimalControlModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      // diagonal Hessian of the Lagrangian objective_multiplier f(x) - multipliers^T c(x)
+      hessian.reset();
+      for (size_t time_step: Range(this->number_time_steps + 1)) {
+         double entry = objective_multiplier * this->step_length;
+         if (time_step < this->number_time_steps) {
+            entry -= multipliers[time_step + 1] * 6. * this->step_length * x[time_step];
+         }
+         hessian.insert(entry, time_step, time_step);
+         hessian.finalize_column(time_step);
+      }
+      for (size_t time_step: Range(this->number_time_steps)) {
+         const size_t variable_index = this->control_index(time_step);
+         hessian.insert(objective_multiplier * this->control_weight * this->step_length, variable_index, variable_index);
+         hessian.finalize_column(variable_index);
+      }
+   }
+
+   size_t OptimalControlModel::number_elements() const {
+      return this->number_variables + this->number_time_steps;
+   }
+
+   // objective terms of the states and controls, then cubic terms of the dynamics
+   void OptimalControlModel::get_elements(std::vector<ElementFunction>& elements) const {
+      elements.clear();
+      for (size_t variable_index: Range(this->number_variables)) {
+         elements.emplace_back(ElementFunction{std::nullopt, {variable_index}});
+      }
+      for (size_t time_step: Range(this->number_time_steps)) {
+         elements.emplace_back(ElementFunction{time_step + 1, {time_step}});
+      }
+   }
+
+   void OptimalControlModel::evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const {
+      for (size_t time_step: Range(this->number_time_steps + 1)) {
+         element_gradients[time_step] = this->step_length * x[time_step];
+      }
+      for (size_t time_step: Range(this->number_time_steps)) {
+         const size_t variable_index = this->control_index(time_step);
+         element_gradients[variable_index] = this->control_weight * this->step_length * x[variable_index];
+         element_gradients[this->number_variables + time_step] = 3. * this->step_length * x[time_step] * x[time_step];
+      }
+   }
+
+   // the control budget couples all the stages
+   size_t OptimalControlModel::number_stages() const {
+      return this->has_control_budget ? 0 : this->number_time_steps + 1;
+   }
+
+   // the initial condition belongs to the first stage
+   void OptimalControlModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      variable_stages.resize(this->number_variables);
+      for (size_t time_step: Range(this->number_time_steps + 1)) {
+         variable_stages[time_step] = time_step;
+      }
+      for (size_t time_step: Range(this->number_time_steps)) {
+         variable_stages[this->control_index(time_step)] = time_step;
+      }
+      constraint_stages.resize(this->number_constraints);
+      constraint_stages[0] = 0;
+      for (size_t time_step: Range(this->number_time_steps)) {
+         constraint_stages[time_step + 1] = time_step;
+      }
+   }
+
+   void OptimalControlModel::initial_primal_point(Vector<double>& x) const {
+      for (size_t time_step: Range(this->number_time_steps + 1)) {
+         x[time_step] = 1.;
+      }
+      for (size_t time_step: Range(this->number_time_steps)) {
+         x[this->control_index(time_step)] = 0.;
+      }
+   }
+
+   size_t OptimalControlModel::number_objective_gradient_nonzeros() const {
+      return this->number_variables;
+   }
+
+   size_t OptimalControlModel::number_jacobian_nonzeros() const {
+      return 1 + (this->has_control_budget ? 4 : 3) * this->number_time_steps;
+   }
+
+   size_t OptimalControlModel::number_hessian_nonzeros() const {
+      return this->number_variables;
+   }
+
+   size_t OptimalControlModel::control_index(size_t time_step) const {
+      return this->number_time_steps + 1 + time_step;
+   }
+} // namespace
@@ -0,0 +1,51 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_OPTIMALCONTROLMODEL_H
+#define UNO_OPTIMALCONTROLMODEL_H
+
+#include "SyntheticModel.hpp"
+
+namespace uno {
+   // optimal control of the ODE y' = u - y^3 on [0, 1], discretized with N explicit Euler steps (h = 1/N):
+   // min h/2 sum_{k=0}^{N} y_k^2 + alpha h/2 sum_{k=0}^{N-1} u_k^2
+   // s.t. y_0 = 1
+   //      y_{k+1} - y_k - h (u_k - y_k^3) = 0, k = 0, ..., N-1
+   //      -1 <= u_k <= 1
+   // variables: y_0, ..., y_N, u_0, ..., u_{N-1}. The Jacobian is banded and the Hessian is diagonal. The elements are the terms of
+   // the objective and the cubic terms h y_k^3 of the dynamics. Stage k contains y_k, u_k and the dynamics between k and k+1.
+   // With a control budget, the linear constraint h sum_{k=0}^{N-1} u_k >= -budget adds a dense row to the Jacobian (no stages)
+   class OptimalControlModel: public SyntheticModel {
+   public:
+      explicit OptimalControlModel(size_t number_time_steps, bool has_control_budget = false);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      [[nodiscard]] size_t number_elements() const override;
+      void get_elements(std::vector<ElementFunction>& elements) const override;
+      void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override;
+      [[nodiscard]] size_t number_stages() const override;
+      void get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+
+   protected:
+      const size_t number_time_steps;
+      const double step_length;
+      const double control_weight{1e-2};
+      const bool has_control_budget;
+      const double control_budget{0.2};
+
+      [[nodiscard]] size_t control_index(size_t time_step) const;
+   };
+} // namespace
+
+#endif // UNO_OPTIMALCONTROLMODEL_H
@@ -0,0 +1,137 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include "PoissonControlModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   PoissonControlModel::PoissonControlModel(size_t grid_size):
+         SyntheticModel("poisson_control_" + std::to_string(grid_size), 2 * grid_size * grid_size, grid_size * grid_size),
+         grid_size(grid_size),
+         number_grid_points(grid_size * grid_size),
+         mesh_size(1. / static_cast<double>(grid_size + 1)) {
+      if (grid_size == 0) {
+         throw std::invalid_argument("The Poisson control model requires at least one grid point");
+      }
+      // bounds on the controls
+      for (size_t grid_point: Range(this->number_grid_points)) {
+         this->variable_lower_bounds[this->number_grid_points + grid_point] = 0.;
+         this->variable_upper_bounds[this->number_grid_points + grid_point] = 10.;
+      }
+      // discretized PDE
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_lower_bounds[constraint_index] = this->constraint_upper_bounds[constraint_index] = 0.;
+      }
+      this->partition_variables_and_constraints();
+   }
+
+   double PoissonControlModel::evaluate_objective(const Vector<double>& x) const {
+      double objective = 0.;
+      for (size_t grid_point: Range(this->number_grid_points)) {
+         const double state_error = x[grid_point] - this->target_state(grid_point);
+         const double control = x[this->number_grid_points + grid_point];
+         objective += state_error * state_error + this->control_weight * control * control;
+      }
+      return 0.5 * this->mesh_size * this->mesh_size * objective;
+   }
+
+   void PoissonControlModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      const double area = this->mesh_size * this->mesh_size;
+      for (size_t grid_point: Range(this->number_grid_points)) {
+         gradient.insert(grid_point, area * (x[grid_point] - this->target_state(grid_point)));
+      }
+      for (size_t grid_point: Range(this->number_grid_points)) {
+         const size_t variable_index = this->number_grid_points + grid_point;
+         gradient.insert(variable_index, area * this->control_weight * x[variable_index]);
+      }
+   }
+
+   void PoissonControlModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      const double area = this->mesh_size * this->mesh_size;
+      for (size_t row: Range(this->grid_size)) {
+         for (size_t column: Range(this->grid_size)) {
+            const size_t grid_point = row * this->grid_size + column;
+            const double state = x[grid_point];
+            double constraint = 4. * state + area * (state * state * state - x[this->number_grid_points + grid_point]);
+            // the neighbors on the boundary are zero
+            if (0 < row) {
+               constraint -= x[grid_point - this->grid_size];
+            }
+            if (row < this->grid_size - 1) {
+               constraint -= x[grid_point + this->grid_size];
+            }
+            if (0 < column) {
+               constraint -= x[grid_point - 1];
+            }
+            if (column < this->grid_size - 1) {
+               constraint -= x[grid_point + 1];
+            }
+            constraints[grid_point] = constraint;
+         }
+      }
+   }
+
+   void PoissonControlModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      const double area = this->mesh_size * this->mesh_size;
+      const size_t row = constraint_index / this->grid_size;
+      const size_t column = constraint_index % this->grid_size;
+      if (0 < row) {
+         gradient.insert(constraint_index - this->grid_size, -1.);
+      }
+      if (0 < column) {
+         gradient.insert(constraint_index - 1, -1.);
+      }
+      const double state = x[constraint_index];
+      gradient.insert(constraint_index, 4. + 3. * area * state * state);
+      if (column < this->grid_size - 1) {
+         gradient.insert(constraint_index + 1, -1.);
+      }
+      if (row < this->grid_size - 1) {
+         gradient.insert(constraint_index + this->grid_size, -1.);
+      }
+      gradient.insert(this->number_grid_points + constraint_index, -area);
+   }
+
+   void PoissonControlModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      // diagonal Hessian of the Lagrangian objective_multiplier f(x) - multipliers^T c(x)
+      const double area = this->mesh_size * this->mesh_size;
+      hessian.reset();
+      for (size_t grid_point: Range(this->number_grid_points)) {
+         hessian.insert(objective_multiplier * area - multipliers[grid_point] * 6. * area * x[grid_point], grid_point, grid_point);
+         hessian.finalize_column(grid_point);
+      }
+      for (size_t grid_point: Range(this->number_grid_points)) {
+         const size_t variable_index = this->number_grid_points + grid_point;
+         hessian.insert(objective_multiplier * area * this->control_weight, variable_index, variable_index);
+         hessian.finalize_column(variable_index);
+      }
+   }
+
+   void PoissonControlModel::initial_primal_point(Vector<double>& x) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] = 0.;
+      }
+   }
+
+   size_t PoissonControlModel::number_objective_gradient_nonzeros() const {
+      return this->number_variables;
+   }
+
+   size_t PoissonControlModel::number_jacobian_nonzeros() const {
+      // diagonal state and control terms + 4 N (N-1) neighbor terms
+      return 2 * this->number_grid_points + 4 * this->grid_size * (this->grid_size - 1);
+   }
+
+   size_t PoissonControlModel::number_hessian_nonzeros() const {
+      return this->number_variables;
+   }
+
+   double PoissonControlModel::target_state(size_t grid_point) const {
+      const double s = static_cast<double>(grid_point / this->grid_size + 1) * this->mesh_size;
+      const double t = static_cast<double>(grid_point % this->grid_size + 1) * this->mesh_size;
+      return 16. * s * (1. - s) * t * (1. - t);
+   }
+} // namespace
@@ -0,0 +1,43 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_POISSONCONTROLMODEL_H
+#define UNO_POISSONCONTROLMODEL_H
+
+#include "SyntheticModel.hpp"
+
+namespace uno {
+   // distributed control of the semilinear elliptic PDE -Laplacian(y) + y^3 = u on the unit square with homogeneous Dirichlet conditions,
+   // discretized with the 5-point finite-difference stencil on an N x N grid of interior points (h = 1/(N+1)):
+   // min h^2/2 sum_{ij} (y_ij - yd_ij)^2 + alpha h^2/2 sum_{ij} u_ij^2
+   // s.t. 4 y_ij - y_{i-1,j} - y_{i+1,j} - y_{i,j-1} - y_{i,j+1} + h^2 (y_ij^3 - u_ij) = 0
+   //      0 <= u_ij <= 10
+   // with the target state yd(s, t) = 16 s (1 - s) t (1 - t). Variables: the N^2 states, then the N^2 controls
+   class PoissonControlModel: public SyntheticModel {
+   public:
+      explicit PoissonControlModel(size_t grid_size);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+
+   protected:
+      const size_t grid_size;
+      const size_t number_grid_points;
+      const double mesh_size;
+      const double control_weight{1e-3};
+
+      [[nodiscard]] double target_state(size_t grid_point) const;
+   };
+} // namespace
+
+#endif // UNO_POISSONCONTROLMODEL_H
@@ -0,0 +1,112 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cassert>
+#include "SyntheticModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   SyntheticModel::SyntheticModel(std::string name, size_t number_variables, size_t number_constraints):
+         Model(std::move(name), number_variables, number_constraints, 1.),
+         variable_lower_bounds(number_variables, -INF<double>),
+         variable_upper_bounds(number_variables, INF<double>),
+         constraint_lower_bounds(number_constraints, -INF<double>),
+         constraint_upper_bounds(number_constraints, INF<double>),
+         constraint_type(number_constraints, NONLINEAR),
+         partition(number_variables, number_constraints) {
+   }
+
+   void SyntheticModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_jacobian[constraint_index].clear();
+         this->evaluate_constraint_gradient(x, constraint_index, constraint_jacobian[constraint_index]);
+      }
+   }
+
+   // the evaluations only read the data of the model
+   bool SyntheticModel::is_thread_safe() const {
+      return true;
+   }
+
+   double SyntheticModel::variable_lower_bound(size_t variable_index) const {
+      return this->variable_lower_bounds[variable_index];
+   }
+
+   double SyntheticModel::variable_upper_bound(size_t variable_index) const {
+      return this->variable_upper_bounds[variable_index];
+   }
+
+   BoundType SyntheticModel::get_variable_bound_type(size_t variable_index) const {
+      return this->partition.get_variable_bound_type(variable_index);
+   }
+
+   const Collection<size_t>& SyntheticModel::get_lower_bounded_variables() const {
+      return this->partition.get_lower_bounded_variables();
+   }
+
+   const Collection<size_t>& SyntheticModel::get_upper_bounded_variables() const {
+      return this->partition.get_upper_bounded_variables();
+   }
+
+   const SparseVector<size_t>& SyntheticModel::get_slacks() const {
+      return this->partition.get_slacks();
+   }
+
+   const Collection<size_t>& SyntheticModel::get_single_lower_bounded_variables() const {
+      return this->partition.get_single_lower_bounded_variables();
+   }
+
+   const Collection<size_t>& SyntheticModel::get_single_upper_bounded_variables() const {
+      return this->partition.get_single_upper_bounded_variables();
+   }
+
+   const Vector<size_t>& SyntheticModel::get_fixed_variables() const {
+      return this->partition.get_fixed_variables();
+   }
+
+   double SyntheticModel::constraint_lower_bound(size_t constraint_index) const {
+      return this->constraint_lower_bounds[constraint_index];
+   }
+
+   double SyntheticModel::constraint_upper_bound(size_t constraint_index) const {
+      return this->constraint_upper_bounds[constraint_index];
+   }
+
+   FunctionType SyntheticModel::get_constraint_type(size_t constraint_index) const {
+      return this->constraint_type[constraint_index];
+   }
+
+   BoundType SyntheticModel::get_constraint_bound_type(size_t constraint_index) const {
+      return this->partition.get_constraint_bound_type(constraint_index);
+   }
+
+   const Collection<size_t>& SyntheticModel::get_equality_constraints() const {
+      return this->partition.get_equality_constraints();
+   }
+
+   const Collection<size_t>& SyntheticModel::get_inequality_constraints() const {
+      return this->partition.get_inequality_constraints();
+   }
+
+   const Collection<size_t>& SyntheticModel::get_linear_constraints() const {
+      return this->partition.get_linear_constraints();
+   }
+
+   void SyntheticModel::initial_dual_point(Vector<double>& multipliers) const {
+      assert(multipliers.size() >= this->number_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         multipliers[constraint_index] = 0.;
+      }
+   }
+
+   void SyntheticModel::postprocess_solution(Iterate& /*iterate*/, IterateStatus /*iterate_status*/) const {
+      // do nothing
+   }
+
+   void SyntheticModel::partition_variables_and_constraints() {
+      this->partition.compute(this->variable_lower_bounds, this->variable_upper_bounds, this->constraint_lower_bounds,
+         this->constraint_upper_bounds, this->constraint_type);
+   }
+} // namespace
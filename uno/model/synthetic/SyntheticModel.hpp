@@ -0,0 +1,61 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SYNTHETICMODEL_H
+#define UNO_SYNTHETICMODEL_H
+
+#include <vector>
+#include "model/Model.hpp"
+#include "model/ModelPartition.hpp"
+
+namespace uno {
+   /*! \class SyntheticModel
+    * \brief Scalable model generated in memory
+    *
+    *  Common bookkeeping (bounds, bound types, partitions of the variables and constraints) of the synthetic models.
+    *  The derived classes set the bounds and the constraint types in their constructor, then call partition_variables_and_constraints().
+    */
+   class SyntheticModel: public Model {
+   public:
+      SyntheticModel(std::string name, size_t number_variables, size_t number_constraints);
+      ~SyntheticModel() override = default;
+
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      [[nodiscard]] bool is_thread_safe() const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override;
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override;
+
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus iterate_status) const override;
+
+   protected:
+      std::vector<double> variable_lower_bounds;
+      std::vector<double> variable_upper_bounds;
+      std::vector<double> constraint_lower_bounds;
+      std::vector<double> constraint_upper_bounds;
+      std::vector<FunctionType> constraint_type; /*!< Types of the constraints (LINEAR, NONLINEAR) */
+
+      void partition_variables_and_constraints();
+
+   private:
+      ModelPartition partition;
+   };
+} // namespace
+
+#endif // UNO_SYNTHETICMODEL_H
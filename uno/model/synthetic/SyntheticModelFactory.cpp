@@ -0,0 +1,34 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include "SyntheticModelFactory.hpp"
+#include "ChainedRosenbrockModel.hpp"
+#include "NetworkFlowModel.hpp"
+#include "OptimalControlModel.hpp"
+#include "PoissonControlModel.hpp"
+
+namespace uno {
+   std::unique_ptr<Model> SyntheticModelFactory::create(const std::string& problem_name, size_t size) {
+      if (problem_name == "chained_rosenbrock") {
+         return std::make_unique<ChainedRosenbrockModel>(size);
+      }
+      else if (problem_name == "optimal_control") {
+         return std::make_unique<OptimalControlModel>(size);
+      }
+      else if (problem_name == "budget_control") {
+         return std::make_unique<OptimalControlModel>(size, true);
+      }
+      else if (problem_name == "poisson_control") {
+         return std::make_unique<PoissonControlModel>(size);
+      }
+      else if (problem_name == "network_flow") {
+         return std::make_unique<NetworkFlowModel>(size);
+      }
+      throw std::invalid_argument("The synthetic problem " + problem_name + " does not exist");
+   }
+
+   std::vector<std::string> SyntheticModelFactory::available_problems() {
+      return {"chained_rosenbrock", "optimal_control", "budget_control", "poisson_control", "network_flow"};
+   }
+} // namespace
@@ -0,0 +1,22 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SYNTHETICMODELFACTORY_H
+#define UNO_SYNTHETICMODELFACTORY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "model/Model.hpp"
+
+namespace uno {
+   class SyntheticModelFactory {
+   public:
+      // the size is the number of variables (chained_rosenbrock), time steps (optimal_control, budget_control), grid points per
+      // dimension (poisson_control) or nodes (network_flow)
+      static std::unique_ptr<Model> create(const std::string& problem_name, size_t size);
+      static std::vector<std::string> available_problems();
+   };
+} // namespace
+
+#endif // UNO_SYNTHETICMODELFACTORY_H
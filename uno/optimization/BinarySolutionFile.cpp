@@ -0,0 +1,104 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include "BinarySolutionFile.hpp"
+#include "Result.hpp"
+
+namespace uno {
+   namespace {
+      constexpr std::array<char, 8> signature{'U', 'N', 'O', 'S', 'O', 'L', '\0', '\0'};
+      constexpr uint32_t version = 1;
+      constexpr uint32_t byte_order_mark = 0x01020304;
+
+      template <typename Number>
+      void write_number(std::ofstream& file, Number number) {
+         file.write(reinterpret_cast<const char*>(&number), sizeof(Number));
+      }
+
+      void write_array(std::ofstream& file, const double* array, size_t size) {
+         file.write(reinterpret_cast<const char*>(array), static_cast<std::streamsize>(size * sizeof(double)));
+      }
+
+      template <typename Number>
+      Number read_number(std::ifstream& file) {
+         Number number{};
+         file.read(reinterpret_cast<char*>(&number), sizeof(Number));
+         return number;
+      }
+
+      void read_array(std::ifstream& file, std::vector<double>& array, size_t size) {
+         array.resize(size);
+         file.read(reinterpret_cast<char*>(array.data()), static_cast<std::streamsize>(size * sizeof(double)));
+      }
+   } // namespace
+
+   void BinarySolutionFile::write(const std::string& file_name, const Result& result) {
+      std::ofstream file(file_name, std::ios::binary);
+      if (not file) {
+         throw std::runtime_error("BinarySolutionFile: the file " + file_name + " could not be opened");
+      }
+      const size_t number_variables = result.number_variables;
+      const size_t number_constraints = result.number_constraints;
+      file.write(signature.data(), signature.size());
+      write_number(file, version);
+      write_number(file, byte_order_mark);
+      write_number(file, static_cast<uint32_t>(result.optimization_status));
+      write_number(file, static_cast<uint32_t>(result.solution.status));
+      write_number(file, static_cast<uint64_t>(number_variables));
+      write_number(file, static_cast<uint64_t>(number_constraints));
+      write_number(file, result.solution.evaluations.objective);
+      write_number(file, result.solution.objective_multiplier);
+      write_array(file, result.solution.primals.data(), number_variables);
+      write_array(file, result.solution.multipliers.constraints.data(), number_constraints);
+      write_array(file, result.solution.multipliers.lower_bounds.data(), number_variables);
+      write_array(file, result.solution.multipliers.upper_bounds.data(), number_variables);
+      if (not file) {
+         throw std::runtime_error("BinarySolutionFile: the file " + file_name + " could not be written");
+      }
+   }
+
+   BinarySolution BinarySolutionFile::read(const std::string& file_name) {
+      std::ifstream file(file_name, std::ios::binary);
+      if (not file) {
+         throw std::runtime_error("BinarySolutionFile: the file " + file_name + " could not be opened");
+      }
+      std::array<char, 8> file_signature{};
+      file.read(file_signature.data(), file_signature.size());
+      if (not file || file_signature != signature) {
+         throw std::runtime_error("BinarySolutionFile: " + file_name + " is not an Uno solution file");
+      }
+      if (read_number<uint32_t>(file) != version) {
+         throw std::runtime_error("BinarySolutionFile: the version of " + file_name + " is not supported");
+      }
+      if (read_number<uint32_t>(file) != byte_order_mark) {
+         throw std::runtime_error("BinarySolutionFile: " + file_name + " was written with a different byte order");
+      }
+      BinarySolution solution{};
+      solution.optimization_status = static_cast<OptimizationStatus>(read_number<uint32_t>(file));
+      solution.iterate_status = static_cast<IterateStatus>(read_number<uint32_t>(file));
+      const auto number_variables = static_cast<size_t>(read_number<uint64_t>(file));
+      const auto number_constraints = static_cast<size_t>(read_number<uint64_t>(file));
+      solution.objective = read_number<double>(file);
+      solution.objective_multiplier = read_number<double>(file);
+      // check the size of the file before allocating the arrays
+      const std::streamoff header_size = file.tellg();
+      file.seekg(0, std::ios::end);
+      const auto array_sizes = static_cast<std::streamoff>((3 * number_variables + number_constraints) * sizeof(double));
+      if (not file || file.tellg() != header_size + array_sizes) {
+         throw std::runtime_error("BinarySolutionFile: the size of " + file_name + " is inconsistent with its header");
+      }
+      file.seekg(header_size);
+      read_array(file, solution.primals, number_variables);
+      read_array(file, solution.constraint_multipliers, number_constraints);
+      read_array(file, solution.lower_bound_multipliers, number_variables);
+      read_array(file, solution.upper_bound_multipliers, number_variables);
+      if (not file) {
+         throw std::runtime_error("BinarySolutionFile: the file " + file_name + " is truncated");
+      }
+      return solution;
+   }
+} // namespace
@@ -0,0 +1,42 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BINARYSOLUTIONFILE_H
+#define UNO_BINARYSOLUTIONFILE_H
+
+#include <string>
+#include <vector>
+#include "IterateStatus.hpp"
+#include "OptimizationStatus.hpp"
+
+namespace uno {
+   // forward declaration
+   struct Result;
+
+   struct BinarySolution {
+      OptimizationStatus optimization_status;
+      IterateStatus iterate_status;
+      double objective;
+      double objective_multiplier;
+      std::vector<double> primals{};
+      std::vector<double> constraint_multipliers{};
+      std::vector<double> lower_bound_multipliers{};
+      std::vector<double> upper_bound_multipliers{};
+   };
+
+   /*! \class BinarySolutionFile
+    * \brief Compact binary file of the primal-dual solution
+    *
+    *  Layout: 8-byte signature, version (uint32), byte order mark (uint32), optimization and iterate statuses (uint32), numbers of
+    *  variables and constraints (uint64), objective and objective multiplier (double), then the primals, the constraint multipliers
+    *  and the lower and upper bound multipliers (arrays of doubles). The numbers are stored in the byte order of the machine that
+    *  wrote the file.
+    */
+   class BinarySolutionFile {
+   public:
+      static void write(const std::string& file_name, const Result& result);
+      [[nodiscard]] static BinarySolution read(const std::string& file_name);
+   };
+} // namespace
+
+#endif // UNO_BINARYSOLUTIONFILE_H
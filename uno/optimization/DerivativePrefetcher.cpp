@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cassert>
+#include <utility>
+#include "DerivativePrefetcher.hpp"
+#include "EvaluationErrors.hpp"
+#include "Iterate.hpp"
+#include "model/Model.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   DerivativePrefetcher::DerivativePrefetcher(size_t number_variables, size_t number_constraints):
+         primals(number_variables),
+         objective_gradient(number_variables),
+         constraint_jacobian(number_constraints, number_variables) {
+   }
+
+   DerivativePrefetcher::~DerivativePrefetcher() {
+      this->synchronize();
+   }
+
+   void DerivativePrefetcher::start(const Model& model, const Iterate& trial_iterate) {
+      assert(not this->is_running() && "DerivativePrefetcher: the previous evaluations were neither committed nor discarded");
+      // the trial iterate may be modified by the globalization bookkeeping: copy its primals
+      this->primals = trial_iterate.primals;
+      this->is_model_constrained = model.is_constrained();
+      this->evaluations = std::async(std::launch::async, [&model, this]() {
+         this->objective_gradient.clear();
+         model.evaluate_objective_gradient(this->primals, this->objective_gradient);
+         this->constraint_jacobian.clear();
+         if (this->is_model_constrained) {
+            model.evaluate_constraint_jacobian(this->primals, this->constraint_jacobian);
+         }
+      });
+   }
+
+   void DerivativePrefetcher::commit(Iterate& iterate) {
+      if (this->wait()) {
+         DEBUG << "The prefetched derivatives are committed to the trial iterate\n";
+         std::swap(iterate.evaluations.objective_gradient, this->objective_gradient);
+         std::swap(iterate.evaluations.constraint_jacobian, this->constraint_jacobian);
+         iterate.is_objective_gradient_computed = true;
+         iterate.is_constraint_jacobian_computed = true;
+      }
+   }
+
+   void DerivativePrefetcher::discard() {
+      [[maybe_unused]] const bool successful = this->wait();
+      DEBUG << "The prefetched derivatives are discarded\n";
+   }
+
+   void DerivativePrefetcher::synchronize() const {
+      if (this->is_running()) {
+         this->evaluations.wait();
+      }
+   }
+
+   bool DerivativePrefetcher::is_running() const {
+      return this->evaluations.valid();
+   }
+
+   // returns true if the derivatives were successfully evaluated
+   bool DerivativePrefetcher::wait() {
+      if (not this->is_running()) {
+         return false;
+      }
+      try {
+         this->evaluations.get();
+         // the evaluations were carried out, whether they are used or not
+         Iterate::number_eval_objective_gradient++;
+         if (this->is_model_constrained) {
+            Iterate::number_eval_jacobian++;
+         }
+         return true;
+      }
+      catch (const EvaluationError&) {
+         // the error will be raised again if the derivatives are evaluated at the iterate
+         return false;
+      }
+   }
+
+   SynchronizedUserCallbacks::SynchronizedUserCallbacks(UserCallbacks& user_callbacks, const DerivativePrefetcher& derivative_prefetcher):
+         UserCallbacks(), user_callbacks(user_callbacks), derivative_prefetcher(derivative_prefetcher) {
+   }
+
+   void SynchronizedUserCallbacks::notify_acceptable_iterate(const Vector<double>& primals, const Multipliers& multipliers,
+         double objective_multiplier) {
+      this->derivative_prefetcher.synchronize();
+      this->user_callbacks.notify_acceptable_iterate(primals, multipliers, objective_multiplier);
+   }
+
+   void SynchronizedUserCallbacks::notify_new_primals(const Vector<double>& primals) {
+      this->derivative_prefetcher.synchronize();
+      this->user_callbacks.notify_new_primals(primals);
+   }
+
+   void SynchronizedUserCallbacks::notify_new_multipliers(const Multipliers& multipliers) {
+      this->derivative_prefetcher.synchronize();
+      this->user_callbacks.notify_new_multipliers(multipliers);
+   }
+} // namespace
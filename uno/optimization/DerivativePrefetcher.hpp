@@ -0,0 +1,61 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DERIVATIVEPREFETCHER_H
+#define UNO_DERIVATIVEPREFETCHER_H
+
+#include <future>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "tools/UserCallbacks.hpp"
+
+namespace uno {
+   // forward declarations
+   class Iterate;
+   class Model;
+   class Multipliers;
+
+   // speculative evaluation of the objective gradient and the constraint Jacobian of a trial iterate on a background thread.
+   // The model must be thread safe (see Model::is_thread_safe): the caller may evaluate the model between start() and
+   // commit()/discard() (e.g. when the acceptance test switches phases)
+   class DerivativePrefetcher {
+   public:
+      DerivativePrefetcher(size_t number_variables, size_t number_constraints);
+      ~DerivativePrefetcher();
+
+      void start(const Model& model, const Iterate& trial_iterate);
+      // wait for the evaluations and move them into the (accepted) iterate
+      void commit(Iterate& iterate);
+      // wait for the evaluations and drop them
+      void discard();
+      // wait for the evaluations without consuming them
+      void synchronize() const;
+      [[nodiscard]] bool is_running() const;
+
+   protected:
+      std::future<void> evaluations;
+      Vector<double> primals;
+      SparseVector<double> objective_gradient;
+      RectangularMatrix<double> constraint_jacobian;
+      bool is_model_constrained{false};
+
+      [[nodiscard]] bool wait();
+   };
+
+   // user callbacks that wait for the background evaluations: the user may evaluate the model (thread safe or not) in the callbacks
+   class SynchronizedUserCallbacks: public UserCallbacks {
+   public:
+      SynchronizedUserCallbacks(UserCallbacks& user_callbacks, const DerivativePrefetcher& derivative_prefetcher);
+
+      void notify_acceptable_iterate(const Vector<double>& primals, const Multipliers& multipliers, double objective_multiplier) override;
+      void notify_new_primals(const Vector<double>& primals) override;
+      void notify_new_multipliers(const Multipliers& multipliers) override;
+
+   protected:
+      UserCallbacks& user_callbacks;
+      const DerivativePrefetcher& derivative_prefetcher;
+   };
+} // namespace
+
+#endif // UNO_DERIVATIVEPREFETCHER_H
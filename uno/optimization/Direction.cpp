@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "Direction.hpp"
+#include "linear_algebra/VectorPrinting.hpp"
 #include "tools/Logger.hpp"
 #include "symbolic/VectorView.hpp"
 
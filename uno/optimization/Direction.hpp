@@ -26,6 +26,8 @@ namespace uno {
 
       double norm{INF<double>}; /*!< Norm of \f$x\f$ */
       double subproblem_objective{INF<double>}; /*!< Objective value */
+      bool is_tiny_step{false}; /*!< Primal step below machine precision relative to the primals (Section 3.9 of the Ipopt paper) */
+      bool is_repeated_tiny_step{false}; /*!< Tiny step while the subproblem cannot be tightened any further */
 
       void set_dimensions(size_t new_number_variables, size_t new_number_constraints);
       void reset();
@@ -7,12 +7,13 @@
 #include "model/Model.hpp"
 #include "optimization/EvaluationErrors.hpp"
 #include "tools/Logger.hpp"
+#include "tools/PerformanceCounters.hpp"
 
 namespace uno {
-   size_t Iterate::number_eval_objective = 0;
-   size_t Iterate::number_eval_constraints = 0;
-   size_t Iterate::number_eval_objective_gradient = 0;
-   size_t Iterate::number_eval_jacobian = 0;
+   thread_local size_t Iterate::number_eval_objective = 0;
+   thread_local size_t Iterate::number_eval_constraints = 0;
+   thread_local size_t Iterate::number_eval_objective_gradient = 0;
+   thread_local size_t Iterate::number_eval_jacobian = 0;
 
    Iterate::Iterate(size_t number_variables, size_t number_constraints) :
          number_variables(number_variables), number_constraints(number_constraints),
@@ -22,6 +23,7 @@ namespace uno {
 
    void Iterate::evaluate_objective(const Model& model) {
       if (not this->is_objective_computed) {
+         PerformanceCounterScope counter_scope(SolverPhase::EVALUATION);
          // evaluate the objective
          this->evaluations.objective = model.evaluate_objective(this->primals);
          Iterate::number_eval_objective++;
@@ -35,6 +37,7 @@ namespace uno {
    void Iterate::evaluate_constraints(const Model& model) {
       if (not this->are_constraints_computed) {
          if (model.is_constrained()) {
+            PerformanceCounterScope counter_scope(SolverPhase::EVALUATION);
             // evaluate the constraints
             model.evaluate_constraints(this->primals, this->evaluations.constraints);
             Iterate::number_eval_constraints++;
@@ -51,6 +54,7 @@ namespace uno {
 
    void Iterate::evaluate_objective_gradient(const Model& model) {
       if (not this->is_objective_gradient_computed) {
+         PerformanceCounterScope counter_scope(SolverPhase::EVALUATION);
          this->evaluations.objective_gradient.clear();
          // evaluate the objective gradient
          model.evaluate_objective_gradient(this->primals, this->evaluations.objective_gradient);
@@ -63,6 +67,7 @@ namespace uno {
       if (not this->is_constraint_jacobian_computed) {
          this->evaluations.constraint_jacobian.clear();
          if (model.is_constrained()) {
+            PerformanceCounterScope counter_scope(SolverPhase::EVALUATION);
             model.evaluate_constraint_jacobian(this->primals, this->evaluations.constraint_jacobian);
             Iterate::number_eval_jacobian++;
          }
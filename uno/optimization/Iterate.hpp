@@ -28,12 +28,12 @@ namespace uno {
       Multipliers feasibility_multipliers; /*!< \f$\mathbb{R}^n\f$ Lagrange multipliers/dual variables */
       double objective_multiplier{1.};
 
-      // evaluations
+      // evaluations (counted per thread: instances solved concurrently have their own counts)
       Evaluations evaluations;
-      static size_t number_eval_objective;
-      static size_t number_eval_constraints;
-      static size_t number_eval_objective_gradient;
-      static size_t number_eval_jacobian;
+      static thread_local size_t number_eval_objective;
+      static thread_local size_t number_eval_constraints;
+      static thread_local size_t number_eval_objective_gradient;
+      static thread_local size_t number_eval_jacobian;
       // lazy evaluation flags
       bool is_objective_computed{false};
       bool are_constraints_computed{false};
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include "Result.hpp"
 #include "IterateStatus.hpp"
+#include "linear_algebra/VectorPrinting.hpp"
 #include "symbolic/VectorView.hpp"
 
 namespace uno {
@@ -47,5 +48,7 @@ namespace uno {
       DISCRETE << "Jacobian evaluations:\t\t\t" << this->jacobian_evaluations << '\n';
       DISCRETE << "Hessian evaluations:\t\t\t" << this->hessian_evaluations << '\n';
       DISCRETE << "Number of subproblems solved:\t\t" << this->number_subproblems_solved << '\n';
+      this->performance_counters.print();
+      this->huge_pages.print();
    }
 } // namespace
@@ -6,6 +6,8 @@
 
 #include "Iterate.hpp"
 #include "OptimizationStatus.hpp"
+#include "tools/HugePageAllocator.hpp"
+#include "tools/PerformanceCounters.hpp"
 
 namespace uno {
    struct Result {
@@ -23,6 +25,8 @@ namespace uno {
       size_t jacobian_evaluations;
       size_t hessian_evaluations;
       size_t number_subproblems_solved;
+      PerformanceCounterReport performance_counters;
+      HugePageReport huge_pages;
 
       void print(bool print_primal_dual_solution) const;
    };
@@ -23,10 +23,22 @@ namespace uno {
       options["time_limit"] = "inf";
       // print optimal solution (yes|no)
       options["print_solution"] = "no";
+      // compact binary file of the primal-dual solution, read by BinarySolutionFile::read (file name|none)
+      options["binary_solution_file"] = "none";
+      // collect hardware performance counters per solver phase, Linux only (yes|no)
+      options["hardware_counters"] = "no";
+      // thread budget shared by Uno and the linear algebra backends (OpenMP, OpenBLAS, MKL, HiGHS). 0: number of hardware threads
+      options["threads"] = "0";
+      // allocation of the large numeric buffers (factors, KKT matrices, workspaces): none, transparent huge pages (madvise) or
+      // explicit huge pages reserved by the system, Linux only. Opt-in: the huge pages may increase the memory footprint
+      // (none|transparent|explicit)
+      options["huge_pages"] = "none";
       // threshold on objective to declare unbounded NLP
       options["unbounded_objective_threshold"] = "-1e20";
       // enforce linear constraints at the initial point (yes|no)
       options["enforce_linear_constraints"] = "no";
+      // number of instances with the same structure solved in lockstep by BatchedUno (one thread per instance)
+      options["batch_size"] = "16";
 
       /** statistics table **/
       options["statistics_print_header_frequency"] = "15";
@@ -39,6 +51,7 @@ namespace uno {
       options["statistics_LS_step_length_column_order"] = "10";
       options["statistics_restoration_phase_column_order"] = "20";
       options["statistics_regularization_column_order"] = "21";
+      options["statistics_hessian_column_order"] = "22";
       options["statistics_funnel_width_column_order"] = "25";
       options["statistics_step_norm_column_order"] = "31";
       options["statistics_objective_column_order"] = "100";
@@ -51,10 +64,21 @@ namespace uno {
       /** main options **/
       // logging level (SILENT|DISCRETE|WARNING|INFO|DEBUG|DEBUG2|DEBUG3)
       options["logger"] = "INFO";
-      // Hessian model (exact|zero)
+      // Hessian model (exact|gauss_newton|partitioned_quasi_newton|hybrid|zero)
       options["hessian_model"] = "exact";
+      // update of the element Hessians of the partitioned quasi-Newton model (SR1|BFGS)
+      options["quasi_newton_update"] = "SR1";
+      // hybrid Hessian: the quasi-Newton approximation is used when the exact Hessian costs more than this ratio of the rest of an
+      // iteration (expected number of additional iterations of the quasi-Newton method per exact iteration)
+      options["hybrid_hessian_cost_ratio"] = "3";
+      // hybrid Hessian: minimum number of iterations between two switches
+      options["hybrid_hessian_min_iterations"] = "3";
+      // hybrid Hessian: the exact Hessian is used when the step norm is below this tolerance (relative to the primal norm)
+      options["hybrid_hessian_local_step_tolerance"] = "1e-6";
       // sparse matrix format (COO|CSC)
       options["sparse_format"] = "COO";
+      // reordering of the variables and constraints at model load to improve memory locality (none|RCM)
+      options["model_reordering"] = "none";
       // scale the functions (yes|no)
       options["scale_functions"] = "no";
       options["function_scaling_threshold"] = "100";
@@ -107,10 +131,14 @@ namespace uno {
       options["LS_min_step_length"] = "1e-12";
       // use the primal-dual and dual step lengths to scale the dual directions when assembling the trial iterate
       options["LS_scale_duals_with_step_length"] = "yes";
+      // evaluate the derivatives at the trial iterate on a background thread during the acceptance test (thread-safe models only)
+      options["LS_prefetch_derivatives"] = "no";
 
       /** regularization options **/
       // regularization failure threshold
       options["regularization_failure_threshold"] = "1e40";
+      // factorization that detects nonconvexity: inertia of the symmetric indefinite linear solver or sparse Cholesky (inertia|cholesky)
+      options["convexification_method"] = "inertia";
       // Hessian regularization: initial value
       options["regularization_initial_value"] = "1e-4";
       options["regularization_increase_factor"] = "2";
@@ -122,6 +150,10 @@ namespace uno {
       options["primal_regularization_fast_increase_factor"] = "100.";
       options["primal_regularization_slow_increase_factor"] = "8.";
       options["threshold_unsuccessful_attempts"] = "8";
+      // quasidefinite mode (static pivoting linear solvers): dual regularization and iterative refinement
+      options["quasidefinite_dual_regularization"] = "1e-8";
+      options["quasidefinite_refinement_iterations"] = "3";
+      options["quasidefinite_refinement_tolerance"] = "1e-12";
 
       /** trust region options **/
       // initial trust region radius
@@ -175,16 +207,38 @@ namespace uno {
       options["barrier_update_fraction"] = "10";
       options["barrier_regularization_exponent"] = "0.25";
       options["barrier_small_direction_factor"] = "10.";
+      options["barrier_tiny_step_infeasibility_tolerance"] = "1e-4";
       options["barrier_push_variable_to_interior_k1"] = "1e-2";
       options["barrier_push_variable_to_interior_k2"] = "1e-2";
       options["barrier_damping_factor"] = "1e-5";
       options["least_square_multiplier_max_norm"] = "1e3";
+      // least-square multipliers: factorization of the augmented system or LSMR, with a direct solve if LSMR fails (direct|LSMR)
+      options["least_square_multiplier_method"] = "direct";
+      // relative tolerance of LSMR, capped by the optimality measure of the current point
+      options["least_square_multiplier_tolerance"] = "1e-2";
+      options["least_square_multiplier_max_iterations"] = "200";
+
+      /** reduced QP options **/
+      // maximum number of degrees of freedom (dimension of the dense reduced Hessian)
+      options["reduced_QP_max_degrees_of_freedom"] = "1000";
+      // relative pivot threshold of the sparse LU factorization of the basis
+      options["reduced_QP_pivot_threshold"] = "0.1";
+      // maximum number of basis changes when the basic variables violate their bounds
+      options["reduced_QP_max_basis_repairs"] = "5";
 
       /** BQPD options **/
       options["BQPD_kmax"] = "500";
 
       /** AMPL options **/
+      // write the solution of stub.nl into stub.sol (yes|no)
       options["AMPL_write_solution_to_file"] = "yes";
+      // evaluate the functions and derivatives with native code compiled from the .nl file (text format) instead of ASL (yes|no)
+      options["AMPL_compile_expressions"] = "no";
+      // C++ compiler used to compile the expressions (program and optional flags separated by spaces, not interpreted by a shell)
+      options["AMPL_compiler"] = "c++";
+      // cache of the compiled models, owned by the user and not writable by the other users (default: $XDG_CACHE_HOME/uno or
+      // ~/.cache/uno)
+      options["AMPL_compilation_directory"] = "default";
 
       return options;
    }
@@ -194,7 +248,7 @@ namespace uno {
 
       /** solvers: check the available solvers **/
       // QP solver
-      const auto QP_solvers = QPSolverFactory::available_solvers();
+      const auto QP_solvers = QPSolverFactory::default_solvers();
       if (not QP_solvers.empty()) {
          options["QP_solver"] = QP_solvers[0];
       }
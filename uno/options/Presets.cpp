@@ -18,7 +18,7 @@ namespace uno {
       }
       else {
          /** default preset **/
-         const auto QP_solvers = QPSolverFactory::available_solvers();
+         const auto QP_solvers = QPSolverFactory::default_solvers();
          const auto linear_solvers = SymmetricIndefiniteLinearSolverFactory::available_solvers();
          const auto LP_solvers = LPSolverFactory::available_solvers();
 
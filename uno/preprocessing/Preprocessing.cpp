@@ -1,11 +1,15 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <cmath>
 #include "Preprocessing.hpp"
+#include "ingredients/subproblem_solvers/LSMRSolver.hpp"
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "ingredients/subproblem_solvers/QPSolver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/VectorPrinting.hpp"
 #include "model/Model.hpp"
 #include "optimization/Direction.hpp"
 #include "optimization/Iterate.hpp"
@@ -13,6 +17,34 @@
 #include "symbolic/VectorView.hpp"
 
 namespace uno {
+   namespace {
+      // the least-square multipliers minimize ||J^T multipliers - (objective gradient - bound multipliers)||_2
+      void assemble_least_square_rhs(const Model& model, const Iterate& current_iterate, Vector<double>& rhs) {
+         rhs.fill(0.);
+         // objective gradient
+         for (const auto [variable_index, derivative]: current_iterate.evaluations.objective_gradient) {
+            rhs[variable_index] += model.objective_sign * derivative;
+         }
+         // variable bound constraints
+         for (size_t variable_index: Range(model.number_variables)) {
+            rhs[variable_index] -= current_iterate.multipliers.lower_bounds[variable_index] + current_iterate.multipliers.upper_bounds[variable_index];
+         }
+      }
+
+      // if least-square multipliers too big, discard them. Otherwise, keep them
+      template <typename Array>
+      void accept_least_square_multipliers(const Array& trial_multipliers, Vector<double>& multipliers, double multiplier_max_norm) {
+         DEBUG2 << "Trial multipliers: "; print_vector(DEBUG2, trial_multipliers);
+         if (norm_inf(trial_multipliers) <= multiplier_max_norm) {
+            multipliers = trial_multipliers;
+         }
+         else {
+            DEBUG << "Ignoring the least-square multipliers\n";
+         }
+         DEBUG << '\n';
+      }
+   } // namespace
+
    // compute a least-square approximation of the multipliers by solving a linear system
    void Preprocessing::compute_least_square_multipliers(const Model& model, SymmetricMatrix<size_t, double>& matrix, Vector<double>& rhs,
          DirectSymmetricIndefiniteLinearSolver<size_t, double>& linear_solver, Iterate& current_iterate, Vector<double>& multipliers,
@@ -23,15 +55,7 @@ namespace uno {
       DEBUG2 << "Current primals: " << current_iterate.primals << '\n';
 
       /* generate the right-hand side */
-      rhs.fill(0.);
-      // objective gradient
-      for (const auto [variable_index, derivative]: current_iterate.evaluations.objective_gradient) {
-         rhs[variable_index] += model.objective_sign * derivative;
-      }
-      // variable bound constraints
-      for (size_t variable_index: Range(model.number_variables)) {
-         rhs[variable_index] -= current_iterate.multipliers.lower_bounds[variable_index] + current_iterate.multipliers.upper_bounds[variable_index];
-      }
+      assemble_least_square_rhs(model, current_iterate, rhs);
       DEBUG2 << "RHS for least-square multipliers: "; print_vector(DEBUG2, view(rhs, 0, model.number_variables + model.number_constraints));
 
       // if the residuals on the RHS are all 0, the least-square multipliers are all 0
@@ -63,16 +87,68 @@ namespace uno {
       linear_solver.do_numerical_factorization(matrix);
       linear_solver.solve_indefinite_system(matrix, rhs, solution);
 
-      // if least-square multipliers too big, discard them. Otherwise, keep them
       const auto trial_multipliers = view(solution, model.number_variables, model.number_variables + model.number_constraints);
-      DEBUG2 << "Trial multipliers: "; print_vector(DEBUG2, trial_multipliers);
-      if (norm_inf(trial_multipliers) <= multiplier_max_norm) {
-         multipliers = trial_multipliers;
+      accept_least_square_multipliers(trial_multipliers, multipliers, multiplier_max_norm);
+   }
+
+   // compute the least-square multipliers with LSMR applied to J^T, without factorizing a matrix. The columns of J^T (constraint
+   // gradients) are scaled to unit norm. The accuracy is relative to the optimality measure ||objective gradient - bound multipliers||:
+   // a rough estimate is enough far from a stationary point. Returns false if LSMR did not converge
+   bool Preprocessing::compute_iterative_least_square_multipliers(const Model& model, Iterate& current_iterate, Vector<double>& multipliers,
+         double multiplier_max_norm, double relative_tolerance, size_t max_iterations) {
+      current_iterate.evaluate_objective_gradient(model);
+      current_iterate.evaluate_constraint_jacobian(model);
+      DEBUG << "Computing least-square multipliers with LSMR\n";
+
+      Vector<double> rhs(model.number_variables);
+      assemble_least_square_rhs(model, current_iterate, rhs);
+      const double optimality_measure = norm_inf(rhs);
+      if (optimality_measure == 0.) {
+         multipliers.fill(0.);
+         DEBUG << "Least-square multipliers are all 0.\n";
+         return true;
       }
-      else {
-         DEBUG << "Ignoring the least-square multipliers\n";
+
+      // diagonal (column) preconditioner
+      const RectangularMatrix<double>& constraint_jacobian = current_iterate.evaluations.constraint_jacobian;
+      Vector<double> column_scaling(model.number_constraints);
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         double gradient_squared_norm = 0.;
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            gradient_squared_norm += derivative * derivative;
+         }
+         const double gradient_norm = std::sqrt(gradient_squared_norm);
+         column_scaling[constraint_index] = (0. < gradient_norm) ? 1. / gradient_norm : 1.;
+      }
+      // J^T D y and D J u
+      const auto product = [&](const Vector<double>& y, Vector<double>& result) {
+         result.fill(0.);
+         for (size_t constraint_index: Range(model.number_constraints)) {
+            const double scaled_component = column_scaling[constraint_index] * y[constraint_index];
+            for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+               result[variable_index] += derivative * scaled_component;
+            }
+         }
+      };
+      const auto transposed_product = [&](const Vector<double>& u, Vector<double>& result) {
+         for (size_t constraint_index: Range(model.number_constraints)) {
+            result[constraint_index] = column_scaling[constraint_index] * dot(u, constraint_jacobian[constraint_index]);
+         }
+      };
+
+      LSMRSolver solver(model.number_variables, model.number_constraints);
+      Vector<double> solution(model.number_constraints);
+      const double tolerance = std::min(relative_tolerance, optimality_measure);
+      const bool converged = solver.solve(product, transposed_product, rhs, solution, tolerance, max_iterations);
+      DEBUG << "LSMR " << (converged ? "converged" : "did not converge") << " in " << solver.number_iterations() << " iterations\n";
+      if (not converged) {
+         return false;
+      }
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         solution[constraint_index] *= column_scaling[constraint_index];
       }
-      DEBUG << '\n';
+      accept_least_square_multipliers(solution, multipliers, multiplier_max_norm);
+      return true;
    }
 
    size_t count_infeasible_linear_constraints(const Model& model, const std::vector<double>& constraint_values) {
@@ -25,6 +25,8 @@ namespace uno {
       static void compute_least_square_multipliers(const Model& model, SymmetricMatrix<size_t, double>& matrix, Vector<double>& rhs,
             DirectSymmetricIndefiniteLinearSolver<size_t, double>& linear_solver, Iterate& current_iterate, Vector<double>& multipliers,
             double multiplier_max_norm);
+      [[nodiscard]] static bool compute_iterative_least_square_multipliers(const Model& model, Iterate& current_iterate, Vector<double>& multipliers,
+            double multiplier_max_norm, double relative_tolerance, size_t max_iterations);
       static void enforce_linear_constraints(const Model& model, Vector<double>& primals, Multipliers& multipliers, QPSolver& qp_solver);
    };
 } // namespace
@@ -0,0 +1,58 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include "ReverseCuthillMcKee.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   std::vector<size_t> compute_reverse_cuthill_mckee_ordering(std::vector<std::vector<size_t>>& adjacency) {
+      const size_t number_nodes = adjacency.size();
+      for (auto& neighbors: adjacency) {
+         std::sort(neighbors.begin(), neighbors.end());
+         neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+      }
+      const auto smaller_degree = [&](size_t node1, size_t node2) {
+         return adjacency[node1].size() < adjacency[node2].size();
+      };
+
+      // breadth-first search of each connected component, starting from a node of minimum degree
+      std::vector<size_t> nodes(number_nodes);
+      for (size_t index: Range(number_nodes)) {
+         nodes[index] = index;
+      }
+      std::stable_sort(nodes.begin(), nodes.end(), smaller_degree);
+      std::vector<bool> visited(number_nodes, false);
+      std::vector<size_t> permutation{};
+      permutation.reserve(number_nodes);
+      for (size_t start_node: nodes) {
+         if (visited[start_node]) {
+            continue;
+         }
+         visited[start_node] = true;
+         size_t queue_head = permutation.size();
+         permutation.emplace_back(start_node);
+         while (queue_head < permutation.size()) {
+            const size_t node = permutation[queue_head++];
+            const size_t first_neighbor = permutation.size();
+            for (size_t neighbor: adjacency[node]) {
+               if (not visited[neighbor]) {
+                  visited[neighbor] = true;
+                  permutation.emplace_back(neighbor);
+               }
+            }
+            std::stable_sort(permutation.begin() + static_cast<std::ptrdiff_t>(first_neighbor), permutation.end(), smaller_degree);
+         }
+      }
+      std::reverse(permutation.begin(), permutation.end());
+      return permutation;
+   }
+
+   std::vector<size_t> invert_permutation(const std::vector<size_t>& permutation) {
+      std::vector<size_t> inverse_permutation(permutation.size());
+      for (size_t index: Range(permutation.size())) {
+         inverse_permutation[permutation[index]] = index;
+      }
+      return inverse_permutation;
+   }
+} // namespace
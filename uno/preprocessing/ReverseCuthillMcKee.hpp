@@ -0,0 +1,19 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REVERSECUTHILLMCKEE_H
+#define UNO_REVERSECUTHILLMCKEE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace uno {
+   // reverse Cuthill-McKee ordering of an undirected graph given by its adjacency lists (sorted and made unique in place).
+   // Returns the permutation: permutation[new index] = old index
+   std::vector<size_t> compute_reverse_cuthill_mckee_ordering(std::vector<std::vector<size_t>>& adjacency);
+
+   // inverse of a permutation: inverse_permutation[old index] = new index
+   std::vector<size_t> invert_permutation(const std::vector<size_t>& permutation);
+} // namespace
+
+#endif // UNO_REVERSECUTHILLMCKEE_H
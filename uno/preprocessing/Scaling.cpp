@@ -6,6 +6,7 @@
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "linear_algebra/VectorPrinting.hpp"
 
 namespace uno {
    Scaling::Scaling(size_t number_constraints, double gradient_threshold):
@@ -0,0 +1,68 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "BufferedWriter.hpp"
+
+namespace uno {
+   // the precision is capped at the number of significant digits of a double
+   BufferedWriter::BufferedWriter(std::ostream& stream, int precision): stream(stream), precision(std::min(precision, 17)) { }
+
+   BufferedWriter::~BufferedWriter() {
+      this->flush();
+   }
+
+   BufferedWriter& BufferedWriter::operator<<(double value) {
+      this->reserve(max_number_length);
+      char* first = this->buffer.data() + this->size;
+      char* last = this->buffer.data() + this->buffer.size();
+#if defined(__cpp_lib_to_chars)
+      const auto result = (this->precision == shortest_round_trip) ? std::to_chars(first, last, value) :
+            std::to_chars(first, last, value, std::chars_format::general, this->precision);
+      this->size = static_cast<size_t>(result.ptr - this->buffer.data());
+#else
+      // the standard library does not format floating-point numbers with std::to_chars
+      const int precision = (this->precision == shortest_round_trip) ? 17 : this->precision;
+      const int length = std::snprintf(first, static_cast<size_t>(last - first), "%.*g", precision, value);
+      this->size += static_cast<size_t>(length);
+#endif
+      return *this;
+   }
+
+   BufferedWriter& BufferedWriter::operator<<(char character) {
+      this->reserve(1);
+      this->buffer[this->size] = character;
+      this->size++;
+      return *this;
+   }
+
+   BufferedWriter& BufferedWriter::operator<<(bool value) {
+      return *this << (value ? '1' : '0');
+   }
+
+   BufferedWriter& BufferedWriter::operator<<(std::string_view string) {
+      while (not string.empty()) {
+         this->reserve(1);
+         const size_t length = std::min(string.size(), this->buffer.size() - this->size);
+         std::memcpy(this->buffer.data() + this->size, string.data(), length);
+         this->size += length;
+         string.remove_prefix(length);
+      }
+      return *this;
+   }
+
+   void BufferedWriter::flush() {
+      if (0 < this->size) {
+         this->stream.write(this->buffer.data(), static_cast<std::streamsize>(this->size));
+         this->size = 0;
+      }
+   }
+
+   void BufferedWriter::reserve(size_t length) {
+      if (this->buffer.size() < this->size + length) {
+         this->flush();
+      }
+   }
+} // namespace
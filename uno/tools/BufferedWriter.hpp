@@ -0,0 +1,60 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BUFFEREDWRITER_H
+#define UNO_BUFFEREDWRITER_H
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace uno {
+   /*! \class BufferedWriter
+    * \brief Locale-independent text output of numbers
+    *
+    *  The numbers are formatted with std::to_chars into a buffer that is flushed into the stream in large blocks. The doubles are
+    *  written with a given number of significant digits (like printf %g) or, by default, with the shortest representation that
+    *  is read back exactly.
+    */
+   class BufferedWriter {
+   public:
+      static constexpr int shortest_round_trip = 0;
+
+      explicit BufferedWriter(std::ostream& stream, int precision = shortest_round_trip);
+      BufferedWriter(const BufferedWriter&) = delete;
+      BufferedWriter& operator=(const BufferedWriter&) = delete;
+      ~BufferedWriter();
+
+      BufferedWriter& operator<<(double value);
+      BufferedWriter& operator<<(char character);
+      BufferedWriter& operator<<(std::string_view string);
+      // string literals would otherwise be converted to bool
+      BufferedWriter& operator<<(const char* string) { return *this << std::string_view(string); }
+      // 0 or 1, like std::ostream without std::boolalpha
+      BufferedWriter& operator<<(bool value);
+      // integers (std::to_chars is deleted for bool)
+      template <typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer> && not std::is_same_v<Integer, bool>>>
+      BufferedWriter& operator<<(Integer value) {
+         this->reserve(max_number_length);
+         const auto result = std::to_chars(this->buffer.data() + this->size, this->buffer.data() + this->buffer.size(), value);
+         this->size = static_cast<size_t>(result.ptr - this->buffer.data());
+         return *this;
+      }
+
+      void flush();
+
+   private:
+      static constexpr size_t max_number_length = 32;
+      std::ostream& stream;
+      const int precision;
+      std::array<char, 65536> buffer{};
+      size_t size{0};
+
+      void reserve(size_t length);
+   };
+} // namespace
+
+#endif // UNO_BUFFEREDWRITER_H
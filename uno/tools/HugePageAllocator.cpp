@@ -0,0 +1,219 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include "HugePageAllocator.hpp"
+#include "Logger.hpp"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace uno {
+   namespace {
+      struct LargeBuffer {
+         size_t mapped_bytes;
+         bool is_explicit;
+         bool is_advised;
+      };
+
+      std::atomic<HugePagePolicy> policy{HugePagePolicy::NONE};
+      std::mutex buffers_mutex{};
+      std::map<std::uintptr_t, LargeBuffer> large_buffers{}; // indexed by start address
+
+      size_t round_up(size_t number_bytes, size_t multiple) {
+         return (number_bytes + multiple - 1) / multiple * multiple;
+      }
+
+      void* allocate_aligned(size_t number_bytes) {
+         return ::operator new(number_bytes, std::align_val_t{HugePages::alignment});
+      }
+
+#ifdef __linux__
+      // maps a buffer aligned on a huge page. Returns nullptr if the mapping failed
+      void* map_large_buffer(size_t number_bytes, HugePagePolicy current_policy, LargeBuffer& buffer) {
+         const size_t mapped_bytes = round_up(number_bytes, HugePages::huge_page_size);
+#ifdef MAP_HUGETLB
+         if (current_policy == HugePagePolicy::EXPLICIT) {
+            // fails if not enough huge pages are reserved
+            void* pointer = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (pointer != MAP_FAILED) {
+               buffer = {mapped_bytes, true, false};
+               return pointer;
+            }
+         }
+#endif
+         // over-allocate, then trim the unaligned head and tail
+         void* pointer = mmap(nullptr, mapped_bytes + HugePages::huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+         if (pointer == MAP_FAILED) {
+            return nullptr;
+         }
+         const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(pointer);
+         const std::uintptr_t aligned_start = round_up(start, HugePages::huge_page_size);
+         if (start < aligned_start) {
+            munmap(pointer, aligned_start - start);
+         }
+         const size_t tail_bytes = HugePages::huge_page_size - (aligned_start - start);
+         if (0 < tail_bytes) {
+            munmap(reinterpret_cast<void*>(aligned_start + mapped_bytes), tail_bytes);
+         }
+         bool is_advised = false;
+#ifdef MADV_HUGEPAGE
+         is_advised = (madvise(reinterpret_cast<void*>(aligned_start), mapped_bytes, MADV_HUGEPAGE) == 0);
+#endif
+         buffer = {mapped_bytes, false, is_advised};
+         return reinterpret_cast<void*>(aligned_start);
+      }
+
+      // huge page memory of the large buffers, read from the memory mappings of the process. Returns false if unavailable
+      bool measure_backed_bytes(size_t& backed_bytes) {
+         std::ifstream smaps("/proc/self/smaps");
+         if (not smaps.is_open()) {
+            return false;
+         }
+         backed_bytes = 0;
+         std::uintptr_t mapping_start = 0, mapping_end = 0;
+         std::string line;
+         while (std::getline(smaps, line)) {
+            std::istringstream stream(line);
+            std::string first_token;
+            stream >> first_token;
+            if (first_token.empty()) {
+               continue;
+            }
+            if (first_token.back() != ':') {
+               // header of a mapping: start-end (hexadecimal)
+               const size_t dash_position = first_token.find('-');
+               if (dash_position != std::string::npos) {
+                  mapping_start = std::stoull(first_token.substr(0, dash_position), nullptr, 16);
+                  mapping_end = std::stoull(first_token.substr(dash_position + 1), nullptr, 16);
+               }
+            }
+            else if (first_token == "AnonHugePages:" || first_token == "Private_Hugetlb:" || first_token == "Shared_Hugetlb:") {
+               size_t kilobytes = 0;
+               stream >> kilobytes;
+               if (kilobytes == 0 || mapping_end <= mapping_start) {
+                  continue;
+               }
+               // the mapping may contain several buffers (or merge with neighboring mappings): prorate its huge pages
+               size_t overlapping_bytes = 0;
+               for (const auto& [buffer_start, buffer]: large_buffers) {
+                  const std::uintptr_t overlap_start = std::max(buffer_start, mapping_start);
+                  const std::uintptr_t overlap_end = std::min(buffer_start + buffer.mapped_bytes, mapping_end);
+                  if (overlap_start < overlap_end) {
+                     overlapping_bytes += overlap_end - overlap_start;
+                  }
+               }
+               const double fraction = static_cast<double>(overlapping_bytes) / static_cast<double>(mapping_end - mapping_start);
+               backed_bytes += static_cast<size_t>(fraction * static_cast<double>(1024 * kilobytes));
+            }
+         }
+         return true;
+      }
+#endif
+   } // namespace
+
+   void HugePages::set_policy(const std::string& policy_name) {
+      if (policy_name == "none") {
+         policy = HugePagePolicy::NONE;
+      }
+      else if (policy_name == "transparent") {
+         policy = HugePagePolicy::TRANSPARENT;
+      }
+      else if (policy_name == "explicit") {
+         policy = HugePagePolicy::EXPLICIT;
+      }
+      else {
+         throw std::invalid_argument("The huge page policy " + policy_name + " does not exist");
+      }
+   }
+
+   HugePagePolicy HugePages::get_policy() {
+      return policy;
+   }
+
+   void* HugePages::allocate(size_t number_bytes) {
+#ifdef __linux__
+      const HugePagePolicy current_policy = policy;
+      if (current_policy != HugePagePolicy::NONE && HugePages::huge_page_size <= number_bytes) {
+         LargeBuffer buffer{};
+         void* pointer = map_large_buffer(number_bytes, current_policy, buffer);
+         if (pointer != nullptr) {
+            const std::lock_guard<std::mutex> lock(buffers_mutex);
+            large_buffers.emplace(reinterpret_cast<std::uintptr_t>(pointer), buffer);
+            return pointer;
+         }
+      }
+#endif
+      return allocate_aligned(number_bytes);
+   }
+
+   void HugePages::deallocate(void* pointer, size_t number_bytes) noexcept {
+      if (pointer == nullptr) {
+         return;
+      }
+#ifdef __linux__
+      // only the buffers of at least one huge page may have been mapped
+      if (HugePages::huge_page_size <= number_bytes) {
+         std::unique_lock<std::mutex> lock(buffers_mutex);
+         const auto position = large_buffers.find(reinterpret_cast<std::uintptr_t>(pointer));
+         if (position != large_buffers.end()) {
+            const size_t mapped_bytes = position->second.mapped_bytes;
+            large_buffers.erase(position);
+            lock.unlock();
+            munmap(pointer, mapped_bytes);
+            return;
+         }
+      }
+#endif
+      ::operator delete(pointer, std::align_val_t{HugePages::alignment});
+   }
+
+   HugePageReport HugePages::get_report() {
+      HugePageReport report{};
+      report.policy = policy;
+      const std::lock_guard<std::mutex> lock(buffers_mutex);
+      for (const auto& [buffer_start, buffer]: large_buffers) {
+         report.number_large_buffers++;
+         report.large_buffer_bytes += buffer.mapped_bytes;
+         if (buffer.is_explicit) {
+            report.explicit_huge_page_bytes += buffer.mapped_bytes;
+         }
+         if (buffer.is_advised) {
+            report.advised_bytes += buffer.mapped_bytes;
+         }
+      }
+#ifdef __linux__
+      if (0 < report.number_large_buffers) {
+         report.is_backing_measured = measure_backed_bytes(report.backed_bytes);
+      }
+#endif
+      return report;
+   }
+
+   void HugePageReport::print() const {
+      if (this->policy == HugePagePolicy::NONE || this->number_large_buffers == 0) {
+         return;
+      }
+      constexpr size_t megabyte = 1024 * 1024;
+      DISCRETE << "Huge pages:\t\t\t\t" << this->number_large_buffers << " large buffers (" << this->large_buffer_bytes / megabyte << " MB), ";
+      if (this->is_backing_measured) {
+         DISCRETE << this->backed_bytes / megabyte << " MB backed by huge pages";
+      }
+      else {
+         DISCRETE << "backing unknown";
+      }
+      if (0 < this->explicit_huge_page_bytes) {
+         DISCRETE << " (" << this->explicit_huge_page_bytes / megabyte << " MB explicit)";
+      }
+      DISCRETE << '\n';
+   }
+} // namespace
@@ -0,0 +1,70 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_HUGEPAGEALLOCATOR_H
+#define UNO_HUGEPAGEALLOCATOR_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace uno {
+   // none: aligned heap allocations. transparent: madvise(MADV_HUGEPAGE) on the large buffers. explicit: the large buffers are
+   // mapped from the reserved huge pages (MAP_HUGETLB), with a fallback to transparent huge pages
+   enum class HugePagePolicy {NONE, TRANSPARENT, EXPLICIT};
+
+   struct HugePageReport {
+      HugePagePolicy policy{HugePagePolicy::NONE};
+      size_t number_large_buffers{0}; // live buffers allocated with the huge page policy
+      size_t large_buffer_bytes{0};
+      size_t explicit_huge_page_bytes{0}; // mapped from the reserved huge pages
+      size_t advised_bytes{0}; // madvise(MADV_HUGEPAGE) succeeded
+      size_t backed_bytes{0}; // actually backed by huge pages (from /proc/self/smaps)
+      bool is_backing_measured{false};
+
+      void print() const;
+   };
+
+   // allocation of the large numeric buffers (factors, KKT matrices, workspaces). All the buffers are aligned on cache lines; the
+   // buffers of at least one huge page are mapped separately and aligned on huge pages to reduce the TLB misses
+   class HugePages {
+   public:
+      static constexpr size_t alignment = 64;
+      static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+      static void set_policy(const std::string& policy);
+      [[nodiscard]] static HugePagePolicy get_policy();
+      [[nodiscard]] static void* allocate(size_t number_bytes);
+      static void deallocate(void* pointer, size_t number_bytes) noexcept;
+      // report on the live large buffers
+      [[nodiscard]] static HugePageReport get_report();
+   };
+
+   template <typename ElementType>
+   class HugePageAllocator {
+   public:
+      using value_type = ElementType;
+
+      HugePageAllocator() noexcept = default;
+      template <typename OtherElementType>
+      HugePageAllocator(const HugePageAllocator<OtherElementType>& /*other*/) noexcept { }
+
+      [[nodiscard]] ElementType* allocate(size_t number_elements) {
+         return static_cast<ElementType*>(HugePages::allocate(number_elements * sizeof(ElementType)));
+      }
+
+      void deallocate(ElementType* pointer, size_t number_elements) noexcept {
+         HugePages::deallocate(pointer, number_elements * sizeof(ElementType));
+      }
+
+      template <typename OtherElementType>
+      bool operator==(const HugePageAllocator<OtherElementType>& /*other*/) const noexcept { return true; }
+      template <typename OtherElementType>
+      bool operator!=(const HugePageAllocator<OtherElementType>& /*other*/) const noexcept { return false; }
+   };
+
+   template <typename ElementType>
+   using HugePageVector = std::vector<ElementType, HugePageAllocator<ElementType>>;
+} // namespace
+
+#endif // UNO_HUGEPAGEALLOCATOR_H
@@ -0,0 +1,25 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_INTEGERCAST_H
+#define UNO_INTEGERCAST_H
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace uno {
+   // narrowing conversion of a size (dimension, number of nonzeros, workspace length) to the integer type of an external solver.
+   // Throws instead of silently overflowing
+   template <typename IntegerType>
+   IntegerType checked_integer_cast(size_t value, const std::string& description) {
+      if (static_cast<size_t>(std::numeric_limits<IntegerType>::max()) < value) {
+         throw std::overflow_error(description + " (" + std::to_string(value) + ") exceeds the largest integer supported by the solver (" +
+            std::to_string(std::numeric_limits<IntegerType>::max()) + ")");
+      }
+      return static_cast<IntegerType>(value);
+   }
+} // namespace
+
+#endif // UNO_INTEGERCAST_H
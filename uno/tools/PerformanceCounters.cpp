@@ -0,0 +1,189 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <iomanip>
+#include <string>
+#include "PerformanceCounters.hpp"
+#include "Logger.hpp"
+#include "symbolic/Range.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace uno {
+   namespace {
+      const std::array<const char*, number_solver_phases> phase_names{"evaluation", "assembly", "factorization", "solve", "subproblem"};
+      const std::array<const char*, number_hardware_events> event_names{"cycles", "instructions", "cache misses", "branch misses"};
+
+      struct CounterState {
+         bool is_open{false};
+         bool is_enabled{false};
+         int leader_descriptor{-1};
+         std::array<int, number_hardware_events> descriptors{-1, -1, -1, -1};
+         // position of each event in the buffer of a group read (after the number of events)
+         std::array<size_t, number_hardware_events> group_positions{};
+         size_t number_open_events{0};
+         PerformanceCounterReport report{};
+
+         CounterState() = default;
+         CounterState(const CounterState&) = delete;
+         CounterState& operator=(const CounterState&) = delete;
+         // the descriptors are closed when the thread exits (e.g. the lanes of a batched solve)
+         ~CounterState() {
+#ifdef __linux__
+            for (const int descriptor: this->descriptors) {
+               if (descriptor != -1) {
+                  close(descriptor);
+               }
+            }
+#endif
+         }
+      };
+      // one group of counters per thread
+      thread_local CounterState state{};
+
+#ifdef __linux__
+      int open_hardware_event(uint64_t configuration, int group_descriptor) {
+         perf_event_attr attributes{};
+         attributes.type = PERF_TYPE_HARDWARE;
+         attributes.size = sizeof(perf_event_attr);
+         attributes.config = configuration;
+         // the leader starts disabled, the group is enabled at once
+         attributes.disabled = (group_descriptor == -1) ? 1 : 0;
+         attributes.exclude_kernel = 1;
+         attributes.exclude_hv = 1;
+         attributes.read_format = PERF_FORMAT_GROUP;
+         // calling thread, any CPU
+         return static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, group_descriptor, 0));
+      }
+#endif
+
+      void open_counters() {
+#ifdef __linux__
+         const std::array<uint64_t, number_hardware_events> configurations{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+         for (size_t event_index: Range(number_hardware_events)) {
+            const int descriptor = open_hardware_event(configurations[event_index], state.leader_descriptor);
+            if (0 <= descriptor) {
+               if (state.leader_descriptor == -1) {
+                  state.leader_descriptor = descriptor;
+               }
+               state.descriptors[event_index] = descriptor;
+               state.group_positions[event_index] = state.number_open_events++;
+            }
+         }
+         if (state.leader_descriptor != -1) {
+            ioctl(state.leader_descriptor, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(state.leader_descriptor, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+         }
+#endif
+         state.is_open = true;
+      }
+   } // namespace
+
+   bool PerformanceCounters::enable() {
+      if (not state.is_open) {
+         open_counters();
+      }
+      state.report = PerformanceCounterReport{};
+      state.report.requested = true;
+      state.report.available = (state.leader_descriptor != -1);
+      for (size_t event_index: Range(number_hardware_events)) {
+         state.report.available_events[event_index] = (state.descriptors[event_index] != -1);
+      }
+      state.is_enabled = state.report.available;
+      return state.is_enabled;
+   }
+
+   void PerformanceCounters::disable() {
+      state.is_enabled = false;
+      state.report = PerformanceCounterReport{};
+   }
+
+   bool PerformanceCounters::is_enabled() {
+      return state.is_enabled;
+   }
+
+   const PerformanceCounterReport& PerformanceCounters::get_report() {
+      return state.report;
+   }
+
+   void PerformanceCounters::read(std::array<uint64_t, number_hardware_events>& values) {
+#ifdef __linux__
+      // group read: number of events followed by their values
+      std::array<uint64_t, number_hardware_events + 1> buffer{};
+      if (::read(state.leader_descriptor, buffer.data(), sizeof(uint64_t) * (state.number_open_events + 1)) <= 0) {
+         values.fill(0);
+         return;
+      }
+      for (size_t event_index: Range(number_hardware_events)) {
+         values[event_index] = (state.descriptors[event_index] != -1) ? buffer[1 + state.group_positions[event_index]] : 0;
+      }
+#else
+      values.fill(0);
+#endif
+   }
+
+   void PerformanceCounters::accumulate(SolverPhase phase, const std::array<uint64_t, number_hardware_events>& start_values) {
+      std::array<uint64_t, number_hardware_events> end_values{};
+      PerformanceCounters::read(end_values);
+      PhaseCounters& counters = state.report.phases[static_cast<size_t>(phase)];
+      counters.number_calls++;
+      for (size_t event_index: Range(number_hardware_events)) {
+         counters.events[event_index] += end_values[event_index] - start_values[event_index];
+      }
+   }
+
+   void PerformanceCounterReport::print() const {
+      if (not this->requested) {
+         return;
+      }
+      if (not this->available) {
+         DISCRETE << "Hardware counters:\t\t\tunavailable\n";
+         return;
+      }
+      DISCRETE << "Hardware counters:\n";
+      DISCRETE << std::left << std::setw(16) << "phase" << std::right << std::setw(10) << "calls";
+      for (size_t event_index: Range(number_hardware_events)) {
+         DISCRETE << std::setw(16) << event_names[event_index];
+      }
+      DISCRETE << std::setw(8) << "IPC" << '\n';
+      for (size_t phase_index: Range(number_solver_phases)) {
+         const PhaseCounters& counters = this->phases[phase_index];
+         DISCRETE << std::left << std::setw(16) << phase_names[phase_index] << std::right << std::setw(10) << counters.number_calls;
+         for (size_t event_index: Range(number_hardware_events)) {
+            if (this->available_events[event_index]) {
+               DISCRETE << std::setw(16) << counters.events[event_index];
+            }
+            else {
+               DISCRETE << std::setw(16) << "n/a";
+            }
+         }
+         // instructions per cycle
+         if (this->available_events[0] && this->available_events[1] && 0 < counters.events[0]) {
+            DISCRETE << std::setw(8) << std::fixed << std::setprecision(2) <<
+                  static_cast<double>(counters.events[1]) / static_cast<double>(counters.events[0]) << std::defaultfloat;
+         }
+         else {
+            DISCRETE << std::setw(8) << "-";
+         }
+         DISCRETE << '\n';
+      }
+   }
+
+   PerformanceCounterScope::PerformanceCounterScope(SolverPhase phase): phase(phase), is_active(PerformanceCounters::is_enabled()) {
+      if (this->is_active) {
+         PerformanceCounters::read(this->start_values);
+      }
+   }
+
+   PerformanceCounterScope::~PerformanceCounterScope() {
+      if (this->is_active) {
+         PerformanceCounters::accumulate(this->phase, this->start_values);
+      }
+   }
+} // namespace
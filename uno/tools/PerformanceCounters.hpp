@@ -0,0 +1,67 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PERFORMANCECOUNTERS_H
+#define UNO_PERFORMANCECOUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace uno {
+   // major phases of the solver. The phases may be nested (e.g. a subproblem contains assemblies, factorizations and solves): the
+   // counters of a phase are inclusive
+   enum class SolverPhase {EVALUATION = 0, ASSEMBLY, FACTORIZATION, SOLVE, SUBPROBLEM};
+   constexpr size_t number_solver_phases = 5;
+
+   // hardware events: cycles, instructions, cache misses, branch misses
+   constexpr size_t number_hardware_events = 4;
+
+   struct PhaseCounters {
+      size_t number_calls{0};
+      std::array<uint64_t, number_hardware_events> events{}; // in the order of the hardware events
+   };
+
+   struct PerformanceCounterReport {
+      bool requested{false};
+      bool available{false};
+      std::array<bool, number_hardware_events> available_events{};
+      std::array<PhaseCounters, number_solver_phases> phases{};
+
+      void print() const;
+   };
+
+   // hardware performance counters (cycles, instructions, cache misses and branch misses) collected with perf_event_open on Linux.
+   // The counters are per thread and are closed when the thread exits. If they cannot be opened (other platform, insufficient
+   // permissions, virtual machine), the collection is disabled (Uno::solve issues a warning) and the report is marked as unavailable
+   class PerformanceCounters {
+   public:
+      // opens the counters (if needed) and resets the report. Returns false if the counters are unavailable
+      static bool enable();
+      // stops the collection and clears the report
+      static void disable();
+      [[nodiscard]] static bool is_enabled();
+      [[nodiscard]] static const PerformanceCounterReport& get_report();
+
+   private:
+      friend class PerformanceCounterScope;
+      static void read(std::array<uint64_t, number_hardware_events>& values);
+      static void accumulate(SolverPhase phase, const std::array<uint64_t, number_hardware_events>& start_values);
+   };
+
+   // RAII scope that attributes the counter increments to a solver phase (no-op when the counters are disabled)
+   class PerformanceCounterScope {
+   public:
+      explicit PerformanceCounterScope(SolverPhase phase);
+      ~PerformanceCounterScope();
+      PerformanceCounterScope(const PerformanceCounterScope&) = delete;
+      PerformanceCounterScope& operator=(const PerformanceCounterScope&) = delete;
+
+   private:
+      const SolverPhase phase;
+      const bool is_active;
+      std::array<uint64_t, number_hardware_events> start_values{};
+   };
+} // namespace
+
+#endif // UNO_PERFORMANCECOUNTERS_H
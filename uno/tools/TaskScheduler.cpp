@@ -0,0 +1,330 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "TaskScheduler.hpp"
+#include "symbolic/Range.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// the BLAS libraries that spawn their own threads are detected at link time
+#if defined(__GNUC__) && defined(__ELF__)
+#define UNO_BLAS_THREAD_CONTROL
+extern "C" {
+   void openblas_set_num_threads(int number_threads) __attribute__((weak));
+   void MKL_Set_Num_Threads(int number_threads) __attribute__((weak));
+}
+#endif
+
+namespace uno {
+   namespace {
+      struct Region {
+         const std::function<void(size_t)>* task;
+         std::atomic<size_t> number_remaining_tasks;
+         std::mutex error_mutex{};
+         std::exception_ptr error{};
+      };
+
+      struct Task {
+         Region* region;
+         size_t index;
+      };
+
+      struct TaskQueue {
+         std::mutex mutex{};
+         std::deque<Task> tasks{};
+      };
+
+      class WorkerPool {
+      public:
+         std::mutex configuration_mutex{};
+         size_t number_threads{std::max(size_t(1), size_t(std::thread::hardware_concurrency()))};
+         std::atomic<size_t> number_running_regions{0};
+         // one queue per worker thread
+         std::vector<std::unique_ptr<TaskQueue>> queues{};
+
+         ~WorkerPool() {
+            this->stop();
+         }
+
+         // the workers are started on the first parallel region
+         void start() {
+            const size_t number_workers = this->number_threads - 1;
+            this->is_stopping = false;
+            while (this->queues.size() < number_workers) {
+               this->queues.emplace_back(std::make_unique<TaskQueue>());
+            }
+            for (size_t worker_index: Range(number_workers)) {
+               this->workers.emplace_back([this, worker_index]() {
+                  this->work(worker_index);
+               });
+            }
+            this->is_started = true;
+         }
+
+         void stop() {
+            {
+               std::lock_guard<std::mutex> lock(this->sleep_mutex);
+               this->is_stopping = true;
+            }
+            this->wake_up.notify_all();
+            for (std::thread& worker: this->workers) {
+               worker.join();
+            }
+            this->workers.clear();
+            this->queues.clear();
+            this->is_started = false;
+         }
+
+         [[nodiscard]] bool started() const {
+            return this->is_started;
+         }
+
+         void push(size_t queue_index, Region& region, size_t first_index, size_t last_index) {
+            std::lock_guard<std::mutex> lock(this->queues[queue_index]->mutex);
+            for (size_t index = first_index; index < last_index; index++) {
+               this->queues[queue_index]->tasks.push_back(Task{&region, index});
+            }
+         }
+
+         void notify(size_t number_tasks) {
+            {
+               std::lock_guard<std::mutex> lock(this->sleep_mutex);
+               this->number_queued_tasks += static_cast<std::ptrdiff_t>(number_tasks);
+            }
+            this->wake_up.notify_all();
+         }
+
+         // the most recent task of the own queue (LIFO), otherwise the oldest task of another queue (FIFO)
+         bool try_get_task(size_t own_queue_index, Task& task) {
+            const size_t number_queues = this->queues.size();
+            if (own_queue_index < number_queues && this->try_pop(*this->queues[own_queue_index], task, true)) {
+               return true;
+            }
+            const size_t first_queue_index = (own_queue_index < number_queues) ? own_queue_index + 1 : 0;
+            for (size_t offset: Range(number_queues)) {
+               const size_t queue_index = (first_queue_index + offset) % number_queues;
+               if (queue_index != own_queue_index && this->try_pop(*this->queues[queue_index], task, false)) {
+                  return true;
+               }
+            }
+            return false;
+         }
+
+      private:
+         std::vector<std::thread> workers{};
+         bool is_started{false};
+         std::mutex sleep_mutex{};
+         std::condition_variable wake_up{};
+         bool is_stopping{false};
+         // may be transiently negative (a task popped before it is counted)
+         std::atomic<std::ptrdiff_t> number_queued_tasks{0};
+
+         bool try_pop(TaskQueue& queue, Task& task, bool from_back) {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+               return false;
+            }
+            if (from_back) {
+               task = queue.tasks.back();
+               queue.tasks.pop_back();
+            }
+            else {
+               task = queue.tasks.front();
+               queue.tasks.pop_front();
+            }
+            this->number_queued_tasks--;
+            return true;
+         }
+
+         void work(size_t worker_index);
+      };
+
+      WorkerPool& pool() {
+         static WorkerPool worker_pool{};
+         return worker_pool;
+      }
+
+      constexpr size_t NO_QUEUE = std::numeric_limits<size_t>::max();
+      // queue of the calling thread (worker threads only)
+      thread_local size_t own_queue_index = NO_QUEUE;
+      // number of nested tasks and external parallel constructs of the calling thread
+      thread_local size_t parallel_depth = 0;
+      // thread count last set for the backends by the calling thread (0: never set)
+      thread_local size_t current_backend_threads = 0;
+
+      void execute(const Task& task) {
+         parallel_depth++;
+         try {
+            (*task.region->task)(task.index);
+         }
+         catch (...) {
+            std::lock_guard<std::mutex> lock(task.region->error_mutex);
+            if (task.region->error == nullptr) {
+               task.region->error = std::current_exception();
+            }
+         }
+         parallel_depth--;
+         task.region->number_remaining_tasks.fetch_sub(1, std::memory_order_acq_rel);
+      }
+
+      void WorkerPool::work(size_t worker_index) {
+         own_queue_index = worker_index;
+         while (true) {
+            Task task{};
+            if (this->try_get_task(worker_index, task)) {
+               execute(task);
+            }
+            else {
+               std::unique_lock<std::mutex> lock(this->sleep_mutex);
+               this->wake_up.wait(lock, [&]() {
+                  return this->is_stopping || 0 < this->number_queued_tasks;
+               });
+               if (this->is_stopping && this->number_queued_tasks <= 0) {
+                  return;
+               }
+            }
+         }
+      }
+
+      void set_backend_threads(size_t number_threads) {
+         [[maybe_unused]] const int backend_threads = static_cast<int>(number_threads);
+#ifdef _OPENMP
+         omp_set_num_threads(backend_threads);
+#endif
+#ifdef UNO_BLAS_THREAD_CONTROL
+         if (openblas_set_num_threads != nullptr) {
+            openblas_set_num_threads(backend_threads);
+         }
+         if (MKL_Set_Num_Threads != nullptr) {
+            MKL_Set_Num_Threads(backend_threads);
+         }
+#endif
+      }
+   } // namespace
+
+   void TaskScheduler::configure(size_t number_threads) {
+      if (number_threads == 0) {
+         number_threads = std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+      }
+      WorkerPool& worker_pool = pool();
+      std::lock_guard<std::mutex> lock(worker_pool.configuration_mutex);
+      if (number_threads != worker_pool.number_threads) {
+         assert(worker_pool.number_running_regions == 0 && "TaskScheduler: the thread budget changed during a parallel region");
+         worker_pool.stop();
+         worker_pool.number_threads = number_threads;
+      }
+   }
+
+   size_t TaskScheduler::number_threads() {
+      return pool().number_threads;
+   }
+
+   bool TaskScheduler::is_in_parallel_region() {
+      return 0 < parallel_depth;
+   }
+
+   size_t TaskScheduler::backend_threads(SolverPhase phase) {
+      // the threads of a parallel region are already busy
+      if (TaskScheduler::is_in_parallel_region()) {
+         return 1;
+      }
+      switch (phase) {
+         case SolverPhase::FACTORIZATION:
+         case SolverPhase::SOLVE:
+         case SolverPhase::SUBPROBLEM:
+            return TaskScheduler::number_threads();
+         default:
+            return 1;
+      }
+   }
+
+   void TaskScheduler::run(size_t number_tasks, const std::function<void(size_t)>& task) {
+      WorkerPool& worker_pool = pool();
+      if (number_tasks <= 1 || worker_pool.number_threads <= 1) {
+         parallel_depth++;
+         try {
+            for (size_t task_index: Range(number_tasks)) {
+               task(task_index);
+            }
+         }
+         catch (...) {
+            parallel_depth--;
+            throw;
+         }
+         parallel_depth--;
+         return;
+      }
+      {
+         std::lock_guard<std::mutex> lock(worker_pool.configuration_mutex);
+         if (not worker_pool.started()) {
+            worker_pool.start();
+         }
+         worker_pool.number_running_regions++;
+      }
+      Region region{&task, {number_tasks}};
+      const size_t number_queues = worker_pool.queues.size();
+      if (own_queue_index != NO_QUEUE) {
+         // nested region: the tasks are pushed onto the own queue and stolen by the idle workers
+         worker_pool.push(own_queue_index, region, 0, number_tasks);
+      }
+      else {
+         // contiguous blocks of tasks are distributed over the workers
+         for (size_t queue_index: Range(number_queues)) {
+            worker_pool.push(queue_index, region, queue_index * number_tasks / number_queues, (queue_index + 1) * number_tasks / number_queues);
+         }
+      }
+      worker_pool.notify(number_tasks);
+
+      // the calling thread executes tasks until its region is complete
+      while (0 < region.number_remaining_tasks.load(std::memory_order_acquire)) {
+         Task pending_task{};
+         if (worker_pool.try_get_task(own_queue_index, pending_task)) {
+            execute(pending_task);
+         }
+         else {
+            std::this_thread::yield();
+         }
+      }
+      worker_pool.number_running_regions--;
+      if (region.error != nullptr) {
+         std::rethrow_exception(region.error);
+      }
+   }
+
+   ParallelRegionScope::ParallelRegionScope() {
+      parallel_depth++;
+   }
+
+   ParallelRegionScope::~ParallelRegionScope() {
+      parallel_depth--;
+   }
+
+   BackendThreadScope::BackendThreadScope(SolverPhase phase): previous_number_threads(current_backend_threads) {
+      const size_t number_threads = TaskScheduler::backend_threads(phase);
+      if (number_threads != current_backend_threads) {
+         set_backend_threads(number_threads);
+         current_backend_threads = number_threads;
+      }
+   }
+
+   BackendThreadScope::~BackendThreadScope() {
+      // the thread counts set before the first scope are unknown and not restored
+      if (this->previous_number_threads != 0 && this->previous_number_threads != current_backend_threads) {
+         set_backend_threads(this->previous_number_threads);
+         current_backend_threads = this->previous_number_threads;
+      }
+   }
+} // namespace
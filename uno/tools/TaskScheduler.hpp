@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_TASKSCHEDULER_H
+#define UNO_TASKSCHEDULER_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "PerformanceCounters.hpp"
+
+namespace uno {
+   // central scheduler that owns the thread budget of Uno: a work-stealing pool used by the parallel primitives, and the thread
+   // counts of the linear algebra backends (OpenMP, OpenBLAS, MKL). The calling thread takes part in the work. Parallel regions may
+   // be nested: a thread that waits for its tasks executes pending tasks in the meantime.
+   // The iteration ranges are split into chunks of grain_size indices that do not depend on the number of threads, and the partial
+   // reductions are combined in the order of the chunks: the results are deterministic
+   class TaskScheduler {
+   public:
+      // sets the thread budget (0: number of hardware threads). Must not be called while a parallel region is running
+      static void configure(size_t number_threads);
+      [[nodiscard]] static size_t number_threads();
+      // true if the calling thread executes a task or an instance of a batch (the backends are then sequential)
+      [[nodiscard]] static bool is_in_parallel_region();
+      // number of threads granted to the linear algebra backends during a solver phase
+      [[nodiscard]] static size_t backend_threads(SolverPhase phase);
+
+      // function(index) for all indices in [begin, end)
+      template <typename Function>
+      static void parallel_for(size_t begin, size_t end, size_t grain_size, const Function& function);
+      // combine(... combine(combine(identity, map(begin)), map(begin + 1)) ..., map(end - 1)), with the partial results of the chunks
+      // combined in order
+      template <typename ResultType, typename Map, typename Combine>
+      [[nodiscard]] static ResultType parallel_reduce(size_t begin, size_t end, size_t grain_size, ResultType identity, const Map& map,
+            const Combine& combine);
+
+   private:
+      // executes task(0), ..., task(number_tasks - 1) in parallel and waits for their completion. Rethrows the first exception
+      static void run(size_t number_tasks, const std::function<void(size_t)>& task);
+   };
+
+   // RAII scope that marks the calling thread as part of an external parallel construct (e.g. a lane of a batched solve)
+   class ParallelRegionScope {
+   public:
+      ParallelRegionScope();
+      ~ParallelRegionScope();
+      ParallelRegionScope(const ParallelRegionScope&) = delete;
+      ParallelRegionScope& operator=(const ParallelRegionScope&) = delete;
+   };
+
+   // RAII scope that sets the thread counts of the linear algebra backends for a solver phase and restores them on exit
+   class BackendThreadScope {
+   public:
+      explicit BackendThreadScope(SolverPhase phase);
+      ~BackendThreadScope();
+      BackendThreadScope(const BackendThreadScope&) = delete;
+      BackendThreadScope& operator=(const BackendThreadScope&) = delete;
+
+   private:
+      const size_t previous_number_threads;
+   };
+
+   template <typename Function>
+   void TaskScheduler::parallel_for(size_t begin, size_t end, size_t grain_size, const Function& function) {
+      if (end <= begin) {
+         return;
+      }
+      const size_t chunk_size = (grain_size == 0) ? 1 : grain_size;
+      const size_t number_chunks = (end - begin + chunk_size - 1) / chunk_size;
+      TaskScheduler::run(number_chunks, [&](size_t chunk_index) {
+         const size_t chunk_begin = begin + chunk_index * chunk_size;
+         const size_t chunk_end = (end - chunk_begin < chunk_size) ? end : chunk_begin + chunk_size;
+         for (size_t index = chunk_begin; index < chunk_end; index++) {
+            function(index);
+         }
+      });
+   }
+
+   template <typename ResultType, typename Map, typename Combine>
+   ResultType TaskScheduler::parallel_reduce(size_t begin, size_t end, size_t grain_size, ResultType identity, const Map& map,
+         const Combine& combine) {
+      if (end <= begin) {
+         return identity;
+      }
+      const size_t chunk_size = (grain_size == 0) ? 1 : grain_size;
+      const size_t number_chunks = (end - begin + chunk_size - 1) / chunk_size;
+      std::vector<ResultType> partial_results(number_chunks, identity);
+      TaskScheduler::run(number_chunks, [&](size_t chunk_index) {
+         const size_t chunk_begin = begin + chunk_index * chunk_size;
+         const size_t chunk_end = (end - chunk_begin < chunk_size) ? end : chunk_begin + chunk_size;
+         ResultType partial_result = identity;
+         for (size_t index = chunk_begin; index < chunk_end; index++) {
+            partial_result = combine(partial_result, map(index));
+         }
+         partial_results[chunk_index] = partial_result;
+      });
+      ResultType result = identity;
+      for (const ResultType& partial_result: partial_results) {
+         result = combine(result, partial_result);
+      }
+      return result;
+   }
+} // namespace
+
+#endif // UNO_TASKSCHEDULER_H
@@ -1,17 +1,124 @@
 // Copyright (c) 2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <cmath>
 #include <gtest/gtest.h>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/hessian_models/ExactHessian.hpp"
 #include "ingredients/subproblem_solvers/HiGHS/HiGHSSolver.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/synthetic/SyntheticModel.hpp"
 #include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
+#include "options/DefaultOptions.hpp"
 #include "options/Options.hpp"
+#include "symbolic/Range.hpp"
 #include "tools/Infinity.hpp"
+#include "tools/Statistics.hpp"
 
 using namespace uno;
 
+// min 1/2 (x_0^2 + x_1^2) + h x_0 x_1 s.t. x_0 + x_1 >= 1. The Hessian [1 h; h 1] has a positive diagonal and is indefinite for |h| > 1
+class QuadraticModel: public SyntheticModel {
+public:
+   explicit QuadraticModel(double off_diagonal_entry): SyntheticModel("quadratic", 2, 1), off_diagonal_entry(off_diagonal_entry) {
+      this->constraint_lower_bounds[0] = 1.;
+      this->constraint_type[0] = LINEAR;
+      this->partition_variables_and_constraints();
+   }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      return 0.5 * (x[0] * x[0] + x[1] * x[1]) + this->off_diagonal_entry * x[0] * x[1];
+   }
+
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, x[0] + this->off_diagonal_entry * x[1]);
+      gradient.insert(1, x[1] + this->off_diagonal_entry * x[0]);
+   }
+
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] + x[1];
+   }
+
+   void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 1.);
+      gradient.insert(1, 1.);
+   }
+
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      hessian.reset();
+      hessian.insert(objective_multiplier, 0, 0);
+      hessian.finalize_column(0);
+      hessian.insert(objective_multiplier * this->off_diagonal_entry, 0, 1);
+      hessian.insert(objective_multiplier, 1, 1);
+      hessian.finalize_column(1);
+   }
+
+   void initial_primal_point(Vector<double>& x) const override {
+      x[0] = x[1] = 0.;
+   }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 3; }
+
+protected:
+   const double off_diagonal_entry;
+};
+
+// solves the QP subproblem at x = 0 within a trust region of radius 10
+Direction solve_QP(double off_diagonal_entry, size_t& number_convexifications) {
+   const QuadraticModel model(off_diagonal_entry);
+   const OptimalityProblem problem(model);
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers());
+   options["globalization_mechanism"] = "TR";
+   Statistics statistics(options);
+   HiGHSSolver highs_solver(problem.number_variables, problem.number_constraints, problem.number_objective_gradient_nonzeros(),
+         problem.number_jacobian_nonzeros(), problem.number_hessian_nonzeros(), options);
+
+   Iterate current_iterate(problem.number_variables, problem.number_constraints);
+   model.initial_primal_point(current_iterate.primals);
+   const Vector<double> multipliers(problem.number_constraints, 0.);
+   const Vector<double> initial_point(problem.number_variables, 0.);
+   Direction direction(problem.number_variables, problem.number_constraints);
+   ExactHessian hessian_model;
+   const WarmstartInformation warmstart_information{};
+   highs_solver.solve_QP(statistics, problem, current_iterate, multipliers, initial_point, direction, hessian_model, 10.,
+         warmstart_information);
+   number_convexifications = highs_solver.get_number_convexifications();
+   return direction;
+}
+
+TEST(HiGHSSolver, ConvexQP) {
+   size_t number_convexifications = 0;
+   const Direction direction = solve_QP(0.5, number_convexifications);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_EQ(number_convexifications, 0);
+   // the minimum lies on the constraint: d = (1/2, 1/2)
+   const double tolerance = 1e-6;
+   EXPECT_NEAR(direction.primals[0], 0.5, tolerance);
+   EXPECT_NEAR(direction.primals[1], 0.5, tolerance);
+}
+
+// the diagonal is positive, but the Hessian is indefinite: it is convexified before being passed to HiGHS
+TEST(HiGHSSolver, NonconvexQP) {
+   size_t number_convexifications = 0;
+   const Direction direction = solve_QP(2., number_convexifications);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_EQ(number_convexifications, 1);
+   // the step is feasible and lies within the trust region
+   const double tolerance = 1e-6;
+   EXPECT_LE(1. - tolerance, direction.primals[0] + direction.primals[1]);
+   for (size_t variable_index: Range(2)) {
+      EXPECT_LE(std::abs(direction.primals[variable_index]), 10. + tolerance);
+   }
+}
+
 /*
 TEST(HiGHSSolver, LP) {
    // https://ergo-code.github.io/HiGHS/stable/interfaces/cpp/library/
@@ -0,0 +1,170 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "ingredients/subproblem_solvers/SPRAL/SPRALSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace uno;
+
+TEST(SPRALSolver, SystemSize5) {
+   const double tolerance = 1e-8;
+
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   SPRALSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+}
+
+TEST(SPRALSolver, Inertia) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+
+   SPRALSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 3);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+}
+
+TEST(SPRALSolver, SingularMatrix) {
+   const size_t n = 4;
+   const size_t nnz = 7;
+   // comes from hs015 solved with byrd preset
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert( -0.0198, 0, 0);
+   matrix.insert(0.625075, 0, 0);
+   matrix.insert(-0.277512, 0, 1);
+   matrix.insert(-0.624975, 1, 1);
+   matrix.insert(0.625075, 1, 1);
+   matrix.insert(0., 2, 2);
+   matrix.insert(0., 3, 3);
+   SPRALSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   // expected inertia (1, 1, 2)
+   ASSERT_TRUE(solver.matrix_is_singular());
+}
+
+TEST(SPRALSolver, ReusedSymbolicAnalysis) {
+   const double tolerance = 1e-8;
+
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+
+   SPRALSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   // same sparsity pattern, doubled entries: the solution is halved
+   matrix.reset();
+   matrix.insert(4., 0, 0);
+   matrix.insert(6., 0, 1);
+   matrix.insert(8., 1, 2);
+   matrix.insert(12., 1, 4);
+   matrix.insert(2., 2, 2);
+   matrix.insert(10., 2, 3);
+   matrix.insert(2., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{0.5, 1., 1.5, 2., 2.5};
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+}
+
+TEST(SPRALSolver, DuplicateAndLowerTriangularEntries) {
+   const double tolerance = 1e-8;
+
+   // same matrix as in SystemSize5: some entries are split into duplicates or stored in the lower triangle
+   const size_t n = 5;
+   const size_t nnz = 9;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(1., 0, 0);
+   matrix.insert(3., 1, 0);
+   matrix.insert(4., 2, 1);
+   matrix.insert(1., 0, 0);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(2., 3, 2);
+   matrix.insert(3., 2, 3);
+   matrix.insert(1., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   SPRALSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+   // the inertia computed by the factorization survives the solve
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 3);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+}
+
+// SSIDS requires OMP_CANCELLATION=TRUE and OMP_PROC_BIND=TRUE: the construction fails otherwise
+TEST(SPRALSolver, OpenMPEnvironment) {
+#ifdef _OPENMP
+   if (omp_get_cancellation() != 0 && omp_get_proc_bind() != omp_proc_bind_false) {
+      EXPECT_NO_THROW(SPRALSolver(5, 7));
+   }
+   else {
+      EXPECT_THROW(SPRALSolver(5, 7), std::runtime_error);
+   }
+#endif
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "model/ModelFactory.hpp"
+#include "model/synthetic/ChainedRosenbrockModel.hpp"
+#include "model/synthetic/OptimalControlModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/Logger.hpp"
+#include "tools/UserCallbacks.hpp"
+
+using namespace uno;
+
+// optimal control model that records the concurrent evaluations and the evaluations on a background thread
+class MonitoredModel: public OptimalControlModel {
+public:
+   MonitoredModel(size_t number_time_steps, bool is_thread_safe): OptimalControlModel(number_time_steps), thread_safe(is_thread_safe) { }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      const Evaluation evaluation(*this);
+      return OptimalControlModel::evaluate_objective(x);
+   }
+
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      const Evaluation evaluation(*this);
+      OptimalControlModel::evaluate_objective_gradient(x, gradient);
+   }
+
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      const Evaluation evaluation(*this);
+      OptimalControlModel::evaluate_constraints(x, constraints);
+   }
+
+   void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      const Evaluation evaluation(*this);
+      OptimalControlModel::evaluate_constraint_jacobian(x, constraint_jacobian);
+   }
+
+   [[nodiscard]] bool is_thread_safe() const override {
+      return this->thread_safe;
+   }
+
+   mutable std::atomic<size_t> running_evaluations{0};
+   mutable std::atomic<bool> has_concurrent_evaluations{false};
+   mutable std::atomic<bool> has_background_evaluations{false};
+
+protected:
+   const bool thread_safe;
+   const std::thread::id main_thread{std::this_thread::get_id()};
+
+   // the evaluation is running during the lifetime of the object. The background evaluations are slow, which leaves time for the
+   // main thread to evaluate the model or to notify the user
+   class Evaluation {
+   public:
+      explicit Evaluation(const MonitoredModel& model): model(model) {
+         if (0 < this->model.running_evaluations++) {
+            this->model.has_concurrent_evaluations = true;
+         }
+         const bool is_background_evaluation = (std::this_thread::get_id() != this->model.main_thread);
+         if (is_background_evaluation) {
+            this->model.has_background_evaluations = true;
+         }
+         std::this_thread::sleep_for(std::chrono::microseconds(is_background_evaluation ? 2000 : 100));
+      }
+      ~Evaluation() {
+         this->model.running_evaluations--;
+      }
+
+   protected:
+      const MonitoredModel& model;
+   };
+};
+
+// callbacks that record whether the user is notified while the model is evaluated
+class MonitoringCallbacks: public UserCallbacks {
+public:
+   explicit MonitoringCallbacks(const MonitoredModel& model): UserCallbacks(), model(model) { }
+
+   void notify_acceptable_iterate(const Vector<double>& /*primals*/, const Multipliers& /*multipliers*/, double /*objective_multiplier*/) override {
+      this->check_evaluations();
+      this->number_acceptable_iterates++;
+   }
+   void notify_new_primals(const Vector<double>& /*primals*/) override { this->check_evaluations(); }
+   void notify_new_multipliers(const Multipliers& /*multipliers*/) override { this->check_evaluations(); }
+
+   size_t number_acceptable_iterates{0};
+   bool is_notified_during_evaluation{false};
+
+protected:
+   const MonitoredModel& model;
+
+   void check_evaluations() {
+      if (0 < this->model.running_evaluations) {
+         this->is_notified_during_evaluation = true;
+      }
+   }
+};
+
+// chained Rosenbrock model that counts the evaluations of the objective and its gradient
+class CountingModel: public ChainedRosenbrockModel {
+public:
+   explicit CountingModel(size_t number_variables): ChainedRosenbrockModel(number_variables) { }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      this->objective_evaluations++;
+      return ChainedRosenbrockModel::evaluate_objective(x);
+   }
+
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      this->objective_gradient_evaluations++;
+      ChainedRosenbrockModel::evaluate_objective_gradient(x, gradient);
+   }
+
+   mutable size_t objective_evaluations{0};
+   mutable size_t objective_gradient_evaluations{0};
+};
+
+// callbacks that record the evaluations of the model at the end of each outer iteration
+class EvaluationRecordingCallbacks: public UserCallbacks {
+public:
+   explicit EvaluationRecordingCallbacks(const CountingModel& model): UserCallbacks(), model(model) { }
+
+   void notify_acceptable_iterate(const Vector<double>& /*primals*/, const Multipliers& /*multipliers*/, double /*objective_multiplier*/) override { }
+   void notify_new_primals(const Vector<double>& /*primals*/) override {
+      this->evaluations.emplace_back(this->model.objective_evaluations, this->model.objective_gradient_evaluations);
+   }
+   void notify_new_multipliers(const Multipliers& /*multipliers*/) override { }
+
+   std::vector<std::pair<size_t, size_t>> evaluations{};
+
+protected:
+   const CountingModel& model;
+};
+
+Result solve(const Model& model, UserCallbacks& user_callbacks, Options& options) {
+   const Level logger_level = Logger::level;
+   Logger::level = SILENT;
+   Iterate initial_iterate(model.number_variables, model.number_constraints);
+   model.initial_primal_point(initial_iterate.primals);
+   model.project_onto_variable_bounds(initial_iterate.primals);
+   model.initial_dual_point(initial_iterate.multipliers.constraints);
+   initial_iterate.feasibility_multipliers.reset();
+
+   auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(model, options);
+   auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+   Uno uno = Uno(*globalization_mechanism, options);
+   Result result = uno.solve(model, initial_iterate, options, user_callbacks);
+   Logger::level = logger_level;
+   return result;
+}
+
+Options line_search_options(bool prefetch_derivatives) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers());
+   Presets::set(options, "ipopt");
+   options["LS_prefetch_derivatives"] = prefetch_derivatives ? "yes" : "no";
+   return options;
+}
+
+TEST(BacktrackingLineSearch, NoPrefetchWithThreadUnsafeModel) {
+   Options options = line_search_options(true);
+   auto monitored_model = std::make_unique<MonitoredModel>(20, false);
+   const MonitoredModel& model = *monitored_model;
+   const std::unique_ptr<Model> reformulated_model = ModelFactory::reformulate(std::move(monitored_model), options);
+   MonitoringCallbacks user_callbacks(model);
+   const Result result = solve(*reformulated_model, user_callbacks, options);
+
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_FALSE(model.has_background_evaluations);
+   ASSERT_FALSE(model.has_concurrent_evaluations);
+}
+
+TEST(BacktrackingLineSearch, PrefetchWithThreadSafeModel) {
+   Options options = line_search_options(true);
+   auto monitored_model = std::make_unique<MonitoredModel>(20, true);
+   const MonitoredModel& model = *monitored_model;
+   const std::unique_ptr<Model> reformulated_model = ModelFactory::reformulate(std::move(monitored_model), options);
+   MonitoringCallbacks user_callbacks(model);
+   const Result result = solve(*reformulated_model, user_callbacks, options);
+
+   // same iterates as without prefetching
+   Options reference_options = line_search_options(false);
+   const std::unique_ptr<Model> reference_model = ModelFactory::reformulate(std::make_unique<MonitoredModel>(20, true), reference_options);
+   NoUserCallbacks no_user_callbacks{};
+   const Result reference_result = solve(*reference_model, no_user_callbacks, reference_options);
+
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_EQ(result.iteration, reference_result.iteration);
+   for (size_t variable_index: Range(model.number_variables)) {
+      EXPECT_DOUBLE_EQ(result.solution.primals[variable_index], reference_result.solution.primals[variable_index]);
+   }
+   ASSERT_TRUE(model.has_background_evaluations);
+   // the user is notified once the background evaluations are over
+   ASSERT_LT(0, user_callbacks.number_acceptable_iterates);
+   ASSERT_FALSE(user_callbacks.is_notified_during_evaluation);
+}
+
+// the tolerance cannot be reached: the interior-point method ends up taking tiny steps, which are taken without evaluating the
+// functions. A tiny step after a tiny step terminates with a small step
+TEST(BacktrackingLineSearch, RepeatedTinySteps) {
+   Options options = line_search_options(false);
+   options["tolerance"] = "1e-16";
+   auto counting_model = std::make_unique<CountingModel>(20);
+   const CountingModel& model = *counting_model;
+   const std::unique_ptr<Model> reformulated_model = ModelFactory::reformulate(std::move(counting_model), options);
+   EvaluationRecordingCallbacks user_callbacks(model);
+   const Result result = solve(*reformulated_model, user_callbacks, options);
+
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_SMALL_STEP);
+   ASSERT_LT(result.iteration, options.get_unsigned_int("max_iterations"));
+   // the last two iterations are tiny steps: the objective and its gradient are not evaluated
+   const std::vector<std::pair<size_t, size_t>>& evaluations = user_callbacks.evaluations;
+   ASSERT_EQ(evaluations.size(), result.iteration);
+   ASSERT_LE(3, evaluations.size());
+   const size_t last = evaluations.size() - 1;
+   ASSERT_EQ(evaluations[last], evaluations[last - 2]);
+   // the earlier iterations evaluate the functions
+   ASSERT_LT(evaluations[0].first, evaluations[last - 2].first);
+   ASSERT_LT(evaluations[0].second, evaluations[last - 2].second);
+}
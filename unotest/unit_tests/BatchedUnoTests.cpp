@@ -0,0 +1,123 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include "BatchedUno.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/subproblem_solvers/BatchedLDLSolver.hpp"
+#include "ingredients/subproblem_solvers/QuasidefiniteLDLSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/ModelFactory.hpp"
+#include "model/synthetic/SyntheticModelFactory.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/Logger.hpp"
+
+using namespace uno;
+
+// quasidefinite augmented matrix [H J^T; J -delta I] whose values depend on the lane
+void fill_augmented_matrix(SymmetricMatrix<size_t, double>& matrix, size_t lane) {
+   const double scaling = 1. + static_cast<double>(lane);
+   matrix.insert(4. * scaling, 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(3. * scaling, 1, 1);
+   matrix.insert(2., 2, 2);
+   matrix.insert(scaling, 0, 3);
+   matrix.insert(1., 1, 3);
+   matrix.insert(-1., 2, 4);
+   matrix.insert(scaling, 1, 4);
+   matrix.insert(-1e-2, 3, 3);
+   matrix.insert(-1e-2, 4, 4);
+}
+
+TEST(BatchedLDLSolver, LockstepFactorizations) {
+   const size_t number_lanes = 3;
+   const Vector<double> rhs{1., 2., 3., 4., 5.};
+   FactorizationBatch batch(number_lanes);
+   std::vector<Vector<double>> solutions(number_lanes, Vector<double>(5));
+   std::vector<std::thread> threads{};
+   for (size_t lane: Range(number_lanes)) {
+      threads.emplace_back([&, lane]() {
+         FactorizationBatch::Membership membership(batch, lane);
+         SymmetricMatrix<size_t, double> matrix(5, 10, false, "COO");
+         fill_augmented_matrix(matrix, lane);
+         auto solver = FactorizationBatch::create_solver(5, 10);
+         solver->do_symbolic_analysis(matrix);
+         solver->do_numerical_factorization(matrix);
+         // the first lane factorizes once more, after the other lanes left the batch
+         if (lane == 0) {
+            solver->do_numerical_factorization(matrix);
+         }
+         solver->solve_indefinite_system(matrix, rhs, solutions[lane]);
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   ASSERT_LE(batch.number_batched_factorizations(), 2 * number_lanes);
+
+   // same results as the sequential factorization
+   for (size_t lane: Range(number_lanes)) {
+      SymmetricMatrix<size_t, double> matrix(5, 10, false, "COO");
+      fill_augmented_matrix(matrix, lane);
+      QuasidefiniteLDLSolver solver(5, 10);
+      solver.do_symbolic_analysis(matrix);
+      solver.do_numerical_factorization(matrix);
+      Vector<double> reference(5);
+      solver.solve_indefinite_system(matrix, rhs, reference);
+      for (size_t index: Range(5)) {
+         EXPECT_DOUBLE_EQ(solutions[lane][index], reference[index]);
+      }
+   }
+}
+
+TEST(BatchedUno, SameResultsAsIndependentSolves) {
+   const Level logger_level = Logger::level;
+   Logger::level = SILENT;
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers());
+   Presets::set(options, "ipopt");
+   options["batch_size"] = "3";
+
+   // four instances (two batches) that differ by their initial points
+   const size_t number_instances = 4;
+   const std::unique_ptr<Model> reformulated_model = ModelFactory::reformulate(SyntheticModelFactory::create("optimal_control", 10), options);
+   const Model& model = *reformulated_model;
+   std::vector<const Model*> models(number_instances, &model);
+   std::vector<Iterate> initial_iterates{};
+   for (size_t instance_index: Range(number_instances)) {
+      Iterate& initial_iterate = initial_iterates.emplace_back(model.number_variables, model.number_constraints);
+      model.initial_primal_point(initial_iterate.primals);
+      initial_iterate.primals[0] += 0.1 * static_cast<double>(instance_index);
+      model.project_onto_variable_bounds(initial_iterate.primals);
+      model.initial_dual_point(initial_iterate.multipliers.constraints);
+      initial_iterate.feasibility_multipliers.reset();
+   }
+   std::vector<Iterate> independent_iterates = initial_iterates;
+
+   BatchedUno batched_uno(options);
+   const std::vector<Result> batched_results = batched_uno.solve(models, initial_iterates, options);
+   for (size_t instance_index: Range(number_instances)) {
+      auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(model, options);
+      auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+      Uno uno = Uno(*globalization_mechanism, options);
+      const Result result = uno.solve(model, independent_iterates[instance_index], options);
+
+      const Result& batched_result = batched_results[instance_index];
+      ASSERT_EQ(batched_result.optimization_status, OptimizationStatus::SUCCESS);
+      ASSERT_EQ(batched_result.iteration, result.iteration);
+      for (size_t variable_index: Range(model.number_variables)) {
+         EXPECT_DOUBLE_EQ(batched_result.solution.primals[variable_index], result.solution.primals[variable_index]);
+      }
+   }
+   ASSERT_LT(0, batched_uno.number_batched_factorizations());
+   Logger::level = logger_level;
+}
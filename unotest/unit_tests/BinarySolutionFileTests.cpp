@@ -0,0 +1,41 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "optimization/BinarySolutionFile.hpp"
+#include "optimization/Result.hpp"
+
+using namespace uno;
+
+TEST(BinarySolutionFile, WriteAndRead) {
+   const size_t number_variables = 3;
+   const size_t number_constraints = 2;
+   Iterate solution(number_variables, number_constraints);
+   solution.primals = {1., -2., 3.5};
+   solution.multipliers.constraints = {0.25, -4.};
+   solution.multipliers.lower_bounds = {0.5, 0., 0.};
+   solution.multipliers.upper_bounds = {0., 0., -1e-3};
+   solution.evaluations.objective = 42.;
+   solution.status = IterateStatus::FEASIBLE_KKT_POINT;
+   const Result result{OptimizationStatus::SUCCESS, std::move(solution), number_variables, number_constraints, 10, 0.1, 11, 11, 11, 11, 10, 10, {}, {}};
+
+   const std::string file_name = (std::filesystem::temp_directory_path() / "uno_binary_solution_test.bin").string();
+   BinarySolutionFile::write(file_name, result);
+   const BinarySolution read_solution = BinarySolutionFile::read(file_name);
+   ASSERT_EQ(read_solution.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_EQ(read_solution.iterate_status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(read_solution.objective, 42.);
+   ASSERT_EQ(read_solution.primals, (std::vector<double>{1., -2., 3.5}));
+   ASSERT_EQ(read_solution.constraint_multipliers, (std::vector<double>{0.25, -4.}));
+   ASSERT_EQ(read_solution.lower_bound_multipliers, (std::vector<double>{0.5, 0., 0.}));
+   ASSERT_EQ(read_solution.upper_bound_multipliers, (std::vector<double>{0., 0., -1e-3}));
+
+   // truncated file
+   std::filesystem::resize_file(file_name, std::filesystem::file_size(file_name) - sizeof(double));
+   ASSERT_THROW(BinarySolutionFile::read(file_name), std::runtime_error);
+   std::remove(file_name.c_str());
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "linear_algebra/VectorPrinting.hpp"
+#include "tools/BufferedWriter.hpp"
+
+using namespace uno;
+
+TEST(BufferedWriter, SamePrecisionAsStream) {
+   const double values[] = {0., -1.5, 1. / 3., 1e-12, 123456789., -2.5e300};
+   std::ostringstream expected, written;
+   expected << std::setprecision(7);
+   {
+      BufferedWriter writer(written, 7);
+      for (double value: values) {
+         expected << value << ' ';
+         writer << value << ' ';
+      }
+      expected << size_t(42) << " end";
+      writer << size_t(42) << " end";
+   }
+   ASSERT_EQ(written.str(), expected.str());
+}
+
+TEST(BufferedWriter, ShortestRoundTrip) {
+   const double values[] = {0.1, 1. / 3., -2.718281828459045e-200};
+   std::ostringstream stream;
+   {
+      BufferedWriter writer(stream);
+      for (double value: values) {
+         writer << value << '\n';
+      }
+   }
+   ASSERT_EQ(stream.str().substr(0, 4), "0.1\n");
+   std::istringstream input(stream.str());
+   for (double value: values) {
+      std::string token;
+      input >> token;
+      ASSERT_EQ(std::strtod(token.c_str(), nullptr), value);
+   }
+}
+
+TEST(BufferedWriter, LargeOutput) {
+   std::ostringstream stream;
+   const size_t number_values = 100000;
+   {
+      BufferedWriter writer(stream);
+      for (size_t index = 0; index < number_values; index++) {
+         writer << index << ' ';
+      }
+   }
+   std::istringstream input(stream.str());
+   size_t value, number_read_values = 0;
+   while (input >> value) {
+      ASSERT_EQ(value, number_read_values);
+      number_read_values++;
+   }
+   ASSERT_EQ(number_read_values, number_values);
+}
+
+// booleans and integers are printed like std::ostream does. Temporary streams are accepted
+TEST(BufferedWriter, PrintVector) {
+   std::ostringstream stream;
+   print_vector(stream, std::vector<bool>{true, false, true});
+   print_vector(stream, std::vector<int>{-3, 0, 7});
+   ASSERT_EQ(stream.str(), "1 0 1 \n-3 0 7 \n");
+   print_vector(std::ostringstream{}, std::vector<double>{1.});
+}
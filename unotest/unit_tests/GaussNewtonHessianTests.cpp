@@ -0,0 +1,217 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <array>
+#include <string>
+#include <utility>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/constraint_relaxation_strategies/l1RelaxedProblem.hpp"
+#include "ingredients/hessian_models/ConvexifiedHessian.hpp"
+#include "ingredients/hessian_models/GaussNewtonHessian.hpp"
+#include "ingredients/hessian_models/HessianModelFactory.hpp"
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/synthetic/SyntheticModel.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+// min 1/2 [(x_0 - 1)^2 + x_1^2] s.t. x_0 x_1 = 1
+class LeastSquaresModel: public SyntheticModel {
+public:
+   LeastSquaresModel(): SyntheticModel("least_squares", 2, 1) {
+      this->constraint_lower_bounds[0] = this->constraint_upper_bounds[0] = 1.;
+      this->partition_variables_and_constraints();
+   }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      return 0.5 * ((x[0] - 1.) * (x[0] - 1.) + x[1] * x[1]);
+   }
+
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, x[0] - 1.);
+      gradient.insert(1, x[1]);
+   }
+
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] * x[1];
+   }
+
+   void evaluate_constraint_gradient(const Vector<double>& x, size_t /*constraint_index*/, SparseVector<double>& gradient) const override {
+      gradient.insert(0, x[1]);
+      gradient.insert(1, x[0]);
+   }
+
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      // the objective terms are omitted when the objective is ignored
+      hessian.reset();
+      if (objective_multiplier != 0.) {
+         hessian.insert(objective_multiplier, 0, 0);
+      }
+      hessian.finalize_column(0);
+      hessian.insert(-multipliers[0], 0, 1);
+      if (objective_multiplier != 0.) {
+         hessian.insert(objective_multiplier, 1, 1);
+      }
+      hessian.finalize_column(1);
+   }
+
+   [[nodiscard]] size_t number_residuals() const override { return 2; }
+
+   void evaluate_residuals(const Vector<double>& x, std::vector<double>& residuals) const override {
+      residuals[0] = x[0] - 1.;
+      residuals[1] = x[1];
+   }
+
+   void evaluate_residual_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& residual_jacobian) const override {
+      residual_jacobian[0].insert(0, 1.);
+      residual_jacobian[1].insert(1, 1.);
+   }
+
+   void initial_primal_point(Vector<double>& x) const override {
+      x[0] = x[1] = 1.;
+   }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 3; }
+};
+
+// dense upper triangular part of the Hessian (x_0, x_1) = (1, 1) and constraint multiplier 3: J_r^T J_r = I and the constraint
+// curvature is -3 on the off-diagonal entry. The matrix [1 -3; -3 1] is indefinite
+std::array<double, 3> evaluate_hessian(HessianModel& hessian_model, SymmetricMatrix<size_t, double>& hessian) {
+   const LeastSquaresModel model;
+   const OptimalityProblem problem(model);
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   hessian_model.initialize_statistics(statistics, options);
+   Vector<double> x(2);
+   model.initial_primal_point(x);
+   const Vector<double> multipliers{3.};
+   hessian_model.evaluate(statistics, problem, x, multipliers, hessian);
+
+   std::array<double, 3> entries{0., 0., 0.}; // (0, 0), (0, 1), (1, 1)
+   for (const auto [row_index, column_index, entry]: hessian) {
+      entries[row_index + column_index] += entry;
+   }
+   return entries;
+}
+
+TEST(GaussNewtonHessian, Assembly) {
+   GaussNewtonHessian hessian_model(2, 3);
+   SymmetricMatrix<size_t, double> hessian(2, 3, false, "COO");
+   const auto [diagonal_entry0, off_diagonal_entry, diagonal_entry1] = evaluate_hessian(hessian_model, hessian);
+   EXPECT_DOUBLE_EQ(diagonal_entry0, 1.);
+   EXPECT_DOUBLE_EQ(off_diagonal_entry, -3.);
+   EXPECT_DOUBLE_EQ(diagonal_entry1, 1.);
+   ASSERT_EQ(hessian_model.evaluation_count, 1);
+}
+
+TEST(GaussNewtonHessian, ConvexifiedConstraintCurvature) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers());
+   const auto hessian_model = HessianModelFactory::create("gauss_newton", 2, 3, true, options);
+   SymmetricMatrix<size_t, double> hessian(2, 3, true, "COO");
+   const auto [diagonal_entry0, off_diagonal_entry, diagonal_entry1] = evaluate_hessian(*hessian_model, hessian);
+   // the regularization is added to the diagonal only
+   EXPECT_DOUBLE_EQ(off_diagonal_entry, -3.);
+   EXPECT_DOUBLE_EQ(diagonal_entry0, diagonal_entry1);
+   // positive definite
+   ASSERT_LT(0., diagonal_entry0);
+   ASSERT_LT(0., diagonal_entry0 * diagonal_entry1 - off_diagonal_entry * off_diagonal_entry);
+   ASSERT_EQ(hessian_model->evaluation_count, 1);
+}
+
+TEST(GaussNewtonHessian, CholeskyConvexification) {
+   Options options = DefaultOptions::load();
+   options["convexification_method"] = "cholesky";
+   const auto hessian_model = HessianModelFactory::create("gauss_newton", 2, 3, true, options);
+   SymmetricMatrix<size_t, double> hessian(2, 3, true, "COO");
+   const auto [diagonal_entry0, off_diagonal_entry, diagonal_entry1] = evaluate_hessian(*hessian_model, hessian);
+   EXPECT_DOUBLE_EQ(off_diagonal_entry, -3.);
+   ASSERT_LT(0., diagonal_entry0 * diagonal_entry1 - off_diagonal_entry * off_diagonal_entry);
+}
+
+// the smallest eigenvalue is -2: the Gershgorin regularization factor 2 + 1e-4 is sufficient. The increased regularization factors
+// (1e-4 * 2^k) exceed the failure threshold before they are clamped to the Gershgorin factor
+TEST(GaussNewtonHessian, ConvexificationBelowFailureThreshold) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers());
+   options["regularization_failure_threshold"] = "2.5";
+   const auto hessian_model = HessianModelFactory::create("gauss_newton", 2, 3, true, options);
+   SymmetricMatrix<size_t, double> hessian(2, 3, true, "COO");
+   const auto [diagonal_entry0, off_diagonal_entry, diagonal_entry1] = evaluate_hessian(*hessian_model, hessian);
+   EXPECT_DOUBLE_EQ(diagonal_entry0, 1. + 2. + 1e-4);
+   EXPECT_DOUBLE_EQ(diagonal_entry1, 1. + 2. + 1e-4);
+   EXPECT_DOUBLE_EQ(off_diagonal_entry, -3.);
+}
+
+// [1 -m; -m 1] has a positive diagonal for any constraint multiplier m, but is indefinite for m = 3, positive semidefinite (singular) for
+// m = 1 and positive definite for m = 0.5
+TEST(GaussNewtonHessian, ConvexityTest) {
+   const LeastSquaresModel model;
+   const OptimalityProblem problem(model);
+   Vector<double> x(2);
+   model.initial_primal_point(x);
+   for (const std::string convexification_method: {"inertia", "cholesky"}) {
+      Options options = DefaultOptions::load();
+      options.overwrite_with(DefaultOptions::determine_solvers());
+      options["convexification_method"] = convexification_method;
+      Statistics statistics(options);
+      GaussNewtonHessian hessian_model(2, 3);
+      ConvexifiedHessian convexified_hessian(2, 3 + 2, options);
+      SymmetricMatrix<size_t, double> hessian(2, 3, true, "COO");
+      for (const auto& [multiplier, is_convex]: std::vector<std::pair<double, bool>>{{3., false}, {1., true}, {0.5, true}}) {
+         const Vector<double> multipliers{multiplier};
+         hessian_model.evaluate(statistics, problem, x, multipliers, hessian);
+         EXPECT_EQ(convexified_hessian.is_convex(problem, hessian), is_convex) << convexification_method << ", m = " << multiplier;
+      }
+   }
+}
+
+// when the objective is ignored (e.g. the feasibility problem of the l1 relaxation), J_r^T J_r contributes structural zeros: the
+// sparsity pattern is unchanged
+TEST(GaussNewtonHessian, PatternIndependentOfObjectiveMultiplier) {
+   const LeastSquaresModel model;
+   l1RelaxedProblem problem(model, 1., 1., 0., nullptr);
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   GaussNewtonHessian hessian_model(problem.number_variables, 3);
+   SymmetricMatrix<size_t, double> hessian(problem.number_variables, 3, false, "COO");
+   Vector<double> x(problem.number_variables, 0.);
+   model.initial_primal_point(x);
+   const Vector<double> multipliers{3.};
+
+   const auto pattern = [&]() {
+      std::vector<std::tuple<size_t, size_t, double>> entries{};
+      for (const auto [row_index, column_index, entry]: hessian) {
+         entries.emplace_back(row_index, column_index, entry);
+      }
+      return entries;
+   };
+   hessian_model.evaluate(statistics, problem, x, multipliers, hessian);
+   const auto entries = pattern();
+   problem.set_objective_multiplier(0.);
+   hessian_model.evaluate(statistics, problem, x, multipliers, hessian);
+   const auto feasibility_entries = pattern();
+
+   ASSERT_EQ(entries.size(), 3);
+   ASSERT_EQ(feasibility_entries.size(), entries.size());
+   for (size_t index: Range(entries.size())) {
+      ASSERT_EQ(std::get<0>(feasibility_entries[index]), std::get<0>(entries[index]));
+      ASSERT_EQ(std::get<1>(feasibility_entries[index]), std::get<1>(entries[index]));
+   }
+   // only the constraint curvature remains
+   EXPECT_DOUBLE_EQ(std::get<2>(feasibility_entries[0]), 0.);
+   EXPECT_DOUBLE_EQ(std::get<2>(feasibility_entries[1]), -3.);
+   EXPECT_DOUBLE_EQ(std::get<2>(feasibility_entries[2]), 0.);
+   ASSERT_EQ(hessian_model.evaluation_count, 2);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/HugePageAllocator.hpp"
+
+using namespace uno;
+
+TEST(HugePageAllocator, CacheLineAlignment) {
+   HugePages::set_policy("none");
+   const HugePageVector<double> vector(100, 1.);
+   ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vector.data()) % HugePages::alignment, 0);
+   ASSERT_EQ(HugePages::get_report().number_large_buffers, 0);
+}
+
+// the large buffers are aligned on huge pages (Linux only), whether or not the system backs them with huge pages
+TEST(HugePageAllocator, LargeBuffer) {
+   HugePages::set_policy("transparent");
+   const size_t number_elements = 3 * HugePages::huge_page_size / sizeof(double);
+   {
+      HugePageVector<double> vector(number_elements, 2.);
+      vector.back() = 3.;
+      ASSERT_EQ(vector.front(), 2.);
+      ASSERT_EQ(vector.back(), 3.);
+#ifdef __linux__
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vector.data()) % HugePages::huge_page_size, 0);
+      const HugePageReport report = HugePages::get_report();
+      ASSERT_EQ(report.number_large_buffers, 1);
+      ASSERT_EQ(report.large_buffer_bytes, 3 * HugePages::huge_page_size);
+      ASSERT_LE(report.backed_bytes, report.large_buffer_bytes);
+#endif
+   }
+   ASSERT_EQ(HugePages::get_report().number_large_buffers, 0);
+   HugePages::set_policy("none");
+}
+
+// huge pages are opt-in
+TEST(HugePageAllocator, DefaultPolicy) {
+   ASSERT_EQ(DefaultOptions::load().get_string("huge_pages"), "none");
+}
+
+TEST(HugePageAllocator, UnknownPolicy) {
+   ASSERT_THROW(HugePages::set_policy("gigantic"), std::invalid_argument);
+}
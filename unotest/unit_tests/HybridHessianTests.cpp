@@ -0,0 +1,239 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/hessian_models/HybridHessian.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/synthetic/SyntheticModel.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+using namespace std::chrono_literals;
+
+// clock advanced by the tests and by the evaluations of the exact Hessian
+using FakeClock = std::chrono::steady_clock::time_point;
+
+// min 1/2 [(x_0 - 1)^2 + x_1^2] s.t. x_0 x_1 = 1 (or x_0 + x_1 = 1), with one element for the objective and one element for the
+// constraint. The evaluation of the exact Hessian takes a given time on the fake clock. With the linear constraint, the exact Hessian
+// is diagonal: the element pattern is a strict superset of the exact pattern
+class TimedElementModel: public SyntheticModel {
+public:
+   TimedElementModel(FakeClock& clock, std::chrono::steady_clock::duration exact_hessian_cost, bool linear_constraint):
+         SyntheticModel("timed_elements", 2, 1), clock(clock), exact_hessian_cost(exact_hessian_cost), linear_constraint(linear_constraint) {
+      this->constraint_lower_bounds[0] = this->constraint_upper_bounds[0] = 1.;
+      this->partition_variables_and_constraints();
+   }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      return 0.5 * ((x[0] - 1.) * (x[0] - 1.) + x[1] * x[1]);
+   }
+
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, x[0] - 1.);
+      gradient.insert(1, x[1]);
+   }
+
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = this->linear_constraint ? x[0] + x[1] : x[0] * x[1];
+   }
+
+   void evaluate_constraint_gradient(const Vector<double>& x, size_t /*constraint_index*/, SparseVector<double>& gradient) const override {
+      gradient.insert(0, this->linear_constraint ? 1. : x[1]);
+      gradient.insert(1, this->linear_constraint ? 1. : x[0]);
+   }
+
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      this->clock += this->exact_hessian_cost;
+      hessian.reset();
+      hessian.insert(objective_multiplier, 0, 0);
+      hessian.finalize_column(0);
+      if (not this->linear_constraint) {
+         hessian.insert(-multipliers[0], 0, 1);
+      }
+      hessian.insert(objective_multiplier, 1, 1);
+      hessian.finalize_column(1);
+   }
+
+   [[nodiscard]] size_t number_elements() const override { return 2; }
+
+   void get_elements(std::vector<ElementFunction>& elements) const override {
+      elements.clear();
+      elements.emplace_back(ElementFunction{std::nullopt, {0, 1}});
+      elements.emplace_back(ElementFunction{0, {0, 1}});
+   }
+
+   void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override {
+      element_gradients[0] = x[0] - 1.;
+      element_gradients[1] = x[1];
+      element_gradients[2] = this->linear_constraint ? 1. : x[1];
+      element_gradients[3] = this->linear_constraint ? 1. : x[0];
+   }
+
+   void initial_primal_point(Vector<double>& x) const override {
+      x[0] = x[1] = 1.;
+   }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 3; }
+
+protected:
+   FakeClock& clock;
+   const std::chrono::steady_clock::duration exact_hessian_cost;
+   const bool linear_constraint;
+};
+
+// hybrid Hessian measured with the fake clock
+class TimedHybridHessian: public HybridHessian {
+public:
+   TimedHybridHessian(const FakeClock& clock, const Options& options): HybridHessian(2, 3, false, options), clock(clock) { }
+
+protected:
+   const FakeClock& clock;
+
+   [[nodiscard]] Clock::time_point current_time() const override {
+      return this->clock;
+   }
+};
+
+// sequence of Hessian evaluations: the rest of each iteration takes a given time on the fake clock
+class HybridHessianRun {
+public:
+   explicit HybridHessianRun(std::chrono::steady_clock::duration exact_hessian_cost, bool linear_constraint = false):
+         model(this->clock, exact_hessian_cost, linear_constraint), problem(this->model), options(DefaultOptions::load()), statistics(this->options),
+         hessian_model(this->clock, this->options) {
+      this->hessian_model.initialize_statistics(this->statistics, this->options);
+      this->model.initial_primal_point(this->primals);
+   }
+
+   // evaluation after the rest of an iteration of the given duration
+   void evaluate(std::chrono::steady_clock::duration iteration_time) {
+      this->clock += iteration_time;
+      this->hessian_model.evaluate(this->statistics, this->problem, this->primals, this->multipliers, this->hessian);
+   }
+
+   // iteration: step of the given norm, then evaluation
+   void iterate(double step_norm, std::chrono::steady_clock::duration iteration_time = 1s) {
+      this->primals[0] += step_norm;
+      this->evaluate(iteration_time);
+   }
+
+   FakeClock clock{};
+   TimedElementModel model;
+   const OptimalityProblem problem;
+   const Options options;
+   Statistics statistics;
+   TimedHybridHessian hessian_model;
+   SymmetricMatrix<size_t, double> hessian{2, 3, false, "COO"};
+   Vector<double> primals{0., 0.};
+   const Vector<double> multipliers{1.};
+};
+
+TEST(HybridHessian, CheapExactHessian) {
+   HybridHessianRun run(1s);
+   run.evaluate(0s);
+   for (size_t iteration = 0; iteration < 10; iteration++) {
+      run.iterate(0.5);
+   }
+   ASSERT_TRUE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian_model.number_switches(), 0);
+}
+
+TEST(HybridHessian, ExpensiveExactHessian) {
+   HybridHessianRun run(10s);
+   run.evaluate(0s);
+   // the exact Hessian is kept for the minimum number of iterations
+   run.iterate(0.5);
+   run.iterate(0.5);
+   ASSERT_TRUE(run.hessian_model.is_using_exact_hessian());
+   run.iterate(0.5);
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian_model.number_switches(), 1);
+   for (size_t iteration = 0; iteration < 10; iteration++) {
+      run.iterate(0.5);
+   }
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian_model.number_switches(), 1);
+}
+
+// the relative step tolerance is 1e-6 and the primal norm is at most 10
+TEST(HybridHessian, LocalPhaseHysteresis) {
+   HybridHessianRun run(10s);
+   run.evaluate(0s);
+   for (size_t iteration = 0; iteration < 4; iteration++) {
+      run.iterate(0.5);
+   }
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   // a single small step does not start the local phase
+   run.iterate(1e-7);
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   // two consecutive small steps do
+   run.iterate(1e-7);
+   ASSERT_TRUE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian_model.number_switches(), 2);
+   // the local phase continues with slightly larger steps
+   run.iterate(5e-6);
+   ASSERT_TRUE(run.hessian_model.is_using_exact_hessian());
+   // the local phase ends with much larger steps, and the exact Hessian is kept for the minimum number of iterations
+   run.iterate(0.5);
+   ASSERT_TRUE(run.hessian_model.is_using_exact_hessian());
+   run.iterate(0.5);
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian_model.number_switches(), 3);
+}
+
+// re-evaluations at unchanged primals (e.g. new multipliers) are neither small steps nor iterations
+TEST(HybridHessian, ReevaluationAtUnchangedPrimals) {
+   HybridHessianRun run(2s);
+   run.evaluate(0s);
+   run.iterate(0.5);
+   run.iterate(0.5);
+   run.evaluate(500ms);
+   run.evaluate(0s);
+   run.iterate(0.5, 500ms);
+   run.iterate(0.5);
+   // with an iteration time of 1s, the exact Hessian is cheaper than the quasi-Newton iterations
+   ASSERT_TRUE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian_model.number_switches(), 0);
+   // with a shorter iteration, the quasi-Newton approximation is used
+   run.iterate(0.5, 0s);
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   // the re-evaluations do not count as small steps: the local phase is not started
+   run.evaluate(0s);
+   run.evaluate(0s);
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian_model.number_switches(), 1);
+}
+
+// the exact Hessian (diagonal) and the approximation (dense) have different sparsity patterns: the switches are reported
+TEST(HybridHessian, SparsityChangeAtSwitches) {
+   HybridHessianRun run(10s, true);
+   run.evaluate(0s);
+   ASSERT_EQ(run.hessian.number_nonzeros(), 2);
+   EXPECT_FALSE(run.hessian_model.sparsity_changed);
+   run.iterate(0.5);
+   run.iterate(0.5);
+   EXPECT_FALSE(run.hessian_model.sparsity_changed);
+   // switch to the quasi-Newton approximation
+   run.iterate(0.5);
+   ASSERT_FALSE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian.number_nonzeros(), 3);
+   EXPECT_TRUE(run.hessian_model.sparsity_changed);
+   run.iterate(0.5);
+   EXPECT_FALSE(run.hessian_model.sparsity_changed);
+   // switch back to the exact Hessian in the local phase
+   run.iterate(1e-7);
+   run.iterate(1e-7);
+   ASSERT_TRUE(run.hessian_model.is_using_exact_hessian());
+   ASSERT_EQ(run.hessian.number_nonzeros(), 2);
+   EXPECT_TRUE(run.hessian_model.sparsity_changed);
+   // a re-evaluation at unchanged primals does not switch
+   run.evaluate(0s);
+   EXPECT_FALSE(run.hessian_model.sparsity_changed);
+   ASSERT_EQ(run.hessian_model.number_switches(), 2);
+}
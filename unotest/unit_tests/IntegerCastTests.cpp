@@ -0,0 +1,21 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "tools/IntegerCast.hpp"
+
+using namespace uno;
+
+TEST(IntegerCast, FitsInInteger) {
+   const size_t value = static_cast<size_t>(std::numeric_limits<int>::max());
+   ASSERT_EQ(checked_integer_cast<int>(value, "number of nonzeros"), std::numeric_limits<int>::max());
+}
+
+TEST(IntegerCast, OverflowsInteger) {
+   const size_t value = static_cast<size_t>(std::numeric_limits<int>::max()) + 1;
+   ASSERT_THROW(checked_integer_cast<int>(value, "number of nonzeros"), std::overflow_error);
+   ASSERT_EQ(checked_integer_cast<std::int64_t>(value, "number of nonzeros"), static_cast<std::int64_t>(value));
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/LSMRSolver.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+// dense 4 x 2 matrix (row major)
+const double A[4][2] = {{1., 2.}, {0., 1.}, {-1., 3.}, {2., 0.}};
+
+void product(const Vector<double>& x, Vector<double>& result) {
+   for (size_t row_index: Range(4)) {
+      result[row_index] = A[row_index][0] * x[0] + A[row_index][1] * x[1];
+   }
+}
+
+void transposed_product(const Vector<double>& u, Vector<double>& result) {
+   for (size_t column_index: Range(2)) {
+      result[column_index] = 0.;
+      for (size_t row_index: Range(4)) {
+         result[column_index] += A[row_index][column_index] * u[row_index];
+      }
+   }
+}
+
+TEST(LSMRSolver, OverdeterminedSystem) {
+   const Vector<double> b{1., -1., 2., 0.5};
+   Vector<double> x(2);
+   LSMRSolver solver(4, 2);
+   ASSERT_TRUE(solver.solve(product, transposed_product, b, x, 1e-12, 10));
+   // normal equations A^T A x = A^T b: [[6, -1], [-1, 14]] x = [0, 7]
+   const double determinant = 6. * 14. - 1.;
+   EXPECT_NEAR(x[0], 7. / determinant, 1e-10);
+   EXPECT_NEAR(x[1], 42. / determinant, 1e-10);
+   // exact arithmetic: at most 2 iterations
+   EXPECT_LE(solver.number_iterations(), 3);
+}
+
+TEST(LSMRSolver, IterationLimit) {
+   const Vector<double> b{1., -1., 2., 0.5};
+   Vector<double> x(2);
+   LSMRSolver solver(4, 2);
+   ASSERT_FALSE(solver.solve(product, transposed_product, b, x, 1e-12, 1));
+}
@@ -0,0 +1,170 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/nl/InterpretedNLEvaluator.hpp"
+#include "model/nl/NLModel.hpp"
+#include "model/nl/NLReader.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+// min sum(exp(x0) sin(x1), log(x0^2 + 1) / sqrt(x1 + 3), min(x0, x1))
+// s.t. atan2(x0, x1) + tanh(x0 x1) + x0^x1 free
+const char* operators = R"(g3 1 1 0
+ 2 1 1 0 0
+ 1 1
+ 0 0
+ 2 2 2
+ 0 0 0 1
+ 0 0 0 0 0
+ 2 2
+ 0 0
+ 0 0 0 0 0
+C0
+o0
+o48
+v0
+v1
+o0
+o37
+o2
+v0
+v1
+o5
+v0
+v1
+O0 0
+o54
+3
+o2
+o44
+v0
+o41
+v1
+o3
+o43
+o0
+o5
+v0
+n2
+n1
+o39
+o0
+v1
+n3
+o11
+2
+v0
+v1
+r
+3
+b
+3
+3
+x2
+0 0.7
+1 1.3
+J0 2
+0 0
+1 0
+G0 2
+0 0
+1 0
+)";
+
+std::unique_ptr<NLModel> create_model() {
+   std::istringstream stream(operators);
+   return std::make_unique<NLModel>(std::make_unique<InterpretedNLEvaluator>(NLReader::read(stream, "operators")));
+}
+
+// gradient of the Lagrangian f - y c in a dense vector
+std::vector<double> lagrangian_gradient(const Model& model, const Vector<double>& x, double multiplier) {
+   std::vector<double> gradient(2, 0.);
+   SparseVector<double> objective_gradient(2);
+   model.evaluate_objective_gradient(x, objective_gradient);
+   for (const auto [variable_index, derivative]: objective_gradient) {
+      gradient[variable_index] += derivative;
+   }
+   SparseVector<double> constraint_gradient(2);
+   model.evaluate_constraint_gradient(x, 0, constraint_gradient);
+   for (const auto [variable_index, derivative]: constraint_gradient) {
+      gradient[variable_index] -= multiplier * derivative;
+   }
+   return gradient;
+}
+
+TEST(NLModel, FiniteDifferences) {
+   const auto model = create_model();
+   ASSERT_EQ(model->get_constraint_type(0), NONLINEAR);
+   ASSERT_EQ(model->get_variable_bound_type(0), UNBOUNDED);
+   Vector<double> x(2);
+   model->initial_primal_point(x);
+   const double multiplier = 0.5;
+   const double step = 1e-6;
+
+   const std::vector<double> gradient = lagrangian_gradient(*model, x, multiplier);
+   SymmetricMatrix<size_t, double> hessian(2, model->number_hessian_nonzeros(), false, "COO");
+   model->evaluate_lagrangian_hessian(x, 1., Vector<double>{multiplier}, hessian);
+   std::vector<double> dense_hessian(4, 0.);
+   for (const auto [row_index, column_index, entry]: hessian) {
+      dense_hessian[2 * row_index + column_index] += entry;
+      if (row_index != column_index) {
+         dense_hessian[2 * column_index + row_index] += entry;
+      }
+   }
+
+   for (size_t variable_index: Range(2)) {
+      Vector<double> x_plus = x, x_minus = x;
+      x_plus[variable_index] += step;
+      x_minus[variable_index] -= step;
+      // central differences of the Lagrangian and its gradient
+      const auto lagrangian = [&](const Vector<double>& point) {
+         std::vector<double> constraints(1);
+         model->evaluate_constraints(point, constraints);
+         return model->evaluate_objective(point) - multiplier * constraints[0];
+      };
+      EXPECT_NEAR(gradient[variable_index], (lagrangian(x_plus) - lagrangian(x_minus)) / (2. * step), 1e-7);
+      const std::vector<double> gradient_plus = lagrangian_gradient(*model, x_plus, multiplier);
+      const std::vector<double> gradient_minus = lagrangian_gradient(*model, x_minus, multiplier);
+      for (size_t row_index: Range(2)) {
+         EXPECT_NEAR(dense_hessian[2 * row_index + variable_index], (gradient_plus[row_index] - gradient_minus[row_index]) / (2. * step), 1e-6);
+      }
+   }
+}
+
+TEST(NLModel, ConcurrentInstances) {
+   const auto shared_model = create_model();
+   const Vector<double> x{0.7, 1.3};
+   const double reference_objective = shared_model->evaluate_objective(x);
+   const std::vector<double> reference_gradient = lagrangian_gradient(*shared_model, x, 2.);
+
+   // each thread evaluates its own instance and the shared instance
+   std::vector<int> successes(4, 0);
+   std::vector<std::thread> threads{};
+   for (size_t thread_index: Range(successes.size())) {
+      threads.emplace_back([&, thread_index]() {
+         const auto model = create_model();
+         bool success = true;
+         for ([[maybe_unused]] size_t iteration: Range(200)) {
+            for (const Model* evaluated_model: {static_cast<const Model*>(model.get()), static_cast<const Model*>(shared_model.get())}) {
+               success = success && (evaluated_model->evaluate_objective(x) == reference_objective) &&
+                     (lagrangian_gradient(*evaluated_model, x, 2.) == reference_gradient);
+            }
+         }
+         successes[thread_index] = success ? 1 : 0;
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   for (int success: successes) {
+      ASSERT_EQ(success, 1);
+   }
+}
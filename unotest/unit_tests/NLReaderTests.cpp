@@ -0,0 +1,408 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/nl/CompiledNLEvaluator.hpp"
+#include "model/nl/InterpretedNLEvaluator.hpp"
+#include "model/nl/NLReader.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/TaskScheduler.hpp"
+
+using namespace uno;
+
+// examples/hs015.nl
+const char* hs015 = R"(g3 1 1 0	# problem hs015
+ 2 2 1 0 0	# vars, constraints, objectives, ranges, eqns
+ 2 1	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 2 2 2	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 4 2	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+b
+1 0.5
+3
+x2
+0 -2
+1 1
+r
+2 1
+2 0
+C0
+o2
+v0
+v1
+C1
+o5
+v1
+n2
+O0 0
+o0
+o2
+n100
+o5
+o1
+v1
+o5
+v0
+n2
+n2
+o5
+o1
+n1
+v0
+n2
+k1
+2
+J0 2
+0 0
+1 0
+J1 2
+0 1
+1 0
+G0 2
+0 0
+1 0
+)";
+
+// min sum_i (x_i - i)^2: three instances of the same element structure
+const char* indexed_least_squares = R"(g3 1 1 0
+ 3 0 1 0 0
+ 0 1
+ 0 0
+ 0 3 0
+ 0 0 0 1
+ 0 0 0 0 0
+ 0 3
+ 0 0
+ 0 0 0 0 0
+O0 0
+o54
+3
+o5
+o1
+v0
+n0
+n2
+o5
+o1
+v1
+n1
+n2
+o5
+o1
+v2
+n2
+n2
+G0 3
+0 0
+1 0
+2 0
+)";
+
+std::unique_ptr<CompiledNLEvaluator> try_compile(const char* nl_file) {
+   std::istringstream stream(nl_file);
+   const std::string directory = (std::filesystem::temp_directory_path() / "uno_unotest").string();
+   try {
+      return std::make_unique<CompiledNLEvaluator>(NLReader::read(stream, "test"), "c++", directory);
+   }
+   catch (const std::runtime_error&) {
+      // no compiler available
+      return nullptr;
+   }
+}
+
+TEST(NLReader, Structure) {
+   std::istringstream stream(hs015);
+   const NLProblem problem = NLReader::read(stream, "hs015");
+   ASSERT_EQ(problem.number_variables, 2);
+   ASSERT_EQ(problem.number_constraints, 2);
+   ASSERT_EQ(problem.variable_upper_bounds[0], 0.5);
+   ASSERT_EQ(problem.variable_lower_bounds[1], -INF<double>);
+   ASSERT_EQ(problem.constraint_lower_bounds[0], 1.);
+   ASSERT_EQ(problem.initial_primals[0], -2.);
+   // the objective is split into 100 (x1 - x0^2)^2 and (1 - x0)^2
+   ASSERT_EQ(problem.objective().elements.size(), 2);
+   ASSERT_EQ(problem.functions[1].elements.size(), 1);
+   ASSERT_EQ(problem.functions[1].linear_part.size(), 2);
+   // dense 2 x 2 upper triangular Hessian
+   ASSERT_EQ(problem.number_hessian_nonzeros(), 3);
+}
+
+void check_hs015_evaluations(const NLEvaluator& evaluator) {
+   const Vector<double> x{-2., 1.};
+   ASSERT_DOUBLE_EQ(evaluator.evaluate_objective(x), 909.);
+   SparseVector<double> gradient(2);
+   evaluator.evaluate_objective_gradient(x, gradient);
+   std::vector<double> dense_gradient(2);
+   for (const auto [variable_index, derivative]: gradient) {
+      dense_gradient[variable_index] += derivative;
+   }
+   ASSERT_DOUBLE_EQ(dense_gradient[0], -2406.);
+   ASSERT_DOUBLE_EQ(dense_gradient[1], -600.);
+   std::vector<double> constraints(2);
+   evaluator.evaluate_constraints(x, constraints);
+   ASSERT_DOUBLE_EQ(constraints[0], -2.);
+   ASSERT_DOUBLE_EQ(constraints[1], -1.);
+
+   // Hessian of f - 1 c0 - 2 c1
+   SymmetricMatrix<size_t, double> hessian(2, evaluator.number_hessian_nonzeros(), false, "COO");
+   evaluator.evaluate_lagrangian_hessian(x, 1., Vector<double>{1., 2.}, hessian);
+   std::vector<double> entries(3);
+   for (const auto [row_index, column_index, entry]: hessian) {
+      entries[row_index + column_index] += entry;
+   }
+   ASSERT_DOUBLE_EQ(entries[0], 4402.);
+   ASSERT_DOUBLE_EQ(entries[1], 799.);
+   ASSERT_DOUBLE_EQ(entries[2], 196.);
+}
+
+TEST(NLReader, InterpretedEvaluation) {
+   std::istringstream stream(hs015);
+   const InterpretedNLEvaluator evaluator(NLReader::read(stream, "hs015"));
+   check_hs015_evaluations(evaluator);
+}
+
+TEST(NLReader, CompiledEvaluation) {
+   const auto evaluator = try_compile(hs015);
+   if (evaluator == nullptr) {
+      GTEST_SKIP() << "no C++ compiler available";
+   }
+   check_hs015_evaluations(*evaluator);
+}
+
+TEST(NLReader, SharedKernels) {
+   const auto evaluator = try_compile(indexed_least_squares);
+   if (evaluator == nullptr) {
+      GTEST_SKIP() << "no C++ compiler available";
+   }
+   // the three elements differ only by their constants
+   ASSERT_EQ(evaluator->number_kernels(), 1);
+   const Vector<double> x{1., 1., 1.};
+   ASSERT_DOUBLE_EQ(evaluator->evaluate_objective(x), 2.);
+}
+
+// min x_0^2 s.t. c_i(x) = s_i(x_i) x_{i+1} + exp(a_i x_i) free, with s_i = cos if i is a multiple of 10 and sin otherwise, and
+// a_i = (i + 1) / 100
+std::string indexed_constraints(size_t number_constraints) {
+   std::ostringstream file;
+   file << "g3 1 1 0\n " << number_constraints + 1 << ' ' << number_constraints << " 1 0 0\n " << number_constraints << " 1\n 0 0\n " <<
+         number_constraints + 1 << " 1 1\n 0 0 0 1\n 0 0 0 0 0\n " << 2 * number_constraints << " 1\n 0 0\n 0 0 0 0 0\n";
+   for (size_t constraint_index: Range(number_constraints)) {
+      file << 'C' << constraint_index << "\no0\no2\no" << ((constraint_index % 10 == 0) ? 46 : 41) << "\nv" << constraint_index << "\nv" <<
+            constraint_index + 1 << "\no44\no2\nv" << constraint_index << "\nn" << static_cast<double>(constraint_index + 1) / 100. << '\n';
+   }
+   file << "O0 0\no5\nv0\nn2\nr\n";
+   for ([[maybe_unused]] size_t constraint_index: Range(number_constraints)) {
+      file << "3\n";
+   }
+   file << "b\n";
+   for ([[maybe_unused]] size_t variable_index: Range(number_constraints + 1)) {
+      file << "3\n";
+   }
+   for (size_t constraint_index: Range(number_constraints)) {
+      file << 'J' << constraint_index << " 2\n" << constraint_index << " 0\n" << constraint_index + 1 << " 0\n";
+   }
+   file << "G0 1\n0 0\n";
+   return file.str();
+}
+
+// the instances of the constraint families are evaluated in several batches
+TEST(NLReader, ConstraintFamilies) {
+   const size_t number_constraints = 150;
+   std::istringstream stream(indexed_constraints(number_constraints));
+   const InterpretedNLEvaluator evaluator(NLReader::read(stream, "indexed_constraints"));
+   // sin(x_i) x_{i+1}, cos(x_i) x_{i+1}, exp(a_i x_i) and x_0^2
+   ASSERT_EQ(evaluator.number_families(), 4);
+
+   const size_t number_variables = number_constraints + 1;
+   Vector<double> x(number_variables);
+   Vector<double> multipliers(number_constraints);
+   for (size_t variable_index: Range(number_variables)) {
+      x[variable_index] = 0.5 + 0.01 * static_cast<double>(variable_index);
+   }
+   for (size_t constraint_index: Range(number_constraints)) {
+      multipliers[constraint_index] = 1. - 0.02 * static_cast<double>(constraint_index);
+   }
+   std::vector<double> constraints(number_constraints);
+   evaluator.evaluate_constraints(x, constraints);
+   RectangularMatrix<double> jacobian(number_constraints, number_variables);
+   evaluator.evaluate_constraint_jacobian(x, jacobian);
+   SymmetricMatrix<size_t, double> hessian(number_variables, evaluator.number_hessian_nonzeros(), false, "COO");
+   evaluator.evaluate_lagrangian_hessian(x, 1., multipliers, hessian);
+   // dense upper triangular Hessian entries of the tridiagonal pattern: (i, i) and (i, i + 1)
+   std::vector<double> diagonal(number_variables, 0.), off_diagonal(number_variables, 0.);
+   for (const auto [row_index, column_index, entry]: hessian) {
+      ((row_index == column_index) ? diagonal : off_diagonal)[std::min(row_index, column_index)] += entry;
+   }
+
+   std::vector<double> expected_diagonal(number_variables, 0.), expected_off_diagonal(number_variables, 0.);
+   expected_diagonal[0] = 2.;
+   for (size_t i: Range(number_constraints)) {
+      const bool is_cosine = (i % 10 == 0);
+      const double a = static_cast<double>(i + 1) / 100.;
+      const double s = is_cosine ? std::cos(x[i]) : std::sin(x[i]);
+      const double ds = is_cosine ? -std::sin(x[i]) : std::cos(x[i]);
+      const double exponential = std::exp(a * x[i]);
+      EXPECT_NEAR(constraints[i], s * x[i + 1] + exponential, 1e-12);
+      std::vector<double> row(number_variables, 0.);
+      for (const auto [variable_index, derivative]: jacobian[i]) {
+         row[variable_index] += derivative;
+      }
+      EXPECT_NEAR(row[i], ds * x[i + 1] + a * exponential, 1e-12);
+      EXPECT_NEAR(row[i + 1], s, 1e-12);
+      // s'' = -s
+      expected_diagonal[i] -= multipliers[i] * (-s * x[i + 1] + a * a * exponential);
+      expected_off_diagonal[i] -= multipliers[i] * ds;
+   }
+   for (size_t variable_index: Range(number_variables)) {
+      EXPECT_NEAR(diagonal[variable_index], expected_diagonal[variable_index], 1e-12);
+      EXPECT_NEAR(off_diagonal[variable_index], expected_off_diagonal[variable_index], 1e-12);
+   }
+
+   // the single evaluations coincide with the batched evaluations
+   for (size_t constraint_index: {size_t(0), size_t(63), size_t(64), size_t(149)}) {
+      SparseVector<double> gradient(number_variables);
+      evaluator.evaluate_constraint_gradient(x, constraint_index, gradient);
+      ASSERT_EQ(gradient.size(), jacobian[constraint_index].size());
+      for (const auto [variable_index, derivative]: gradient) {
+         double batched_derivative = 0.;
+         for (const auto [batched_variable_index, entry]: jacobian[constraint_index]) {
+            if (batched_variable_index == variable_index) {
+               batched_derivative += entry;
+            }
+         }
+         EXPECT_DOUBLE_EQ(derivative, batched_derivative);
+      }
+   }
+}
+
+// min sum_i sin(x_i): an objective with one element per variable
+std::string separable_objective(size_t number_variables) {
+   std::ostringstream file;
+   file << "g3 1 1 0\n " << number_variables << " 0 1 0 0\n 0 1\n 0 0\n 0 " << number_variables << " 0\n 0 0 0 1\n 0 0 0 0 0\n 0 " <<
+         number_variables << "\n 0 0\n 0 0 0 0 0\n";
+   file << "O0 0\no54\n" << number_variables << '\n';
+   for (size_t variable_index: Range(number_variables)) {
+      file << "o41\nv" << variable_index << '\n';
+   }
+   file << "b\n";
+   for ([[maybe_unused]] size_t variable_index: Range(number_variables)) {
+      file << "3\n";
+   }
+   file << "G0 " << number_variables << '\n';
+   for (size_t variable_index: Range(number_variables)) {
+      file << variable_index << " 0\n";
+   }
+   return file.str();
+}
+
+// the batches of constraint gradients and the long sums are distributed over the threads: the results do not depend on their number
+TEST(NLReader, ParallelEvaluation) {
+   const size_t number_constraints = 2000;
+   std::istringstream constraint_stream(indexed_constraints(number_constraints));
+   const InterpretedNLEvaluator constraint_evaluator(NLReader::read(constraint_stream, "indexed_constraints"));
+   Vector<double> x(number_constraints + 1);
+   for (size_t variable_index: Range(number_constraints + 1)) {
+      x[variable_index] = 0.5 + 1e-4 * static_cast<double>(variable_index);
+   }
+   const auto evaluate_jacobian = [&]() {
+      RectangularMatrix<double> jacobian(number_constraints, number_constraints + 1);
+      constraint_evaluator.evaluate_constraint_jacobian(x, jacobian);
+      std::vector<double> entries{};
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, derivative]: jacobian[constraint_index]) {
+            entries.emplace_back(derivative);
+         }
+      }
+      return entries;
+   };
+
+   const size_t number_variables = 5000;
+   std::istringstream objective_stream(separable_objective(number_variables));
+   const InterpretedNLEvaluator objective_evaluator(NLReader::read(objective_stream, "separable_objective"));
+   Vector<double> y(number_variables);
+   double expected_objective = 0.;
+   for (size_t variable_index: Range(number_variables)) {
+      y[variable_index] = 1e-3 * static_cast<double>(variable_index);
+      expected_objective += std::sin(y[variable_index]);
+   }
+
+   TaskScheduler::configure(1);
+   const std::vector<double> sequential_jacobian = evaluate_jacobian();
+   const double sequential_objective = objective_evaluator.evaluate_objective(y);
+   TaskScheduler::configure(4);
+   ASSERT_EQ(evaluate_jacobian(), sequential_jacobian);
+   ASSERT_EQ(objective_evaluator.evaluate_objective(y), sequential_objective);
+   EXPECT_NEAR(sequential_objective, expected_objective, 1e-9);
+   TaskScheduler::configure(0);
+}
+
+TEST(NLReader, BinaryFormat) {
+   // same header as the text file, segments in binary format
+   std::string file(indexed_least_squares, std::strstr(indexed_least_squares, "O0 0"));
+   file[0] = 'b';
+   const auto append = [&](auto number) {
+      file.append(reinterpret_cast<const char*>(&number), sizeof(number));
+   };
+   file += 'O'; append(int32_t{0}); append(int32_t{0});
+   file += 'o'; append(int32_t{54}); append(int32_t{3});
+   for (int32_t variable_index: {0, 1, 2}) {
+      // (x_i - i)^2 with a short integer exponent
+      file += 'o'; append(int32_t{5});
+      file += 'o'; append(int32_t{1});
+      file += 'v'; append(variable_index);
+      file += 'n'; append(static_cast<double>(variable_index));
+      file += 's'; append(int16_t{2});
+   }
+   file += 'G'; append(int32_t{0}); append(int32_t{3});
+   for (int32_t variable_index: {0, 1, 2}) {
+      append(variable_index); append(0.);
+   }
+
+   std::istringstream stream(file);
+   const InterpretedNLEvaluator evaluator(NLReader::read(stream, "binary"));
+   ASSERT_EQ(evaluator.get_problem().objective().elements.size(), 3);
+   ASSERT_DOUBLE_EQ(evaluator.evaluate_objective(Vector<double>{1., 1., 1.}), 2.);
+}
+
+TEST(NLReader, PrivateCache) {
+   const std::filesystem::path directory = std::filesystem::temp_directory_path() / "uno_unotest_private_cache";
+   std::filesystem::remove_all(directory);
+   std::unique_ptr<CompiledNLEvaluator> evaluator{};
+   try {
+      std::istringstream stream(hs015);
+      evaluator = std::make_unique<CompiledNLEvaluator>(NLReader::read(stream, "test"), "c++", directory.string());
+   }
+   catch (const std::runtime_error&) {
+      GTEST_SKIP() << "no C++ compiler available";
+   }
+   // the new cache directory is private to the user
+   ASSERT_EQ(std::filesystem::status(directory).permissions(), std::filesystem::perms::owner_all);
+
+   // a cached library that the other users may have modified is not loaded
+   const std::string library_path = evaluator->get_library_path();
+   evaluator.reset();
+   std::filesystem::permissions(library_path, std::filesystem::perms::others_write, std::filesystem::perm_options::add);
+   std::istringstream stream(hs015);
+   ASSERT_THROW(CompiledNLEvaluator(NLReader::read(stream, "test"), "c++", directory.string()), std::runtime_error);
+
+   // the compiler command is not interpreted by a shell
+   const std::filesystem::path marker = directory / "marker";
+   std::istringstream other_stream(hs015);
+   ASSERT_THROW(CompiledNLEvaluator(NLReader::read(other_stream, "test"), "c++ -o /dev/null; touch " + marker.string(), directory.string()),
+      std::runtime_error);
+   ASSERT_FALSE(std::filesystem::exists(marker));
+   std::filesystem::remove_all(directory);
+}
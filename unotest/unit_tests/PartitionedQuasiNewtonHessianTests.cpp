@@ -0,0 +1,117 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <array>
+#include <gtest/gtest.h>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/hessian_models/HessianModelFactory.hpp"
+#include "ingredients/hessian_models/PartitionedQuasiNewtonHessian.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/synthetic/SyntheticModel.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+// min 1/2 [(x_0 - 1)^2 + x_1^2] s.t. x_0 x_1 = 1, with one element for the objective and one element for the constraint
+class ElementModel: public SyntheticModel {
+public:
+   ElementModel(): SyntheticModel("elements", 2, 1) {
+      this->constraint_lower_bounds[0] = this->constraint_upper_bounds[0] = 1.;
+      this->partition_variables_and_constraints();
+   }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      return 0.5 * ((x[0] - 1.) * (x[0] - 1.) + x[1] * x[1]);
+   }
+
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, x[0] - 1.);
+      gradient.insert(1, x[1]);
+   }
+
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] * x[1];
+   }
+
+   void evaluate_constraint_gradient(const Vector<double>& x, size_t /*constraint_index*/, SparseVector<double>& gradient) const override {
+      gradient.insert(0, x[1]);
+      gradient.insert(1, x[0]);
+   }
+
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      hessian.reset();
+      hessian.insert(objective_multiplier, 0, 0);
+      hessian.finalize_column(0);
+      hessian.insert(-multipliers[0], 0, 1);
+      hessian.insert(objective_multiplier, 1, 1);
+      hessian.finalize_column(1);
+   }
+
+   [[nodiscard]] size_t number_elements() const override { return 2; }
+
+   void get_elements(std::vector<ElementFunction>& elements) const override {
+      elements.clear();
+      elements.emplace_back(ElementFunction{std::nullopt, {0, 1}});
+      elements.emplace_back(ElementFunction{0, {0, 1}});
+   }
+
+   void evaluate_element_gradients(const Vector<double>& x, std::vector<double>& element_gradients) const override {
+      element_gradients[0] = x[0] - 1.;
+      element_gradients[1] = x[1];
+      element_gradients[2] = x[1];
+      element_gradients[3] = x[0];
+   }
+
+   void initial_primal_point(Vector<double>& x) const override {
+      x[0] = x[1] = 1.;
+   }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 3; }
+};
+
+// dense upper triangular part of the Hessian at the initial point with constraint multiplier 3. The initial element approximations are
+// the identity: the assembled approximation I - 3 I is negative definite
+std::array<double, 3> evaluate_approximation(HessianModel& hessian_model, SymmetricMatrix<size_t, double>& hessian) {
+   const ElementModel model;
+   const OptimalityProblem problem(model);
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   hessian_model.initialize_statistics(statistics, options);
+   Vector<double> x(2);
+   model.initial_primal_point(x);
+   const Vector<double> multipliers{3.};
+   hessian_model.evaluate(statistics, problem, x, multipliers, hessian);
+
+   std::array<double, 3> entries{0., 0., 0.}; // (0, 0), (0, 1), (1, 1)
+   for (const auto [row_index, column_index, entry]: hessian) {
+      entries[row_index + column_index] += entry;
+   }
+   return entries;
+}
+
+TEST(PartitionedQuasiNewtonHessian, IndefiniteApproximation) {
+   const Options options = DefaultOptions::load();
+   PartitionedQuasiNewtonHessian hessian_model(options);
+   SymmetricMatrix<size_t, double> hessian(2, 3, false, "COO");
+   const auto [diagonal_entry0, off_diagonal_entry, diagonal_entry1] = evaluate_approximation(hessian_model, hessian);
+   EXPECT_DOUBLE_EQ(diagonal_entry0, -2.);
+   EXPECT_DOUBLE_EQ(off_diagonal_entry, 0.);
+   EXPECT_DOUBLE_EQ(diagonal_entry1, -2.);
+}
+
+TEST(PartitionedQuasiNewtonHessian, ConvexifiedApproximation) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers());
+   const auto hessian_model = HessianModelFactory::create("partitioned_quasi_newton", 2, 3, true, options);
+   SymmetricMatrix<size_t, double> hessian(2, 3, true, "COO");
+   const auto [diagonal_entry0, off_diagonal_entry, diagonal_entry1] = evaluate_approximation(*hessian_model, hessian);
+   // positive definite
+   ASSERT_LT(0., diagonal_entry0);
+   ASSERT_LT(0., diagonal_entry0 * diagonal_entry1 - off_diagonal_entry * off_diagonal_entry);
+   ASSERT_EQ(hessian_model->evaluation_count, 1);
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <thread>
+#include "tools/PerformanceCounters.hpp"
+
+using namespace uno;
+
+TEST(PerformanceCounters, Disabled) {
+   PerformanceCounters::disable();
+   {
+      PerformanceCounterScope scope(SolverPhase::SOLVE);
+   }
+   const PerformanceCounterReport& report = PerformanceCounters::get_report();
+   ASSERT_FALSE(report.requested);
+   ASSERT_EQ(report.phases[static_cast<size_t>(SolverPhase::SOLVE)].number_calls, 0);
+}
+
+// the counters may be unavailable in the test environment: in this case, the scopes are no-ops
+TEST(PerformanceCounters, NestedScopes) {
+   const bool available = PerformanceCounters::enable();
+   {
+      PerformanceCounterScope subproblem_scope(SolverPhase::SUBPROBLEM);
+      for (size_t iteration = 0; iteration < 3; iteration++) {
+         PerformanceCounterScope factorization_scope(SolverPhase::FACTORIZATION);
+      }
+   }
+   const PerformanceCounterReport& report = PerformanceCounters::get_report();
+   ASSERT_TRUE(report.requested);
+   ASSERT_EQ(report.available, available);
+   ASSERT_EQ(report.phases[static_cast<size_t>(SolverPhase::SUBPROBLEM)].number_calls, available ? 1 : 0);
+   ASSERT_EQ(report.phases[static_cast<size_t>(SolverPhase::FACTORIZATION)].number_calls, available ? 3 : 0);
+   ASSERT_EQ(report.phases[static_cast<size_t>(SolverPhase::EVALUATION)].number_calls, 0);
+   PerformanceCounters::disable();
+}
+
+#ifdef __linux__
+size_t number_open_file_descriptors() {
+   size_t number_descriptors = 0;
+   for ([[maybe_unused]] const auto& entry: std::filesystem::directory_iterator("/proc/self/fd")) {
+      number_descriptors++;
+   }
+   return number_descriptors;
+}
+
+// the counters opened by a thread are closed when the thread exits
+TEST(PerformanceCounters, NoDescriptorLeakAcrossThreads) {
+   const size_t initial_number_descriptors = number_open_file_descriptors();
+   for (size_t thread_index = 0; thread_index < 8; thread_index++) {
+      std::thread thread([] {
+         PerformanceCounters::enable();
+         {
+            PerformanceCounterScope scope(SolverPhase::EVALUATION);
+         }
+         PerformanceCounters::disable();
+      });
+      thread.join();
+   }
+   ASSERT_EQ(number_open_file_descriptors(), initial_number_descriptors);
+}
+#endif
@@ -0,0 +1,184 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/QuasidefiniteLDLSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-10;
+
+// quasidefinite augmented matrix [H J^T; J -delta I] with H positive definite
+void fill_augmented_matrix(SymmetricMatrix<size_t, double>& matrix) {
+   matrix.insert(4., 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(3., 1, 1);
+   matrix.insert(2., 2, 2);
+   matrix.insert(1., 0, 3);
+   matrix.insert(1., 1, 3);
+   matrix.insert(-1., 2, 4);
+   matrix.insert(1., 1, 4);
+   matrix.insert(-1e-2, 3, 3);
+   matrix.insert(-1e-2, 4, 4);
+}
+
+TEST(QuasidefiniteLDLSolver, SystemSize5) {
+   const size_t n = 5;
+   const size_t nnz = 10;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_augmented_matrix(matrix);
+   // rhs = matrix * (1, 2, 3, 4, 5)
+   const Vector<double> rhs{10., 16., 1., 2.96, -1.05};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   QuasidefiniteLDLSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+}
+
+TEST(QuasidefiniteLDLSolver, Inertia) {
+   const size_t n = 5;
+   const size_t nnz = 10;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_augmented_matrix(matrix);
+
+   QuasidefiniteLDLSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 3);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+}
+
+TEST(QuasidefiniteLDLSolver, SingularMatrix) {
+   const size_t n = 4;
+   const size_t nnz = 7;
+   // comes from hs015 solved with byrd preset
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert( -0.0198, 0, 0);
+   matrix.insert(0.625075, 0, 0);
+   matrix.insert(-0.277512, 0, 1);
+   matrix.insert(-0.624975, 1, 1);
+   matrix.insert(0.625075, 1, 1);
+   matrix.insert(0., 2, 2);
+   matrix.insert(0., 3, 3);
+   QuasidefiniteLDLSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   // expected inertia (1, 1, 2)
+   ASSERT_TRUE(solver.matrix_is_singular());
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 1);
+   ASSERT_EQ(number_negative, 1);
+   ASSERT_EQ(number_zero, 2);
+}
+
+TEST(QuasidefiniteLDLSolver, DenseRow) {
+   // tridiagonal Hessian and a single dense constraint (budget)
+   const size_t number_variables = 200;
+   const size_t n = number_variables + 1;
+   const size_t nnz = 3 * number_variables;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   for (size_t variable_index: Range(number_variables)) {
+      matrix.insert(4., variable_index, variable_index);
+      if (0 < variable_index) {
+         matrix.insert(1., variable_index - 1, variable_index);
+      }
+      matrix.insert(1., variable_index, number_variables);
+   }
+   matrix.insert(-1e-2, number_variables, number_variables);
+   // rhs = matrix * (1, ..., 1, 2)
+   Vector<double> rhs(n);
+   for (size_t variable_index: Range(number_variables)) {
+      rhs[variable_index] = 6. + (0 < variable_index ? 1. : 0.) + (variable_index < number_variables - 1 ? 1. : 0.);
+   }
+   rhs[number_variables] = static_cast<double>(number_variables) - 2e-2;
+   Vector<double> result(n);
+   result.fill(0.);
+
+   QuasidefiniteLDLSolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   ASSERT_EQ(solver.number_dense_rows(), 1);
+   for (size_t variable_index: Range(number_variables)) {
+      EXPECT_NEAR(result[variable_index], 1., tolerance);
+   }
+   EXPECT_NEAR(result[number_variables], 2., tolerance);
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, number_variables);
+   ASSERT_EQ(number_negative, 1);
+   ASSERT_EQ(number_zero, 0);
+}
+
+// augmented matrix of a 2D grid: 5-point Laplacian + 4 I (primal block) and a coupling constraint per row of the grid. The modification
+// changes a diagonal entry and an off-diagonal entry
+void fill_grid_matrix(SymmetricMatrix<size_t, double>& matrix, size_t grid_size, bool is_modified) {
+   const size_t number_variables = grid_size * grid_size;
+   matrix.reset();
+   for (size_t variable_index: Range(number_variables)) {
+      const size_t row = variable_index / grid_size;
+      const size_t column = variable_index % grid_size;
+      matrix.insert((is_modified && variable_index == number_variables / 2) ? 10. : 8., variable_index, variable_index);
+      if (0 < column) {
+         matrix.insert((is_modified && variable_index == number_variables / 3) ? -0.5 : -1., variable_index - 1, variable_index);
+      }
+      if (0 < row) {
+         matrix.insert(-1., variable_index - grid_size, variable_index);
+      }
+   }
+   for (size_t row: Range(grid_size)) {
+      const size_t constraint_index = number_variables + row;
+      matrix.insert(1., row * grid_size, constraint_index);
+      matrix.insert(-1., row * grid_size + grid_size - 1, constraint_index);
+      matrix.insert(-1e-2, constraint_index, constraint_index);
+   }
+}
+
+TEST(QuasidefiniteLDLSolver, FactorizationUpdate) {
+   const size_t grid_size = 15;
+   const size_t n = grid_size * grid_size + grid_size;
+   const size_t nnz = 3 * grid_size * grid_size + 3 * grid_size;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   Vector<double> rhs(n);
+   for (size_t index: Range(n)) {
+      rhs[index] = 1. + static_cast<double>(index % 7);
+   }
+
+   // factorize the original matrix, then update the factors with the modified matrix
+   QuasidefiniteLDLSolver solver(n, nnz);
+   fill_grid_matrix(matrix, grid_size, false);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   fill_grid_matrix(matrix, grid_size, true);
+   solver.do_numerical_factorization(matrix);
+   Vector<double> result(n);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   ASSERT_EQ(solver.number_factorizations(), 1);
+   ASSERT_EQ(solver.number_factorization_updates(), 1);
+
+   // factorize the modified matrix from scratch
+   QuasidefiniteLDLSolver reference_solver(n, nnz);
+   reference_solver.do_symbolic_analysis(matrix);
+   reference_solver.do_numerical_factorization(matrix);
+   Vector<double> reference(n);
+   reference_solver.solve_indefinite_system(matrix, rhs, reference);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+   ASSERT_EQ(solver.get_inertia(), reference_solver.get_inertia());
+}
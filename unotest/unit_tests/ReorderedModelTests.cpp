@@ -0,0 +1,80 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/ReorderedModel.hpp"
+#include "model/synthetic/SyntheticModelFactory.hpp"
+#include "preprocessing/ReverseCuthillMcKee.hpp"
+
+using namespace uno;
+
+TEST(ReverseCuthillMcKee, ScrambledPath) {
+   // path 3 - 0 - 4 - 1 - 2
+   std::vector<std::vector<size_t>> adjacency{{3, 4}, {4, 2}, {1}, {0}, {0, 1}};
+   const std::vector<size_t> permutation = compute_reverse_cuthill_mckee_ordering(adjacency);
+   const std::vector<size_t> inverse_permutation = invert_permutation(permutation);
+   // the bandwidth of the reordered path is 1
+   for (size_t node: Range(adjacency.size())) {
+      for (size_t neighbor: adjacency[node]) {
+         EXPECT_EQ(std::abs(static_cast<int>(inverse_permutation[node]) - static_cast<int>(inverse_permutation[neighbor])), 1);
+      }
+   }
+}
+
+TEST(ReorderedModel, EvaluationsArePermuted) {
+   const std::unique_ptr<Model> original_model = SyntheticModelFactory::create("network_flow", 10);
+   const ReorderedModel reordered_model(SyntheticModelFactory::create("network_flow", 10));
+   const std::vector<size_t>& variable_permutation = reordered_model.get_variable_permutation();
+   const std::vector<size_t>& constraint_permutation = reordered_model.get_constraint_permutation();
+   const size_t n = original_model->number_variables;
+   const size_t m = original_model->number_constraints;
+   ASSERT_EQ(variable_permutation.size(), n);
+   ASSERT_EQ(constraint_permutation.size(), m);
+
+   Vector<double> original_x(n), x(n);
+   for (size_t variable_index: Range(n)) {
+      original_x[variable_index] = std::sin(static_cast<double>(variable_index));
+   }
+   for (size_t variable_index: Range(n)) {
+      x[variable_index] = original_x[variable_permutation[variable_index]];
+      EXPECT_EQ(reordered_model.variable_upper_bound(variable_index), original_model->variable_upper_bound(variable_permutation[variable_index]));
+   }
+   Vector<double> original_multipliers(m), multipliers(m);
+   for (size_t constraint_index: Range(m)) {
+      original_multipliers[constraint_index] = 1. + static_cast<double>(constraint_index);
+   }
+   for (size_t constraint_index: Range(m)) {
+      multipliers[constraint_index] = original_multipliers[constraint_permutation[constraint_index]];
+   }
+
+   EXPECT_DOUBLE_EQ(reordered_model.evaluate_objective(x), original_model->evaluate_objective(original_x));
+   std::vector<double> original_constraints(m), constraints(m);
+   original_model->evaluate_constraints(original_x, original_constraints);
+   reordered_model.evaluate_constraints(x, constraints);
+   for (size_t constraint_index: Range(m)) {
+      EXPECT_DOUBLE_EQ(constraints[constraint_index], original_constraints[constraint_permutation[constraint_index]]);
+      EXPECT_EQ(reordered_model.constraint_lower_bound(constraint_index), original_model->constraint_lower_bound(constraint_permutation[constraint_index]));
+   }
+
+   // the permuted Hessian is P H P^T
+   SymmetricMatrix<size_t, double> original_hessian(n, original_model->number_hessian_nonzeros(), false, "COO");
+   SymmetricMatrix<size_t, double> hessian(n, reordered_model.number_hessian_nonzeros(), false, "CSC");
+   original_model->evaluate_lagrangian_hessian(original_x, 1., original_multipliers, original_hessian);
+   reordered_model.evaluate_lagrangian_hessian(x, 1., multipliers, hessian);
+   ASSERT_EQ(hessian.number_nonzeros(), original_hessian.number_nonzeros());
+   std::vector<double> original_diagonal(n, 0.);
+   for (const auto [row_index, column_index, entry]: original_hessian) {
+      if (row_index == column_index) {
+         original_diagonal[row_index] += entry;
+      }
+   }
+   for (const auto [row_index, column_index, entry]: hessian) {
+      if (row_index == column_index) {
+         EXPECT_DOUBLE_EQ(entry, original_diagonal[variable_permutation[row_index]]);
+      }
+   }
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/RiccatiSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-10;
+
+// augmented matrix [H J^T; J -delta I] of 3 variables (stages 0, 1, 2) and 2 constraints (stages 0, 1)
+void fill_multistage_matrix(SymmetricMatrix<size_t, double>& matrix) {
+   matrix.insert(4., 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(3., 1, 1);
+   matrix.insert(2., 2, 2);
+   matrix.insert(1., 0, 3);
+   matrix.insert(1., 1, 3);
+   matrix.insert(-1., 2, 4);
+   matrix.insert(1., 1, 4);
+   matrix.insert(-1e-2, 3, 3);
+   matrix.insert(-1e-2, 4, 4);
+}
+
+void solve_multistage_system(const std::vector<size_t>& stages, bool uses_recursion) {
+   const size_t n = 5;
+   const size_t nnz = 10;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_multistage_matrix(matrix);
+   // rhs = matrix * (1, 2, 3, 4, 5)
+   const Vector<double> rhs{10., 16., 1., 2.96, -1.05};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   RiccatiSolver solver(n, nnz);
+   solver.set_stages(stages);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   ASSERT_EQ(solver.uses_recursion(), uses_recursion);
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 3);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+}
+
+TEST(RiccatiSolver, BlockTridiagonalSystem) {
+   solve_multistage_system({0, 1, 2, 0, 1}, true);
+}
+
+TEST(RiccatiSolver, NonadjacentStagesFallBack) {
+   // the entry (2, 4) couples the stages 2 and 0
+   solve_multistage_system({0, 1, 2, 0, 0}, false);
+}
+
+TEST(RiccatiSolver, NoStagesFallBack) {
+   solve_multistage_system({}, false);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <array>
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/SparseCholeskySolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+using namespace uno;
+
+const size_t n = 5;
+const size_t nnz = 10;
+
+void fill_positive_definite_matrix(SymmetricMatrix<size_t, double>& matrix) {
+   for (size_t column_index: Range(n)) {
+      if (0 < column_index) {
+         matrix.insert(-1., column_index - 1, column_index);
+      }
+      if (column_index == 4) {
+         matrix.insert(1., 0, column_index);
+      }
+      matrix.insert(4., column_index, column_index);
+      matrix.finalize_column(column_index);
+   }
+}
+
+void fill_indefinite_matrix(SymmetricMatrix<size_t, double>& matrix) {
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+}
+
+TEST(SparseCholeskySolver, SystemSize5) {
+   const Vector<double> rhs{7., 4., 6., 8., 17.};
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   for (const std::string sparse_format: {"COO", "CSC"}) {
+      SymmetricMatrix<size_t, double> matrix(n, nnz, false, sparse_format);
+      fill_positive_definite_matrix(matrix);
+      Vector<double> result(n);
+      result.fill(0.);
+
+      SparseCholeskySolver solver(n, nnz);
+      solver.do_symbolic_analysis(matrix, n);
+      ASSERT_TRUE(solver.do_numerical_factorization(matrix));
+      solver.solve(rhs, result);
+      for (size_t index: Range(n)) {
+         EXPECT_NEAR(result[index], reference[index], 1e-12);
+      }
+   }
+}
+
+TEST(SparseCholeskySolver, EarlyExitOnIndefiniteMatrix) {
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_indefinite_matrix(matrix);
+   SparseCholeskySolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix, n);
+   ASSERT_FALSE(solver.do_numerical_factorization(matrix));
+   Vector<double> result(n);
+   ASSERT_THROW(solver.solve(result, result), std::runtime_error);
+}
+
+TEST(SparseCholeskySolver, Regularization) {
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_indefinite_matrix(matrix);
+   SparseCholeskySolver solver(n, nnz);
+   solver.do_symbolic_analysis(matrix, n);
+   ASSERT_FALSE(solver.do_numerical_factorization(matrix, 1.));
+   // larger than the Gershgorin bound
+   ASSERT_TRUE(solver.do_numerical_factorization(matrix, 20.));
+}
+
+TEST(SparseCholeskySolver, CachedSymbolicAnalysis) {
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_positive_definite_matrix(matrix);
+   SparseCholeskySolver solver(n, nnz);
+   ASSERT_TRUE(solver.sparsity_changed(matrix, n));
+   solver.do_symbolic_analysis(matrix, n);
+   ASSERT_FALSE(solver.sparsity_changed(matrix, n));
+   SymmetricMatrix<size_t, double> other_matrix(n, nnz, false, "COO");
+   fill_indefinite_matrix(other_matrix);
+   ASSERT_TRUE(solver.sparsity_changed(other_matrix, n));
+   // the factor of a matrix with an arrow pattern is sparse
+   ASSERT_TRUE(solver.do_numerical_factorization(matrix));
+   ASSERT_LE(solver.number_factor_nonzeros(), 12);
+}
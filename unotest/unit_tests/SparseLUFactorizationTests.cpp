@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/SparseLUFactorization.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+const size_t number_rows = 3;
+const size_t number_columns = 5;
+
+// 3 x 5 matrix of full row rank
+RectangularMatrix<double> create_matrix(double scaling) {
+   RectangularMatrix<double> matrix(number_rows, 0);
+   matrix[0].insert(0, 2. * scaling);
+   matrix[0].insert(1, 1.);
+   matrix[0].insert(3, -1.);
+   matrix[1].insert(1, 3.);
+   matrix[1].insert(2, 1. * scaling);
+   matrix[1].insert(4, 2.);
+   matrix[2].insert(0, 1.);
+   matrix[2].insert(2, -2.);
+   matrix[2].insert(3, 4. * scaling);
+   return matrix;
+}
+
+// check B x = b and B^T y = c, where B is made of the basic columns
+void check_solves(const SparseLUFactorization& factorization, const RectangularMatrix<double>& matrix) {
+   const std::vector<size_t>& basic_columns = factorization.get_basic_columns();
+   ASSERT_EQ(basic_columns.size(), number_rows);
+   std::vector<size_t> position(number_columns, number_columns);
+   for (size_t index: Range(number_rows)) {
+      position[basic_columns[index]] = index;
+   }
+
+   const Vector<double> rhs{1., -2., 3.};
+   Vector<double> result(number_rows);
+   factorization.solve(rhs, result);
+   for (size_t row_index: Range(number_rows)) {
+      double product = 0.;
+      for (const auto [column_index, entry]: matrix[row_index]) {
+         if (position[column_index] < number_columns) {
+            product += entry * result[position[column_index]];
+         }
+      }
+      EXPECT_NEAR(product, rhs[row_index], 1e-12);
+   }
+
+   Vector<double> transposed_result(number_rows);
+   factorization.solve_transpose(rhs, transposed_result);
+   std::vector<double> transposed_product(number_rows, 0.);
+   for (size_t row_index: Range(number_rows)) {
+      for (const auto [column_index, entry]: matrix[row_index]) {
+         if (position[column_index] < number_columns) {
+            transposed_product[position[column_index]] += entry * transposed_result[row_index];
+         }
+      }
+   }
+   for (size_t index: Range(number_rows)) {
+      EXPECT_NEAR(transposed_product[index], rhs[index], 1e-12);
+   }
+}
+
+TEST(SparseLUFactorization, FactorizeAndSolve) {
+   const RectangularMatrix<double> matrix = create_matrix(1.);
+   SparseLUFactorization factorization(number_rows, number_columns, 0.1);
+   ASSERT_TRUE(factorization.factorize(matrix, number_rows, number_columns, std::vector<double>(number_columns, 1.)));
+   check_solves(factorization, matrix);
+}
+
+TEST(SparseLUFactorization, ColumnPriorities) {
+   const RectangularMatrix<double> matrix = create_matrix(1.);
+   SparseLUFactorization factorization(number_rows, number_columns, 0.1);
+   // columns 0 and 1 should not be selected
+   ASSERT_TRUE(factorization.factorize(matrix, number_rows, number_columns, {0., 0., 1., 1., 1.}));
+   EXPECT_FALSE(factorization.is_basic(0));
+   EXPECT_FALSE(factorization.is_basic(1));
+   check_solves(factorization, matrix);
+}
+
+TEST(SparseLUFactorization, RefactorizeWithSameBasis) {
+   SparseLUFactorization factorization(number_rows, number_columns, 0.1);
+   ASSERT_TRUE(factorization.factorize(create_matrix(1.), number_rows, number_columns, std::vector<double>(number_columns, 1.)));
+   const std::vector<size_t> basic_columns = factorization.get_basic_columns();
+   const RectangularMatrix<double> new_matrix = create_matrix(1.5);
+   ASSERT_TRUE(factorization.refactorize(new_matrix));
+   EXPECT_EQ(factorization.get_basic_columns(), basic_columns);
+   check_solves(factorization, new_matrix);
+}
+
+TEST(SparseLUFactorization, RankDeficientMatrix) {
+   RectangularMatrix<double> matrix(2, 0);
+   matrix[0].insert(0, 1.);
+   matrix[0].insert(2, 2.);
+   matrix[1].insert(0, -2.);
+   matrix[1].insert(2, -4.);
+   SparseLUFactorization factorization(2, 3, 0.1);
+   EXPECT_FALSE(factorization.factorize(matrix, 2, 3, std::vector<double>(3, 1.)));
+}
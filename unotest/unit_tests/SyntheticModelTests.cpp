@@ -0,0 +1,177 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/synthetic/ChainedRosenbrockModel.hpp"
+#include "model/synthetic/SyntheticModelFactory.hpp"
+
+using namespace uno;
+
+const double finite_difference_step = 1e-6;
+const double tolerance = 1e-5;
+
+// dense gradient of the Lagrangian objective_multiplier f(x) - multipliers^T c(x)
+std::vector<double> lagrangian_gradient(const Model& model, const Vector<double>& x, const Vector<double>& multipliers) {
+   std::vector<double> gradient(model.number_variables, 0.);
+   SparseVector<double> objective_gradient(model.number_variables);
+   model.evaluate_objective_gradient(x, objective_gradient);
+   for (const auto [variable_index, derivative]: objective_gradient) {
+      gradient[variable_index] += derivative;
+   }
+   RectangularMatrix<double> constraint_jacobian(model.number_constraints, model.number_variables);
+   model.evaluate_constraint_jacobian(x, constraint_jacobian);
+   for (size_t constraint_index: Range(model.number_constraints)) {
+      for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+         gradient[variable_index] -= multipliers[constraint_index] * derivative;
+      }
+   }
+   return gradient;
+}
+
+void check_derivatives(const Model& model) {
+   const size_t n = model.number_variables;
+   const size_t m = model.number_constraints;
+   Vector<double> x(n);
+   model.initial_primal_point(x);
+   for (size_t variable_index: Range(n)) {
+      x[variable_index] += 0.1 * std::sin(static_cast<double>(variable_index + 1));
+   }
+   Vector<double> multipliers(m);
+   for (size_t constraint_index: Range(m)) {
+      multipliers[constraint_index] = 0.5 + 0.1 * static_cast<double>(constraint_index % 4);
+   }
+
+   // objective gradient
+   SparseVector<double> objective_gradient(n);
+   model.evaluate_objective_gradient(x, objective_gradient);
+   EXPECT_EQ(objective_gradient.size(), model.number_objective_gradient_nonzeros());
+   std::vector<double> dense_objective_gradient(n, 0.);
+   for (const auto [variable_index, derivative]: objective_gradient) {
+      dense_objective_gradient[variable_index] += derivative;
+   }
+   // constraint Jacobian
+   RectangularMatrix<double> constraint_jacobian(m, n);
+   model.evaluate_constraint_jacobian(x, constraint_jacobian);
+   std::vector<std::vector<double>> dense_jacobian(m, std::vector<double>(n, 0.));
+   size_t number_jacobian_nonzeros = 0;
+   for (size_t constraint_index: Range(m)) {
+      for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+         dense_jacobian[constraint_index][variable_index] += derivative;
+         number_jacobian_nonzeros++;
+      }
+   }
+   EXPECT_EQ(number_jacobian_nonzeros, model.number_jacobian_nonzeros());
+   // Lagrangian Hessian
+   SymmetricMatrix<size_t, double> hessian(n, model.number_hessian_nonzeros(), false, "COO");
+   model.evaluate_lagrangian_hessian(x, 1., multipliers, hessian);
+   EXPECT_EQ(hessian.number_nonzeros(), model.number_hessian_nonzeros());
+   std::vector<std::vector<double>> dense_hessian(n, std::vector<double>(n, 0.));
+   for (const auto [row_index, column_index, entry]: hessian) {
+      EXPECT_LE(row_index, column_index);
+      dense_hessian[row_index][column_index] += entry;
+      if (row_index != column_index) {
+         dense_hessian[column_index][row_index] += entry;
+      }
+   }
+
+   // central finite differences
+   std::vector<double> constraints_plus(m), constraints_minus(m);
+   for (size_t variable_index: Range(n)) {
+      const double value = x[variable_index];
+      x[variable_index] = value + finite_difference_step;
+      const double objective_plus = model.evaluate_objective(x);
+      model.evaluate_constraints(x, constraints_plus);
+      const std::vector<double> lagrangian_gradient_plus = lagrangian_gradient(model, x, multipliers);
+      x[variable_index] = value - finite_difference_step;
+      const double objective_minus = model.evaluate_objective(x);
+      model.evaluate_constraints(x, constraints_minus);
+      const std::vector<double> lagrangian_gradient_minus = lagrangian_gradient(model, x, multipliers);
+      x[variable_index] = value;
+
+      EXPECT_NEAR(dense_objective_gradient[variable_index], (objective_plus - objective_minus) / (2. * finite_difference_step), tolerance);
+      for (size_t constraint_index: Range(m)) {
+         EXPECT_NEAR(dense_jacobian[constraint_index][variable_index],
+               (constraints_plus[constraint_index] - constraints_minus[constraint_index]) / (2. * finite_difference_step), tolerance);
+      }
+      for (size_t row_index: Range(n)) {
+         EXPECT_NEAR(dense_hessian[row_index][variable_index],
+               (lagrangian_gradient_plus[row_index] - lagrangian_gradient_minus[row_index]) / (2. * finite_difference_step), tolerance);
+      }
+   }
+}
+
+TEST(SyntheticModel, Derivatives) {
+   for (const std::string& problem_name: SyntheticModelFactory::available_problems()) {
+      SCOPED_TRACE(problem_name);
+      const auto model = SyntheticModelFactory::create(problem_name, 4);
+      check_derivatives(*model);
+   }
+}
+
+TEST(SyntheticModel, ChainedRosenbrockResiduals) {
+   const ChainedRosenbrockModel model(6);
+   Vector<double> x(model.number_variables);
+   model.initial_primal_point(x);
+   std::vector<double> residuals(model.number_residuals());
+   model.evaluate_residuals(x, residuals);
+   double squared_norm = 0.;
+   for (double residual: residuals) {
+      squared_norm += residual * residual;
+   }
+   EXPECT_NEAR(model.evaluate_objective(x), 0.5 * squared_norm, 1e-12);
+}
+
+// the objective is the sum of its element functions
+TEST(SyntheticModel, ObjectiveElementGradients) {
+   for (const std::string& problem_name: SyntheticModelFactory::available_problems()) {
+      SCOPED_TRACE(problem_name);
+      const auto model = SyntheticModelFactory::create(problem_name, 4);
+      if (model->number_elements() == 0) {
+         continue;
+      }
+      const size_t n = model->number_variables;
+      Vector<double> x(n);
+      model->initial_primal_point(x);
+      for (size_t variable_index: Range(n)) {
+         x[variable_index] += 0.1 * std::sin(static_cast<double>(variable_index + 1));
+      }
+      std::vector<ElementFunction> elements{};
+      model->get_elements(elements);
+      EXPECT_EQ(elements.size(), model->number_elements());
+      size_t number_element_gradient_entries = 0;
+      for (const ElementFunction& element: elements) {
+         number_element_gradient_entries += element.variables.size();
+      }
+      std::vector<double> element_gradients(number_element_gradient_entries);
+      model->evaluate_element_gradients(x, element_gradients);
+
+      std::vector<double> objective_gradient(n, 0.);
+      size_t offset = 0;
+      for (const ElementFunction& element: elements) {
+         for (size_t variable_index: element.variables) {
+            if (not element.constraint_index.has_value()) {
+               objective_gradient[variable_index] += element_gradients[offset];
+            }
+            offset++;
+         }
+      }
+      SparseVector<double> exact_objective_gradient(n);
+      model->evaluate_objective_gradient(x, exact_objective_gradient);
+      std::vector<double> dense_objective_gradient(n, 0.);
+      for (const auto [variable_index, derivative]: exact_objective_gradient) {
+         dense_objective_gradient[variable_index] += derivative;
+      }
+      for (size_t variable_index: Range(n)) {
+         EXPECT_NEAR(objective_gradient[variable_index], dense_objective_gradient[variable_index], 1e-12);
+      }
+   }
+}
+
+TEST(SyntheticModel, UnknownProblem) {
+   EXPECT_THROW(SyntheticModelFactory::create("unknown", 10), std::invalid_argument);
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "tools/TaskScheduler.hpp"
+
+using namespace uno;
+
+TEST(TaskScheduler, ParallelFor) {
+   TaskScheduler::configure(4);
+   std::vector<size_t> values(1000, 0);
+   TaskScheduler::parallel_for(0, values.size(), 16, [&](size_t index) {
+      values[index] = 2 * index;
+   });
+   for (size_t index = 0; index < values.size(); index++) {
+      ASSERT_EQ(values[index], 2 * index);
+   }
+}
+
+// the sum does not depend on the number of threads
+TEST(TaskScheduler, DeterministicReduction) {
+   const auto sum = []() {
+      return TaskScheduler::parallel_reduce(0, 100000, 64, 0., [](size_t index) {
+         return std::sin(static_cast<double>(index));
+      }, [](double x, double y) {
+         return x + y;
+      });
+   };
+   TaskScheduler::configure(1);
+   const double sequential_sum = sum();
+   TaskScheduler::configure(4);
+   ASSERT_EQ(sum(), sequential_sum);
+   ASSERT_EQ(sum(), sequential_sum);
+}
+
+TEST(TaskScheduler, NestedRegions) {
+   TaskScheduler::configure(4);
+   std::vector<size_t> row_sums(8, 0);
+   TaskScheduler::parallel_for(0, row_sums.size(), 1, [&](size_t row_index) {
+      // the backends are sequential within a task
+      ASSERT_EQ(TaskScheduler::backend_threads(SolverPhase::FACTORIZATION), 1);
+      row_sums[row_index] = TaskScheduler::parallel_reduce(0, 100, 10, size_t(0), [=](size_t column_index) {
+         return row_index * column_index;
+      }, [](size_t x, size_t y) {
+         return x + y;
+      });
+   });
+   for (size_t row_index = 0; row_index < row_sums.size(); row_index++) {
+      ASSERT_EQ(row_sums[row_index], row_index * 4950);
+   }
+   ASSERT_EQ(TaskScheduler::backend_threads(SolverPhase::FACTORIZATION), 4);
+   ASSERT_EQ(TaskScheduler::backend_threads(SolverPhase::EVALUATION), 1);
+}
+
+TEST(TaskScheduler, Exception) {
+   TaskScheduler::configure(4);
+   ASSERT_THROW(TaskScheduler::parallel_for(0, 100, 1, [](size_t index) {
+      if (index == 42) {
+         throw std::runtime_error("task failed");
+      }
+   }), std::runtime_error);
+}